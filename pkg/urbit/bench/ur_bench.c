@@ -387,7 +387,202 @@ _cue_soft_bench(void)
   u3z(vat);
 }
 
+/* _mbs(): throughput of [len_d] bytes in [d0], in MB/s.
+*/
+static double
+_mbs(c3_d len_d, struct timeval* d0)
+{
+  c3_d mic_d = ((c3_d)d0->tv_sec * 1000000ULL) + d0->tv_usec;
+
+  //  bytes per microsecond
+  //
+  return ( mic_d ) ? ((double)len_d / (double)mic_d) : 0.0;
+}
+
+/* _batch_ex(): [len_w] distinct events, carrying irregular payloads.
+*/
+static u3_noun
+_batch_ex(c3_w len_w)
+{
+  u3_noun lis = u3_nul;
+  c3_w    ran_w = 0x9e3779b9;
+  c3_y    pay_y[1021];
+  c3_w    i_w, j_w;
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    c3_w pay_w = 1 + (ran_w % sizeof(pay_y));
+
+    for ( j_w = 0; j_w < pay_w; j_w++ ) {
+      ran_w  = (ran_w * 1103515245) + 12345;
+      pay_y[j_w] = (c3_y)(ran_w >> 16);
+    }
+
+    //  make sure the payload is exactly [pay_w] bytes
+    //
+    pay_y[pay_w - 1] |= 1;
+
+    {
+      u3_noun wir = u3nt(c3__newt, u3i_word(ran_w), u3_nul);
+      u3_noun cad = u3nt(c3__send, u3nc(0, i_w), u3i_bytes(pay_w, pay_y));
+
+      lis = u3nc(u3nt(u3i_word(i_w), u3nc(u3_blip, wir), cad), lis);
+    }
+  }
+
+  return lis;
+}
+
+/* _bits_bench_bytes(): bitstream throughput over a jammed buffer.
+*/
+static void
+_bits_bench_bytes(c3_c* cap_c, c3_d len_d, c3_y* byt_y)
+{
+  struct timeval b4, f2, d0;
+  c3_w  i_w, max_w;
+
+  //  aim for at least ~64MB of traffic per measurement
+  //
+  max_w = c3_max(1, (64ULL << 20) / c3_max(1, len_d));
+
+  fprintf(stderr, "\r\n%s: %" PRIu64 " bytes, %u rounds\r\n",
+                  cap_c, len_d, max_w);
+
+  {
+    ur_cue_test_t *t = ur_cue_test_init();
+
+    gettimeofday(&b4, 0);
+
+    for ( i_w = 0; i_w < max_w; i_w++ ) {
+      if ( !ur_cue_test_with(t, len_d, byt_y) ) {
+        fprintf(stderr, "  cue test: invalid jam\r\n");
+        ur_cue_test_done(t);
+        return;
+      }
+    }
+
+    gettimeofday(&f2, 0);
+    timersub(&f2, &b4, &d0);
+    fprintf(stderr, "  cue test: %.1f MB/s\r\n",
+                    _mbs(len_d * max_w, &d0));
+
+    ur_cue_test_done(t);
+  }
+
+  {
+    ur_root_t* rot_u = ur_root_init();
+    ur_nref      ref;
+    c3_d       jen_d;
+    c3_y*      jyt_y;
+
+    gettimeofday(&b4, 0);
+
+    for ( i_w = 0; i_w < max_w; i_w++ ) {
+      ur_cue(rot_u, len_d, byt_y, &ref);
+    }
+
+    gettimeofday(&f2, 0);
+    timersub(&f2, &b4, &d0);
+    fprintf(stderr, "  cue cons: %.1f MB/s\r\n",
+                    _mbs(len_d * max_w, &d0));
+
+    {
+      ur_jam_t *jam_u = ur_jam_init(rot_u);
+
+      gettimeofday(&b4, 0);
+
+      for ( i_w = 0; i_w < max_w; i_w++ ) {
+        ur_jam_with(jam_u, ref, &jen_d, &jyt_y);
+        c3_free(jyt_y);
+      }
+
+      gettimeofday(&f2, 0);
+      timersub(&f2, &b4, &d0);
+      fprintf(stderr, "  jam cons with: %.1f MB/s\r\n",
+                      _mbs(jen_d * max_w, &d0));
+
+      ur_jam_done(jam_u);
+    }
+
+    ur_root_free(rot_u);
+  }
+}
+
+/* _bits_bench(): bitstream throughput, on an event batch and any files.
+*/
+static void
+_bits_bench(c3_i argc, c3_c* argv[])
+{
+  struct timeval b4, f2, d0;
+  c3_w  i_w, max_w = 20;
+  u3_noun bat = _batch_ex(2048);
+  c3_d  len_d;
+  c3_y* byt_y;
+
+  fprintf(stderr, "\r\nbitstream benchmark:\r\n");
+
+  {
+    gettimeofday(&b4, 0);
+
+    for ( i_w = 0; i_w < max_w; i_w++ ) {
+      u3s_jam_xeno(bat, &len_d, &byt_y);
+      c3_free(byt_y);
+    }
+
+    gettimeofday(&f2, 0);
+    timersub(&f2, &b4, &d0);
+    fprintf(stderr, "  batch jam xeno: %.1f MB/s\r\n",
+                    _mbs(len_d * max_w, &d0));
+  }
+
+  u3s_jam_xeno(bat, &len_d, &byt_y);
+  u3z(bat);
+
+  {
+    gettimeofday(&b4, 0);
+
+    for ( i_w = 0; i_w < max_w; i_w++ ) {
+      u3z(u3s_cue_xeno(len_d, byt_y));
+    }
+
+    gettimeofday(&f2, 0);
+    timersub(&f2, &b4, &d0);
+    fprintf(stderr, "  batch cue xeno: %.1f MB/s\r\n",
+                    _mbs(len_d * max_w, &d0));
+  }
+
+  _bits_bench_bytes("event batch", len_d, byt_y);
+  c3_free(byt_y);
+
+  //  jammed files (pills, event batches) named on the command line
+  //
+  for ( i_w = 1; i_w < (c3_w)argc; i_w++ ) {
+    FILE* fil_u = fopen(argv[i_w], "rb");
+
+    if ( !fil_u ) {
+      fprintf(stderr, "bench: open %s: %s\r\n", argv[i_w], strerror(errno));
+      continue;
+    }
+
+    fseek(fil_u, 0, SEEK_END);
+    len_d = ftell(fil_u);
+    fseek(fil_u, 0, SEEK_SET);
+    byt_y = c3_malloc(len_d);
+
+    if ( len_d != fread(byt_y, 1, len_d, fil_u) ) {
+      fprintf(stderr, "bench: read %s failed\r\n", argv[i_w]);
+    }
+    else {
+      _bits_bench_bytes(argv[i_w], len_d, byt_y);
+    }
+
+    fclose(fil_u);
+    c3_free(byt_y);
+  }
+}
+
 /* main(): run all benchmarks
+**
+**   any arguments are paths to jammed nouns, for bitstream throughput.
 */
 int
 main(int argc, char* argv[])
@@ -397,6 +592,7 @@ main(int argc, char* argv[])
   _jam_bench();
   _cue_bench();
   _cue_soft_bench();
+  _bits_bench(argc, argv);
 
   //  GC
   //
@@ -369,9 +369,85 @@ long sysconf(int name)
 {
   SYSTEM_INFO si;
 
-  if ( _SC_PAGESIZE != name ) {
-    return -1;
-  }
   GetNativeSystemInfo(&si);
-  return si.dwPageSize;
+
+  switch ( name ) {
+    case _SC_PAGESIZE:         return si.dwPageSize;
+    case _SC_NPROCESSORS_ONLN: return si.dwNumberOfProcessors;
+    default:                   return -1;
+  }
+}
+
+//  positioned I/O via OVERLAPPED offsets; like POSIX on a file,
+//  but (unlike POSIX) this moves the file pointer
+//
+static ssize_t _positioned(int fd, void *buf, size_t count, off_t offset, int wri)
+{
+    HANDLE     h = (HANDLE)_get_osfhandle(fd);
+    OVERLAPPED o = {0};
+    DWORD      n;
+    BOOL       ok;
+
+    if (h == INVALID_HANDLE_VALUE)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    o.Offset     = (DWORD)((uint64_t)offset & 0xffffffff);
+    o.OffsetHigh = (DWORD)((uint64_t)offset >> 32);
+
+    if (count > 0x7ffff000)
+    {
+        count = 0x7ffff000;
+    }
+
+    ok = wri ? WriteFile(h, buf, (DWORD)count, &n, &o)
+             : ReadFile(h, buf, (DWORD)count, &n, &o);
+
+    if (!ok)
+    {
+        DWORD err = GetLastError();
+
+        if (!wri && ERROR_HANDLE_EOF == err)
+        {
+            return 0;
+        }
+        errno = err_win_to_posix(err);
+        return -1;
+    }
+    return n;
+}
+
+ssize_t pread(int fd, void *buf, size_t count, off_t offset)
+{
+    return _positioned(fd, buf, count, offset, 0);
+}
+
+ssize_t pwrite(int fd, const void *buf, size_t count, off_t offset)
+{
+    return _positioned(fd, (void*)buf, count, offset, 1);
+}
+
+ssize_t pwritev(int fd, const struct iovec *iov, int iovcnt, off_t offset)
+{
+    ssize_t tot = 0;
+    int     i;
+
+    for (i = 0; i < iovcnt; i++)
+    {
+        ssize_t ret = pwrite(fd, iov[i].iov_base, iov[i].iov_len, offset + tot);
+
+        if (ret < 0)
+        {
+            return tot ? tot : -1;
+        }
+        tot += ret;
+
+        if ((size_t)ret < iov[i].iov_len)
+        {
+            break;
+        }
+    }
+    return tot;
 }
@@ -9,6 +9,15 @@ int fdatasync(int fd);
 int utimes(const char *path, const struct timeval times[2]);
 long sysconf(int name);
 
+struct iovec {
+  void*  iov_base;
+  size_t iov_len;
+};
+
+ssize_t pread(int fd, void *buf, size_t count, off_t offset);
+ssize_t pwrite(int fd, const void *buf, size_t count, off_t offset);
+ssize_t pwritev(int fd, const struct iovec *iov, int iovcnt, off_t offset);
+
 int kill(pid_t pid, int signum);
 
 #define SIGUSR1       10
@@ -17,5 +26,6 @@ int kill(pid_t pid, int signum);
 #define SIGSTK        31
 #define SIG_COUNT     32
 #define _SC_PAGESIZE  29
+#define _SC_NPROCESSORS_ONLN 84
 
 #endif//_MINGW_IO_H
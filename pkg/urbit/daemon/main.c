@@ -21,6 +21,12 @@
 #include <vere/db/lmdb.h>
 #include <getopt.h>
 #include <libgen.h>
+#if !defined(U3_OS_mingw)
+#include <sys/wait.h>
+#endif
+#if defined(U3_OS_linux)
+#include <sys/prctl.h>
+#endif
 
 #include "ca-bundle.h"
 #include "whereami.h"
@@ -30,7 +36,14 @@
 static u3_serf        u3V;             //  one serf per process
 static u3_moat      inn_u;             //  input stream
 static u3_mojo      out_u;             //  output stream
+static u3_ring*     rin_u;             //  shared memory, if any
 static u3_cue_xeno* sil_u;             //  cue handle
+#if !defined(U3_OS_mingw)
+static c3_w         sry_w;             //  scry readers
+static c3_i         sry_i[u3_seer_max];  //  reader pids (-1 if gone)
+static c3_i         sry_o = -1;        //  in a reader, its output
+static uv_signal_t  sry_u;             //  reader exits
+#endif
 
 #undef SERF_TRACE_JAM
 #undef SERF_TRACE_CUE
@@ -162,6 +175,10 @@ _main_init(void)
   u3_Host.ops_u.tem = c3n;
   u3_Host.ops_u.tex = c3n;
   u3_Host.ops_u.tra = c3n;
+  u3_Host.ops_u.uff = c3n;
+  u3_Host.ops_u.hug = c3n;
+  u3_Host.ops_u.rin = c3n;
+  u3_Host.ops_u.sry_w = 0;
   u3_Host.ops_u.veb = c3n;
   u3_Host.ops_u.puf_c = "jam";
   u3_Host.ops_u.hap_w = 50000;
@@ -222,6 +239,7 @@ _main_getopt(c3_i argc, c3_c** argv)
     { "kernel-stage",        required_argument, NULL, 'K' },
     { "key-file",            required_argument, NULL, 'k' },
     { "loom",                required_argument, NULL, c3__loom },
+    { "loom-page",           required_argument, NULL, c3__page },
     { "local",               no_argument,       NULL, 'L' },
     { "lite-boot",           no_argument,       NULL, 'l' },
     { "replay-to",           required_argument, NULL, 'n' },
@@ -231,6 +249,12 @@ _main_getopt(c3_i argc, c3_c** argv)
     { "https-port",          required_argument, NULL, c3__htls },
     { "no-conn",             no_argument,       NULL, c3__noco },
     { "no-dock",             no_argument,       NULL, c3__nodo },
+    { "userfaultfd",         no_argument,       NULL, c3__uffd },
+    { "huge-pages",          no_argument,       NULL, c3__huge },
+    { "commit-wait",         required_argument, NULL, c3__wait },
+    { "commit-size",         required_argument, NULL, c3__size },
+    { "ipc-ring",            no_argument,       NULL, c3__ring },
+    { "scry-readers",        required_argument, NULL, c3__scry },
     { "quiet",               no_argument,       NULL, 'q' },
     { "versions",            no_argument,       NULL, 'R' },
     { "replay-from",         required_argument, NULL, 'r' },
@@ -384,6 +408,49 @@ _main_getopt(c3_i argc, c3_c** argv)
         u3_Host.ops_u.doc = c3n;
         break;
       }
+      case c3__page: {
+        c3_w pag_w;
+        c3_o res_o = _main_readw(optarg, 22, &pag_w);
+        if ( (c3n == res_o) || (pag_w < 14) ) {
+          fprintf(stderr, "error: --loom-page must be >= 14 and <= 21\r\n");
+          return c3n;
+        }
+        u3_Host.ops_u.pag_y = pag_w;
+        break;
+      }
+      case c3__huge: {
+        u3_Host.ops_u.hug = c3y;
+        break;
+      }
+      case c3__wait: {
+        if ( c3n == _main_readw(optarg, 60000, &u3_Host.ops_u.wai_w) ) {
+          fprintf(stderr, "error: --commit-wait must be < 60000\r\n");
+          return c3n;
+        }
+        break;
+      }
+      case c3__size: {
+        if ( c3n == _main_readw(optarg, 1U << 20, &u3_Host.ops_u.bat_w) ) {
+          fprintf(stderr, "error: --commit-size must be < 1048576\r\n");
+          return c3n;
+        }
+        break;
+      }
+      case c3__uffd: {
+        u3_Host.ops_u.uff = c3y;
+        break;
+      }
+      case c3__ring: {
+        u3_Host.ops_u.rin = c3y;
+        break;
+      }
+      case c3__scry: {
+        if ( c3n == _main_readw(optarg, u3_seer_max + 1, &u3_Host.ops_u.sry_w) ) {
+          fprintf(stderr, "error: --scry-readers must be <= %u\r\n", u3_seer_max);
+          return c3n;
+        }
+        break;
+      }
       case 'R': {
         u3_Host.ops_u.rep = c3y;
         return c3y;
@@ -628,6 +695,7 @@ _cw_usage(c3_c* bin_c)
 {
   c3_c *use_c[] = {
     "utilities:\n",
+    "  %s chop %.*s              truncate event log:\n",
     "  %s cram %.*s              jam state:\n",
     "  %s dock %.*s              copy binary:\n",
     "  %s grab %.*s              measure memory usage:\n",
@@ -642,6 +710,8 @@ _cw_usage(c3_c* bin_c)
     "    %s serf <pier> <key> <flags> <cache-size> <at-event>"
 #ifdef U3_OS_mingw
     " <ctrlc-handle>"
+#else
+    " [ring|pipe] [scry-readers]"
 #endif
     "\n",
     0
@@ -713,6 +783,13 @@ u3_ve_usage(c3_i argc, c3_c** argv)
     "-Z, --scry-format FORMAT      Optional file format ('jam', or aura, for -X)\n",
     "    --no-conn                 Do not run control plane\n",
     "    --no-dock                 Skip binary \"docking\" on boot\n",
+    "    --userfaultfd             Page in loom snapshots on demand (Linux)\n",
+    "    --loom-page               Set loom page to binary exponent (14 == 16KB)\n",
+    "    --huge-pages              Back the loom with huge pages (Linux)\n",
+    "    --commit-wait MS          Hold events up to MS before committing\n",
+    "    --commit-size N           Commit once N events are pending\n",
+    "    --ipc-ring                Talk to the serf over shared memory (Linux)\n",
+    "    --scry-readers N          Answer scries on N forks of the serf (Unix)\n",
     "\n",
     "Development Usage:\n",
     "   To create a development ship, use a fakezod:\n",
@@ -833,7 +910,12 @@ _cw_serf_send(u3_noun pel)
   u3t_event_trace("serf ipc jam", 'E');
 #endif
 
-  u3_newt_send(&out_u, len_d, byt_y);
+  if ( rin_u ) {
+    u3_newt_ring_send(rin_u, len_d, byt_y);
+  }
+  else {
+    u3_newt_send(&out_u, len_d, byt_y);
+  }
   u3z(pel);
 }
 
@@ -884,7 +966,11 @@ _cw_serf_writ(void* vod_p, c3_d len_d, c3_y* byt_y)
   u3t_event_trace("serf ipc cue", 'B');
 #endif
 
-  jar = u3s_cue_xeno_with(sil_u, len_d, byt_y);
+  //  %play is framed, not jammed (see vere/lord.c)
+  //
+  jar = ( len_d && (0xff == byt_y[0]) )
+        ? u3_lord_play_cue(sil_u, len_d, byt_y)
+        : u3s_cue_xeno_with(sil_u, len_d, byt_y);
 
 #ifdef SERF_TRACE_CUE
   u3t_event_trace("serf ipc cue", 'E');
@@ -1022,15 +1108,261 @@ _cw_intr_win(c3_c* han_c)
 }
 #endif
 
+#ifndef U3_OS_mingw
+/* _cw_seer_write(): write a whole buffer from a scry reader, or exit.
+*/
+static void
+_cw_seer_write(c3_i fid_i, c3_y* buf_y, c3_d len_d)
+{
+  ssize_t ret_i;
+
+  while ( len_d ) {
+    if ( 0 > (ret_i = write(fid_i, buf_y, len_d)) ) {
+      if ( EINTR == errno ) {
+        continue;
+      }
+
+      _exit(1);
+    }
+
+    buf_y += ret_i;
+    len_d -= ret_i;
+  }
+}
+
+/* _cw_seer_read(): read a whole buffer into a scry reader, c3n on EOF.
+*/
+static c3_o
+_cw_seer_read(c3_i fid_i, c3_y* buf_y, c3_d len_d)
+{
+  ssize_t ret_i;
+
+  while ( len_d ) {
+    if ( 0 > (ret_i = read(fid_i, buf_y, len_d)) ) {
+      if ( EINTR == errno ) {
+        continue;
+      }
+
+      _exit(1);
+    }
+    else if ( 0 == ret_i ) {
+      return c3n;
+    }
+
+    buf_y += ret_i;
+    len_d -= ret_i;
+  }
+
+  return c3y;
+}
+
+/* _cw_seer_send(): send plea from a scry reader (see vere/newt.c).
+*/
+static void
+_cw_seer_send(u3_noun pel)
+{
+  c3_y  hed_y[5];
+  c3_d  len_d;
+  c3_y* byt_y;
+
+  u3s_jam_xeno(pel, &len_d, &byt_y);
+
+  hed_y[0] = 0x0;
+  hed_y[1] = ( len_d        & 0xff);
+  hed_y[2] = ((len_d >>  8) & 0xff);
+  hed_y[3] = ((len_d >> 16) & 0xff);
+  hed_y[4] = ((len_d >> 24) & 0xff);
+
+  _cw_seer_write(sry_o, hed_y, sizeof(hed_y));
+  _cw_seer_write(sry_o, byt_y, len_d);
+
+  c3_free(byt_y);
+  u3z(pel);
+}
+
+/* _cw_seer_send_slog(): send hint output from a scry reader.
+*/
+static void
+_cw_seer_send_slog(u3_noun hod)
+{
+  _cw_seer_send(u3nc(c3__slog, hod));
+}
+
+/* _cw_seer_send_stdr(): send stderr output from a scry reader.
+*/
+static void
+_cw_seer_send_stdr(c3_c* str_c)
+{
+  _cw_seer_send(u3nc(c3__flog, u3i_string(str_c)));
+}
+
+/* _cw_seer_run(): as scry reader [red_w], answer %peek until EOF.
+**
+**   runs in a fork of the serf, against a copy-on-write loom; all i/o
+**   is blocking, as the event loop belongs to the parent.
+*/
+static void
+_cw_seer_run(c3_w red_w)
+{
+  c3_i inn_i = 6 + 2 * red_w;
+  c3_w i_w;
+
+#if defined(U3_OS_linux)
+  prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+
+  //  drop the serf's streams, and other readers', so that their
+  //  EOFs aren't held up by us
+  //
+  {
+    uv_os_fd_t fid_i;
+
+    if ( !uv_fileno((uv_handle_t*)&inn_u.pyp_u, &fid_i) ) {
+      close(fid_i);
+    }
+
+    if ( !uv_fileno((uv_handle_t*)&out_u.pyp_u, &fid_i) ) {
+      close(fid_i);
+    }
+
+    if ( rin_u ) {
+      close(rin_u->mem_i);
+      close(rin_u->wak_i);
+      close(rin_u->pir_i);
+    }
+
+    for ( i_w = 0; i_w < sry_w; i_w++ ) {
+      if ( (i_w != red_w) && (-1 != sry_i[i_w]) ) {
+        close(6 + 2 * i_w);
+        close(7 + 2 * i_w);
+      }
+    }
+  }
+
+  sry_w = 0;
+  sry_o = 7 + 2 * red_w;
+
+  fcntl(inn_i, F_SETFL, fcntl(inn_i, F_GETFL) & ~O_NONBLOCK);
+  fcntl(sry_o, F_SETFL, fcntl(sry_o, F_GETFL) & ~O_NONBLOCK);
+
+  u3_Host.tra_u.fil_u = 0;
+  u3C.stderr_log_f = _cw_seer_send_stdr;
+  u3C.slog_f = _cw_seer_send_slog;
+
+  while ( 1 ) {
+    c3_y    hed_y[5];
+    c3_d    len_d;
+    c3_y*   byt_y;
+    u3_weak jar;
+    u3_noun pel;
+
+    if ( c3n == _cw_seer_read(inn_i, hed_y, sizeof(hed_y)) ) {
+      _exit(0);
+    }
+
+    len_d = (((c3_d)hed_y[1]) <<  0)
+          | (((c3_d)hed_y[2]) <<  8)
+          | (((c3_d)hed_y[3]) << 16)
+          | (((c3_d)hed_y[4]) << 24);
+
+    if ( (0x0 != hed_y[0]) || !len_d ) {
+      _exit(1);
+    }
+
+    byt_y = c3_malloc(len_d);
+
+    if ( c3n == _cw_seer_read(inn_i, byt_y, len_d) ) {
+      _exit(1);
+    }
+
+    jar = u3s_cue_xeno_with(sil_u, len_d, byt_y);
+    c3_free(byt_y);
+
+    if (  (u3_none == jar)
+       || (c3n == u3a_is_cell(jar))
+       || (c3__peek != u3h(jar))
+       || (c3n == u3_serf_writ(&u3V, jar, &pel)) )
+    {
+      fprintf(stderr, "serf: scry reader %u: bad jar\r\n", red_w);
+      _exit(1);
+    }
+
+    _cw_seer_send(pel);
+  }
+}
+
+/* _cw_serf_gone(): scry reader [red_w] is gone; close its streams,
+**                  so that the king sees EOF.
+*/
+static void
+_cw_serf_gone(c3_w red_w)
+{
+  close(6 + 2 * red_w);
+  close(7 + 2 * red_w);
+  sry_i[red_w] = -1;
+}
+
+/* _cw_serf_reap_cb(): reap scry readers that exited on their own.
+*/
+static void
+_cw_serf_reap_cb(uv_signal_t* sig_u, c3_i num_i)
+{
+  c3_w i_w;
+  c3_i sat_i;
+
+  for ( i_w = 0; i_w < sry_w; i_w++ ) {
+    if (  (0 < sry_i[i_w])
+       && (sry_i[i_w] == waitpid(sry_i[i_w], &sat_i, WNOHANG)) )
+    {
+      fprintf(stderr, "serf: scry reader %u exited (status %d)\r\n",
+                      i_w, sat_i);
+      _cw_serf_gone(i_w);
+    }
+  }
+}
+
+/* _cw_serf_fork(): (re)fork scry reader [red_w] from the current state.
+*/
+static void
+_cw_serf_fork(c3_w red_w)
+{
+  c3_i pid_i;
+
+  if ( (red_w >= sry_w) || (-1 == sry_i[red_w]) ) {
+    fprintf(stderr, "serf: fork: no scry reader %u\r\n", red_w);
+    return;
+  }
+
+  //  the king only re-forks idle readers
+  //
+  if ( sry_i[red_w] ) {
+    kill(sry_i[red_w], SIGKILL);
+    waitpid(sry_i[red_w], 0, 0);
+    sry_i[red_w] = 0;
+  }
+
+  if ( -1 == (pid_i = u3e_fork()) ) {
+    fprintf(stderr, "serf: fork: %s\r\n", strerror(errno));
+    _cw_serf_gone(red_w);
+  }
+  else if ( !pid_i ) {
+    _cw_seer_run(red_w);
+  }
+  else {
+    sry_i[red_w] = pid_i;
+  }
+}
+#endif
+
 /* _cw_serf_commence(): initialize and run serf
 */
 static void
 _cw_serf_commence(c3_i argc, c3_c* argv[])
 {
 #ifdef U3_OS_mingw
-  if ( 9 > argc ) {
+  if ( 10 > argc ) {
 #else
-  if ( 8 > argc ) {
+  if ( 9 > argc ) {
 #endif
     fprintf(stderr, "serf: missing args\n");
     exit(1);
@@ -1045,13 +1377,33 @@ _cw_serf_commence(c3_i argc, c3_c* argv[])
   c3_c*      lom_c = argv[6];
   c3_w       lom_w;
   c3_c*      eve_c = argv[7];
+  c3_c*      pag_c = argv[8];
+  c3_w       pag_w;
 #ifdef U3_OS_mingw
-  c3_c*      han_c = argv[8];
+  c3_c*      han_c = argv[9];
   _cw_intr_win(han_c);
 #endif
 
   _cw_init_io(lup_u);
 
+#ifndef U3_OS_mingw
+  //  join the king's shared-memory transport (see vere/lord.c)
+  //
+  if ( (10 <= argc) && !strcmp(argv[9], "ring") ) {
+    if ( !(rin_u = u3_newt_ring_join(3, 4, 5)) ) {
+      fprintf(stderr, "serf: unable to join shared-memory ipc\r\n");
+      exit(1);
+    }
+  }
+
+  //  scry readers are forked on command (see vere/lord.c)
+  //
+  if ( 11 <= argc ) {
+    sscanf(argv[10], "%" SCNu32, &sry_w);
+    sry_w = c3_min(sry_w, u3_seer_max);
+  }
+#endif
+
   memset(&u3V, 0, sizeof(u3V));
   memset(&u3_Host.tra_u, 0, sizeof(u3_Host.tra_u));
 
@@ -1073,6 +1425,11 @@ _cw_serf_commence(c3_i argc, c3_c* argv[])
     sscanf(wag_c, "%" SCNu32, &u3C.wag_w);
     sscanf(hap_c, "%" SCNu32, &u3_Host.ops_u.hap_w);
     sscanf(lom_c, "%" SCNu32, &lom_w);
+    sscanf(pag_c, "%" SCNu32, &pag_w);
+
+    //  page size is given in bytes, kept in words
+    //
+    u3C.pag_y = ( pag_w ) ? (pag_w - 2) : 0;
 
     if ( 1 != sscanf(eve_c, "%" PRIu64, &eve_d) ) {
       fprintf(stderr, "serf: rock: invalid number '%s'\r\n", argv[4]);
@@ -1122,6 +1479,14 @@ _cw_serf_commence(c3_i argc, c3_c* argv[])
 
   u3V.xit_f = _cw_serf_exit;
 
+#ifndef U3_OS_mingw
+  if ( sry_w ) {
+    u3V.fok_f = _cw_serf_fork;
+    uv_signal_init(lup_u, &sry_u);
+    uv_signal_start(&sry_u, _cw_serf_reap_cb, SIGCHLD);
+  }
+#endif
+
 #if defined(SERF_TRACE_JAM) || defined(SERF_TRACE_CUE)
   u3t_trace_open(u3V.dir_c);
 #endif
@@ -1136,6 +1501,10 @@ _cw_serf_commence(c3_i argc, c3_c* argv[])
   //
   u3_newt_read_sync(&inn_u);
 
+  if ( rin_u ) {
+    u3_newt_ring_read(rin_u, &inn_u);
+  }
+
   //  enter loop
   //
   uv_run(lup_u, UV_RUN_DEFAULT);
@@ -1326,6 +1695,12 @@ _cw_info(c3_i argc, c3_c* argv[])
   fprintf(stderr, "\r\nurbit: %s at event %" PRIu64 "\r\n",
                   u3_Host.dir_c, eve_d);
 
+  if ( (eve_d + 1) < log_u->fir_d ) {
+    fprintf(stderr, "urbit: snapshot precedes the event log (epoch %" PRIu64
+                    "), and cannot be replayed\r\n",
+                    log_u->epo_d);
+  }
+
   u3_disk_slog(log_u);
   printf("\n");
   u3_lmdb_stat(log_u->mdb_u, stdout);
@@ -1442,6 +1817,105 @@ _cw_cram(c3_i argc, c3_c* argv[])
   u3m_stop();
 }
 
+/* _cw_chop(): start a new event log epoch after the snapshot, and exit.
+**
+**   the snapshot is checked against the log, and jammed into a rock
+**   (see _cw_queu()) before any events are removed. the events before
+**   it are archived in .urb/log/chop/, unless --drop is given.
+*/
+static void
+_cw_chop(c3_i argc, c3_c* argv[])
+{
+  c3_i ch_i, lid_i;
+  c3_w arg_w;
+  c3_o arc_o = c3y;
+
+  static struct option lop_u[] = {
+    { "loom", required_argument, NULL, c3__loom },
+    { "drop", no_argument,       NULL, c3__drop },
+    { NULL, 0, NULL, 0 }
+  };
+
+  u3_Host.dir_c = _main_pier_run(argv[0]);
+
+  while ( -1 != (ch_i=getopt_long(argc, argv, "", lop_u, &lid_i)) ) {
+    switch ( ch_i ) {
+      case c3__loom: {
+        c3_w lom_w;
+        c3_o res_o = _main_readw(optarg, u3a_bits + 3, &lom_w);
+        if ( (c3n == res_o) || (lom_w < 20) ) {
+          fprintf(stderr, "error: --loom must be >= 20 and <= %u\r\n", u3a_bits + 2);
+          exit(1);
+        }
+        u3_Host.ops_u.lom_y = lom_w;
+      } break;
+
+      case c3__drop: {
+        arc_o = c3n;
+      } break;
+
+      case '?': {
+        fprintf(stderr, "invalid argument\r\n");
+        exit(1);
+      } break;
+    }
+  }
+
+  //  argv[optind] is always "chop"
+  //
+
+  if ( !u3_Host.dir_c ) {
+    if ( optind + 1 < argc ) {
+      u3_Host.dir_c = argv[optind + 1];
+    }
+    else {
+      fprintf(stderr, "invalid command, pier required\r\n");
+      exit(1);
+    }
+
+    optind++;
+  }
+
+  if ( optind + 1 != argc ) {
+    fprintf(stderr, "invalid command\r\n");
+    exit(1);
+  }
+
+  u3_disk* log_u = _cw_disk_init(u3_Host.dir_c); // XX s/b try_aquire lock
+  c3_d     eve_d = u3m_boot(u3_Host.dir_c, (size_t)1 << u3_Host.ops_u.lom_y);
+  c3_l     mug_l;
+
+  if ( !eve_d ) {
+    fprintf(stderr, "urbit: chop: no snapshot\r\n");
+    exit(1);
+  }
+
+  mug_l = u3r_mug(u3A->roc);
+
+  fprintf(stderr, "urbit: chop: preparing rock at event %" PRIu64 "\r\n", eve_d);
+
+  if ( c3n == u3u_cram(u3_Host.dir_c, eve_d) ) {
+    fprintf(stderr, "urbit: chop: unable to jam state\r\n");
+    exit(1);
+  }
+
+  //  save, as we just did all the work of deduplication
+  //
+  u3e_save();
+
+  if ( c3n == u3_disk_chop(log_u, eve_d, mug_l, arc_o) ) {
+    fprintf(stderr, "urbit: chop: failed\r\n");
+    exit(1);
+  }
+
+  fprintf(stderr, "urbit: chop: epoch starts after event %" PRIu64
+                  ", log now %" PRIu64 "-%" PRIu64 "\r\n",
+                  eve_d, log_u->fir_d, log_u->dun_d);
+
+  u3_disk_exit(log_u);
+  u3m_stop();
+}
+
 /* _cw_queu(): cue rock, save, and exit.
 */
 static void
@@ -1491,12 +1965,12 @@ _cw_queu(c3_i argc, c3_c* argv[])
     optind++;
   }
 
-  if ( optind + 1 != argc ) {
+  if ( optind + 2 != argc ) {
     fprintf(stderr, "invalid command\r\n");
     exit(1);
   }
 
-  c3_c* eve_c;
+  c3_c* eve_c = argv[optind + 1];
   c3_d  eve_d;
 
   if ( 1 != sscanf(eve_c, "%" PRIu64 "", &eve_d) ) {
@@ -1506,6 +1980,18 @@ _cw_queu(c3_i argc, c3_c* argv[])
   else {
     u3_disk* log_u = _cw_disk_init(u3_Host.dir_c); // XX s/b try_aquire lock
 
+    //  the rock must be followed by its epoch in the log
+    //
+    if (  (eve_d > log_u->dun_d)
+       || ((eve_d + 1) < log_u->fir_d) )
+    {
+      fprintf(stderr, "urbit: queu: rock at event %" PRIu64 " not covered"
+                      " by event log (%" PRIu64 "-%" PRIu64 ")\r\n",
+                      eve_d, log_u->fir_d, log_u->dun_d);
+      u3_disk_exit(log_u);
+      exit(1);
+    }
+
     fprintf(stderr, "urbit: queu: preparing\r\n");
 
     u3m_boot(u3_Host.dir_c, (size_t)1 << u3_Host.ops_u.lom_y);
@@ -1997,7 +2483,8 @@ _cw_utils(c3_i argc, c3_c* argv[])
   //  utility commands and positional arguments, by analogy
   //
   //    $@  ~                                             ::  usage
-  //    $%  [%cram dir=@t]                                ::  jam state
+  //    $%  [%chop dir=@t]                                ::  truncate log
+  //        [%cram dir=@t]                                ::  jam state
   //        [%dock dir=@t]                                ::  copy binary
   //        [?(%grab %mass) dir=@t]                       ::  gc
   //        [%info dir=@t]                                ::  print
@@ -2012,6 +2499,8 @@ _cw_utils(c3_i argc, c3_c* argv[])
   //        $:  %serf                                     ::  compute
   //            dir=@t  key=@t wag=@t hap=@ud             ::
   //            lom=@ud eve=@ud                           ::
+  //            pag=@ud rin=(unit ?(%ring %pipe))        ::
+  //            sry=(unit @ud)                            ::
   //    ==  ==                                            ::
   //
   //    NB: don't print to anything other than stderr;
@@ -2033,6 +2522,7 @@ _cw_utils(c3_i argc, c3_c* argv[])
   }
 
   switch ( mot_m ) {
+    case c3__chop: _cw_chop(argc, argv); return 1;
     case c3__cram: _cw_cram(argc, argv); return 1;
     case c3__dock: _cw_dock(argc, argv); return 1;
     case c3__eval: _cw_eval(argc, argv); return 1;
@@ -2213,6 +2703,18 @@ main(c3_i   argc,
         u3C.wag_w |= u3o_hashless;
       }
 
+      /*  Set userfaultfd flag
+      */
+      if ( _(u3_Host.ops_u.uff) ) {
+        u3C.wag_w |= u3o_userfault;
+      }
+
+      /*  Set huge page flag
+      */
+      if ( _(u3_Host.ops_u.hug) ) {
+        u3C.wag_w |= u3o_hugepage;
+      }
+
       /*  Set tracing flag
       */
       if ( _(u3_Host.ops_u.tra) ) {
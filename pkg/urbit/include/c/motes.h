@@ -63,6 +63,7 @@
 #   define c3__bcts   c3_s4('b','c','t','s')
 #   define c3__bczp   c3_s4('b','c','z','p')
 #   define c3__bead   c3_s4('b','e','a','d')
+#   define c3__beam   c3_s4('b','e','a','m')
 #   define c3__bean   c3_s4('b','e','a','n')
 #   define c3__bear   c3_s4('b','e','a','r')
 #   define c3__bede   c3_s4('b','e','d','e')
@@ -197,6 +198,7 @@
 #   define c3__chew   c3_s4('c','h','e','w')
 #   define c3__chis   c3_s4('c','h','i','s')
 #   define c3__chob   c3_s4('c','h','o','b')
+#   define c3__chop   c3_s4('c','h','o','p')
 #   define c3__chug   c3_s4('c','h','u','g')
 #   define c3__claf   c3_s4('c','l','a','f')
 #   define c3__clam   c3_s4('c','l','a','m')
@@ -576,6 +578,7 @@
 #   define c3__html   c3_s4('h','t','m','l')
 #   define c3__htmt   c3_s4('h','t','m','t')
 #   define c3__http   c3_s4('h','t','t','p')
+#   define c3__huge   c3_s4('h','u','g','e')
 #   define c3__hume   c3_s4('h','u','m','e')
 #   define c3__hunk   c3_s4('h','u','n','k')
 #   define c3__hxgl   c3_s4('h','x','g','l')
@@ -837,6 +840,7 @@
 #   define c3__ovum   c3_s4('o','v','u','m')
 #   define c3__p      c3_s1('p')
 #   define c3__pack   c3_s4('p','a','c','k')
+#   define c3__page   c3_s4('p','a','g','e')
 #   define c3__pair   c3_s4('p','a','i','r')
 #   define c3__palm   c3_s4('p','a','l','m')
 #   define c3__palq   c3_s4('p','a','l','q')
@@ -1212,6 +1216,7 @@
 #   define c3__ubin   c3_s4('u','b','i','n')
 #   define c3__ubit   c3_s4('u','b','i','t')
 #   define c3__ud     c3_s2('u','d')
+#   define c3__uffd   c3_s4('u','f','f','d')
 #   define c3__ulib   c3_s4('u','l','i','b')
 #   define c3__un     c3_s2('u','n')
 #   define c3__uniq   c3_s4('u','n','i','q')
@@ -1247,6 +1252,7 @@
 #   define c3__vorp   c3_s4('v','o','r','p')
 #   define c3__wack   c3_s4('w','a','c','k')
 #   define c3__wail   c3_s4('w','a','i','l')
+#   define c3__wait   c3_s4('w','a','i','t')
 #   define c3__wake   c3_s4('w','a','k','e')
 #   define c3__walk   c3_s4('w','a','l','k')
 #   define c3__wamp   c3_s4('w','a','m','p')
@@ -42,6 +42,14 @@
     */
 #     define u3a_fbox_no   27
 
+    /* u3a_slab_no: number of small-atom slabs, by box size past the minimum.
+    */
+#     define u3a_slab_no   3
+
+    /* u3a_slab_max: maximum number of boxes cached in any one slab.
+    */
+#     define u3a_slab_max  (1 << 16)
+
 
   /**  Structures.
   **/
@@ -117,7 +125,13 @@
         u3p(c3_w) rut_p;                      //  bottom of durable region
         u3p(c3_w) ear_p;                      //  original cap if kid is live
 
-        c3_w fut_w[32];                       //  futureproof buffer
+        struct {                              //  small-box slabs
+          u3p(u3a_fbox) fre_p[u3a_slab_no];   //  small atoms, by size
+          c3_w len_w[u3a_slab_no];            //  boxes in each slab
+          c3_w cel_w;                         //  boxes in cell allocator
+        } sab;                                //
+
+        c3_w fut_w[25];                       //  futureproof buffer
 
         struct {                              //  escape buffer
           union {
@@ -169,7 +183,7 @@
     /* u3a_flag: flags for how.fag_w.  All arena related.
     */
       enum u3a_flag {
-        u3a_flag_sand  = 0x1,                 //  bump allocation (XX not impl)
+        u3a_flag_sand  = 0x1,                 //  bump allocation, no refcounts
       };
 
     /* u3a_pile: stack control, abstracted over road direction.
@@ -335,8 +349,12 @@
                          ?  u3a_north_is_senior(r, som) \
                          :  u3a_south_is_senior(r, som) )
 
+      //  nothing is uniquely referenced on a sand road (see u3a_flag_sand)
+      //
 #     define  u3a_is_mutable(r, som) \
                 ( _(u3a_is_atom(som)) \
+                  ? c3n \
+                  : ((r)->how.fag_w & u3a_flag_sand) \
                   ? c3n \
                   : _(u3a_is_senior(r, som)) \
                   ? c3n \
@@ -552,6 +570,11 @@
           c3_w
           u3a_mark_road(FILE* fil_u);
 
+        /* u3a_reflux(): return cached small boxes to the free lists.
+        */
+          c3_w
+          u3a_reflux(void);
+
         /* u3a_reclaim(): clear ad-hoc persistent caches to reclaim memory.
         */
           void
@@ -582,6 +605,11 @@
           u3_noun
           u3a_rewritten_noun(u3_noun som);
 
+        /* u3a_rewritten_mptr(): rewrite a u3a_malloc-allocated pointer.
+        */
+          u3_post
+          u3a_rewritten_mptr(u3_post som_p);
+
         /* u3a_count_noun(): count size of noun.
         */
           c3_w
@@ -14,18 +14,37 @@
     */
       typedef struct _u3e_control {
         c3_w     ver_y;                     //  version number
+        c3_w     pag_y;                     //  page size, log2 words
         c3_w     nor_w;                     //  new page count north
         c3_w     sou_w;                     //  new page count south
         c3_w     pgs_w;                     //  number of changed pages
         u3e_line mem_u[0];                  //  per page
       } u3e_control;
 
+    /* u3e_control_v1: control file, version 1 (always 16KB pages).
+    */
+      typedef struct _u3e_control_v1 {
+        c3_w     ver_y;                     //  version number
+        c3_w     nor_w;                     //  new page count north
+        c3_w     sou_w;                     //  new page count south
+        c3_w     pgs_w;                     //  number of changed pages
+        u3e_line mem_u[0];                  //  per page
+      } u3e_control_v1;
+
+    /* u3e_meta: snapshot image metadata, meta file.
+    */
+      typedef struct _u3e_meta {
+        c3_w     ver_y;                     //  version number
+        c3_w     pag_y;                     //  page size, log2 words
+      } u3e_meta;
+
     /* u3_cs_patch: memory change, top level.
     */
       typedef struct _u3_cs_patch {
         c3_i         ctl_i;
         c3_i         mem_i;
         u3e_control* con_u;
+        c3_w*        buf_w;                 //  captured pages, or 0
       } u3_ce_patch;
 
     /* u3e_image: memory segment, open file.
@@ -42,6 +61,7 @@
         c3_c*     dir_c;                     //  path to
         c3_w      dit_w[u3a_pages >> 5];     //  touched since last save
         c3_w      pag_w;                     //  number of pages (<= u3a_pages)
+        c3_y      pag_y;                     //  page size, log2 words
         u3e_image nor_u;                     //  north segment
         u3e_image sou_u;                     //  south segment
       } u3e_pool;
@@ -56,7 +76,9 @@
 
   /** Constants.
   **/
-#     define u3e_version 1
+#     define u3e_version       2
+#     define u3e_meta_version  1
+#     define u3e_page_max      (u3a_page + 7)   //  2MB
 
   /** Functions.
   **/
@@ -65,11 +87,26 @@
       c3_i
       u3e_fault(void* adr_v, c3_i ser_i);
 
-    /* u3e_save():
+    /* u3e_save(): save current changes, synchronously.
     */
       void
       u3e_save(void);
 
+    /* u3e_save_async(): capture current changes, saving in the background.
+    */
+      void
+      u3e_save_async(void);
+
+    /* u3e_wait(): wait for any background save to complete.
+    */
+      void
+      u3e_wait(void);
+
+    /* u3e_fork(): fork(2) a process with a private, copy-on-write loom.
+    */
+      c3_i
+      u3e_fork(void);
+
     /* u3e_live(): start the persistence system.  Return c3y if no image.
     */
       c3_o
@@ -57,6 +57,41 @@
           u3h_slot sot_w[0];  // filled slots
         } u3h_buck;
 
+    /**  Flat layout, for hot internal tables.
+    ***
+    ***  A flat table is an open-addressed array of lines, each one
+    ***  cache line wide, holding eight entries and their key mugs.
+    ***  A lookup hashes to a line, rejects mismatches by inline mug
+    ***  without touching the keys, and probes onward only if that
+    ***  line has no free entries.  The whole table doubles as needed.
+    ***
+    ***  Flat tables are created with u3h_new_flat(), identified by
+    ***  u3h_flat_bit in [max_w], and otherwise use the same u3h_*
+    ***  functions (and clock policy) as the HAMT.
+    **/
+#     define  u3h_flat_bit   0x80000000   //  in [max_w], flat layout
+#     define  u3h_flat_dead  0xffffffff   //  in [mug_w], deleted entry
+#     define  u3h_line_len   8            //  entries per line
+
+      /* u3h_line: flat table line.
+      */
+        typedef struct {
+          c3_w     mug_w[u3h_line_len];   // key mugs (0 if empty)
+          u3h_slot sot_w[u3h_line_len];   // entries
+        } u3h_line;
+
+      /* u3h_flat: flat table root, prefix-compatible with u3h_root.
+      */
+        typedef struct {
+          c3_w     max_w;     // u3h_flat_bit | max entries (0 for no trimming)
+          c3_w     use_w;     // number of entries
+          c3_w     del_w;     // number of deleted entries
+          c3_w     bit_w;     // log2 of number of lines
+          c3_w     arm_w;     // clock arm (entry index)
+          c3_w     off_w;     // line alignment offset into [lin_p]
+          u3_post  lin_p;     // lines allocation
+        } u3h_flat;
+
     /**  HAMT macros.
     ***
     ***  Coordinate with u3_noun definition!
@@ -97,6 +132,12 @@
         u3p(u3h_root)
         u3h_new(void);
 
+      /* u3h_new_flat(): create hashtable with flat layout, bounded
+      **                 by [max_w] entries (0 for unbounded).
+      */
+        u3p(u3h_root)
+        u3h_new_flat(c3_w max_w);
+
       /* u3h_put(): insert in hashtable.
       **
       ** `key` is RETAINED; `val` is transferred.
@@ -104,6 +145,17 @@
         void
         u3h_put(u3p(u3h_root) har_p, u3_noun key, u3_noun val);
 
+      /* u3h_put_with(): insert in hashtable, trimming with [fun_f].
+      **
+      ** `key` is RETAINED; `val` is transferred.
+      ** see u3h_trim_with() for [fun_f].
+      */
+        void
+        u3h_put_with(u3p(u3h_root) har_p,
+                     u3_noun       key,
+                     u3_noun       val,
+                     c3_o        (*fun_f)(u3_noun));
+
       /* u3h_uni(): unify hashtables, copying [rah_p] into [har_p]
       */
         void
@@ -128,6 +180,15 @@
         void
         u3h_trim_to(u3p(u3h_root) har_p, c3_w n_w);
 
+      /* u3h_trim_with(): trim to n key-value pairs, sparing cold entries
+      **                  for which [fun_f] produces yes.
+      **
+      ** [fun_f] is given each cold key-value cell the clock arm passes.
+      ** it must eventually produce no, or trimming will not terminate.
+      */
+        void
+        u3h_trim_with(u3p(u3h_root) har_p, c3_w n_w, c3_o (*fun_f)(u3_noun));
+
       /* u3h_free(): free hashtable.
       */
         void
@@ -54,6 +54,17 @@
           u3_atom
           u3i_slab_moot(u3i_slab* sab_u);
 
+        /* u3i_slab_mpn(): configure slab for [len_mp] GMP limbs, uninitialized,
+        **                 producing a limb buffer for mpn_*() output.
+        */
+          mp_limb_t*
+          u3i_slab_mpn(u3i_slab* sab_u, mp_size_t len_mp);
+
+        /* u3i_slab_mpn_mint(): produce atom from limb-slab, trimming.
+        */
+          u3_atom
+          u3i_slab_mpn_mint(u3i_slab* sab_u, mp_limb_t* buf_mp);
+
         /* u3i_slab_mint_bytes(): produce atom from byte-slab, trimming.
         ** XX assumes little-endian, implement swap to support big-endian
         */
@@ -78,6 +78,7 @@
         c3_l          len_l;            //  dynamic array length
         c3_l          all_l;            //  allocated length
         u3j_core*     ray_u;            //  dynamic array by axis
+        c3_w          gen_w;            //  cold state generation
       } u3j_dash;
 
     /* u3j_fist: a single step in a fine check.
@@ -103,9 +104,38 @@
         u3p(u3j_fink) fin_p;          //  fine check
       } u3j_rite;
 
-    /* u3j_site: site of a kick (nock 9), used to cache call target.
+    /* u3j_pice: polymorphic inline cache entry, a displaced site target.
     */
       struct _u3n_prog;
+      typedef struct {
+        u3p(struct _u3n_prog) pog_p;  //  program for formula
+        u3_weak       bat;            //  battery (for verification)
+        u3_noun       loc;            //  location
+        c3_o          jet_o;          //  have jet driver?
+        c3_o          fon_o;          //  entry owns fink?
+        u3_noun       lab;            //  label (for tracing)
+        u3j_core*     cop_u;          //  jet core
+        u3j_harm*     ham_u;          //  jet arm
+        u3p(u3j_fink) fin_p;          //  fine check
+      } u3j_pice;
+
+    /* u3j_pics: polymorphic inline cache, for sites that see many cores.
+    */
+#     define u3j_pics_len 4
+      typedef struct {
+        c3_w          len_w;          //  entries in use
+        c3_w          rov_w;          //  next entry to replace
+        u3j_pice      ent_u[u3j_pics_len];
+      } u3j_pics;
+
+    /* u3j_site: site of a kick (nock 9), used to cache call target.
+    **
+    **   The located target is kept inline; targets displaced by a
+    **   different core are kept in [pic_p]. A battery with no cold
+    **   state is remembered in [gen_w], skipping the search for it.
+    **   NB: [gen_w] and [pic_p] occupy what was padding in version 1
+    **   images, see u3j_site_ream().
+    */
       typedef struct {
         u3p(struct _u3n_prog) pog_p;  //  program for formula
         u3_noun       axe;            //  axis
@@ -115,9 +145,11 @@
         c3_o          jet_o;          //  have jet driver?
         c3_o          fon_o;          //  site owns fink?
         u3_weak       lab;            //  label (for tracing)
+        c3_w          gen_w;          //  [bat] unregistered as of, or 0
         u3j_core*     cop_u;          //  jet core
         u3j_harm*     ham_u;          //  jet arm
         u3p(u3j_fink) fin_p;          //  fine check
+        u3p(u3j_pics) pic_p;          //  displaced targets, or 0
       } u3j_site;
 
   /** Globals.
@@ -236,6 +268,11 @@
         void
         u3j_site_merge(u3j_site* dst_u, u3j_site* src_u);
 
+      /* u3j_site_lend(): prepare a site copied from a senior program.
+      */
+        void
+        u3j_site_lend(u3j_site* sit_u);
+
       /* u3j_site_ream(): refresh u3j_site after restoring from checkpoint
       */
         void
@@ -281,6 +318,16 @@
         c3_w
         u3j_site_mark(u3j_site* sit_u);
 
+      /* u3j_rite_rewrite(): rewrite u3j_rite for compaction.
+      */
+        void
+        u3j_rite_rewrite(u3j_rite* rit_u);
+
+      /* u3j_site_rewrite(): rewrite u3j_site for compaction.
+      */
+        void
+        u3j_site_rewrite(u3j_site* sit_u);
+
       /* u3j_mark(): mark jet state for gc.
       */
         c3_w
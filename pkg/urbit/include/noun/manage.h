@@ -76,6 +76,12 @@
         u3_noun
         u3m_soft(c3_w mil_w, u3_funk fun_f, u3_noun arg);
 
+      /* u3m_soft_sand(): u3m_soft() on a sand road, for bounded,
+      **                  read-only computations.  See u3a_flag_sand.
+      */
+        u3_noun
+        u3m_soft_sand(c3_w mil_w, u3_funk fun_f, u3_noun arg);
+
       /* u3m_soft_slam: top-level call.
       */
         u3_noun
@@ -13,7 +13,10 @@
   } u3n_memo;
 
   /* u3n_prog: program compiled from nock
-   */
+  **
+  **   NB: [lit_u.mug_w] occupies what was padding in version 2 images,
+  **   and is recomputed by u3n_ream().
+  */
   typedef struct _u3n_prog {
     struct {
       c3_o      own_o;                // program owns ops_y?
@@ -22,6 +25,7 @@
     } byc_u;                          // bytecode
     struct {
       c3_w      len_w;                // number of literals
+      c3_w      mug_w;                // mug of bytecode and literals
       u3_noun*  non;                  // array of literals
     } lit_u;                          // literals
     struct {
@@ -131,9 +135,19 @@
       void
       u3n_free(void);
 
+    /* u3n_bare(): forget unregistered batteries at call sites in [har_p].
+    */
+      void
+      u3n_bare(u3p(u3h_root) har_p);
+
     /* u3n_ream(): refresh after restoring from checkpoint.
     */
       void
       u3n_ream(void);
 
+    /* u3n_damp(): print and clear bytecode profile (-P, U3_CPU_DEBUG).
+    */
+      void
+      u3n_damp(FILE* fil_u);
+
 #endif /* ifndef U3_NOCK_H */
@@ -1,6 +1,17 @@
 #ifndef U3_RETRIEVE_H
 #define U3_RETRIEVE_H
 
+  /**  Structures.
+  **/
+    /* u3r_mpn: read-only GMP limb view of an atom, for mpn_*().
+    */
+      typedef struct _u3r_mpn {
+        const mp_limb_t* buf_mp;              //  limbs, LSL first
+        mp_size_t        len_mp;              //  significant limbs
+        mp_limb_t        sat_mp;              //  direct atom storage
+        mp_limb_t*       cop_mp;              //  copied limbs (nullable)
+      } u3r_mpn;
+
     /** u3r_*: read without ever crashing.
     **/
 #if 1
@@ -417,6 +428,22 @@
         u3r_mp(mpz_t   a_mp,
                u3_atom b);
 
+      /* u3r_mpn_view():
+      **
+      **   View (b) as GMP limbs in (a_u), without copying if possible.
+      **   (a_u) must not move, and (b) must outlive it.
+      */
+        void
+        u3r_mpn_view(u3r_mpn* a_u,
+                     u3_atom  b);
+
+      /* u3r_mpn_free():
+      **
+      **   Release (a_u).
+      */
+        void
+        u3r_mpn_free(u3r_mpn* a_u);
+
       /* u3r_short():
       **
       **   Return short (a_w) of (b).
@@ -45,6 +45,17 @@
                           c3_d         len_d,
                           const c3_y*  byt_y);
 
+      /* u3s_cue_xeno_fd(): cue on-loom from a file, reading it in chunks.
+      */
+        u3_weak
+        u3s_cue_xeno_fd(u3_cue_xeno* sil_u, c3_i fid_i);
+
+      /* u3s_cue_xeno_mmap(): cue on-loom from a read-only file mapping,
+      **                      releasing its pages as they're consumed.
+      */
+        u3_weak
+        u3s_cue_xeno_mmap(u3_cue_xeno* sil_u, c3_d len_d, c3_y* byt_y);
+
       /* u3s_cue_xeno_init(): dispose cue_xeno handle.
       */
         void
@@ -33,7 +33,7 @@
 
   /** Constants.
   **/
-#     define u3v_version 1
+#     define u3v_version 3
 
   /**  Functions.
   **/
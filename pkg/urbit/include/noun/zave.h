@@ -10,6 +10,9 @@
   ***  The memo cache is within its road and dies when it falls.
   ***
   ***  Memo functions RETAIN keys and transfer values.
+  ***
+  ***  Eviction is by clock, weighted by the cost of computing each
+  ***  entry relative to its size (see zave.c).
   **/
     /* u3z_key*(): construct a memo cache-key.  Arguments retained.
     */
@@ -37,4 +40,9 @@
       u3_noun
       u3z_uniq(u3_noun som);
 
+    /* u3z_mark(): mark memo cache for gc, printing statistics.
+    */
+      c3_w
+      u3z_mark(FILE* fil_u);
+
 #endif /* ifndef U3_ZAVE_H */
@@ -17,6 +17,17 @@
       u3_lmdb_exit(MDB_env* env_u);
 
 
+    /* u3_lmdb_pack(): enable/disable sealing events into segments on save.
+    */
+      void
+      u3_lmdb_pack(MDB_env* env_u, c3_o pac_o);
+
+    /* u3_lmdb_pack_info(): read segment compression stats; [zip_d] counts
+    **                      both segments and their dictionaries.
+    */
+      c3_o
+      u3_lmdb_pack_info(MDB_env* env_u, c3_d* seg_d, c3_d* raw_d, c3_d* zip_d);
+
     /* u3_lmdb_stat(): print env stats.
     */
       void
@@ -27,6 +38,21 @@
       c3_o
       u3_lmdb_gulf(MDB_env* env_u, c3_d* low_d, c3_d* hig_d);
 
+    /* u3_lmdb_epoch(): read the snapshot the log was last chopped behind.
+    */
+      c3_o
+      u3_lmdb_epoch(MDB_env* env_u, c3_d* epo_d);
+
+    /* u3_lmdb_cut(): find the first event that must be kept to read [eve_d].
+    */
+      c3_o
+      u3_lmdb_cut(MDB_env* env_u, c3_d eve_d, c3_d* cut_d);
+
+    /* u3_lmdb_chop(): delete events before [cut_d], starting an epoch at [epo_d].
+    */
+      c3_o
+      u3_lmdb_chop(MDB_env* env_u, c3_d cut_d, c3_d epo_d);
+
     /* u3_lmdb_read(): read [len_d] events starting at [eve_d].
     */
       c3_o
@@ -61,4 +87,9 @@
                         size_t      val_i,
                         void*       val_p);
 
+    /* u3_lmdb_copy(): write a compacted copy of the env into directory [pax_c].
+    */
+      c3_o
+      u3_lmdb_copy(MDB_env* env_u, const c3_c* pax_c);
+
 #endif /* ifndef U3_VERE_DB_LMDB_H */
@@ -16,6 +16,7 @@
         c3_o    mut_o;             //  mutated kerne
         u3_noun sac;               //  space measurementl
         void  (*xit_f)(void);      //  exit callback
+        void  (*fok_f)(c3_w);      //  fork scry reader
       } u3_serf;
 
   /** Functions.
@@ -77,6 +77,29 @@
         };
       } u3_mess;
 
+    /* u3_rung: one direction of a u3_ring, in shared memory.
+    */
+      typedef struct _u3_rung u3_rung;
+
+    /* u3_ring: shared-memory message transport (see vere/newt.c).
+    */
+      typedef struct _u3_ring {
+        c3_i             mem_i;             //  shared memory (memfd)
+        c3_i             wak_i;             //  our wakeups (eventfd)
+        c3_i             pir_i;             //  peer wakeups (eventfd)
+        c3_y*            map_y;             //  mapping
+        size_t           map_i;             //  mapping length
+        u3_rung*         inn_u;             //  inbound ring
+        u3_rung*         out_u;             //  outbound ring
+        uv_poll_t        pol_u;             //  wakeup watcher
+        struct _u3_moat* mot_u;             //  delivering to, if reading
+        c3_o             liv_o;             //  not yet stopped
+        struct _u3_pend* ent_u;             //  entry of blocked writes
+        struct _u3_pend* ext_u;             //  exit of blocked writes
+        c3_y*            fag_y;             //  inbound fragments
+        c3_d             fag_d;             //  inbound fragments length
+      } u3_ring;
+
     /* u3_moat: inbound message stream.
     */
       typedef struct _u3_moat {
@@ -292,6 +315,7 @@
         c3_o    net;                        //  -L, local-only networking
         c3_o    lit;                        //  -l, lite mode
         c3_y    lom_y;                      //      loom bex
+        c3_y    pag_y;                      //      loom page bex
         c3_y    lut_y;                      //      urth-loom bex
         c3_c*   til_c;                      //  -n, play till eve_d
         c3_o    pro;                        //  -P, profile
@@ -313,6 +337,12 @@
         c3_c*   puf_c;                      //  -Z, scry result format
         c3_o    con;                        //      run conn
         c3_o    doc;                        //      dock binary in pier
+        c3_o    uff;                        //      userfaultfd loom paging
+        c3_o    hug;                        //      huge page loom backing
+        c3_w    wai_w;                      //      group commit max ms
+        c3_w    bat_w;                      //      group commit max events
+        c3_o    rin;                        //      shared-memory serf ipc
+        c3_w    sry_w;                      //      scry reader forks
       } u3_opts;
 
     /* u3_host: entire host.
@@ -385,7 +415,9 @@
         typedef struct _u3_fact {
           c3_d             eve_d;               //  event number
           c3_l             mug_l;               //  kernel mug after
-          u3_noun            job;               //  (pair date ovum)
+          u3_noun            job;               //  (pair date ovum), or u3_none
+          c3_y*            hun_y;               //  log entry (mug, jam), or 0
+          size_t           len_i;               //  log entry length
           struct _u3_fact* nex_u;               //  next in queue
         } u3_fact;
 
@@ -433,6 +465,15 @@
           };
         } u3_pico;
 
+      /* u3_scry: cached namespace read, pending delivery
+      */
+        typedef struct _u3_scry {
+          struct _u3_scry* nex_u;               //  next in queue
+          void*            ptr_v;               //  context
+          u3_peek_cb       fun_f;               //  callback
+          u3_noun            res;               //  result
+        } u3_scry;
+
       /* u3_peek: namespace read request
       */
         typedef struct _u3_peek {
@@ -452,7 +493,8 @@
           u3_writ_cram = 4,
           u3_writ_meld = 5,
           u3_writ_pack = 6,
-          u3_writ_exit = 7
+          u3_writ_exit = 7,
+          u3_writ_fork = 8
         } u3_writ_type;
 
       /* u3_writ: ipc message from king to serf
@@ -468,6 +510,7 @@
             u3_peek*       pek_u;               //  peek
             u3_info        fon_u;               //  recompute
             c3_d           eve_d;               //  save/pack at
+            c3_w           red_w;               //  fork reader
           };
         } u3_writ;
 
@@ -489,16 +532,36 @@
           void (*exit_f)(void*);
         } u3_lord_cb;
 
+      /* u3_seer_max: most scry readers.
+      */
+#       define u3_seer_max  8
+
+      /* u3_seer: read-only fork of the serf, answering %peek.
+      */
+        typedef struct _u3_seer {
+          struct _u3_lord*     god_u;           //  serf controller
+          c3_w                 red_w;           //  reader index
+          c3_o                 liv_o;           //  forked and ready
+          c3_o                 fok_o;           //  fork requested
+          c3_d                 eve_d;           //  frozen at event
+          c3_w                 dep_w;           //  queue depth
+          struct _u3_writ*     ent_u;           //  queue entry
+          struct _u3_writ*     ext_u;           //  queue exit
+          u3_mojo              inn_u;           //  reader's input
+          u3_moat              out_u;           //  reader's output
+        } u3_seer;
+
       /* u3_lord: serf controller.
       */
         typedef struct _u3_lord {
           uv_process_t         cub_u;           //  process handle
           uv_process_options_t ops_u;           //  process configuration
-          uv_stdio_container_t cod_u[3];        //  process options
+          uv_stdio_container_t cod_u[6 + 2 * u3_seer_max];  //  process options
           u3_cue_xeno*         sil_u;           //  cue handle
           time_t               wen_t;           //  process creation time
           u3_mojo              inn_u;           //  client's stdin
           u3_moat              out_u;           //  client's stdout
+          u3_ring*             rin_u;           //  client's shared memory
           uv_pipe_t            err_u;           //  client's stderr
           c3_w                 wag_w;           //  config flags
           c3_c*                bin_c;           //  binary path
@@ -514,6 +577,8 @@
           c3_w                 dep_w;           //  queue depth
           struct _u3_writ*     ent_u;           //  queue entry
           struct _u3_writ*     ext_u;           //  queue exit
+          c3_w                 see_w;           //  scry readers
+          u3_seer*             see_u[u3_seer_max];  //  scry readers
         } u3_lord;
 
       /* u3_read: event log read request
@@ -549,9 +614,12 @@
           u3_dire*         urb_u;               //  urbit system data
           u3_dire*         com_u;               //  log directory
           c3_o             liv_o;               //  live
+          c3_w             ver_w;               //  log format version
           void*            mdb_u;               //  lmdb environment.
           c3_d             sen_d;               //  commit requested
           c3_d             dun_d;               //  committed
+          c3_d             fir_d;               //  first event in log
+          c3_d             epo_d;               //  epoch snapshot, if chopped
           u3_disk_cb        cb_u;               //  callbacks
           u3_read*         red_u;               //  read requests
           union {                               //  write thread/request
@@ -560,6 +628,10 @@
           };                                    //
           c3_o             ted_o;               //  c3y == active
           u3_info          put_u;               //  write queue
+          struct _cd_save* nex_u;               //  next write batch
+          uv_timer_t*      tim_u;               //  group commit timer
+          c3_w             wai_w;               //  group commit max ms
+          c3_w             bat_w;               //  group commit max events
         } u3_disk;
 
       /* u3_psat: pier state.
@@ -660,6 +732,15 @@
             u3_pico*       ent_u;
             u3_pico*       ext_u;
           } pec_u;
+          struct {                              //  scry cache:
+            c3_d           eve_d;               //    generation
+            u3p(u3h_root)  nex_p;               //    results at generation
+            u3p(u3h_root)  fix_p;               //    immutable results
+            c3_d           hit_d;               //    hits
+            c3_d           mis_d;               //    misses
+            u3_scry*       ent_u;               //    hits, queue entry
+            u3_scry*       ext_u;               //    hits, queue exit
+          } sky_u;
           void*            sop_p;               //  slog stream data
           void           (*sog_f)               //  slog stream callback
                          (void*, c3_w, u3_noun);//
@@ -794,6 +875,16 @@
         u3_fact*
         u3_fact_init(c3_d eve_d, c3_l mug_l, u3_noun job);
 
+      /* u3_fact_load(): initialize event from raw log entry, uncued.
+      */
+        u3_fact*
+        u3_fact_load(c3_d eve_d, c3_l mug_l, size_t len_i, const c3_y* byt_y);
+
+      /* u3_fact_job(): produce event (pair date ovum), cueing if needed.
+      */
+        u3_noun
+        u3_fact_job(u3_fact* tac_u);
+
       /* u3_fact_free(): dispose completed event.
       */
         void
@@ -973,6 +1064,11 @@
                           c3_o     fak_o,
                           c3_w     lif_w);
 
+      /* u3_disk_chop(): start a new epoch after the snapshot at [eve_d].
+      */
+        c3_o
+        u3_disk_chop(u3_disk* log_u, c3_d eve_d, c3_l mug_l, c3_o arc_o);
+
       /* u3_disk_read(): read [len_d] events starting at [eve_d].
       */
         void
@@ -1056,11 +1152,29 @@
         void
         u3_lord_play(u3_lord* god_u, u3_info fon_u);
 
+      /* u3_lord_play_frame(): frame %play batch from raw log entries,
+      **                       jamming any events not read from the log.
+      */
+        void
+        u3_lord_play_frame(u3_info fon_u, c3_d* out_d, c3_y** out_y);
+
+      /* u3_lord_play_cue(): parse %play frame (in the serf), cueing
+      **                     each event once; u3_none if malformed.
+      */
+        u3_weak
+        u3_lord_play_cue(u3_cue_xeno* sil_u, c3_d len_d, c3_y* byt_y);
+
       /* u3_lord_peek(): read namespace, injecting what's missing.
       */
         void
         u3_lord_peek(u3_lord* god_u, u3_pico* pic_u);
 
+      /* u3_lord_gaze(): read namespace on a scry reader, if one is
+      **                 frozen at or after [eve_d]; c3n if none.
+      */
+        c3_o
+        u3_lord_gaze(u3_lord* god_u, c3_d eve_d, u3_pico* pic_u);
+
     /**  Filesystem (async).
     **/
       /* u3_foil_folder(): load directory, blockingly.  create if nonexistent.
@@ -1242,6 +1356,36 @@
         void
         u3_newt_send(u3_mojo* moj_u, c3_d len_d, c3_y* byt_y);
 
+      /* u3_newt_ring_make(): create shared-memory transport, or 0.
+      */
+        u3_ring*
+        u3_newt_ring_make(void);
+
+      /* u3_newt_ring_join(): map a peer's shared-memory transport, or 0.
+      */
+        u3_ring*
+        u3_newt_ring_join(c3_i mem_i, c3_i wak_i, c3_i pir_i);
+
+      /* u3_newt_ring_read(): start delivering inbound msgs to [mot_u].
+      */
+        void
+        u3_newt_ring_read(u3_ring* rin_u, u3_moat* mot_u);
+
+      /* u3_newt_ring_send(): write buffer to ring.
+      */
+        void
+        u3_newt_ring_send(u3_ring* rin_u, c3_d len_d, c3_y* byt_y);
+
+      /* u3_newt_ring_stop(): stop and dispose, asynchronously.
+      */
+        void
+        u3_newt_ring_stop(u3_ring* rin_u);
+
+      /* u3_newt_ring_info(): status info as $mass.
+      */
+        u3_noun
+        u3_newt_ring_info(u3_ring* rin_u);
+
       /* u3_newt_read_sync(): start reading; multiple msgs synchronous.
       */
         void
@@ -1274,6 +1418,12 @@
 
     /** Pier scries.
     **/
+      /* u3_pier_sky_look(): check scry cache, queueing a hit for delivery,
+      **                    or wrapping [pic_u]'s callback to cache its response.
+      */
+        c3_o
+        u3_pier_sky_look(u3_pier* pir_u, u3_pico* pic_u);
+
       /* u3_pier_peek(): read namespace.
       */
         void
@@ -18,16 +18,35 @@
     else if ( 0 == a ) {
       return u3k(b);
     }
+    else if ( 0 == b ) {
+      return u3k(a);
+    }
     else {
-      mpz_t a_mp, b_mp;
+      u3r_mpn  a_u, b_u;
+      u3r_mpn  *l_u, *s_u;
+      u3i_slab sab_u;
+      mp_limb_t* c_mp;
+
+      u3r_mpn_view(&a_u, a);
+      u3r_mpn_view(&b_u, b);
+
+      //  mpn_add() wants the longer operand first
+      //
+      if ( a_u.len_mp >= b_u.len_mp ) {
+        l_u = &a_u; s_u = &b_u;
+      }
+      else {
+        l_u = &b_u; s_u = &a_u;
+      }
 
-      u3r_mp(a_mp, a);
-      u3r_mp(b_mp, b);
+      c_mp = u3i_slab_mpn(&sab_u, l_u->len_mp + 1);
+      c_mp[l_u->len_mp] = mpn_add(c_mp, l_u->buf_mp, l_u->len_mp,
+                                        s_u->buf_mp, s_u->len_mp);
 
-      mpz_add(a_mp, a_mp, b_mp);
-      mpz_clear(b_mp);
+      u3r_mpn_free(&a_u);
+      u3r_mpn_free(&b_u);
 
-      return u3i_mp(a_mp);
+      return u3i_slab_mpn_mint(&sab_u, c_mp);
     }
   }
   u3_noun
@@ -18,15 +18,39 @@
         return a / b;
       }
       else {
-        mpz_t a_mp, b_mp;
+        u3r_mpn    a_u, b_u;
+        u3i_slab   sab_u;
+        mp_limb_t  *c_mp, *d_mp;
+        mp_size_t  len_mp;
 
-        u3r_mp(a_mp, a);
-        u3r_mp(b_mp, b);
+        u3r_mpn_view(&a_u, a);
+        u3r_mpn_view(&b_u, b);
 
-        mpz_tdiv_q(a_mp, a_mp, b_mp);
-        mpz_clear(b_mp);
+        if ( a_u.len_mp < b_u.len_mp ) {
+          u3r_mpn_free(&a_u);
+          u3r_mpn_free(&b_u);
+          return 0;
+        }
 
-        return u3i_mp(a_mp);
+        len_mp = a_u.len_mp - b_u.len_mp + 1;
+        c_mp   = u3i_slab_mpn(&sab_u, len_mp);
+
+        //  the remainder is discarded
+        //
+        if ( 1 == b_u.len_mp ) {
+          mpn_divrem_1(c_mp, 0, a_u.buf_mp, a_u.len_mp, b_u.buf_mp[0]);
+        }
+        else {
+          d_mp = u3a_malloc(b_u.len_mp * sizeof(mp_limb_t));
+          mpn_tdiv_qr(c_mp, d_mp, 0, a_u.buf_mp, a_u.len_mp,
+                                     b_u.buf_mp, b_u.len_mp);
+          u3a_free(d_mp);
+        }
+
+        u3r_mpn_free(&a_u);
+        u3r_mpn_free(&b_u);
+
+        return u3i_slab_mpn_mint(&sab_u, c_mp);
       }
     }
   }
@@ -20,21 +20,30 @@
       return u3k(a);
     }
     else {
-      mpz_t a_mp, b_mp;
+      u3r_mpn    a_u, b_u;
+      u3i_slab   sab_u;
+      mp_limb_t* c_mp;
 
-      u3r_mp(a_mp, a);
-      u3r_mp(b_mp, b);
+      u3r_mpn_view(&a_u, a);
+      u3r_mpn_view(&b_u, b);
 
-      if ( mpz_cmp(a_mp, b_mp) < 0 ) {
-        mpz_clear(a_mp);
-        mpz_clear(b_mp);
+      if (  (a_u.len_mp < b_u.len_mp)
+         || (  (a_u.len_mp == b_u.len_mp)
+            && (mpn_cmp(a_u.buf_mp, b_u.buf_mp, a_u.len_mp) < 0) ) )
+      {
+        u3r_mpn_free(&a_u);
+        u3r_mpn_free(&b_u);
 
         return u3m_error("subtract-underflow");
       }
-      mpz_sub(a_mp, a_mp, b_mp);
-      mpz_clear(b_mp);
 
-      return u3i_mp(a_mp);
+      c_mp = u3i_slab_mpn(&sab_u, a_u.len_mp);
+      mpn_sub(c_mp, a_u.buf_mp, a_u.len_mp, b_u.buf_mp, b_u.len_mp);
+
+      u3r_mpn_free(&a_u);
+      u3r_mpn_free(&b_u);
+
+      return u3i_slab_mpn_mint(&sab_u, c_mp);
     }
   }
 
@@ -6,60 +6,155 @@
 
 /* functions
 */
-  // like skid, except its callback is $-([* *] ?) and it takes the second
-  // argument so that it calls its callback with [i.list, second]
+  /* _sort_ord: native comparator, as the jetted gate would compute.
+  */
+  typedef u3_noun (*_sort_ord)(u3_noun, u3_noun);
+
+  //  recognize a jetted comparator by its driver, producing a native
+  //  equivalent, or 0.
+  //
+  //  all of these are total orders (lth/gth only over atoms), under
+  //  which the +sort quicksort is stable, so any stable sort agrees
+  //  with it exactly.
   //
-  // all args are RETAINED
-  static u3_noun
-  _split_in(u3j_site* sit_u,
-            u3_noun a,
-            u3_noun second)
+  static _sort_ord
+  _sort_spot(u3j_site* sit_u, c3_w len_w, const u3_noun* lis)
   {
-    if ( 0 == a ) {
-      return u3nc(u3_nul, u3_nul);
+    u3_noun (*fun_f)(u3_noun);
+    c3_w      i_w;
+
+    if (  (u3_none == sit_u->loc)
+       || (c3y != sit_u->jet_o)
+       || (c3y != sit_u->ham_u->liv)
+       || (c3y != sit_u->ham_u->ice) )
+    {
+      return 0;
     }
-    else if ( c3n == u3du(a) ) {
-      return u3m_bail(c3__exit);
-    } else {
-      u3_noun acc = _split_in(sit_u, u3t(a), second);
-      u3_noun hoz = u3j_gate_slam(sit_u, u3nc(u3k(u3h(a)), u3k(second)));
-      u3_noun nex;
 
-      if ( c3y == hoz ) {
-        nex = u3nc(u3nc(u3k(u3h(a)), u3k(u3h(acc))), u3k(u3t(acc)));
-      }
-      else {
-        nex = u3nc(u3k(u3h(acc)), u3nc(u3k(u3h(a)), u3k(u3t(acc))));
+    fun_f = sit_u->ham_u->fun_f;
+
+    if ( u3wc_dor == fun_f ) {
+      return u3qc_dor;
+    }
+    else if ( u3wc_gor == fun_f ) {
+      return u3qc_gor;
+    }
+    else if ( u3wc_mor == fun_f ) {
+      return u3qc_mor;
+    }
+    else if ( (u3wa_lth == fun_f) || (u3wa_gth == fun_f) ) {
+      //  lth/gth punt on cells in odd ways; leave those to the gate
+      //
+      for ( i_w = 0; i_w < len_w; i_w++ ) {
+        if ( c3n == u3ud(lis[i_w]) ) {
+          return 0;
+        }
       }
-      u3z(hoz);
-      u3z(acc);
 
-      return nex;
+      return ( u3wa_lth == fun_f ) ? u3qa_lth : u3qa_gth;
     }
+
+    return 0;
   }
 
-  static u3_noun
-  _sort_in(u3j_site* sit_u, u3_noun list)
+  //  stable bottom-up merge sort of [lis], with scratch [tmp].
+  //
+  static void
+  _sort_merge(_sort_ord ord_f, c3_w len_w, u3_noun* lis, u3_noun* tmp)
   {
-    if ( 0 == list ) {
-      return u3_nul;
+    u3_noun* src = lis;
+    u3_noun* dst = tmp;
+    u3_noun* swp;
+    c3_w     wid_w, lef_w, mid_w, rig_w, i_w, j_w, k_w;
+
+    for ( wid_w = 1; wid_w < len_w; wid_w <<= 1 ) {
+      for ( lef_w = 0; lef_w < len_w; lef_w += (wid_w << 1) ) {
+        mid_w = c3_min(lef_w + wid_w, len_w);
+        rig_w = c3_min(mid_w + wid_w, len_w);
+        i_w   = lef_w;
+        j_w   = mid_w;
+        k_w   = lef_w;
+
+        //  take from the right run only if strictly ordered first
+        //
+        while ( (i_w < mid_w) && (j_w < rig_w) ) {
+          if ( c3y == ord_f(src[j_w], src[i_w]) ) {
+            dst[k_w++] = src[j_w++];
+          }
+          else {
+            dst[k_w++] = src[i_w++];
+          }
+        }
+
+        while ( i_w < mid_w ) {
+          dst[k_w++] = src[i_w++];
+        }
+
+        while ( j_w < rig_w ) {
+          dst[k_w++] = src[j_w++];
+        }
+      }
+
+      swp = src; src = dst; dst = swp;
     }
-    else if ( c3n == u3du(list) ) {
-      return u3m_bail(c3__exit);
-    } else {
-      u3_noun hed, tal;
-      u3x_cell(list, &hed, &tal);
 
-      u3_noun split = _split_in(sit_u, tal, hed);
-      u3_noun lhs = _sort_in(sit_u, u3h(split));
-      u3_noun rhs = u3nc(u3k(hed), _sort_in(sit_u, u3t(split)));
+    if ( src != lis ) {
+      memcpy(lis, src, len_w * sizeof(u3_noun));
+    }
+  }
+
+  //  +sort with an arbitrary gate: the same quicksort as the hoon,
+  //  partitioning stably on the first element, but in place over
+  //  [lis] with scratch [tmp], and an explicit stack [sac_w].
+  //
+  //  the gate is not known to be an order, so this must make exactly
+  //  the same choices as the hoon, not merely produce a sorted list.
+  //
+  static void
+  _sort_quick(u3j_site* sit_u,
+              c3_w      len_w,
+              u3_noun*  lis,
+              u3_noun*  tmp,
+              c3_w*     sac_w)
+  {
+    c3_w top_w = 0;
+
+    sac_w[top_w++] = 0;
+    sac_w[top_w++] = len_w;
 
-      u3_noun ret = u3qb_weld(lhs, rhs);
-      u3z(lhs);
-      u3z(rhs);
-      u3z(split);
+    while ( top_w ) {
+      c3_w    end_w = sac_w[--top_w];
+      c3_w    sat_w = sac_w[--top_w];
+      u3_noun piv   = lis[sat_w];
+      c3_w    lef_w = 0;
+      c3_w    rig_w = 0;
+      c3_w    i_w;
 
-      return ret;
+      for ( i_w = sat_w + 1; i_w < end_w; i_w++ ) {
+        u3_noun hoz = u3j_gate_slam(sit_u, u3nc(u3k(lis[i_w]), u3k(piv)));
+
+        if ( c3y == hoz ) {
+          lis[sat_w + lef_w++] = lis[i_w];
+        }
+        else {
+          tmp[rig_w++] = lis[i_w];
+        }
+
+        u3z(hoz);
+      }
+
+      lis[sat_w + lef_w] = piv;
+      memcpy(lis + sat_w + lef_w + 1, tmp, rig_w * sizeof(u3_noun));
+
+      if ( 1 < lef_w ) {
+        sac_w[top_w++] = sat_w;
+        sac_w[top_w++] = sat_w + lef_w;
+      }
+
+      if ( 1 < rig_w ) {
+        sac_w[top_w++] = sat_w + lef_w + 1;
+        sac_w[top_w++] = end_w;
+      }
     }
   }
 
@@ -67,11 +162,55 @@
   u3qb_sort(u3_noun a,
             u3_noun b)
   {
-    u3_noun  pro;
-    u3j_site sit_u;
+    u3_noun   pro = u3_nul;
+    u3_noun   t   = a;
+    c3_w    len_w = 0;
+    c3_w      i_w;
+    u3_noun  *lis, *tmp;
+    _sort_ord ord_f;
+    u3j_site  sit_u;
+
+    while ( c3y == u3du(t) ) {
+      len_w++;
+      t = u3t(t);
+    }
+
+    if ( 0 != t ) {
+      return u3m_bail(c3__exit);
+    }
+    else if ( 0 == len_w ) {
+      return u3_nul;
+    }
+
+    lis = u3a_malloc(len_w * sizeof(u3_noun));
+    tmp = u3a_malloc(len_w * sizeof(u3_noun));
+
+    for ( t = a, i_w = 0; i_w < len_w; i_w++, t = u3t(t) ) {
+      lis[i_w] = u3h(t);
+    }
+
     u3j_gate_prep(&sit_u, u3k(b));
-    pro = _sort_in(&sit_u, a);
+
+    if ( 0 != (ord_f = _sort_spot(&sit_u, len_w, lis)) ) {
+      _sort_merge(ord_f, len_w, lis, tmp);
+    }
+    else {
+      //  at most one pending range per element
+      //
+      c3_w* sac_w = u3a_malloc(2 * len_w * sizeof(c3_w));
+      _sort_quick(&sit_u, len_w, lis, tmp, sac_w);
+      u3a_free(sac_w);
+    }
+
     u3j_gate_lose(&sit_u);
+
+    for ( i_w = len_w; i_w--; ) {
+      pro = u3nc(u3k(lis[i_w]), pro);
+    }
+
+    u3a_free(lis);
+    u3a_free(tmp);
+
     return pro;
   }
   u3_noun
@@ -85,4 +224,3 @@
       return u3qb_sort(a, b);
     }
   }
-
@@ -13,17 +13,23 @@
     c3_w lna_w = u3r_met(5, a);
     c3_w lnb_w = u3r_met(5, b);
 
-    if ( (lna_w == 0) && (lnb_w == 0) ) {
+    if ( (lna_w == 0) || (lnb_w == 0) ) {
       return 0;
     }
     else {
-      c3_w     len_w = c3_max(lna_w, lnb_w);
+      c3_w     len_w = c3_min(lna_w, lnb_w);
+      c3_w*      b_w = ( _(u3a_is_cat(b)) )
+                       ? &b
+                       : ((u3a_atom*)u3a_to_ptr(b))->buf_w;
       c3_w       i_w;
       u3i_slab sab_u;
       u3i_slab_from(&sab_u, a, 5, len_w);
 
+      //  no bits above the shorter operand survive; read [b] in place,
+      //  so the loop can be vectorized
+      //
       for ( i_w = 0; i_w < len_w; i_w++ ) {
-        sab_u.buf_w[i_w] &= u3r_word(i_w, b);
+        sab_u.buf_w[i_w] &= b_w[i_w];
       }
 
       return u3i_slab_mint(&sab_u);
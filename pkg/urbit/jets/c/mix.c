@@ -18,15 +18,9 @@
     }
     else {
       c3_w     len_w = c3_max(lna_w, lnb_w);
-      c3_w       i_w;
       u3i_slab sab_u;
       u3i_slab_from(&sab_u, a, 5, len_w);
-
-      //  XX use u3r_chop for XOR?
-      //
-      for ( i_w = 0; i_w < lnb_w; i_w++ ) {
-        sab_u.buf_w[i_w] ^= u3r_word(i_w, b);
-      }
+      u3r_chop(5, 0, lnb_w, 0, sab_u.buf_w, b);
 
       return u3i_slab_mint(&sab_u);
     }
@@ -13,13 +13,69 @@
     if ( !_(u3a_is_cat(b)) ) {
       return u3m_bail(c3__fail);
     }
+    else if ( 0 == b ) {
+      return 1;
+    }
+    else if ( (1 == b) || (0 == a) || (1 == a) ) {
+      return u3k(a);
+    }
     else {
-      mpz_t a_mp;
+      c3_d       bit_d = (c3_d)u3r_met(0, a) * b;
+      c3_w       top_w = c3_bits_word(b) - 1;
+      c3_w       ops_w = top_w + __builtin_popcount(b) - 1;
+      u3r_mpn    a_u;
+      u3i_slab   sab_u;
+      mp_limb_t  *c_mp, *d_mp, *r_mp, *s_mp, *t_mp;
+      mp_size_t  len_mp, max_mp;
+
+      if ( bit_d > ((c3_d)u3a_maximum << 5) ) {
+        return u3m_bail(c3__meme);
+      }
+
+      //  every partial power fits in [max_mp] limbs, with room
+      //  for the unnormalized product
+      //
+      max_mp = (bit_d + (GMP_NUMB_BITS - 1)) / GMP_NUMB_BITS + 1;
+
+      u3r_mpn_view(&a_u, a);
+      c_mp = u3i_slab_mpn(&sab_u, max_mp);
+      d_mp = u3a_malloc(max_mp * sizeof(mp_limb_t));
+
+      //  square-and-multiply, ping-ponging between the slab and a
+      //  scratch buffer; start wherever makes the last step land
+      //  in the slab
+      //
+      if ( ops_w & 1 ) {
+        r_mp = d_mp; s_mp = c_mp;
+      }
+      else {
+        r_mp = c_mp; s_mp = d_mp;
+      }
+
+      len_mp = a_u.len_mp;
+      memcpy(r_mp, a_u.buf_mp, len_mp * sizeof(mp_limb_t));
+
+      while ( top_w-- ) {
+        mpn_sqr(s_mp, r_mp, len_mp);
+        len_mp <<= 1;
+        len_mp  -= ( 0 == s_mp[len_mp - 1] );
+        t_mp = r_mp; r_mp = s_mp; s_mp = t_mp;
+
+        if ( (b >> top_w) & 1 ) {
+          mpn_mul(s_mp, r_mp, len_mp, a_u.buf_mp, a_u.len_mp);
+          len_mp += a_u.len_mp;
+          len_mp -= ( 0 == s_mp[len_mp - 1] );
+          t_mp = r_mp; r_mp = s_mp; s_mp = t_mp;
+        }
+      }
+
+      c3_assert( r_mp == c_mp );
+      memset(c_mp + len_mp, 0, (max_mp - len_mp) * sizeof(mp_limb_t));
 
-      u3r_mp(a_mp, a);
-      mpz_pow_ui(a_mp, a_mp, b);
+      u3a_free(d_mp);
+      u3r_mpn_free(&a_u);
 
-      return u3i_mp(a_mp);
+      return u3i_slab_mpn_mint(&sab_u, c_mp);
     }
   }
   u3_noun
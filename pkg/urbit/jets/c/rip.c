@@ -97,6 +97,9 @@ _block_rip(u3_atom bloq, u3_atom b)
   */
   if ( bloq_g < 5 ) {                                   //  produce direct atoms
     u3_noun acc     = u3_nul;
+    c3_w*   b_w     = ( _(u3a_is_cat(b)) )              //  words, in place
+                      ? &b
+                      : ((u3a_atom*)u3a_to_ptr(b))->buf_w;
 
     c3_w met_w   = u3r_met(bloq_g, b);                  //  num blocks in atom
     c3_w nbits_w = 1 << bloq_g;                         //  block size in bits
@@ -108,7 +111,7 @@ _block_rip(u3_atom bloq, u3_atom b)
       c3_w bit_w = pat_w << bloq_g;                     //  bits left after this
       c3_w wor_w = bit_w >> 5;                          //  wrds left after this
       c3_w sif_w = bit_w & 31;                          //  bits left in word
-      c3_w src_w = u3r_word(wor_w, b);                  //  find word by index
+      c3_w src_w = b_w[wor_w];                          //  find word by index
       c3_w rip_w = (src_w >> sif_w) & bmask_w;          //  get item from word
 
       acc = u3nc(rip_w, acc);
@@ -129,14 +132,11 @@ _block_rip(u3_atom bloq, u3_atom b)
     c3_w     pat_w = (met_w - (i_w + 1));
     c3_w     wut_w = (pat_w << san_g);
     c3_w     sap_w = ((0 == i_w) ? tub_w : san_w);
-    c3_w       j_w;
     u3_atom    rip;
     u3i_slab sab_u;
     u3i_slab_bare(&sab_u, 5, sap_w);
 
-    for ( j_w = 0; j_w < sap_w; j_w++ ) {
-      sab_u.buf_w[j_w] = u3r_word(wut_w + j_w, b);
-    }
+    u3r_words(wut_w, sap_w, sab_u.buf_w, b);
 
     rip = u3i_slab_mint(&sab_u);
     acc = u3nc(rip, acc);
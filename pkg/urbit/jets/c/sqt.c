@@ -9,13 +9,30 @@
   u3_noun
   u3qc_sqt(u3_atom a)
   {
-    mpz_t a_mp, b_mp;
+    if ( 0 == a ) {
+      return u3nc(0, 0);
+    }
+    else {
+      u3r_mpn    a_u;
+      u3i_slab   sab_u, bas_u;
+      mp_limb_t  *b_mp, *c_mp;
+      mp_size_t  len_mp;
+
+      u3r_mpn_view(&a_u, a);
+
+      b_mp   = u3i_slab_mpn(&sab_u, (a_u.len_mp + 1) >> 1);
+      c_mp   = u3i_slab_mpn(&bas_u, a_u.len_mp);
+      len_mp = mpn_sqrtrem(b_mp, c_mp, a_u.buf_mp, a_u.len_mp);
 
-    u3r_mp(a_mp, a);
-    mpz_init(b_mp);
-    mpz_sqrtrem(a_mp, b_mp, a_mp);
+      //  only the low [len_mp] limbs of the remainder are written
+      //
+      memset(c_mp + len_mp, 0, (a_u.len_mp - len_mp) * sizeof(mp_limb_t));
 
-    return u3nc(u3i_mp(a_mp), u3i_mp(b_mp));
+      u3r_mpn_free(&a_u);
+
+      return u3nc(u3i_slab_mpn_mint(&sab_u, b_mp),
+                  u3i_slab_mpn_mint(&bas_u, c_mp));
+    }
   }
   u3_noun
   u3wc_sqt(u3_noun cor)
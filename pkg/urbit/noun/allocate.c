@@ -2,6 +2,7 @@
 **
 */
 #include "all.h"
+#include "vere/vere.h"
 
 //  declarations of inline functions
 //
@@ -366,25 +367,162 @@ u3a_sane(void)
 }
 #endif
 
-/* u3a_reflux(): dump 1K cells from the cell list into regular memory.
+/* _ca_is_sand(): yes if u3R is a sand road.
+**
+**   A sand road allocates by bumping the hat, and ignores frees:
+**   its whole heap is discarded when it falls.
 */
-void
-u3a_reflux(void)
+static __inline__ c3_o
+_ca_is_sand(void)
+{
+  return __(u3R->how.fag_w & u3a_flag_sand);
+}
+
+/* _ca_sand_willoc(): allocate on a sand road.
+*/
+static void*
+_ca_sand_willoc(c3_w siz_w, c3_w ald_w, c3_w alp_w)
+{
+  u3a_box* box_u = 0;
+
+  //  stop while what's left could hold a copy of the heap,
+  //  so that anything live can be taken out of it by our parent
+  //
+  if ( u3a_heap(u3R) < u3a_open(u3R) ) {
+    box_u = _ca_box_make_hat(siz_w, ald_w, alp_w, 1);
+  }
+
+  //  nothing on a sand road can be reclaimed; revert to ordinary
+  //  allocation, so that releasing the emergency buffer makes room
+  //  to bail
+  //
+  if ( 0 == box_u ) {
+    u3R->how.fag_w &= ~u3a_flag_sand;
+    u3m_bail(c3__meme);
+  }
+
+  return u3a_boxto(box_u);
+}
+
+/* _ca_slab(): slab for boxes of exactly [siz_w], and its length; or 0.
+**
+**   Cells and one-word atoms share the cell allocator;
+**   slightly larger atoms each have a slab by size.  Cached boxes
+**   keep a use count of 1, so they are never coalesced, and are
+**   not counted as free.
+*/
+static __inline__ u3p(u3a_fbox)*
+_ca_slab(c3_w siz_w, c3_w** len_w)
+{
+  c3_w sab_w = siz_w - u3a_minimum;
+
+#ifdef U3_MEMORY_DEBUG
+  if ( u3C.wag_w & u3o_debug_ram ) {
+    return 0;
+  }
+#endif
+
+  if ( 0 == sab_w ) {
+    *len_w = &(u3R->sab.cel_w);
+    return &(u3R->all.cel_p);
+  }
+  else if ( sab_w <= u3a_slab_no ) {
+    *len_w = &(u3R->sab.len_w[sab_w - 1]);
+    return &(u3R->sab.fre_p[sab_w - 1]);
+  }
+
+  return 0;
+}
+
+/* _ca_slab_pop(): take a box of exactly [siz_w] from its slab, if cached.
+*/
+static __inline__ u3a_box*
+_ca_slab_pop(c3_w siz_w)
+{
+  c3_w*          len_w;
+  u3p(u3a_fbox)* pfr_p = _ca_slab(siz_w, &len_w);
+
+  if ( !pfr_p || !*pfr_p ) {
+    return 0;
+  }
+  else {
+    u3a_box* box_u = &(u3to(u3a_fbox, *pfr_p)->box_u);
+
+    *pfr_p  = u3to(u3a_fbox, *pfr_p)->nex_p;
+    *len_w -= 1;
+    box_u->use_w = 1;
+
+    return box_u;
+  }
+}
+
+/* _ca_slab_push(): cache a box of use 1 in its slab, if any.
+*/
+static __inline__ c3_o
+_ca_slab_push(u3a_box* box_u)
 {
+  c3_w*          len_w;
+  u3p(u3a_fbox)* pfr_p = _ca_slab(box_u->siz_w, &len_w);
+
+  if ( !pfr_p || (*len_w >= u3a_slab_max) ) {
+    return c3n;
+  }
+  else {
+    u3p(u3a_fbox) fre_p = u3of(u3a_fbox, box_u);
+
+    u3to(u3a_fbox, fre_p)->nex_p = *pfr_p;
+    *pfr_p  = fre_p;
+    *len_w += 1;
+
+    return c3y;
+  }
+}
+
+/* _ca_slab_mark(): mark cached boxes, so that sweeping keeps them.
+*/
+static c3_w
+_ca_slab_mark(void)
+{
+  c3_w tot_w = 0;
   c3_w i_w;
 
-  for ( i_w = 0; u3R->all.cel_p && (i_w < 1024); i_w++ ) {
-    u3_post  cel_p = u3R->all.cel_p;
-    u3a_box* box_u = &(u3to(u3a_fbox, cel_p)->box_u);
+  for ( i_w = 0; i_w <= u3a_slab_no; i_w++ ) {
+    c3_w*         len_w;
+    u3p(u3a_fbox)* pfr_p = _ca_slab(u3a_minimum + i_w, &len_w);
+    u3p(u3a_fbox)  fre_p = pfr_p ? *pfr_p : 0;
 
-    u3R->all.cel_p = u3to(u3a_fbox, cel_p)->nex_p;
+    while ( fre_p ) {
+      tot_w += u3a_mark_ptr(u3a_boxto(u3to(u3a_fbox, fre_p)));
+      fre_p  = u3to(u3a_fbox, fre_p)->nex_p;
+    }
+  }
 
-    // otherwise _box_free() will double-count it
-    //
-    _box_count(-(u3a_minimum));
-    _box_free(box_u);
+  return tot_w;
+}
+
+/* u3a_reflux(): dump up to 1K boxes from each slab into regular memory,
+**               producing the number of boxes dumped.
+*/
+c3_w
+u3a_reflux(void)
+{
+  c3_w tot_w = 0;
+  c3_w i_w, j_w;
+
+  for ( i_w = 0; i_w <= u3a_slab_no; i_w++ ) {
+    u3a_box* box_u;
+
+    for ( j_w = 0;
+          (j_w < 1024) && (box_u = _ca_slab_pop(u3a_minimum + i_w));
+          j_w++ )
+    {
+      _box_free(box_u);
+    }
 
+    tot_w += j_w;
   }
+
+  return tot_w;
 }
 
 /* _ca_reclaim_half(): reclaim from memoization cache.
@@ -425,6 +563,23 @@ _ca_willoc(c3_w len_w, c3_w ald_w, c3_w alp_w)
 
   alp_w = (alp_w + c3_wiseof(u3a_box)) % ald_w;
 
+  if ( c3y == _ca_is_sand() ) {
+    return _ca_sand_willoc(siz_w, ald_w, alp_w);
+  }
+
+  //  small unaligned boxes are recycled first
+  //
+  if ( 1 == ald_w ) {
+    u3a_box* box_u = _ca_slab_pop(siz_w);
+
+    if ( box_u ) {
+#ifdef U3_MEMORY_DEBUG
+      box_u->cod_w = u3_Code;
+#endif
+      return u3a_boxto(box_u);
+    }
+  }
+
   //  XX: this logic is totally bizarre, but preserve it.
   //
   if ( (sel_w != 0) && (sel_w != u3a_fbox_no - 1) ) {
@@ -451,12 +606,10 @@ _ca_willoc(c3_w len_w, c3_w ald_w, c3_w alp_w)
           // if ( (u3a_open(u3R) + u3R->all.fre_w) < 65536 ) { _ca_reclaim_half(); }
           box_u = _ca_box_make_hat(siz_w, ald_w, alp_w, 1);
 
-          /* Flush a bunch of cell cache, then try again.
+          /* Flush a bunch of slab cache, then try again.
           */
           if ( 0 == box_u ) {
-            if ( u3R->all.cel_p ) {
-              u3a_reflux();
-
+            if ( u3a_reflux() ) {
               return _ca_willoc(len_w, ald_w, alp_w);
             }
             else {
@@ -627,7 +780,17 @@ u3a_pile_prep(u3a_pile* pil_u, c3_w len_w)
 void
 u3a_wfree(void* tox_v)
 {
-  _box_free(u3a_botox(tox_v));
+  u3a_box* box_u = u3a_botox(tox_v);
+
+  if ( c3y == _ca_is_sand() ) {
+    return;
+  }
+
+  if ( (1 == box_u->use_w) && (c3y == _ca_slab_push(box_u)) ) {
+    return;
+  }
+
+  _box_free(box_u);
 }
 
 /* u3a_wtrim(): trim storage.
@@ -637,7 +800,8 @@ u3a_wtrim(void* tox_v, c3_w old_w, c3_w len_w)
 {
   c3_w* nov_w = tox_v;
 
-  if (  (old_w > len_w)
+  if (  (c3n == _ca_is_sand())
+     && (old_w > len_w)
      && ((old_w - len_w) >= u3a_minimum) )
   {
     c3_w* box_w = (void *)u3a_botox(nov_w);
@@ -768,7 +932,7 @@ u3a_cellblock(c3_w num_w)
       u3R->all.cel_p = cel_p;
     }
   }
-  _box_count(num_w * u3a_minimum);
+  u3R->sab.cel_w += num_w;
   return c3y;
 }
 
@@ -787,33 +951,21 @@ u3a_celloc(void)
   }
 #endif
 
-  u3p(u3a_fbox) cel_p;
+  if ( c3y == _ca_is_sand() ) {
+    return _ca_sand_willoc(u3a_minimum, 1, 0);
+  }
 
-  if ( !(cel_p = u3R->all.cel_p) ) {
-    if ( u3R == &(u3H->rod_u) ) {
-      // no cell allocator on home road
-      //
+  if ( !u3R->all.cel_p ) {
+    //  the home road is persistent; take cells from the hat sparingly
+    //
+    c3_w num_w = ( u3R == &(u3H->rod_u) ) ? 256 : 4096;
+
+    if ( c3n == u3a_cellblock(num_w) ) {
       return u3a_walloc(c3_wiseof(u3a_cell));
     }
-    else {
-      if ( c3n == u3a_cellblock(4096) ) {
-        return u3a_walloc(c3_wiseof(u3a_cell));
-      }
-      cel_p = u3R->all.cel_p;
-    }
   }
 
-  {
-    u3a_box* box_u = &(u3to(u3a_fbox, cel_p)->box_u);
-
-
-    box_u->use_w = 1;
-    u3R->all.cel_p = u3to(u3a_fbox, cel_p)->nex_p;
-
-    _box_count(-(u3a_minimum));
-
-    return u3a_boxto(box_u);
-  }
+  return u3a_boxto(_ca_slab_pop(u3a_minimum));
 }
 
 /* u3a_cfree(): free a cell.
@@ -827,17 +979,15 @@ u3a_cfree(c3_w* cel_w)
   }
 #endif
 
-  if ( u3R == &(u3H->rod_u) ) {
-    return u3a_wfree(cel_w);
+  if ( c3y == _ca_is_sand() ) {
+    return;
   }
   else {
-    u3a_box*      box_u = u3a_botox(cel_w);
-    u3p(u3a_fbox) fre_p = u3of(u3a_fbox, box_u);
-
-    _box_count(u3a_minimum);
+    u3a_box* box_u = u3a_botox(cel_w);
 
-    u3to(u3a_fbox, fre_p)->nex_p = u3R->all.cel_p;
-    u3R->all.cel_p = fre_p;
+    if ( c3n == _ca_slab_push(box_u) ) {
+      _box_free(box_u);
+    }
   }
 }
 
@@ -1429,6 +1579,9 @@ top:
 }
 
 /* u3a_gain(): gain a reference count in normal space.
+**
+**   Nothing is refcounted on a sand road, which is discarded whole;
+**   whatever is taken out of it is counted afresh by u3a_take().
 */
 u3_noun
 u3a_gain(u3_noun som)
@@ -1436,7 +1589,7 @@ u3a_gain(u3_noun som)
   u3t_on(mal_o);
   c3_assert(u3_none != som);
 
-  if ( !_(u3a_is_cat(som)) ) {
+  if ( !_(u3a_is_cat(som)) && !_(_ca_is_sand()) ) {
     som = _(u3a_is_north(u3R))
               ? _me_gain_north(som)
               : _me_gain_south(som);
@@ -1452,7 +1605,7 @@ void
 u3a_lose(u3_noun som)
 {
   u3t_on(mal_o);
-  if ( !_(u3a_is_cat(som)) ) {
+  if ( !_(u3a_is_cat(som)) && !_(_ca_is_sand()) ) {
     if ( _(u3a_is_north(u3R)) ) {
       _me_lose_north(som);
     } else {
@@ -1677,6 +1830,21 @@ u3a_rewritten_noun(u3_noun som)
   }
 }
 
+/* u3a_rewritten_mptr(): rewrite a u3a_malloc-allocated pointer.
+**
+**   NB: the leading padding moves with the allocation,
+**   so the result may not retain its original alignment.
+*/
+u3_post
+u3a_rewritten_mptr(u3_post som_p)
+{
+  c3_w*   ptr_w = u3a_into(som_p);
+  c3_w    pad_w = ptr_w[-1];
+  u3_post org_p = som_p - (pad_w + 1);
+
+  return u3a_rewritten(org_p) + (pad_w + 1);
+}
+
 /* u3a_mark_mptr(): mark a malloc-allocated ptr for gc.
 */
 c3_w
@@ -1943,7 +2111,8 @@ u3a_mark_road(FILE* fil_u)
   tot_w += u3a_maid(fil_u, "  profile batteries", u3a_mark_noun(u3R->pro.don));
   tot_w += u3a_maid(fil_u, "  profile doss", u3a_mark_noun(u3R->pro.day));
   tot_w += u3a_maid(fil_u, "  new profile trace", u3a_mark_noun(u3R->pro.trace));
-  tot_w += u3a_maid(fil_u, "  memoization cache", u3h_mark(u3R->cax.har_p));
+  tot_w += u3z_mark(fil_u);
+  tot_w += u3a_maid(fil_u, "  slab cache", _ca_slab_mark());
   return   u3a_maid(fil_u, "total road stuff", tot_w);
 }
 
@@ -1955,7 +2124,11 @@ u3a_reclaim(void)
   //  clear the memoization cache
   //
   u3h_free(u3R->cax.har_p);
-  u3R->cax.har_p = u3h_new();
+  u3R->cax.har_p = u3h_new_flat(u3_Host.ops_u.hap_w);
+
+  //  return cached small boxes to the free lists
+  //
+  while ( u3a_reflux() );
 }
 
 /* u3a_rewrite_compact(): rewrite pointers in ad-hoc persistent road structures.
@@ -2445,6 +2618,8 @@ u3a_pack_move(u3a_road* rod_u)
 
     u3R->all.fre_w = 0;
     u3R->all.cel_p = 0;
+
+    memset(&(u3R->sab), 0, sizeof(u3R->sab));
   }
 }
 
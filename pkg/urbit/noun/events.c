@@ -46,44 +46,126 @@
 //!       high/low watermarks; the last page in each is always adjacent to the
 //!       contiguous free space).
 //!   - patch pages are written to memory.bin, metadata to control.bin.
+//!     - pages are checksummed in parallel, and written with vectored
+//!       writes that coalesce runs of adjacent pages.
+//!     - patches are read back in large batches, and applied with one
+//!       write per run of adjacent image pages.
 //!   - the patch is applied to the snapshot segments, in-place.
 //!   - patch files are deleted.
 //!
 //! ### limitations
 //!
-//!   - loom page size is fixed (16 KB), and must be a multiple of the
-//!     system page size. (can the size vary at runtime give south.bin's
-//!     reversed order? alternately, if system page size > ours, the fault
-//!     handler could dirty N pages at a time.)
+//!   - loom page size must be a multiple of the system page size.
 //!   - update atomicity is suspect: patch application must either
 //!     completely succeed or leave on-disk segments intact. unapplied
 //!     patches can be discarded (triggering event replay), but once
 //!     patch application begins it must succeed (can fail if disk is full).
 //!     may require integration into the overall signal-handling regime.
-//!   - any errors are handled with assertions; failed/partial writes are not
-//!     retried.
+//!   - any errors are handled with assertions; short reads and writes
+//!     are retried, failed ones are not.
+//!
+//! ### userfaultfd (u3o_userfault, linux only)
+//!
+//!   - snapshot pages are not read at boot, but loaded on first access
+//!     by a fault-handling thread (demand paging).
+//!   - where the kernel supports write-protecting anonymous memory,
+//!     clean pages are write-protected through the userfaultfd instead of
+//!     mprotect(), and write faults are handled by the same thread.
+//!   - the guard page is still protected with mprotect(), and handled
+//!     in u3e_fault().
+//!   - if userfaultfd is unavailable (or unprivileged), we fall back to
+//!     reading the snapshot at boot and tracking writes with SIGSEGV.
 //!
 //! ### enhancements
 //!
-//!   - use platform specific page fault mechanism (mach rpc, userfaultfd, &c).
-//!   - implement demand paging / heuristic page-out.
+//!   - use platform specific page fault mechanism (mach rpc, &c).
+//!   - implement heuristic page-out.
 //!   - add a guard page in the middle of the loom to reactively handle stack overflow.
-//!   - parallelism
+//!
+//! ### page size (u3C.pag_y)
+//!
+//!   - pages are 16KB by default, and may be as large as 2MB, trading
+//!     write amplification for fewer faults and page-table entries.
+//!   - the page size of the images is recorded in meta.bin (16KB if
+//!     absent), and that of a patch in its control file.
+//!   - images are loaded at their own page size; if that differs from
+//!     the configured size, all pages are left dirty, and the next save
+//!     rewrites the images at the new size.
+//!   - with u3o_hugepage, the loom is mapped with explicit 2MB pages
+//!     (if loom pages are at least that large) or transparent huge pages.
+//!
+//! ### background saves (u3e_save_async())
+//!
+//!   - dirty pages are copied into an off-loom buffer, then cleaned
+//!     and protected, as in a synchronous save.
+//!   - the patch is written, synced, and applied on a separate thread,
+//!     which never touches the loom.
+//!   - at most one save is in progress; all saves wait for the last.
+//!   - a crash before the patch is synced leaves the previous snapshot
+//!     intact, so the lost events are replayed.
 //!
 
 #include "all.h"
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
 #include <sys/stat.h>
+#ifndef U3_OS_mingw
+#  include <sys/uio.h>
+#endif
+
+#if defined(U3_OS_linux)
+#  include <linux/userfaultfd.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  if defined(__NR_userfaultfd) && defined(UFFDIO_WRITEPROTECT)
+#    define U3_EVENTS_UFFD
+#  endif
+#endif
 
 // Base loom offset of the guard page.
 static u3p(c3_w) gar_pag_p;
 
-//! Urbit page size in 4-byte words.
-static const size_t pag_wiz_i = 1 << u3a_page;
+// Background save thread, if any.
+static c3_o      sav_o = c3n;
+static pthread_t sav_u;
+
+#ifdef U3_EVENTS_UFFD
+// userfaultfd paging state.
+static struct {
+  c3_i      fid_i;                //  userfaultfd, or -1
+  c3_o      wip_o;                //  write-protect clean pages
+  c3_w      nor_w;                //  north image pages at boot
+  c3_w      sou_w;                //  south image pages at boot
+  pthread_t tid_u;                //  fault handler
+  c3_o      ful_o;                //  all image pages faulted in
+} uff_u = { .fid_i = -1, .wip_o = c3n, .ful_o = c3n };
+#endif
+
+//! Urbit page size in 4-byte words (see _ce_page_size()).
+static size_t pag_wiz_i = 1 << u3a_page;
 
 //! Urbit page size in bytes.
-static const size_t pag_siz_i = sizeof(c3_w) * pag_wiz_i;
+static size_t pag_siz_i = sizeof(c3_w) << u3a_page;
+
+//! Page size of the snapshot images on disk, log2 words.
+static c3_y   dsk_y = u3a_page;
+
+//! Page size recorded in meta.bin, log2 words (0 if none).
+static c3_y   met_y = 0;
+
+//! Bytes per patch read, and per vectored patch write.
+#define _ce_io_bytes    (1 << 23)
+
+//! Most pages in a patch read or write, at the smallest page size.
+#define _ce_io_pages    (_ce_io_bytes >> (u3a_page + 2))
+
+//! Maximum threads used to checksum pages.
+#define _ce_mug_threads 8
+
+//! Minimum bytes per checksum thread.
+#define _ce_mug_bytes   (1 << 20)
 
 #ifdef U3_SNAPSHOT_VALIDATION
 /* Image check.
@@ -99,8 +181,8 @@ struct {
 static c3_w
 _ce_check_page(c3_w pag_w)
 {
-  c3_w* mem_w = u3_Loom + (pag_w << u3a_page);
-  c3_w  mug_w = u3r_mug_words(mem_w, (1 << u3a_page));
+  c3_w* mem_w = u3_Loom + (pag_w << u3P.pag_y);
+  c3_w  mug_w = u3r_mug_words(mem_w, pag_wiz_i);
 
   return mug_w;
 }
@@ -118,8 +200,8 @@ u3e_check(c3_c* cap_c)
 
     u3m_water(&nwr_w, &swu_w);
 
-    nor_w = (nwr_w + ((1 << u3a_page) - 1)) >> u3a_page;
-    sou_w = (swu_w + ((1 << u3a_page) - 1)) >> u3a_page;
+    nor_w = (nwr_w + (pag_wiz_i - 1)) >> u3P.pag_y;
+    sou_w = (swu_w + (pag_wiz_i - 1)) >> u3P.pag_y;
   }
 
   /* Count dirty pages.
@@ -264,7 +346,7 @@ u3e_fault(void* adr_v, c3_i ser_i)
   }
 
   u3p(c3_w) adr_p  = u3a_outa(adr_w);
-  c3_w      pag_w  = adr_p >> u3a_page;
+  c3_w      pag_w  = adr_p >> u3P.pag_y;
   c3_w      blk_w  = (pag_w >> 5);
   c3_w      bit_w  = (pag_w & 31);
 
@@ -285,7 +367,7 @@ u3e_fault(void* adr_v, c3_i ser_i)
 
   u3P.dit_w[blk_w] |= (1 << bit_w);
 
-  if ( -1 == mprotect((void *)(u3_Loom + (pag_w << u3a_page)),
+  if ( -1 == mprotect((void *)(u3_Loom + (pag_w << u3P.pag_y)),
                       pag_siz_i,
                       (PROT_READ | PROT_WRITE)) )
   {
@@ -297,6 +379,459 @@ u3e_fault(void* adr_v, c3_i ser_i)
   return 1;
 }
 
+/* _ce_page_protect(): protect a clean page, so that writes are tracked.
+*/
+static void
+_ce_page_protect(c3_w pag_w)
+{
+#ifdef U3_EVENTS_UFFD
+  if ( c3y == uff_u.wip_o ) {
+    struct uffdio_writeprotect wip_u = {
+      .range = { .start = (c3_d)(c3_p)(u3_Loom + (pag_w << u3P.pag_y)),
+                 .len   = pag_siz_i },
+      .mode  = UFFDIO_WRITEPROTECT_MODE_WP
+    };
+
+    if ( -1 == ioctl(uff_u.fid_i, UFFDIO_WRITEPROTECT, &wip_u) ) {
+      fprintf(stderr, "loom: userfault protect: %s\r\n", strerror(errno));
+      c3_assert(0);
+    }
+    return;
+  }
+#endif
+
+  if ( -1 == mprotect(u3_Loom + (pag_w << u3P.pag_y),
+                      pag_siz_i,
+                      PROT_READ) )
+  {
+    fprintf(stderr, "loom: patch mprotect: %s\r\n", strerror(errno));
+    c3_assert(0);
+  }
+}
+
+/* _ce_thread_spawn(): start a thread with all signals blocked,
+**                     keeping them on the main thread.
+*/
+static c3_i
+_ce_thread_spawn(pthread_t* tid_u, void* (*fun_f)(void*), void* ptr_v)
+{
+  sigset_t set_u, old_u;
+  c3_i     ret_i;
+
+  sigfillset(&set_u);
+
+  if ( 0 != (ret_i = pthread_sigmask(SIG_BLOCK, &set_u, &old_u)) ) {
+    return ret_i;
+  }
+
+  ret_i = pthread_create(tid_u, 0, fun_f, ptr_v);
+
+  if ( 0 != pthread_sigmask(SIG_SETMASK, &old_u, 0) ) {
+    fprintf(stderr, "loom: thread unmask failed\r\n");
+    c3_assert(0);
+  }
+
+  return ret_i;
+}
+
+/* _ce_read_at(): read [len_i] bytes at [off_i], retrying short reads.
+*/
+static c3_o
+_ce_read_at(c3_i fid_i, void* buf_v, size_t len_i, off_t off_i)
+{
+  c3_y*   buf_y = buf_v;
+  ssize_t ret_i;
+
+  while ( len_i ) {
+    if ( 0 > (ret_i = pread(fid_i, buf_y, len_i, off_i)) ) {
+      if ( EINTR == errno ) {
+        continue;
+      }
+      return c3n;
+    }
+    else if ( 0 == ret_i ) {
+      errno = EIO;
+      return c3n;
+    }
+
+    buf_y += ret_i;
+    len_i -= ret_i;
+    off_i += ret_i;
+  }
+
+  return c3y;
+}
+
+/* _ce_writev_at(): gather-write [iov_u] at [off_i], retrying short writes.
+**
+**   [iov_u] is consumed.
+*/
+static c3_o
+_ce_writev_at(c3_i fid_i, struct iovec* iov_u, c3_i cnt_i, off_t off_i)
+{
+  ssize_t ret_i;
+
+  while ( cnt_i ) {
+    if ( 0 > (ret_i = pwritev(fid_i, iov_u, cnt_i, off_i)) ) {
+      if ( EINTR == errno ) {
+        continue;
+      }
+      return c3n;
+    }
+
+    off_i += ret_i;
+
+    while ( cnt_i && ((size_t)ret_i >= iov_u->iov_len) ) {
+      ret_i -= iov_u->iov_len;
+      iov_u++;
+      cnt_i--;
+    }
+
+    if ( cnt_i ) {
+      iov_u->iov_base  = (c3_y*)iov_u->iov_base + ret_i;
+      iov_u->iov_len  -= ret_i;
+    }
+  }
+
+  return c3y;
+}
+
+/* _ce_write_at(): write [len_i] bytes at [off_i], retrying short writes.
+*/
+static c3_o
+_ce_write_at(c3_i fid_i, void* buf_v, size_t len_i, off_t off_i)
+{
+  struct iovec iov_u = { .iov_base = buf_v, .iov_len = len_i };
+
+  return _ce_writev_at(fid_i, &iov_u, 1, off_i);
+}
+
+/* _ce_mugs: a slice of pages to checksum.
+*/
+typedef struct _ce_mugs {
+  c3_w   len_w;                     //  page count
+  size_t wiz_i;                     //  page size in words
+  c3_w** pag_w;                     //  page addresses
+  c3_w*  mug_w;                     //  output mugs
+  c3_o   liv_o;                     //  on its own thread
+  pthread_t tid_u;                  //  thread, if [liv_o]
+} _ce_mugs;
+
+/* _ce_mugs_work(): checksum a slice of pages.
+*/
+static void*
+_ce_mugs_work(void* ptr_v)
+{
+  _ce_mugs* mug_u = ptr_v;
+  c3_w      i_w;
+
+  for ( i_w = 0; i_w < mug_u->len_w; i_w++ ) {
+    mug_u->mug_w[i_w] = u3r_mug_words(mug_u->pag_w[i_w], mug_u->wiz_i);
+  }
+
+  return 0;
+}
+
+/* _ce_page_mugs(): checksum [len_w] pages of [wiz_i] words at [pag_w]
+**                  into [mug_w], in parallel where there are enough.
+*/
+static void
+_ce_page_mugs(c3_w len_w, c3_w** pag_w, size_t wiz_i, c3_w* mug_w)
+{
+  _ce_mugs mug_u[_ce_mug_threads];
+  c3_w     thr_w = ((c3_d)len_w * (wiz_i << 2)) / _ce_mug_bytes;
+  c3_w     per_w, i_w;
+
+  {
+    long cpu_l = sysconf(_SC_NPROCESSORS_ONLN);
+
+    thr_w = c3_min(thr_w, _ce_mug_threads);
+    thr_w = ( 0 < cpu_l ) ? c3_min(thr_w, (c3_w)cpu_l) : 1;
+    thr_w = c3_max(thr_w, 1);
+  }
+
+  per_w = (len_w + (thr_w - 1)) / thr_w;
+
+  for ( i_w = 0; i_w < thr_w; i_w++ ) {
+    c3_w fir_w = c3_min(len_w, i_w * per_w);
+
+    mug_u[i_w].len_w = c3_min(per_w, len_w - fir_w);
+    mug_u[i_w].wiz_i = wiz_i;
+    mug_u[i_w].pag_w = pag_w + fir_w;
+    mug_u[i_w].mug_w = mug_w + fir_w;
+    mug_u[i_w].liv_o = c3n;
+
+    //  the first slice is ours, as is any we fail to hand off
+    //
+    if (  i_w
+       && (0 == _ce_thread_spawn(&mug_u[i_w].tid_u, _ce_mugs_work, &mug_u[i_w])) )
+    {
+      mug_u[i_w].liv_o = c3y;
+    }
+  }
+
+  for ( i_w = 0; i_w < thr_w; i_w++ ) {
+    if ( c3n == mug_u[i_w].liv_o ) {
+      _ce_mugs_work(&mug_u[i_w]);
+    }
+  }
+
+  for ( i_w = 1; i_w < thr_w; i_w++ ) {
+    if ( c3y == mug_u[i_w].liv_o ) {
+      pthread_join(mug_u[i_w].tid_u, 0);
+    }
+  }
+}
+
+#ifdef U3_EVENTS_UFFD
+/* _ce_uffd_read(): read a page from the boot-time images.
+*/
+static void
+_ce_uffd_read(c3_w pag_w, c3_w* buf_w)
+{
+  c3_y*   buf_y = (c3_y*)buf_w;
+  size_t  len_i = pag_siz_i;
+  c3_i    fid_i;
+  c3_w    off_w;
+  ssize_t ret_i;
+
+  if ( pag_w < uff_u.nor_w ) {
+    fid_i = u3P.nor_u.fid_i;
+    off_w = pag_w;
+  }
+  else {
+    fid_i = u3P.sou_u.fid_i;
+    off_w = (u3P.pag_w - (pag_w + 1));
+  }
+
+  //  images may since have been truncated past this page, which can
+  //  only be above the watermarks; its contents are then unused
+  //
+  while ( len_i ) {
+    ret_i = pread(fid_i, buf_y, len_i,
+                  ((off_t)off_w << (u3P.pag_y + 2)) + (pag_siz_i - len_i));
+
+    if ( 0 > ret_i ) {
+      if ( EINTR == errno ) {
+        continue;
+      }
+      fprintf(stderr, "loom: userfault read: %s\r\n", strerror(errno));
+      c3_assert(0);
+    }
+    else if ( 0 == ret_i ) {
+      memset(buf_y, 0, len_i);
+      break;
+    }
+
+    buf_y += ret_i;
+    len_i -= ret_i;
+  }
+}
+
+/* _ce_uffd_fault(): handle a userfault.
+**
+**   the faulting thread is suspended, so we may update the dirty bitmap.
+*/
+static void
+_ce_uffd_fault(c3_d adr_d, c3_d fag_d, c3_w* buf_w)
+{
+  c3_w  pag_w = (adr_d - (c3_d)(c3_p)u3_Loom) >> (u3P.pag_y + 2);
+  c3_w  blk_w = (pag_w >> 5);
+  c3_w  bit_w = (pag_w & 31);
+  c3_d  pag_d = (c3_d)(c3_p)(u3_Loom + (pag_w << u3P.pag_y));
+
+  if ( fag_d & UFFD_PAGEFAULT_FLAG_WP ) {
+    struct uffdio_writeprotect wip_u = {
+      .range = { .start = pag_d, .len = pag_siz_i },
+      .mode  = 0
+    };
+
+    u3P.dit_w[blk_w] |= (1 << bit_w);
+
+    if ( -1 == ioctl(uff_u.fid_i, UFFDIO_WRITEPROTECT, &wip_u) ) {
+      fprintf(stderr, "loom: userfault unprotect: %s\r\n", strerror(errno));
+      c3_assert(0);
+    }
+  }
+  else {
+    struct uffdio_copy cop_u = {
+      .dst  = pag_d,
+      .src  = (c3_d)(c3_p)buf_w,
+      .len  = pag_siz_i,
+      .mode = 0
+    };
+
+    if ( fag_d & UFFD_PAGEFAULT_FLAG_WRITE ) {
+      u3P.dit_w[blk_w] |= (1 << bit_w);
+    }
+    else if (  (c3y == uff_u.wip_o)
+            && !(u3P.dit_w[blk_w] & (1 << bit_w)) )
+    {
+      cop_u.mode = UFFDIO_COPY_MODE_WP;
+    }
+
+    _ce_uffd_read(pag_w, buf_w);
+
+    if ( -1 == ioctl(uff_u.fid_i, UFFDIO_COPY, &cop_u) ) {
+      //  already present; the faulting thread may just need waking
+      //
+      if ( EEXIST == errno ) {
+        struct uffdio_range ran_u = { .start = pag_d, .len = pag_siz_i };
+        ioctl(uff_u.fid_i, UFFDIO_WAKE, &ran_u);
+      }
+      else {
+        fprintf(stderr, "loom: userfault copy: %s\r\n", strerror(errno));
+        c3_assert(0);
+      }
+    }
+  }
+}
+
+/* _ce_uffd_thread(): handle userfaults, forever.
+*/
+static void*
+_ce_uffd_thread(void* ptr_v)
+{
+  c3_w*           buf_w = c3_malloc(pag_siz_i);
+  struct uffd_msg msg_u;
+  ssize_t         ret_i;
+
+  while ( 1 ) {
+    if ( sizeof(msg_u) != (ret_i = read(uff_u.fid_i, &msg_u, sizeof(msg_u))) ) {
+      if ( (0 > ret_i) && ((EINTR == errno) || (EAGAIN == errno)) ) {
+        continue;
+      }
+      fprintf(stderr, "loom: userfault read: %s\r\n", strerror(errno));
+      c3_assert(0);
+    }
+
+    if ( UFFD_EVENT_PAGEFAULT == msg_u.event ) {
+      _ce_uffd_fault(msg_u.arg.pagefault.address,
+                     msg_u.arg.pagefault.flags,
+                     buf_w);
+    }
+  }
+
+  return 0;
+}
+
+/* _ce_uffd_range(): register loom pages with the userfaultfd.
+*/
+static c3_o
+_ce_uffd_range(c3_w pag_w, c3_w len_w, c3_d mod_d)
+{
+  struct uffdio_register reg_u = {
+    .range = { .start = (c3_d)(c3_p)(u3_Loom + (pag_w << u3P.pag_y)),
+               .len   = (c3_d)len_w * pag_siz_i },
+    .mode  = mod_d
+  };
+
+  if ( !len_w || !mod_d ) {
+    return c3y;
+  }
+
+  return ( -1 == ioctl(uff_u.fid_i, UFFDIO_REGISTER, &reg_u) ) ? c3n : c3y;
+}
+
+/* _ce_uffd_register(): register the loom, in segments.
+*/
+static c3_o
+_ce_uffd_register(void)
+{
+  c3_d wip_d = ( c3y == uff_u.wip_o ) ? UFFDIO_REGISTER_MODE_WP : 0;
+  c3_d mis_d = UFFDIO_REGISTER_MODE_MISSING | wip_d;
+  c3_w sou_w = u3P.pag_w - uff_u.sou_w;
+
+  return ( (c3y == _ce_uffd_range(0, uff_u.nor_w, mis_d))
+        && (c3y == _ce_uffd_range(uff_u.nor_w, sou_w - uff_u.nor_w, wip_d))
+        && (c3y == _ce_uffd_range(sou_w, uff_u.sou_w, mis_d)) ) ? c3y : c3n;
+}
+
+/* _ce_uffd_live(): page the loom through a userfaultfd, if possible.
+*/
+static c3_o
+_ce_uffd_live(void)
+{
+  struct uffdio_api api_u = { .api = UFFD_API, .features = 0 };
+
+  if ( -1 == (uff_u.fid_i = syscall(__NR_userfaultfd, O_CLOEXEC)) ) {
+    fprintf(stderr, "loom: userfaultfd: %s\r\n", strerror(errno));
+    return c3n;
+  }
+
+  if ( -1 == ioctl(uff_u.fid_i, UFFDIO_API, &api_u) ) {
+    fprintf(stderr, "loom: userfaultfd api: %s\r\n", strerror(errno));
+    goto fail;
+  }
+
+  uff_u.nor_w = u3P.nor_u.pgs_w;
+  uff_u.sou_w = u3P.sou_u.pgs_w;
+  uff_u.wip_o = __(api_u.features & UFFD_FEATURE_PAGEFAULT_FLAG_WP);
+
+  //  write-protection of anonymous memory may still be unsupported
+  //
+  if ( c3n == _ce_uffd_register() ) {
+    struct uffdio_range ran_u = {
+      .start = (c3_d)(c3_p)u3_Loom,
+      .len   = (c3_d)u3P.pag_w * pag_siz_i
+    };
+
+    ioctl(uff_u.fid_i, UFFDIO_UNREGISTER, &ran_u);
+
+    if ( c3n == uff_u.wip_o ) {
+      goto reg;
+    }
+
+    uff_u.wip_o = c3n;
+
+    if ( c3n == _ce_uffd_register() ) {
+      goto reg;
+    }
+  }
+
+  if ( (c3n == uff_u.wip_o) && !uff_u.nor_w && !uff_u.sou_w ) {
+    goto fail;
+  }
+
+  {
+    c3_i ret_i = _ce_thread_spawn(&uff_u.tid_u, _ce_uffd_thread, 0);
+
+    if ( 0 != ret_i ) {
+      fprintf(stderr, "loom: userfault thread: %s\r\n", strerror(ret_i));
+      goto fail;
+    }
+  }
+
+  u3l_log("loom: userfaultfd paging%s\r\n",
+          ( c3y == uff_u.wip_o ) ? ", write-protect tracking" : "");
+  return c3y;
+
+reg:
+  fprintf(stderr, "loom: userfaultfd register: %s\r\n", strerror(errno));
+fail:
+  close(uff_u.fid_i);
+  uff_u.fid_i = -1;
+  uff_u.wip_o = c3n;
+  return c3n;
+}
+#endif /* ifdef U3_EVENTS_UFFD */
+
+/* _ce_image_lazy(): mark image pages clean, to be paged in on demand.
+*/
+static void
+_ce_image_lazy(u3e_image* img_u, c3_w pag_w, c3_ws stp_ws)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < img_u->pgs_w; i_w++ ) {
+    c3_w blk_w = pag_w >> 5;
+    c3_w bit_w = pag_w & 31;
+    u3P.dit_w[blk_w] &= ~(1 << bit_w);
+
+    pag_w += stp_ws;
+  }
+}
+
 /* _ce_image_open(): open or create image.
 */
 static c3_o
@@ -329,14 +864,14 @@ _ce_image_open(u3e_image* img_u)
     }
     else {
       c3_d siz_d = buf_u.st_size;
-      c3_d pgs_d = (siz_d + (c3_d)(pag_siz_i - 1)) >>
-                   (c3_d)(u3a_page + 2);
+      c3_d pgs_d = (siz_d + ((c3_d)sizeof(c3_w) << dsk_y) - 1) >>
+                   (c3_d)(dsk_y + 2);
 
       if ( !siz_d ) {
         return c3y;
       }
       else {
-        if ( siz_d != (pgs_d << (c3_d)(u3a_page + 2)) ) {
+        if ( siz_d != (pgs_d << (c3_d)(dsk_y + 2)) ) {
           fprintf(stderr, "%s: corrupt size %" PRIx64 "\r\n", ful_c, siz_d);
           return c3n;
         }
@@ -349,6 +884,124 @@ _ce_image_open(u3e_image* img_u)
   }
 }
 
+/* _ce_meta_read(): read the image page size from meta.bin, 0 if absent.
+*/
+static c3_o
+_ce_meta_read(c3_y* pag_y)
+{
+  u3e_meta met_u;
+  c3_c     ful_c[8193];
+  c3_i     fid_i;
+  c3_o     ret_o;
+
+  snprintf(ful_c, 8192, "%s/.urb/chk/meta.bin", u3P.dir_c);
+
+  if ( -1 == (fid_i = c3_open(ful_c, O_RDONLY)) ) {
+    *pag_y = 0;
+    return ( ENOENT == errno ) ? c3y : c3n;
+  }
+
+  ret_o = _ce_read_at(fid_i, &met_u, sizeof(met_u), 0);
+  close(fid_i);
+
+  if (  (c3n == ret_o)
+     || (u3e_meta_version != met_u.ver_y)
+     || (u3a_page > met_u.pag_y)
+     || (u3e_page_max < met_u.pag_y) )
+  {
+    fprintf(stderr, "loom: %s: invalid\r\n", ful_c);
+    return c3n;
+  }
+
+  *pag_y = met_u.pag_y;
+  return c3y;
+}
+
+/* _ce_meta_write(): record the image page size in [dir_c]/meta.bin.
+*/
+static c3_o
+_ce_meta_write(c3_c* dir_c, c3_y pag_y)
+{
+  u3e_meta met_u = { .ver_y = u3e_meta_version, .pag_y = pag_y };
+  c3_c     ful_c[8193];
+  c3_i     fid_i;
+  c3_o     ret_o;
+
+  snprintf(ful_c, 8192, "%s/meta.bin", dir_c);
+
+  if ( -1 == (fid_i = c3_open(ful_c, O_RDWR | O_CREAT | O_TRUNC, 0666)) ) {
+    fprintf(stderr, "loom: c3_open %s: %s\r\n", ful_c, strerror(errno));
+    return c3n;
+  }
+
+  if (  (c3n == (ret_o = _ce_write_at(fid_i, &met_u, sizeof(met_u), 0)))
+     || (-1 == c3_sync(fid_i)) )
+  {
+    fprintf(stderr, "loom: write %s: %s\r\n", ful_c, strerror(errno));
+    ret_o = c3n;
+  }
+
+  close(fid_i);
+  return ret_o;
+}
+
+/* _ce_meta_sync(): record the page size of the images, if it changed.
+**
+**   Must follow image sync, and precede patch deletion: a patch that
+**   changes the page size is reapplied until it's recorded.
+*/
+static void
+_ce_meta_sync(void)
+{
+  if ( met_y != dsk_y ) {
+    c3_c ful_c[8193];
+
+    snprintf(ful_c, 8192, "%s/.urb/chk", u3P.dir_c);
+
+    if ( c3n == _ce_meta_write(ful_c, dsk_y) ) {
+      c3_assert(!"loom: meta");
+    }
+    met_y = dsk_y;
+  }
+}
+
+/* _ce_page_size(): set the loom page size, [pag_y] log2 words.
+*/
+static void
+_ce_page_size(c3_y pag_y)
+{
+  //  require that our page size is a multiple of the system page size,
+  //  and that the loom has room for some pages.
+  //
+  {
+    size_t sys_i = sysconf(_SC_PAGESIZE);
+    size_t siz_i = sizeof(c3_w) << pag_y;
+
+    if ( (pag_y < u3a_page) || (pag_y > u3e_page_max) ) {
+      fprintf(stderr, "loom: unsupported page size (%zuKB)\r\n",
+                      siz_i >> 10);
+      exit(1);
+    }
+
+    if ( siz_i % sys_i ) {
+      fprintf(stderr, "loom: incompatible system page size (%zuKB)\r\n",
+                      sys_i >> 10);
+      exit(1);
+    }
+
+    if ( (u3C.wor_i >> pag_y) < 16 ) {
+      fprintf(stderr, "loom: page size (%zuKB) too large for loom\r\n",
+                      siz_i >> 10);
+      exit(1);
+    }
+  }
+
+  u3P.pag_y = pag_y;
+  u3P.pag_w = u3C.wor_i >> pag_y;
+  pag_wiz_i = (size_t)1 << pag_y;
+  pag_siz_i = sizeof(c3_w) << pag_y;
+}
+
 /* _ce_patch_write_control(): write control block file.
 */
 static void
@@ -369,6 +1022,41 @@ _ce_patch_write_control(u3_ce_patch* pat_u)
   }
 }
 
+/* _ce_patch_read_control_v1(): upgrade a version 1 control block.
+**
+**   version 1 patches, left by an older binary that stopped before
+**   (or while) applying them, are still needed to complete the images.
+**   they differ only in their header, and in always using 16KB pages.
+*/
+static c3_o
+_ce_patch_read_control_v1(u3_ce_patch* pat_u, c3_w len_w)
+{
+  u3e_control_v1* old_u = (u3e_control_v1*)pat_u->con_u;
+  u3e_control*    con_u;
+
+  if (  (len_w < sizeof(u3e_control_v1))
+     || (len_w != sizeof(u3e_control_v1) +
+                  ((size_t)old_u->pgs_w * sizeof(u3e_line))) )
+  {
+    return c3n;
+  }
+
+  con_u = c3_malloc(sizeof(u3e_control) +
+                    ((size_t)old_u->pgs_w * sizeof(u3e_line)));
+  con_u->ver_y = u3e_version;
+  con_u->pag_y = u3a_page;
+  con_u->nor_w = old_u->nor_w;
+  con_u->sou_w = old_u->sou_w;
+  con_u->pgs_w = old_u->pgs_w;
+  memcpy(con_u->mem_u, old_u->mem_u, old_u->pgs_w * sizeof(u3e_line));
+
+  u3l_log("loom: upgrading version 1 patch (%u pages)\r\n", con_u->pgs_w);
+
+  c3_free(pat_u->con_u);
+  pat_u->con_u = con_u;
+  return c3y;
+}
+
 /* _ce_patch_read_control(): read control block file.
 */
 static c3_o
@@ -387,10 +1075,25 @@ _ce_patch_read_control(u3_ce_patch* pat_u)
     len_w = (c3_w) buf_u.st_size;
   }
 
-  pat_u->con_u = c3_malloc(len_w);
-  if ( (len_w != read(pat_u->ctl_i, pat_u->con_u, len_w)) ||
-        (len_w != sizeof(u3e_control) +
-                  (pat_u->con_u->pgs_w * sizeof(u3e_line))) )
+  pat_u->con_u = c3_malloc(c3_max(len_w, sizeof(u3e_control)));
+  if (  (len_w != read(pat_u->ctl_i, pat_u->con_u, len_w))
+     || (len_w < sizeof(c3_w)) )
+  {
+    c3_free(pat_u->con_u);
+    pat_u->con_u = 0;
+    return c3n;
+  }
+
+  if ( 1 == pat_u->con_u->ver_y ) {
+    if ( c3n == _ce_patch_read_control_v1(pat_u, len_w) ) {
+      c3_free(pat_u->con_u);
+      pat_u->con_u = 0;
+      return c3n;
+    }
+  }
+  else if ( (len_w < sizeof(u3e_control))
+         || (len_w != sizeof(u3e_control) +
+                      (pat_u->con_u->pgs_w * sizeof(u3e_line))) )
   {
     c3_free(pat_u->con_u);
     pat_u->con_u = 0;
@@ -450,8 +1153,7 @@ _ce_patch_delete(void)
 static c3_o
 _ce_patch_verify(u3_ce_patch* pat_u)
 {
-  ssize_t ret_i;
-  c3_w      i_w;
+  c3_w i_w;
 
   if ( u3e_version != pat_u->con_u->ver_y ) {
     fprintf(stderr, "loom: patch version mismatch: have %u, need %u\r\n",
@@ -460,40 +1162,65 @@ _ce_patch_verify(u3_ce_patch* pat_u)
     return c3n;
   }
 
-  for ( i_w = 0; i_w < pat_u->con_u->pgs_w; i_w++ ) {
-    c3_w pag_w = pat_u->con_u->mem_u[i_w].pag_w;
-    c3_w mug_w = pat_u->con_u->mem_u[i_w].mug_w;
-    c3_w mem_w[1 << u3a_page];
+  if (  (u3a_page > pat_u->con_u->pag_y)
+     || (u3e_page_max < pat_u->con_u->pag_y) )
+  {
+    fprintf(stderr, "loom: patch page size invalid: %u\r\n",
+                    pat_u->con_u->pag_y);
+    return c3n;
+  }
 
-    if ( -1 == lseek(pat_u->mem_i, (i_w << (u3a_page + 2)), SEEK_SET) ) {
-      fprintf(stderr, "loom: patch seek: %s\r\n", strerror(errno));
-      return c3n;
+  //  read the patch in batches, checksumming each in parallel
+  //
+  {
+    c3_y   pag_y = pat_u->con_u->pag_y;
+    size_t siz_i = sizeof(c3_w) << pag_y;
+    c3_w   bat_w = c3_max(1, _ce_io_bytes / siz_i);
+    c3_w   pgs_w = pat_u->con_u->pgs_w;
+    c3_w*  buf_w = c3_malloc(bat_w * siz_i);
+    c3_w*  pag_w[_ce_io_pages];
+    c3_w   nug_w[_ce_io_pages];
+    c3_o   ret_o = c3y;
+    c3_w   len_w, j_w;
+
+    for ( j_w = 0; j_w < bat_w; j_w++ ) {
+      pag_w[j_w] = buf_w + (j_w << pag_y);
     }
-    if ( pag_siz_i != (ret_i = read(pat_u->mem_i, mem_w, pag_siz_i)) ) {
-      if ( 0 < ret_i ) {
-        fprintf(stderr, "loom: patch partial read: %zu\r\n", (size_t)ret_i);
-      }
-      else {
+
+    for ( i_w = 0; (c3y == ret_o) && (i_w < pgs_w); i_w += len_w ) {
+      len_w = c3_min(bat_w, pgs_w - i_w);
+
+      if ( c3n == _ce_read_at(pat_u->mem_i, buf_w, len_w * siz_i,
+                                            (off_t)i_w * siz_i) )
+      {
         fprintf(stderr, "loom: patch read fail: %s\r\n", strerror(errno));
+        ret_o = c3n;
+        break;
       }
-      return c3n;
-    }
-    {
-      c3_w nug_w = u3r_mug_words(mem_w, pag_wiz_i);
 
-      if ( mug_w != nug_w ) {
-        fprintf(stderr, "loom: patch mug mismatch %d/%d; (%x, %x)\r\n",
-                        pag_w, i_w, mug_w, nug_w);
-        return c3n;
-      }
+      _ce_page_mugs(len_w, pag_w, (size_t)1 << pag_y, nug_w);
+
+      for ( j_w = 0; j_w < len_w; j_w++ ) {
+        u3e_line* lin_u = &pat_u->con_u->mem_u[i_w + j_w];
+
+        if ( lin_u->mug_w != nug_w[j_w] ) {
+          fprintf(stderr, "loom: patch mug mismatch %d/%d; (%x, %x)\r\n",
+                          lin_u->pag_w, i_w + j_w, lin_u->mug_w, nug_w[j_w]);
+          ret_o = c3n;
+          break;
+        }
 #if 0
-      else {
-        u3l_log("verify: patch %d/%d, %x\r\n", pag_w, i_w, mug_w);
-      }
+        else {
+          u3l_log("verify: patch %d/%d, %x\r\n",
+                  lin_u->pag_w, i_w + j_w, lin_u->mug_w);
+        }
 #endif
+      }
     }
+
+    c3_free(buf_w);
+    return ret_o;
   }
-  return c3y;
 }
 
 /* _ce_patch_free(): free a patch.
@@ -501,6 +1228,7 @@ _ce_patch_verify(u3_ce_patch* pat_u)
 static void
 _ce_patch_free(u3_ce_patch* pat_u)
 {
+  c3_free(pat_u->buf_w);
   c3_free(pat_u->con_u);
   close(pat_u->ctl_i);
   close(pat_u->mem_i);
@@ -538,6 +1266,7 @@ _ce_patch_open(void)
   pat_u->ctl_i = ctl_i;
   pat_u->mem_i = mem_i;
   pat_u->con_u = 0;
+  pat_u->buf_w = 0;
 
   if ( c3n == _ce_patch_read_control(pat_u) ) {
     close(pat_u->ctl_i);
@@ -555,30 +1284,63 @@ _ce_patch_open(void)
   return pat_u;
 }
 
-/* _ce_patch_write_page(): write a page of patch memory.
+/* _ce_patch_write_pages(): checksum patch pages on the loom and write them.
 */
 static void
-_ce_patch_write_page(u3_ce_patch* pat_u,
-                     c3_w         pgc_w,
-                     c3_w*        mem_w)
+_ce_patch_write_pages(u3_ce_patch* pat_u)
 {
-  ssize_t ret_i;
+  c3_w   pgs_w = pat_u->con_u->pgs_w;
+  c3_w** pag_w = c3_malloc(pgs_w * sizeof(c3_w*));
+  c3_w*  mug_w = c3_malloc(pgs_w * sizeof(c3_w));
+  c3_w   bat_w = c3_max(1, _ce_io_bytes / pag_siz_i);
+  c3_w   i_w, len_w;
+
+  for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+    pag_w[i_w] = u3_Loom + (pat_u->con_u->mem_u[i_w].pag_w << u3P.pag_y);
+  }
+
+  _ce_page_mugs(pgs_w, pag_w, pag_wiz_i, mug_w);
+
+  for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+    pat_u->con_u->mem_u[i_w].mug_w = mug_w[i_w];
+  }
+
+  //  patch memory is in order; gather it straight from the loom,
+  //  coalescing runs of adjacent pages
+  //
+  for ( i_w = 0; i_w < pgs_w; i_w += len_w ) {
+    struct iovec iov_u[_ce_io_pages];
+    c3_i         cnt_i = 0;
 
-  if ( -1 == lseek(pat_u->mem_i, pgc_w * pag_siz_i, SEEK_SET) ) {
-    fprintf(stderr, "loom: patch page seek: %s\r\n", strerror(errno));
-    c3_assert(0);
-  }
+    for ( len_w = 0;
+          (i_w + len_w < pgs_w) && (len_w < bat_w);
+          len_w++ )
+    {
+      c3_y* pag_y = (c3_y*)pag_w[i_w + len_w];
 
-  if ( pag_siz_i != (ret_i = write(pat_u->mem_i, mem_w, pag_siz_i)) ) {
-    if ( 0 < ret_i ) {
-      fprintf(stderr, "loom: patch page partial write: %zu\r\n",
-                      (size_t)ret_i);
+      if (  cnt_i
+         && (pag_y == (c3_y*)iov_u[cnt_i - 1].iov_base
+                      + iov_u[cnt_i - 1].iov_len) )
+      {
+        iov_u[cnt_i - 1].iov_len += pag_siz_i;
+      }
+      else {
+        iov_u[cnt_i].iov_base = pag_y;
+        iov_u[cnt_i].iov_len  = pag_siz_i;
+        cnt_i++;
+      }
     }
-    else {
+
+    if ( c3n == _ce_writev_at(pat_u->mem_i, iov_u, cnt_i,
+                                            (off_t)i_w * pag_siz_i) )
+    {
       fprintf(stderr, "loom: patch page write: %s\r\n", strerror(errno));
+      c3_assert(0);
     }
-    c3_assert(0);
   }
+
+  c3_free(pag_w);
+  c3_free(mug_w);
 }
 
 /* _ce_patch_count_page(): count a page, producing new counter.
@@ -607,23 +1369,21 @@ _ce_patch_save_page(u3_ce_patch* pat_u,
   c3_w bit_w = (pag_w & 31);
 
   if ( u3P.dit_w[blk_w] & (1 << bit_w) ) {
-    c3_w* mem_w = u3_Loom + (pag_w << u3a_page);
+    c3_w* mem_w = u3_Loom + (pag_w << u3P.pag_y);
 
     pat_u->con_u->mem_u[pgc_w].pag_w = pag_w;
-    pat_u->con_u->mem_u[pgc_w].mug_w = u3r_mug_words(mem_w, pag_wiz_i);
+
+    //  capture the page for a background save; either way,
+    //  it's checksummed and written later
+    //
+    if ( pat_u->buf_w ) {
+      memcpy(pat_u->buf_w + (pgc_w << u3P.pag_y), mem_w, pag_siz_i);
+    }
 
 #if 0
     u3l_log("protect a: page %d\r\n", pag_w);
 #endif
-    _ce_patch_write_page(pat_u, pgc_w, mem_w);
-
-    if ( -1 == mprotect(u3_Loom + (pag_w << u3a_page),
-                        pag_siz_i,
-                        PROT_READ) )
-    {
-      fprintf(stderr, "loom: patch mprotect: %s\r\n", strerror(errno));
-      c3_assert(0);
-    }
+    _ce_page_protect(pag_w);
 
     u3P.dit_w[blk_w] &= ~(1 << bit_w);
     pgc_w += 1;
@@ -631,10 +1391,11 @@ _ce_patch_save_page(u3_ce_patch* pat_u,
   return pgc_w;
 }
 
-/* _ce_patch_compose(): make and write current patch.
+/* _ce_patch_compose(): make and write current patch,
+**                     or capture it in memory if [cap_o].
 */
 static u3_ce_patch*
-_ce_patch_compose(void)
+_ce_patch_compose(c3_o cap_o)
 {
   c3_w pgs_w = 0;
   c3_w nor_w = 0;
@@ -647,11 +1408,11 @@ _ce_patch_compose(void)
 
     u3m_water(&nwr_w, &swu_w);
 
-    nor_w = (nwr_w + (pag_wiz_i - 1)) >> u3a_page;
-    sou_w = (swu_w + (pag_wiz_i - 1)) >> u3a_page;
+    nor_w = (nwr_w + (pag_wiz_i - 1)) >> u3P.pag_y;
+    sou_w = (swu_w + (pag_wiz_i - 1)) >> u3P.pag_y;
 
-    c3_assert(  ((gar_pag_p >> u3a_page) >= nor_w)
-             && ((gar_pag_p >> u3a_page) <= (u3a_pages - (sou_w + 1))) );
+    c3_assert(  ((gar_pag_p >> u3P.pag_y) >= nor_w)
+             && ((gar_pag_p >> u3P.pag_y) <= (u3P.pag_w - (sou_w + 1))) );
   }
 
 #ifdef U3_SNAPSHOT_VALIDATION
@@ -679,9 +1440,18 @@ _ce_patch_compose(void)
     u3_ce_patch* pat_u = c3_malloc(sizeof(u3_ce_patch));
     c3_w i_w, pgc_w;
 
-    _ce_patch_create(pat_u);
+    if ( c3y == cap_o ) {
+      pat_u->ctl_i = pat_u->mem_i = -1;
+      pat_u->buf_w = c3_malloc((size_t)pgs_w * pag_siz_i);
+    }
+    else {
+      _ce_patch_create(pat_u);
+      pat_u->buf_w = 0;
+    }
+
     pat_u->con_u = c3_malloc(sizeof(u3e_control) + (pgs_w * sizeof(u3e_line)));
     pat_u->con_u->ver_y = u3e_version;
+    pat_u->con_u->pag_y = u3P.pag_y;
     pgc_w = 0;
 
     for ( i_w = 0; i_w < nor_w; i_w++ ) {
@@ -695,11 +1465,54 @@ _ce_patch_compose(void)
     pat_u->con_u->sou_w = sou_w;
     pat_u->con_u->pgs_w = pgc_w;
 
-    _ce_patch_write_control(pat_u);
+    if ( c3n == cap_o ) {
+      _ce_patch_write_pages(pat_u);
+      _ce_patch_write_control(pat_u);
+    }
     return pat_u;
   }
 }
 
+/* _ce_patch_dump(): checksum and write a captured patch.
+*/
+static void
+_ce_patch_dump(u3_ce_patch* pat_u)
+{
+  c3_w   pgs_w = pat_u->con_u->pgs_w;
+  c3_w** pag_w = c3_malloc(pgs_w * sizeof(c3_w*));
+  c3_w*  mug_w = c3_malloc(pgs_w * sizeof(c3_w));
+  c3_w   i_w;
+
+  for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+    pag_w[i_w] = pat_u->buf_w + (i_w << u3P.pag_y);
+  }
+
+  _ce_page_mugs(pgs_w, pag_w, pag_wiz_i, mug_w);
+
+  for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+    pat_u->con_u->mem_u[i_w].mug_w = mug_w[i_w];
+  }
+
+  c3_free(pag_w);
+  c3_free(mug_w);
+
+  _ce_patch_create(pat_u);
+
+  //  patch memory is the captured buffer, in order
+  //
+  if ( c3n == _ce_write_at(pat_u->mem_i, pat_u->buf_w,
+                                         (size_t)pgs_w * pag_siz_i, 0) )
+  {
+    fprintf(stderr, "loom: patch dump write: %s\r\n", strerror(errno));
+    c3_assert(0);
+  }
+
+  c3_free(pat_u->buf_w);
+  pat_u->buf_w = 0;
+
+  _ce_patch_write_control(pat_u);
+}
+
 /* _ce_patch_sync(): make sure patch is synced to disk.
 */
 static void
@@ -731,13 +1544,14 @@ _ce_image_sync(u3e_image* img_u)
   }
 }
 
-/* _ce_image_resize(): resize image, truncating if it shrunk.
+/* _ce_image_resize(): resize image to [pgs_w] pages of size [pag_y],
+**                     truncating if it shrunk.
 */
 static void
-_ce_image_resize(u3e_image* img_u, c3_w pgs_w)
+_ce_image_resize(u3e_image* img_u, c3_w pgs_w, c3_y pag_y)
 {
-  if ( img_u->pgs_w > pgs_w ) {
-    if ( ftruncate(img_u->fid_i, pgs_w << (u3a_page + 2)) ) {
+  if ( ((c3_d)img_u->pgs_w << dsk_y) > ((c3_d)pgs_w << pag_y) ) {
+    if ( ftruncate(img_u->fid_i, (off_t)pgs_w << (pag_y + 2)) ) {
       fprintf(stderr, "loom: image (%s) truncate: %s\r\n",
                       img_u->nam_c,
                       strerror(errno));
@@ -748,76 +1562,78 @@ _ce_image_resize(u3e_image* img_u, c3_w pgs_w)
   img_u->pgs_w = pgs_w;
 }
 
+/* _ce_patch_place(): image and page offset for patch page [i_w].
+*/
+static c3_w
+_ce_patch_place(u3_ce_patch* pat_u, c3_w i_w, c3_i* fid_i)
+{
+  c3_w pag_w = pat_u->con_u->mem_u[i_w].pag_w;
+
+  if ( pag_w < pat_u->con_u->nor_w ) {
+    *fid_i = u3P.nor_u.fid_i;
+    return pag_w;
+  }
+  else {
+    *fid_i = u3P.sou_u.fid_i;
+    return ((u3C.wor_i >> pat_u->con_u->pag_y) - (pag_w + 1));
+  }
+}
+
 /* _ce_patch_apply(): apply patch to images.
 */
 static void
 _ce_patch_apply(u3_ce_patch* pat_u)
 {
-  ssize_t ret_i;
-  c3_w      i_w;
-
-  //  resize images
-  //
-  _ce_image_resize(&u3P.nor_u, pat_u->con_u->nor_w);
-  _ce_image_resize(&u3P.sou_u, pat_u->con_u->sou_w);
-
-  //  seek to begining of patch and images
+  c3_y   pag_y = pat_u->con_u->pag_y;
+  size_t siz_i = sizeof(c3_w) << pag_y;
+  c3_w   bat_w = c3_max(1, _ce_io_bytes / siz_i);
+  c3_w   pgs_w = pat_u->con_u->pgs_w;
+  c3_w*  buf_w = c3_malloc(bat_w * siz_i);
+  c3_w   i_w, j_w, len_w, run_w;
+
+  //  resize images; the patch may change their page size
   //
-  if (  (-1 == lseek(pat_u->mem_i, 0, SEEK_SET))
-     || (-1 == lseek(u3P.nor_u.fid_i, 0, SEEK_SET))
-     || (-1 == lseek(u3P.sou_u.fid_i, 0, SEEK_SET)) )
-  {
-    fprintf(stderr, "loom: patch apply seek 0: %s\r\n", strerror(errno));
-    c3_assert(0);
-  }
+  _ce_image_resize(&u3P.nor_u, pat_u->con_u->nor_w, pag_y);
+  _ce_image_resize(&u3P.sou_u, pat_u->con_u->sou_w, pag_y);
+  dsk_y = pag_y;
 
-  //  write patch pages into the appropriate image
+  //  read the patch in batches, writing runs of pages that are
+  //  adjacent in the same image with one call
   //
-  for ( i_w = 0; i_w < pat_u->con_u->pgs_w; i_w++ ) {
-    c3_w pag_w = pat_u->con_u->mem_u[i_w].pag_w;
-    c3_w mem_w[pag_wiz_i];
-    c3_i fid_i;
-    c3_w off_w;
-
-    if ( pag_w < pat_u->con_u->nor_w ) {
-      fid_i = u3P.nor_u.fid_i;
-      off_w = pag_w;
-    }
-    else {
-      fid_i = u3P.sou_u.fid_i;
-      off_w = (u3P.pag_w - (pag_w + 1));
-    }
+  for ( i_w = 0; i_w < pgs_w; i_w += len_w ) {
+    len_w = c3_min(bat_w, pgs_w - i_w);
 
-    if ( pag_siz_i != (ret_i = read(pat_u->mem_i, mem_w, pag_siz_i)) ) {
-      if ( 0 < ret_i ) {
-        fprintf(stderr, "loom: patch apply partial read: %zu\r\n",
-                        (size_t)ret_i);
-      }
-      else {
-        fprintf(stderr, "loom: patch apply read: %s\r\n", strerror(errno));
-      }
+    if ( c3n == _ce_read_at(pat_u->mem_i, buf_w, len_w * siz_i,
+                                          (off_t)i_w * siz_i) )
+    {
+      fprintf(stderr, "loom: patch apply read: %s\r\n", strerror(errno));
       c3_assert(0);
     }
-    else {
-      if ( -1 == lseek(fid_i, (off_w << (u3a_page + 2)), SEEK_SET) ) {
-        fprintf(stderr, "loom: patch apply seek: %s\r\n", strerror(errno));
-        c3_assert(0);
-      }
-      if ( pag_siz_i != (ret_i = write(fid_i, mem_w, pag_siz_i)) ) {
-        if ( 0 < ret_i ) {
-          fprintf(stderr, "loom: patch apply partial write: %zu\r\n",
-                          (size_t)ret_i);
-        }
-        else {
-          fprintf(stderr, "loom: patch apply write: %s\r\n", strerror(errno));
+
+    for ( j_w = 0; j_w < len_w; j_w += run_w ) {
+      c3_i fid_i;
+      c3_w off_w = _ce_patch_place(pat_u, i_w + j_w, &fid_i);
+
+      for ( run_w = 1; (j_w + run_w) < len_w; run_w++ ) {
+        c3_i fud_i;
+        c3_w ofe_w = _ce_patch_place(pat_u, i_w + j_w + run_w, &fud_i);
+
+        if ( (fud_i != fid_i) || (ofe_w != (off_w + run_w)) ) {
+          break;
         }
+      }
+
+      if ( c3n == _ce_write_at(fid_i, buf_w + (j_w << pag_y),
+                                      run_w * siz_i,
+                                      (off_t)off_w * siz_i) )
+      {
+        fprintf(stderr, "loom: patch apply write: %s\r\n", strerror(errno));
         c3_assert(0);
       }
     }
-#if 0
-    u3l_log("apply: %d, %x\n", pag_w, u3r_mug_words(mem_w, pag_wiz_i));
-#endif
   }
+
+  c3_free(buf_w);
 }
 
 /* _ce_image_blit(): apply image to memory.
@@ -833,7 +1649,11 @@ _ce_image_blit(u3e_image* img_u,
 
   ssize_t ret_i;
   c3_w      i_w;
-  c3_w    siz_w = pag_siz_i;
+  c3_w    siz_w = sizeof(c3_w) * (( 0 > stp_ws ) ? -stp_ws : stp_ws);
+
+  //  pages of another size are left dirty, to be saved at ours
+  //
+  c3_o    cln_o = ( siz_w == pag_siz_i ) ? c3y : c3n;
 
   if ( -1 == lseek(img_u->fid_i, 0, SEEK_SET) ) {
     fprintf(stderr, "loom: image (%s) blit seek 0: %s\r\n",
@@ -854,15 +1674,17 @@ _ce_image_blit(u3e_image* img_u,
       c3_assert(0);
     }
 
-    if ( 0 != mprotect(ptr_w, siz_w, PROT_READ) ) {
-      fprintf(stderr, "loom: live mprotect: %s\r\n", strerror(errno));
-      c3_assert(0);
-    }
+    if ( c3y == cln_o ) {
+      if ( 0 != mprotect(ptr_w, siz_w, PROT_READ) ) {
+        fprintf(stderr, "loom: live mprotect: %s\r\n", strerror(errno));
+        c3_assert(0);
+      }
 
-    c3_w pag_w = u3a_outa(ptr_w) >> u3a_page;
-    c3_w blk_w = pag_w >> 5;
-    c3_w bit_w = pag_w & 31;
-    u3P.dit_w[blk_w] &= ~(1 << bit_w);
+      c3_w pag_w = u3a_outa(ptr_w) >> u3P.pag_y;
+      c3_w blk_w = pag_w >> 5;
+      c3_w bit_w = pag_w & 31;
+      u3P.dit_w[blk_w] &= ~(1 << bit_w);
+    }
 
     ptr_w += stp_ws;
   }
@@ -903,7 +1725,7 @@ _ce_image_fine(u3e_image* img_u,
     fil_w = u3r_mug_words(buf_w, pag_wiz_i);
 
     if ( mem_w != fil_w ) {
-      c3_w pag_w = (ptr_w - u3_Loom) >> u3a_page;
+      c3_w pag_w = (ptr_w - u3_Loom) >> u3P.pag_y;
 
       fprintf(stderr, "loom: image (%s) mismatch: "
                       "page %d, mem_w %x, fil_w %x, K %x\r\n",
@@ -924,62 +1746,39 @@ _ce_image_fine(u3e_image* img_u,
 static c3_o
 _ce_image_copy(u3e_image* fom_u, u3e_image* tou_u)
 {
-  ssize_t ret_i;
-  c3_w      i_w;
+  c3_d  len_d = (c3_d)fom_u->pgs_w << (dsk_y + 2);
+  c3_d  off_d;
+  c3_y* buf_y;
+  c3_o  ret_o = c3y;
 
   //  resize images
   //
-  _ce_image_resize(tou_u, fom_u->pgs_w);
+  _ce_image_resize(tou_u, fom_u->pgs_w, dsk_y);
 
-  //  seek to begining of patch and images
+  //  copy pages into destination image, in batches
   //
-  if (  (-1 == lseek(fom_u->fid_i, 0, SEEK_SET))
-     || (-1 == lseek(tou_u->fid_i, 0, SEEK_SET)) )
-  {
-    fprintf(stderr, "loom: image (%s) copy seek: %s\r\n",
-                    fom_u->nam_c,
-                    strerror(errno));
-    return c3n;
-  }
+  buf_y = c3_malloc(_ce_io_bytes);
 
-  //  copy pages into destination image
-  //
-  for ( i_w = 0; i_w < fom_u->pgs_w; i_w++ ) {
-    c3_w mem_w[pag_wiz_i];
-    c3_w off_w = i_w;
+  for ( off_d = 0; off_d < len_d; off_d += _ce_io_bytes ) {
+    size_t siz_i = c3_min(_ce_io_bytes, len_d - off_d);
 
-    if ( pag_siz_i != (ret_i = read(fom_u->fid_i, mem_w, pag_siz_i)) ) {
-      if ( 0 < ret_i ) {
-        fprintf(stderr, "loom: image (%s) copy partial read: %zu\r\n",
-                        fom_u->nam_c, (size_t)ret_i);
-      }
-      else {
-        fprintf(stderr, "loom: image (%s) copy read: %s\r\n",
-                        fom_u->nam_c, strerror(errno));
-      }
-      return c3n;
+    if ( c3n == _ce_read_at(fom_u->fid_i, buf_y, siz_i, off_d) ) {
+      fprintf(stderr, "loom: image (%s) copy read: %s\r\n",
+                      fom_u->nam_c, strerror(errno));
+      ret_o = c3n;
+      break;
     }
-    else {
-      if ( -1 == lseek(tou_u->fid_i, (off_w << (u3a_page + 2)), SEEK_SET) ) {
-        fprintf(stderr, "loom: image (%s) copy seek: %s\r\n",
-                        tou_u->nam_c, strerror(errno));
-        return c3n;
-      }
-      if ( pag_siz_i != (ret_i = write(tou_u->fid_i, mem_w, pag_siz_i)) ) {
-        if ( 0 < ret_i ) {
-          fprintf(stderr, "loom: image (%s) copy partial write: %zu\r\n",
-                          tou_u->nam_c, (size_t)ret_i);
-        }
-        else {
-          fprintf(stderr, "loom: image (%s) copy write: %s\r\n",
-                          tou_u->nam_c, strerror(errno));
-        }
-        return c3n;
-      }
+
+    if ( c3n == _ce_write_at(tou_u->fid_i, buf_y, siz_i, off_d) ) {
+      fprintf(stderr, "loom: image (%s) copy write: %s\r\n",
+                      tou_u->nam_c, strerror(errno));
+      ret_o = c3n;
+      break;
     }
   }
 
-  return c3y;
+  c3_free(buf_y);
+  return ret_o;
 }
 
 /* _ce_backup();
@@ -991,6 +1790,7 @@ _ce_backup(void)
   u3e_image sop_u = { .nam_c = "south", .pgs_w = 0 };
   c3_i mod_i = O_RDWR | O_CREAT;
   c3_c ful_c[8193];
+  c3_c bhk_c[8193];
 
   snprintf(ful_c, 8192, "%s/.urb/bhk", u3P.dir_c);
 
@@ -1015,29 +1815,63 @@ _ce_backup(void)
     return;
   }
 
+  snprintf(bhk_c, 8192, "%s/.urb/bhk", u3P.dir_c);
+
   if (  (c3n == _ce_image_copy(&u3P.nor_u, &nop_u))
-     || (c3n == _ce_image_copy(&u3P.sou_u, &sop_u)) )
+     || (c3n == _ce_image_copy(&u3P.sou_u, &sop_u))
+     || (c3n == _ce_meta_write(bhk_c, dsk_y)) )
   {
 
     c3_unlink(ful_c);
     snprintf(ful_c, 8192, "%s/.urb/bhk/%s.bin", u3P.dir_c, nop_u.nam_c);
     c3_unlink(ful_c);
-    snprintf(ful_c, 8192, "%s/.urb/bhk", u3P.dir_c);
-    c3_rmdir(ful_c);
+    snprintf(ful_c, 8192, "%s/.urb/bhk/meta.bin", u3P.dir_c);
+    c3_unlink(ful_c);
+    c3_rmdir(bhk_c);
   }
 
   close(nop_u.fid_i);
   close(sop_u.fid_i);
 }
 
+/* _ce_patch_commit(): sync and verify patch, and apply it to images.
+*/
+static void
+_ce_patch_commit(u3_ce_patch* pat_u)
+{
+  // u3a_print_memory(stderr, "sync: save", 4096 * pat_u->con_u->pgs_w);
+
+  _ce_patch_sync(pat_u);
+
+  if ( c3n == _ce_patch_verify(pat_u) ) {
+    c3_assert(!"loom: save failed");
+  }
+
+  _ce_patch_apply(pat_u);
+}
+
+/* _ce_patch_finish(): sync images, delete patch, and back up images.
+*/
+static void
+_ce_patch_finish(u3_ce_patch* pat_u)
+{
+  _ce_image_sync(&u3P.nor_u);
+  _ce_image_sync(&u3P.sou_u);
+  _ce_meta_sync();
+  _ce_patch_free(pat_u);
+  _ce_patch_delete();
+
+  _ce_backup();
+}
+
 /*
   u3e_save(): save current changes.
 
   If we are in dry-run mode, do nothing.
 
-  First, call `_ce_patch_compose` to write all dirty pages to disk and
-  clear protection and dirty bits. If there were no dirty pages to write,
-  then we're done.
+  First, wait for any background save, then call `_ce_patch_compose` to
+  write all dirty pages to disk and clear protection and dirty bits. If
+  there were no dirty pages to write, then we're done.
 
   - Sync the patch files to disk.
   - Verify the patch (because why not?)
@@ -1045,33 +1879,25 @@ _ce_backup(void)
   - Sync the image file.
   - Delete the patchfile and free it.
 
-  Once we've written the dirty pages to disk (and have reset their dirty bits
-  and protection flags), we *could* handle the rest of the checkpointing
-  process in a separate thread, but we'd need to wait until that finishes
-  before we try to make another snapshot.
+  See u3e_save_async() to handle all but the first step in a separate
+  thread.
 */
 void
 u3e_save(void)
 {
   u3_ce_patch* pat_u;
 
+  u3e_wait();
+
   if ( u3C.wag_w & u3o_dryrun ) {
     return;
   }
 
-  if ( !(pat_u = _ce_patch_compose()) ) {
+  if ( !(pat_u = _ce_patch_compose(c3n)) ) {
     return;
   }
 
-  // u3a_print_memory(stderr, "sync: save", 4096 * pat_u->con_u->pgs_w);
-
-  _ce_patch_sync(pat_u);
-
-  if ( c3n == _ce_patch_verify(pat_u) ) {
-    c3_assert(!"loom: save failed");
-  }
-
-  _ce_patch_apply(pat_u);
+  _ce_patch_commit(pat_u);
 
 #ifdef U3_SNAPSHOT_VALIDATION
   {
@@ -1088,35 +1914,141 @@ u3e_save(void)
   }
 #endif
 
-  _ce_image_sync(&u3P.nor_u);
-  _ce_image_sync(&u3P.sou_u);
-  _ce_patch_free(pat_u);
-  _ce_patch_delete();
+  _ce_patch_finish(pat_u);
+}
 
-  _ce_backup();
+/* _ce_save_thread(): complete a captured save, off the main thread.
+*/
+static void*
+_ce_save_thread(void* ptr_v)
+{
+  u3_ce_patch* pat_u = ptr_v;
+
+  _ce_patch_dump(pat_u);
+  _ce_patch_commit(pat_u);
+  _ce_patch_finish(pat_u);
+
+  return 0;
 }
 
-/* u3e_live(): start the checkpointing system.
+/* u3e_save_async(): capture current changes, saving in the background.
+**
+**   Only copying dirty pages stalls the caller; the patch is written,
+**   synced and applied on a separate thread.  Falls back to u3e_save()
+**   where that isn't possible.
 */
-c3_o
-u3e_live(c3_o nuu_o, c3_c* dir_c)
+void
+u3e_save_async(void)
 {
-  //  require that our page size is a multiple of the system page size.
+#ifdef U3_SNAPSHOT_VALIDATION
+  //  validation compares images to the loom, which has since moved on
   //
+  u3e_save();
+#else
+  u3_ce_patch* pat_u;
+
+  u3e_wait();
+
+  if ( u3C.wag_w & u3o_dryrun ) {
+    return;
+  }
+
+  if ( !(pat_u = _ce_patch_compose(c3y)) ) {
+    return;
+  }
+
   {
-    size_t sys_i = sysconf(_SC_PAGESIZE);
+    c3_i ret_i = _ce_thread_spawn(&sav_u, _ce_save_thread, pat_u);
 
-    if ( pag_siz_i % sys_i ) {
-      fprintf(stderr, "loom: incompatible system page size (%zuKB)\r\n",
-                      sys_i >> 10);
-      exit(1);
+    if ( 0 != ret_i ) {
+      fprintf(stderr, "loom: save thread: %s\r\n", strerror(ret_i));
+      _ce_save_thread(pat_u);
+    }
+    else {
+      sav_o = c3y;
+    }
+  }
+#endif
+}
+
+/* u3e_wait(): wait for any background save to complete.
+*/
+void
+u3e_wait(void)
+{
+  if ( c3y == sav_o ) {
+    c3_i ret_i;
+
+    if ( 0 != (ret_i = pthread_join(sav_u, 0)) ) {
+      fprintf(stderr, "loom: save join: %s\r\n", strerror(ret_i));
+      c3_assert(0);
+    }
+
+    sav_o = c3n;
+  }
+}
+
+/* u3e_fork(): fork(2) a process with a private, copy-on-write loom.
+**
+**   Neither the userfaultfd nor its registrations survive in the child,
+**   so any snapshot pages not yet paged in are faulted in first (once).
+**   The child never saves.
+*/
+c3_i
+u3e_fork(void)
+{
+#ifdef U3_OS_mingw
+  errno = ENOSYS;
+  return -1;
+#else
+  c3_i pid_i;
+
+#ifdef U3_EVENTS_UFFD
+  if ( (-1 != uff_u.fid_i) && (c3n == uff_u.ful_o) ) {
+    c3_w sou_w = u3P.pag_w - uff_u.sou_w;
+    c3_w i_w;
+
+    for ( i_w = 0; i_w < uff_u.nor_w; i_w++ ) {
+      (void)*(volatile c3_w*)(u3_Loom + (i_w << u3P.pag_y));
+    }
+
+    for ( i_w = sou_w; i_w < u3P.pag_w; i_w++ ) {
+      (void)*(volatile c3_w*)(u3_Loom + (i_w << u3P.pag_y));
     }
+
+    uff_u.ful_o = c3y;
+  }
+#endif
+
+  if ( 0 == (pid_i = fork()) ) {
+#ifdef U3_EVENTS_UFFD
+    //  the userfaultfd still refers to the parent's address space
+    //
+    if ( -1 != uff_u.fid_i ) {
+      close(uff_u.fid_i);
+      uff_u.fid_i = -1;
+      uff_u.wip_o = c3n;
+    }
+#endif
+
+    //  a background save is the parent's, on a thread we don't have
+    //
+    sav_o = c3n;
+    u3C.wag_w |= u3o_dryrun;
   }
 
+  return pid_i;
+#endif
+}
+
+/* u3e_live(): start the checkpointing system.
+*/
+c3_o
+u3e_live(c3_o nuu_o, c3_c* dir_c)
+{
   u3P.dir_c = dir_c;
   u3P.nor_u.nam_c = "north";
   u3P.sou_u.nam_c = "south";
-  u3P.pag_w = u3C.wor_i >> u3a_page;
 
   //  XX review dryrun requirements, enable or remove
   //
@@ -1126,6 +2058,25 @@ u3e_live(c3_o nuu_o, c3_c* dir_c)
   } else
 #endif
   {
+    u3_ce_patch* pat_u;
+
+    /* Find the page size of the images: recorded in meta.bin (16KB if
+    ** absent), or that of a pending patch, which will rewrite them.
+    */
+    {
+      c3_o met_o = _ce_meta_read(&met_y);
+
+      dsk_y = ( met_y ) ? met_y : u3a_page;
+
+      if ( 0 != (pat_u = _ce_patch_open()) ) {
+        dsk_y = pat_u->con_u->pag_y;
+      }
+      else if ( c3n == met_o ) {
+        fprintf(stderr, "boot: image metadata failed\r\n");
+        exit(1);
+      }
+    }
+
     //  Open image files.
     //
     if ( (c3n == _ce_image_open(&u3P.nor_u)) ||
@@ -1135,39 +2086,83 @@ u3e_live(c3_o nuu_o, c3_c* dir_c)
       exit(1);
     }
     else {
-      u3_ce_patch* pat_u;
-
-      /* Load any patch files; apply them to images.
+      /* Apply any patch to the images.
       */
-      if ( 0 != (pat_u = _ce_patch_open()) ) {
+      if ( pat_u ) {
         _ce_patch_apply(pat_u);
         _ce_image_sync(&u3P.nor_u);
         _ce_image_sync(&u3P.sou_u);
+        _ce_meta_sync();
         _ce_patch_free(pat_u);
         _ce_patch_delete();
       }
 
       //  detect snapshots from a larger loom
       //
-      if ( (u3P.nor_u.pgs_w + u3P.sou_u.pgs_w + 1) >= u3a_pages ) {
+      if ( ((c3_d)(u3P.nor_u.pgs_w + u3P.sou_u.pgs_w + 1) << dsk_y)
+           >= u3C.wor_i )
+      {
         fprintf(stderr, "boot: snapshot too big for loom\r\n");
         exit(1);
       }
 
+      //  use the configured page size, or keep that of the images
+      //
+      _ce_page_size( u3C.pag_y ? u3C.pag_y : dsk_y );
+
+      if (  (dsk_y != u3P.pag_y)
+         && (u3P.nor_u.pgs_w || u3P.sou_u.pgs_w) )
+      {
+        u3l_log("loom: converting snapshot from %zuKB to %zuKB pages\r\n",
+                ((size_t)4 << dsk_y) >> 10,
+                pag_siz_i >> 10);
+      }
+
       //  mark all pages dirty (pages in the snapshot will be marked clean)
       //
       u3e_foul();
 
+#ifdef U3_EVENTS_UFFD
+      /* Map image files into memory on demand.
+      */
+      if (  (u3C.wag_w & u3o_userfault)
+         && (dsk_y == u3P.pag_y)
+         && (c3y == _ce_uffd_live()) )
+      {
+        _ce_image_lazy(&u3P.nor_u, 0, 1);
+        _ce_image_lazy(&u3P.sou_u, u3P.pag_w - 1, -1);
+
+        //  without write-protection, track writes with SIGSEGV
+        //
+        if ( c3n == uff_u.wip_o ) {
+          c3_w sou_w = u3P.pag_w - u3P.sou_u.pgs_w;
+
+          if (  (0 != mprotect(u3_Loom,
+                               u3P.nor_u.pgs_w * pag_siz_i,
+                               PROT_READ))
+             || (0 != mprotect(u3_Loom + (sou_w << u3P.pag_y),
+                               u3P.sou_u.pgs_w * pag_siz_i,
+                               PROT_READ)) )
+          {
+            fprintf(stderr, "loom: live mprotect: %s\r\n", strerror(errno));
+            c3_assert(0);
+          }
+        }
+      }
+      else
+#endif
       /* Write image files to memory; reinstate protection.
       */
       {
+        c3_ws dsk_ws = (c3_ws)1 << dsk_y;
+
         _ce_image_blit(&u3P.nor_u,
                        u3_Loom,
-                       pag_wiz_i);
+                       dsk_ws);
 
         _ce_image_blit(&u3P.sou_u,
-                       (u3_Loom + u3C.wor_i) - pag_wiz_i,
-                       -(ssize_t)pag_wiz_i);
+                       (u3_Loom + u3C.wor_i) - dsk_ws,
+                       -dsk_ws);
 
         u3l_log("boot: protected loom\r\n");
       }
@@ -1180,7 +2175,7 @@ u3e_live(c3_o nuu_o, c3_c* dir_c)
       }
       else {
         u3a_print_memory(stderr, "live: loaded",
-                         (u3P.nor_u.pgs_w + u3P.sou_u.pgs_w) << u3a_page);
+                         (u3P.nor_u.pgs_w + u3P.sou_u.pgs_w) << dsk_y);
       }
     }
   }
@@ -1205,6 +2200,21 @@ u3e_yolo(void)
     return c3n;
   }
 
+#ifdef U3_EVENTS_UFFD
+  if ( c3y == uff_u.wip_o ) {
+    struct uffdio_writeprotect wip_u = {
+      .range = { .start = (c3_d)(c3_p)u3_Loom,
+                 .len   = (c3_d)u3P.pag_w * pag_siz_i },
+      .mode  = 0
+    };
+
+    if ( -1 == ioctl(uff_u.fid_i, UFFDIO_WRITEPROTECT, &wip_u) ) {
+      fprintf(stderr, "loom: yolo: %s\r\n", strerror(errno));
+      return c3n;
+    }
+  }
+#endif
+
   if ( 0 != mprotect(u3a_into(gar_pag_p), pag_siz_i, PROT_NONE) ) {
     fprintf(stderr, "loom: failed to protect guard page: %s\r\n",
                     strerror(errno));
@@ -1227,7 +2237,9 @@ u3e_foul(void)
 void
 u3e_init(void)
 {
-  u3P.pag_w = u3C.wor_i >> u3a_page;
+  if ( !u3P.pag_y ) {
+    _ce_page_size( u3C.pag_y ? u3C.pag_y : u3a_page );
+  }
 
 #ifdef U3_GUARD_PAGE
   _ce_center_guard_page();
@@ -12,11 +12,18 @@
 #define BIT_SET(a_w, b_w) (a_w & (1 << b_w))
 
 static c3_o
-_ch_trim_slot(u3h_root* har_u, u3h_slot *sot_w, c3_w lef_w, c3_w rem_w);
+_ch_trim_slot(u3h_root* har_u,
+              u3h_slot* sot_w,
+              c3_w      lef_w,
+              c3_w      rem_w,
+              c3_o    (*fun_f)(u3_noun));
 
 c3_w
 _ch_skip_slot(c3_w mug_w, c3_w lef_w);
 
+static c3_o
+_ch_trim_kev(u3h_slot *sot_w, c3_o (*fun_f)(u3_noun));
+
 /* u3h_new_cache(): create hashtable with bounded size.
 */
 u3p(u3h_root)
@@ -45,6 +52,333 @@ u3h_new(void)
   return u3h_new_cache(0);
 }
 
+/* _ch_flat_lines(): flat table lines.
+*/
+static u3h_line*
+_ch_flat_lines(u3h_flat* fla_u)
+{
+  return (u3h_line*)((c3_w*)u3a_into(fla_u->lin_p) + fla_u->off_w);
+}
+
+/* _ch_flat_alloc(): allocate 2^bit_w zeroed lines, aligned to a line.
+*/
+static void
+_ch_flat_alloc(c3_w bit_w, u3_post* lin_p, c3_w* off_w)
+{
+  c3_w    len_w = c3_wiseof(u3h_line) << bit_w;
+  c3_w*   all_w = u3a_walloc(len_w + c3_wiseof(u3h_line) - 1);
+  u3_post all_p = u3a_outa(all_w);
+
+  *lin_p = all_p;
+  *off_w = ( c3_wiseof(u3h_line) - (all_p % c3_wiseof(u3h_line)) )
+           % c3_wiseof(u3h_line);
+
+  memset(all_w + *off_w, 0, len_w << 2);
+}
+
+/* u3h_new_flat(): create hashtable with flat layout, bounded
+**                 by [max_w] entries (0 for unbounded).
+*/
+u3p(u3h_root)
+u3h_new_flat(c3_w max_w)
+{
+  u3h_flat*     fla_u = u3a_walloc(c3_wiseof(u3h_flat));
+  u3p(u3h_root) har_p = u3of(u3h_flat, fla_u);
+
+  c3_assert( !(max_w & u3h_flat_bit) );
+
+  fla_u->max_w = u3h_flat_bit | max_w;
+  fla_u->use_w = 0;
+  fla_u->del_w = 0;
+  fla_u->bit_w = 1;
+  fla_u->arm_w = 0;
+
+  _ch_flat_alloc(fla_u->bit_w, &fla_u->lin_p, &fla_u->off_w);
+
+  return har_p;
+}
+
+/* _ch_is_flat(): yes if hashtable has flat layout.
+*/
+static c3_o
+_ch_is_flat(u3h_root* har_u)
+{
+  return __(har_u->max_w & u3h_flat_bit);
+}
+
+/* _ch_flat_find(): find entry for [key] in flat table.
+*/
+static c3_o
+_ch_flat_find(u3h_flat*  fla_u,
+              u3_noun      key,
+              c3_w       mug_w,
+              u3h_line** lin_u,
+              c3_w*      inx_w)
+{
+  u3h_line* lan_u = _ch_flat_lines(fla_u);
+  c3_w      msk_w = (1 << fla_u->bit_w) - 1;
+  c3_w      lin_w = mug_w & msk_w;
+  c3_w      i_w, n_w;
+
+  for ( n_w = 0; n_w <= msk_w; n_w++ ) {
+    u3h_line* lon_u = &(lan_u[lin_w]);
+    c3_o      emp_o = c3n;
+
+    //  a line that has been full may overflow into the next
+    //
+    if ( lon_u->mug_w[u3h_line_len - 1] ) {
+      __builtin_prefetch(&(lan_u[(lin_w + 1) & msk_w]));
+    }
+
+    for ( i_w = 0; i_w < u3h_line_len; i_w++ ) {
+      c3_w hug_w = lon_u->mug_w[i_w];
+
+      if ( mug_w == hug_w ) {
+        u3_noun kev = u3h_slot_to_noun(lon_u->sot_w[i_w]);
+
+        if ( c3y == u3r_sing(key, u3h(kev)) ) {
+          *lin_u = lon_u;
+          *inx_w = i_w;
+          return c3y;
+        }
+      }
+      else if ( 0 == hug_w ) {
+        emp_o = c3y;
+      }
+    }
+
+    //  no entry was ever placed past a line with empty space
+    //
+    if ( c3y == emp_o ) {
+      return c3n;
+    }
+
+    lin_w = (lin_w + 1) & msk_w;
+  }
+
+  return c3n;
+}
+
+/* _ch_flat_seat(): find a free entry for [mug_w] in lines.
+*/
+static void
+_ch_flat_seat(u3h_line*  lan_u,
+              c3_w       bit_w,
+              c3_w       mug_w,
+              u3h_line** lin_u,
+              c3_w*      inx_w)
+{
+  c3_w msk_w = (1 << bit_w) - 1;
+  c3_w lin_w = mug_w & msk_w;
+  c3_w i_w;
+
+  while ( 1 ) {
+    u3h_line* lon_u = &(lan_u[lin_w]);
+
+    for ( i_w = 0; i_w < u3h_line_len; i_w++ ) {
+      c3_w hug_w = lon_u->mug_w[i_w];
+
+      if ( (0 == hug_w) || (u3h_flat_dead == hug_w) ) {
+        *lin_u = lon_u;
+        *inx_w = i_w;
+        return;
+      }
+    }
+
+    lin_w = (lin_w + 1) & msk_w;
+  }
+}
+
+/* _ch_flat_grow(): rehash, doubling if more than 3/8 full.
+*/
+static void
+_ch_flat_grow(u3h_flat* fla_u)
+{
+  c3_w      cap_w = u3h_line_len << fla_u->bit_w;
+  c3_w      bit_w = ( (8 * (fla_u->use_w + 1)) > (3 * cap_w) )
+                    ? (fla_u->bit_w + 1)
+                    : fla_u->bit_w;
+  u3_post   lin_p;
+  c3_w      off_w;
+
+  //  allocate first: reclamation may trim this very table
+  //
+  _ch_flat_alloc(bit_w, &lin_p, &off_w);
+
+  {
+    u3h_line* lan_u = _ch_flat_lines(fla_u);
+    u3h_line* nal_u = (u3h_line*)((c3_w*)u3a_into(lin_p) + off_w);
+    c3_w      len_w = 1 << fla_u->bit_w;
+    c3_w      i_w, j_w;
+
+    for ( i_w = 0; i_w < len_w; i_w++ ) {
+      u3h_line* lon_u = &(lan_u[i_w]);
+
+      for ( j_w = 0; j_w < u3h_line_len; j_w++ ) {
+        c3_w hug_w = lon_u->mug_w[j_w];
+
+        if ( (0 != hug_w) && (u3h_flat_dead != hug_w) ) {
+          u3h_line* nol_u;
+          c3_w      inx_w;
+
+          _ch_flat_seat(nal_u, bit_w, hug_w, &nol_u, &inx_w);
+          nol_u->mug_w[inx_w] = hug_w;
+          nol_u->sot_w[inx_w] = lon_u->sot_w[j_w];
+        }
+      }
+    }
+  }
+
+  u3a_wfree(u3a_into(fla_u->lin_p));
+
+  fla_u->lin_p = lin_p;
+  fla_u->off_w = off_w;
+  fla_u->bit_w = bit_w;
+  fla_u->del_w = 0;
+  fla_u->arm_w = 0;
+}
+
+/* _ch_flat_trim(): trim flat table to [n_w] entries, by clock.
+*/
+static void
+_ch_flat_trim(u3h_flat* fla_u, c3_w n_w, c3_o (*fun_f)(u3_noun))
+{
+  u3h_line* lan_u = _ch_flat_lines(fla_u);
+  c3_w      msk_w = (u3h_line_len << fla_u->bit_w) - 1;
+
+  while ( fla_u->use_w > n_w ) {
+    c3_w      arm_w = fla_u->arm_w;
+    u3h_line* lon_u = &(lan_u[arm_w / u3h_line_len]);
+    c3_w      inx_w = arm_w % u3h_line_len;
+    c3_w      hug_w = lon_u->mug_w[inx_w];
+
+    fla_u->arm_w = (arm_w + 1) & msk_w;
+
+    if (  (0 != hug_w)
+       && (u3h_flat_dead != hug_w)
+       && (c3y == _ch_trim_kev(&(lon_u->sot_w[inx_w]), fun_f)) )
+    {
+      lon_u->mug_w[inx_w] = u3h_flat_dead;
+      fla_u->use_w -= 1;
+      fla_u->del_w += 1;
+    }
+  }
+}
+
+/* _ch_flat_put(): insert in flat table.
+*/
+static void
+_ch_flat_put(u3h_flat* fla_u,
+             u3_noun     key,
+             u3_noun     val,
+             c3_o      (*fun_f)(u3_noun))
+{
+  u3_noun   kev   = u3nc(u3k(key), val);
+  c3_w      mug_w = u3r_mug(key);
+  c3_w      max_w = fla_u->max_w & ~u3h_flat_bit;
+  u3h_line* lin_u;
+  c3_w      inx_w;
+
+  if ( c3y == _ch_flat_find(fla_u, key, mug_w, &lin_u, &inx_w) ) {
+    u3z(u3h_slot_to_noun(lin_u->sot_w[inx_w]));
+    lin_u->sot_w[inx_w] = u3h_noun_to_slot(kev);
+    return;
+  }
+
+  //  keep at most 3/4 of entries in use (or deleted)
+  //
+  if ( (4 * (fla_u->use_w + fla_u->del_w + 1))
+       > (3 * (u3h_line_len << fla_u->bit_w)) )
+  {
+    _ch_flat_grow(fla_u);
+  }
+
+  _ch_flat_seat(_ch_flat_lines(fla_u), fla_u->bit_w, mug_w, &lin_u, &inx_w);
+
+  if ( u3h_flat_dead == lin_u->mug_w[inx_w] ) {
+    fla_u->del_w -= 1;
+  }
+
+  lin_u->mug_w[inx_w] = mug_w;
+  lin_u->sot_w[inx_w] = u3h_noun_to_slot(kev);
+  fla_u->use_w += 1;
+
+  if ( max_w > 0 ) {
+    _ch_flat_trim(fla_u, max_w, fun_f);
+  }
+}
+
+/* _ch_flat_git(): read from flat table, warming entry.
+*/
+static u3_weak
+_ch_flat_git(u3h_flat* fla_u, u3_noun key)
+{
+  u3h_line* lin_u;
+  c3_w      inx_w;
+
+  if ( c3n == _ch_flat_find(fla_u, key, u3r_mug(key), &lin_u, &inx_w) ) {
+    return u3_none;
+  }
+
+  lin_u->sot_w[inx_w] = u3h_noun_be_warm(lin_u->sot_w[inx_w]);
+  return u3t(u3h_slot_to_noun(lin_u->sot_w[inx_w]));
+}
+
+/* _ch_flat_hum(): check presence of [mug_w] in flat table.
+*/
+static c3_o
+_ch_flat_hum(u3h_flat* fla_u, c3_w mug_w)
+{
+  u3h_line* lan_u = _ch_flat_lines(fla_u);
+  c3_w      msk_w = (1 << fla_u->bit_w) - 1;
+  c3_w      lin_w = mug_w & msk_w;
+  c3_w      i_w, n_w;
+
+  for ( n_w = 0; n_w <= msk_w; n_w++ ) {
+    u3h_line* lon_u = &(lan_u[lin_w]);
+    c3_o      emp_o = c3n;
+
+    for ( i_w = 0; i_w < u3h_line_len; i_w++ ) {
+      if ( mug_w == lon_u->mug_w[i_w] ) {
+        return c3y;
+      }
+      else if ( 0 == lon_u->mug_w[i_w] ) {
+        emp_o = c3y;
+      }
+    }
+
+    if ( c3y == emp_o ) {
+      return c3n;
+    }
+
+    lin_w = (lin_w + 1) & msk_w;
+  }
+
+  return c3n;
+}
+
+/* _ch_flat_walk(): traverse flat table, calling [fun_f] on entry slots.
+*/
+static void
+_ch_flat_walk(u3h_flat* fla_u, void (*fun_f)(u3h_slot*, void*), void* wit)
+{
+  u3h_line* lan_u = _ch_flat_lines(fla_u);
+  c3_w      len_w = 1 << fla_u->bit_w;
+  c3_w      i_w, j_w;
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    u3h_line* lon_u = &(lan_u[i_w]);
+
+    for ( j_w = 0; j_w < u3h_line_len; j_w++ ) {
+      c3_w hug_w = lon_u->mug_w[j_w];
+
+      if ( (0 != hug_w) && (u3h_flat_dead != hug_w) ) {
+        fun_f(&(lon_u->sot_w[j_w]), wit);
+      }
+    }
+  }
+}
+
 /* _ch_popcount(): number of bits set in word.  A standard intrinsic.
 */
 static c3_w
@@ -239,14 +573,23 @@ _ch_slot_put(u3h_slot* sot_w, u3_noun kev, c3_w lef_w, c3_w rem_w, c3_w* use_w)
   }
 }
 
-/* u3h_put(): insert in hashtable.
+/* u3h_put_with(): insert in hashtable, trimming with [fun_f].
 **
 ** `key` is RETAINED; `val` is transferred.
 */
 void
-u3h_put(u3p(u3h_root) har_p, u3_noun key, u3_noun val)
+u3h_put_with(u3p(u3h_root) har_p,
+             u3_noun       key,
+             u3_noun       val,
+             c3_o        (*fun_f)(u3_noun))
 {
   u3h_root* har_u = u3to(u3h_root, har_p);
+
+  if ( c3y == _ch_is_flat(har_u) ) {
+    _ch_flat_put((u3h_flat*)har_u, key, val, fun_f);
+    return;
+  }
+
   u3_noun   kev   = u3nc(u3k(key), val);
   c3_w      mug_w = u3r_mug(key);
   c3_w      inx_w = (mug_w >> 25);  //  6 bits
@@ -262,10 +605,20 @@ u3h_put(u3p(u3h_root) har_p, u3_noun key, u3_noun val)
   }
 
   if ( har_u->max_w > 0 ) {
-    u3h_trim_to(har_p, har_u->max_w);
+    u3h_trim_with(har_p, har_u->max_w, fun_f);
   }
 }
 
+/* u3h_put(): insert in hashtable.
+**
+** `key` is RETAINED; `val` is transferred.
+*/
+void
+u3h_put(u3p(u3h_root) har_p, u3_noun key, u3_noun val)
+{
+  u3h_put_with(har_p, key, val, 0);
+}
+
 /* _ch_uni_with(): key/value callback, put into [*wit]
 */
 static void
@@ -289,7 +642,11 @@ u3h_uni(u3p(u3h_root) har_p, u3p(u3h_root) rah_p)
 /* _ch_trim_node(): trim one entry from a node slot or its children
 */
 static c3_o
-_ch_trim_node(u3h_root* har_u, u3h_slot* sot_w, c3_w lef_w, c3_w rem_w)
+_ch_trim_node(u3h_root* har_u,
+              u3h_slot* sot_w,
+              c3_w      lef_w,
+              c3_w      rem_w,
+              c3_o    (*fun_f)(u3_noun))
 {
   c3_w bit_w, map_w, inx_w;
   u3h_slot* tos_w;
@@ -308,7 +665,7 @@ _ch_trim_node(u3h_root* har_u, u3h_slot* sot_w, c3_w lef_w, c3_w rem_w)
   inx_w = _ch_popcount(CUT_END(map_w, bit_w));
   tos_w = &(han_u->sot_w[inx_w]);
 
-  if ( c3n == _ch_trim_slot(har_u, tos_w, lef_w, rem_w) ) {
+  if ( c3n == _ch_trim_slot(har_u, tos_w, lef_w, rem_w, fun_f) ) {
     // nothing trimmed
     return c3n;
   }
@@ -343,14 +700,19 @@ _ch_trim_node(u3h_root* har_u, u3h_slot* sot_w, c3_w lef_w, c3_w rem_w)
 }
 
 /* _ch_trim_kev(): trim a single entry slot
+**
+**   a cold entry is spared (and left cold) if [fun_f] produces yes.
 */
 static c3_o
-_ch_trim_kev(u3h_slot *sot_w)
+_ch_trim_kev(u3h_slot *sot_w, c3_o (*fun_f)(u3_noun))
 {
   if ( _(u3h_slot_is_warm(*sot_w)) ) {
     *sot_w = u3h_noun_be_cold(*sot_w);
     return c3n;
   }
+  else if ( fun_f && (c3y == fun_f(u3h_slot_to_noun(*sot_w))) ) {
+    return c3n;
+  }
   else {
     u3_noun kev = u3h_slot_to_noun(*sot_w);
     *sot_w = 0;
@@ -362,7 +724,7 @@ _ch_trim_kev(u3h_slot *sot_w)
 /* _ch_trim_node(): trim one entry from a bucket slot
 */
 static c3_o
-_ch_trim_buck(u3h_root* har_u, u3h_slot* sot_w)
+_ch_trim_buck(u3h_root* har_u, u3h_slot* sot_w, c3_o (*fun_f)(u3_noun))
 {
   c3_w i_w, len_w;
   u3h_buck* hab_u = u3h_slot_to_node(*sot_w);
@@ -371,7 +733,7 @@ _ch_trim_buck(u3h_root* har_u, u3h_slot* sot_w)
         har_u->arm_u.inx_w < len_w;
         har_u->arm_u.inx_w += 1 )
   {
-    if ( c3y == _ch_trim_kev(&(hab_u->sot_w[har_u->arm_u.inx_w])) ) {
+    if ( c3y == _ch_trim_kev(&(hab_u->sot_w[har_u->arm_u.inx_w]), fun_f) ) {
       if ( 2 == len_w ) {
         // 2 things in bucket: debucketize to key-value pair, the next
         // run will point at this pair (same mug_w, no longer in bucket)
@@ -401,13 +763,17 @@ _ch_trim_buck(u3h_root* har_u, u3h_slot* sot_w)
 /* _ch_trim_some(): trim one entry from a bucket or node slot
 */
 static c3_o
-_ch_trim_some(u3h_root* har_u, u3h_slot* sot_w, c3_w lef_w, c3_w rem_w)
+_ch_trim_some(u3h_root* har_u,
+              u3h_slot* sot_w,
+              c3_w      lef_w,
+              c3_w      rem_w,
+              c3_o    (*fun_f)(u3_noun))
 {
   if ( 0 == lef_w ) {
-    return _ch_trim_buck(har_u, sot_w);
+    return _ch_trim_buck(har_u, sot_w, fun_f);
   }
   else {
-    return _ch_trim_node(har_u, sot_w, lef_w, rem_w);
+    return _ch_trim_node(har_u, sot_w, lef_w, rem_w, fun_f);
   }
 }
 
@@ -424,21 +790,25 @@ _ch_skip_slot(c3_w mug_w, c3_w lef_w)
 /* _ch_trim_slot(): trim one entry from a non-bucket slot
 */
 static c3_o
-_ch_trim_slot(u3h_root* har_u, u3h_slot *sot_w, c3_w lef_w, c3_w rem_w)
+_ch_trim_slot(u3h_root* har_u,
+              u3h_slot* sot_w,
+              c3_w      lef_w,
+              c3_w      rem_w,
+              c3_o    (*fun_f)(u3_noun))
 {
   if ( c3y == u3h_slot_is_noun(*sot_w) ) {
     har_u->arm_u.mug_w = _ch_skip_slot(har_u->arm_u.mug_w, lef_w);
-    return _ch_trim_kev(sot_w);
+    return _ch_trim_kev(sot_w, fun_f);
   }
   else {
-    return _ch_trim_some(har_u, sot_w, lef_w, rem_w);
+    return _ch_trim_some(har_u, sot_w, lef_w, rem_w, fun_f);
   }
 }
 
 /* _ch_trim_root(): trim one entry from a hashtable
 */
 static c3_o
-_ch_trim_root(u3h_root* har_u)
+_ch_trim_root(u3h_root* har_u, c3_o (*fun_f)(u3_noun))
 {
   c3_w      mug_w = har_u->arm_u.mug_w;
   c3_w      inx_w = mug_w >> 25; // 6 bits
@@ -449,23 +819,37 @@ _ch_trim_root(u3h_root* har_u)
     return c3n;
   }
 
-  return _ch_trim_slot(har_u, sot_w, 25, CUT_END(mug_w, 25));
+  return _ch_trim_slot(har_u, sot_w, 25, CUT_END(mug_w, 25), fun_f);
 }
 
-/* u3h_trim_to(): trim to n key-value pairs
+/* u3h_trim_with(): trim to n key-value pairs, sparing cold entries
+**                  for which [fun_f] produces yes.
 */
 void
-u3h_trim_to(u3p(u3h_root) har_p, c3_w n_w)
+u3h_trim_with(u3p(u3h_root) har_p, c3_w n_w, c3_o (*fun_f)(u3_noun))
 {
   u3h_root* har_u = u3to(u3h_root, har_p);
 
+  if ( c3y == _ch_is_flat(har_u) ) {
+    _ch_flat_trim((u3h_flat*)har_u, n_w, fun_f);
+    return;
+  }
+
   while ( har_u->use_w > n_w ) {
-    if ( c3y == _ch_trim_root(har_u) ) {
+    if ( c3y == _ch_trim_root(har_u, fun_f) ) {
       har_u->use_w -= 1;
     }
   }
 }
 
+/* u3h_trim_to(): trim to n key-value pairs
+*/
+void
+u3h_trim_to(u3p(u3h_root) har_p, c3_w n_w)
+{
+  u3h_trim_with(har_p, n_w, 0);
+}
+
 /* _ch_buck_hum(): read in bucket.
 */
 static c3_o
@@ -529,6 +913,11 @@ c3_o
 u3h_hum(u3p(u3h_root) har_p, c3_w mug_w)
 {
   u3h_root* har_u = u3to(u3h_root, har_p);
+
+  if ( c3y == _ch_is_flat(har_u) ) {
+    return _ch_flat_hum((u3h_flat*)har_u, mug_w);
+  }
+
   c3_w      inx_w = (mug_w >> 25);
   c3_w      rem_w = CUT_END(mug_w, 25);
   c3_w      sot_w = har_u->sot_w[inx_w];
@@ -563,6 +952,7 @@ _ch_buck_git(u3h_buck* hab_u, u3_noun key)
   for ( i_w = 0; i_w < hab_u->len_w; i_w++ ) {
     u3_noun kev = u3h_slot_to_noun(hab_u->sot_w[i_w]);
     if ( _(u3r_sing(key, u3h(kev))) ) {
+      hab_u->sot_w[i_w] = u3h_noun_be_warm(hab_u->sot_w[i_w]);
       return u3t(kev);
     }
   }
@@ -592,6 +982,7 @@ _ch_node_git(u3h_node* han_u, c3_w lef_w, c3_w rem_w, u3_noun key)
       u3_noun kev = u3h_slot_to_noun(sot_w);
 
       if ( _(u3r_sing(key, u3h(kev))) ) {
+        han_u->sot_w[inx_w] = u3h_noun_be_warm(sot_w);
         return u3t(kev);
       }
       else {
@@ -617,6 +1008,11 @@ u3_weak
 u3h_git(u3p(u3h_root) har_p, u3_noun key)
 {
   u3h_root* har_u = u3to(u3h_root, har_p);
+
+  if ( c3y == _ch_is_flat(har_u) ) {
+    return _ch_flat_git((u3h_flat*)har_u, key);
+  }
+
   c3_w      mug_w = u3r_mug(key);
   c3_w      inx_w = (mug_w >> 25);
   c3_w      rem_w = CUT_END(mug_w, 25);
@@ -700,6 +1096,14 @@ _ch_free_node(u3h_node* han_u, c3_w lef_w)
   u3a_wfree(han_u);
 }
 
+/* _ch_flat_free_slot(): free entry in flat table.
+*/
+static void
+_ch_flat_free_slot(u3h_slot* sot_w, void* wit)
+{
+  u3z(u3h_slot_to_noun(*sot_w));
+}
+
 /* u3h_free(): free hashtable.
 */
 void
@@ -708,6 +1112,15 @@ u3h_free(u3p(u3h_root) har_p)
   u3h_root* har_u = u3to(u3h_root, har_p);
   c3_w        i_w;
 
+  if ( c3y == _ch_is_flat(har_u) ) {
+    u3h_flat* fla_u = (u3h_flat*)har_u;
+
+    _ch_flat_walk(fla_u, _ch_flat_free_slot, 0);
+    u3a_wfree(u3a_into(fla_u->lin_p));
+    u3a_wfree(fla_u);
+    return;
+  }
+
   for ( i_w = 0; i_w < 64; i_w++ ) {
     c3_w sot_w = har_u->sot_w[i_w];
 
@@ -765,6 +1178,22 @@ _ch_walk_node(u3h_node* han_u, c3_w lef_w, void (*fun_f)(u3_noun, void*), void*
   }
 }
 
+/* _ch_flat_walk_with: flat table traversal state.
+*/
+struct _ch_flat_walk_with {
+  void (*fun_f)(u3_noun, void*);
+  void*  wit;
+};
+
+/* _ch_flat_walk_slot(): traverse entry in flat table.
+*/
+static void
+_ch_flat_walk_slot(u3h_slot* sot_w, void* wit)
+{
+  struct _ch_flat_walk_with* wal_u = wit;
+  wal_u->fun_f(u3h_slot_to_noun(*sot_w), wal_u->wit);
+}
+
 /* u3h_walk_with(): traverse hashtable with key, value fn and data
  *                  argument; RETAINS.
 */
@@ -776,6 +1205,12 @@ u3h_walk_with(u3p(u3h_root) har_p,
   u3h_root* har_u = u3to(u3h_root, har_p);
   c3_w        i_w;
 
+  if ( c3y == _ch_is_flat(har_u) ) {
+    struct _ch_flat_walk_with wal_u = { fun_f, wit };
+    _ch_flat_walk((u3h_flat*)har_u, _ch_flat_walk_slot, &wal_u);
+    return;
+  }
+
   for ( i_w = 0; i_w < 64; i_w++ ) {
     c3_w sot_w = har_u->sot_w[i_w];
 
@@ -862,6 +1297,42 @@ _ch_take_node(u3h_slot sot_w, c3_w lef_w, u3_funk fun_f)
   return u3h_node_to_slot(nah_u);
 }
 
+/* _ch_flat_take(): gain flat table, copying junior keys
+** and calling [fun_f] on values
+*/
+static u3p(u3h_root)
+_ch_flat_take(u3h_flat* fla_u, u3_funk fun_f)
+{
+  u3h_flat*     alf_u = u3a_walloc(c3_wiseof(u3h_flat));
+  u3p(u3h_root) rah_p = u3of(u3h_flat, alf_u);
+  c3_w          len_w = 1 << fla_u->bit_w;
+  u3h_line*     lan_u;
+  u3h_line*     nal_u;
+  c3_w          i_w, j_w;
+
+  *alf_u = *fla_u;
+  _ch_flat_alloc(alf_u->bit_w, &alf_u->lin_p, &alf_u->off_w);
+
+  lan_u = _ch_flat_lines(fla_u);
+  nal_u = _ch_flat_lines(alf_u);
+
+  //  preserve positions, including deleted entries, to keep probe chains
+  //
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    for ( j_w = 0; j_w < u3h_line_len; j_w++ ) {
+      c3_w hug_w = lan_u[i_w].mug_w[j_w];
+
+      nal_u[i_w].mug_w[j_w] = hug_w;
+
+      if ( (0 != hug_w) && (u3h_flat_dead != hug_w) ) {
+        nal_u[i_w].sot_w[j_w] = _ch_take_noun(lan_u[i_w].sot_w[j_w], fun_f);
+      }
+    }
+  }
+
+  return rah_p;
+}
+
 /* u3h_take_with(): gain hashtable, copying junior keys
 ** and calling [fun_f] on values
 */
@@ -869,6 +1340,11 @@ u3p(u3h_root)
 u3h_take_with(u3p(u3h_root) har_p, u3_funk fun_f)
 {
   u3h_root*     har_u = u3to(u3h_root, har_p);
+
+  if ( c3y == _ch_is_flat(har_u) ) {
+    return _ch_flat_take((u3h_flat*)har_u, fun_f);
+  }
+
   u3p(u3h_root) rah_p = u3h_new_cache(har_u->max_w);
   u3h_root*     rah_u = u3to(u3h_root, rah_p);
   c3_w            i_w;
@@ -945,6 +1421,15 @@ _ch_mark_node(u3h_node* han_u, c3_w lef_w)
   return tot_w;
 }
 
+/* _ch_flat_mark_slot(): mark entry in flat table.
+*/
+static void
+_ch_flat_mark_slot(u3h_slot* sot_w, void* wit)
+{
+  c3_w* tot_w = wit;
+  *tot_w += u3a_mark_noun(u3h_slot_to_noun(*sot_w));
+}
+
 /* u3h_mark(): mark hashtable for gc.
 */
 c3_w
@@ -954,6 +1439,15 @@ u3h_mark(u3p(u3h_root) har_p)
   u3h_root* har_u = u3to(u3h_root, har_p);
   c3_w        i_w;
 
+  if ( c3y == _ch_is_flat(har_u) ) {
+    u3h_flat* fla_u = (u3h_flat*)har_u;
+
+    _ch_flat_walk(fla_u, _ch_flat_mark_slot, &tot_w);
+    tot_w += u3a_mark_ptr(u3a_into(fla_u->lin_p));
+    tot_w += u3a_mark_ptr(fla_u);
+    return tot_w;
+  }
+
   for ( i_w = 0; i_w < 64; i_w++ ) {
     c3_w sot_w = har_u->sot_w[i_w];
 
@@ -1024,6 +1518,17 @@ _ch_rewrite_node(u3h_node* han_u, c3_w lef_w)
   }
 }
 
+/* _ch_flat_rewrite_slot(): rewrite entry in flat table.
+*/
+static void
+_ch_flat_rewrite_slot(u3h_slot* sot_w, void* wit)
+{
+  u3_noun kev = u3h_slot_to_noun(*sot_w);
+  *sot_w = u3h_noun_to_slot(u3a_rewritten_noun(kev));
+
+  u3a_rewrite_noun(kev);
+}
+
 /* u3h_rewrite(): rewrite pointers during compaction.
 */
 void
@@ -1034,6 +1539,18 @@ u3h_rewrite(u3p(u3h_root) har_p)
 
   if ( c3n == u3a_rewrite_ptr(har_u) ) return;
 
+  //  NB: lines keep their offset into the allocation as it moves,
+  //  and so may lose their alignment until the table next grows
+  //
+  if ( c3y == _ch_is_flat(har_u) ) {
+    u3h_flat* fla_u = (u3h_flat*)har_u;
+
+    _ch_flat_walk(fla_u, _ch_flat_rewrite_slot, 0);
+    u3a_rewrite_ptr(u3a_into(fla_u->lin_p));
+    fla_u->lin_p = u3a_rewritten(fla_u->lin_p);
+    return;
+  }
+
   for ( i_w = 0; i_w < 64; i_w++ ) {
     c3_w sot_w = har_u->sot_w[i_w];
 
@@ -1104,6 +1621,15 @@ _ch_count_node(u3h_node* han_u, c3_w lef_w)
   return tot_w;
 }
 
+/* _ch_flat_count_slot(): count entry in flat table.
+*/
+static void
+_ch_flat_count_slot(u3h_slot* sot_w, void* wit)
+{
+  c3_w* tot_w = wit;
+  *tot_w += u3a_count_noun(u3h_slot_to_noun(*sot_w));
+}
+
 /* u3h_count(): count hashtable for gc.
 */
 c3_w
@@ -1113,6 +1639,15 @@ u3h_count(u3p(u3h_root) har_p)
   u3h_root* har_u = u3to(u3h_root, har_p);
   c3_w        i_w;
 
+  if ( c3y == _ch_is_flat(har_u) ) {
+    u3h_flat* fla_u = (u3h_flat*)har_u;
+
+    _ch_flat_walk(fla_u, _ch_flat_count_slot, &tot_w);
+    tot_w += u3a_count_ptr(u3a_into(fla_u->lin_p));
+    tot_w += u3a_count_ptr(fla_u);
+    return tot_w;
+  }
+
   for ( i_w = 0; i_w < 64; i_w++ ) {
     c3_w sot_w = har_u->sot_w[i_w];
 
@@ -1184,6 +1719,15 @@ _ch_discount_node(u3h_node* han_u, c3_w lef_w)
   return tot_w;
 }
 
+/* _ch_flat_discount_slot(): discount entry in flat table.
+*/
+static void
+_ch_flat_discount_slot(u3h_slot* sot_w, void* wit)
+{
+  c3_w* tot_w = wit;
+  *tot_w += u3a_discount_noun(u3h_slot_to_noun(*sot_w));
+}
+
 /* u3h_discount(): discount hashtable for gc.
 */
 c3_w
@@ -1193,6 +1737,15 @@ u3h_discount(u3p(u3h_root) har_p)
   u3h_root* har_u = u3to(u3h_root, har_p);
   c3_w        i_w;
 
+  if ( c3y == _ch_is_flat(har_u) ) {
+    u3h_flat* fla_u = (u3h_flat*)har_u;
+
+    _ch_flat_walk(fla_u, _ch_flat_discount_slot, &tot_w);
+    tot_w += u3a_discount_ptr(u3a_into(fla_u->lin_p));
+    tot_w += u3a_discount_ptr(fla_u);
+    return tot_w;
+  }
+
   for ( i_w = 0; i_w < 64; i_w++ ) {
     c3_w sot_w = har_u->sot_w[i_w];
 
@@ -280,6 +280,41 @@ u3i_slab_moot(u3i_slab* sab_u)
   return pro;
 }
 
+/* u3i_slab_mpn(): configure slab for [len_mp] GMP limbs, uninitialized,
+**                 producing a limb buffer for mpn_*() output.
+**
+**   mpn_*() writes directly into the atom, unless the allocator
+**   has left it misaligned for limbs, in which case we stage the
+**   result and copy it in u3i_slab_mpn_mint().
+*/
+mp_limb_t*
+u3i_slab_mpn(u3i_slab* sab_u, mp_size_t len_mp)
+{
+  c3_assert( 0 < len_mp );
+
+  u3i_slab_bare(sab_u, 3, (c3_d)len_mp * sizeof(mp_limb_t));
+
+  if ( !((c3_p)sab_u->buf_w % sizeof(mp_limb_t)) ) {
+    return (mp_limb_t*)sab_u->buf_w;
+  }
+  else {
+    return u3a_malloc(len_mp * sizeof(mp_limb_t));
+  }
+}
+
+/* u3i_slab_mpn_mint(): produce atom from limb-slab, trimming.
+*/
+u3_atom
+u3i_slab_mpn_mint(u3i_slab* sab_u, mp_limb_t* buf_mp)
+{
+  if ( (c3_w*)buf_mp != sab_u->buf_w ) {
+    memcpy(sab_u->buf_w, buf_mp, (size_t)sab_u->len_w << 2);
+    u3a_free(buf_mp);
+  }
+
+  return u3i_slab_mint(sab_u);
+}
+
 /* u3i_word(): construct u3_atom from c3_w.
 */
 u3_atom
@@ -478,6 +478,40 @@ _cj_find_cold(u3_noun bat)
   }
 }
 
+/* _cj_bare_hank(): forget a hook site's unregistered battery.
+*/
+static void
+_cj_bare_hank(u3_noun kev)
+{
+  u3to(_cj_hank, u3t(kev))->sit_u.gen_w = 0;
+}
+
+/* _cj_cold_bump(): note new cold state, invalidating site bindings.
+**
+**   cold state is written on every road, so the generation can wrap
+**   in a long-lived process. when it does, clear every binding on
+**   the road stack, so that none can match a reused generation.
+*/
+static void
+_cj_cold_bump(void)
+{
+  if ( 0 == ++u3D.gen_w ) {
+    u3a_road* rod_u = u3R;
+
+    while ( 1 ) {
+      u3h_walk(rod_u->jed.han_p, _cj_bare_hank);
+      u3n_bare(rod_u->byc.har_p);
+
+      if ( rod_u->par_p ) {
+        rod_u = u3to(u3a_road, rod_u->par_p);
+      }
+      else break;
+    }
+
+    u3D.gen_w = 1;
+  }
+}
+
 /* _cj_find_warm(): search warm state for `loc`s activation.
  *                  RETAIN.
  */
@@ -642,6 +676,7 @@ _cj_spot(u3_noun cor, u3_weak* bas)
       if ( u3_none != act ) {
         reg = _cj_gust(reg, _cj_loc_axe(loc), _cj_loc_pel(loc), u3k(loc));
         u3h_put(u3R->jed.cod_p, u3h(cor), u3nc(u3k(*bas), u3k(reg)));
+        _cj_cold_bump();
         /* caution: could overwrites old value, debug batteries etc.
         **          old value contains old _cj_jit (from different
         **          battery). if we change jit to (map battery *),
@@ -701,6 +736,7 @@ _cj_cast(u3_noun cor, u3_noun loc)
 }
 
 /* _cj_fine(): check that a core matches a u3j_fink. RETAIN.
+ *             nouns are compared by pointer before structure.
  */
 static c3_o
 _cj_fine(u3_noun cor, u3p(u3j_fink) fin_p)
@@ -709,14 +745,25 @@ _cj_fine(u3_noun cor, u3p(u3j_fink) fin_p)
   c3_w i_w;
   for ( i_w = 0; i_w < fin_u->len_w; ++i_w ) {
     u3j_fist* fis_u = &(fin_u->fis_u[i_w]);
-    if ( c3n == u3r_sing(fis_u->bat, u3h(cor)) ) {
+    if ( (fis_u->bat != u3h(cor)) &&
+         (c3n == u3r_sing(fis_u->bat, u3h(cor))) )
+    {
       return c3n;
     }
     else {
       cor = u3r_at(fis_u->pax, cor);
     }
   }
-  return u3r_sing(fin_u->sat, cor);
+  return ( fin_u->sat == cor ) ? c3y : u3r_sing(fin_u->sat, cor);
+}
+
+/* _cj_fink_bat(): battery of the core checked by a u3j_fink.
+ */
+static u3_noun
+_cj_fink_bat(u3p(u3j_fink) fin_p)
+{
+  u3j_fink* fin_u = u3to(u3j_fink, fin_p);
+  return ( 0 == fin_u->len_w ) ? u3h(fin_u->sat) : fin_u->fis_u[0].bat;
 }
 
 /* _cj_nail(): resolve hot state for arm at axis within cores located
@@ -806,11 +853,12 @@ u3j_boot(c3_o nuu_o)
 
   u3D.ray_u = c3_malloc(u3D.all_l * sizeof(u3j_core));
   memset(u3D.ray_u, 0, (u3D.all_l * sizeof(u3j_core)));
+  u3D.gen_w = 1;
 
   if ( c3n == nuu_o ) {
     u3h_free(u3R->jed.hot_p);
   }
-  u3R->jed.hot_p = u3h_new();
+  u3R->jed.hot_p = u3h_new_flat(0);
 
   return _cj_install(u3D.ray_u, 1,
                      (c3_l) (long long) u3D.dev_u[0].par_u,
@@ -1143,7 +1191,9 @@ _cj_hank_fill(_cj_hank* han_u, u3_noun tam, u3_noun cor)
     return u3m_bail(c3__fail);
   }
 
-  sit_u->bas = u3_none;
+  sit_u->bas   = u3_none;
+  sit_u->gen_w = 0;
+  sit_u->pic_p = 0;
   if ( u3_none == (col = loc = _cj_spot(cor, NULL)) ) {
     u3l_log("fail in _cj_hank_fill (_cj_spot(cor, NULL))");
     return u3m_bail(c3__fail);
@@ -1350,6 +1400,93 @@ _cj_fink_free(u3p(u3j_fink) fin_p)
   u3a_wfree(fin_u);
 }
 
+/* _cj_pice_lose(): lose references of a u3j_pice.
+*/
+static void
+_cj_pice_lose(u3j_pice* ent_u)
+{
+  if ( u3_none != ent_u->bat ) {
+    u3z(ent_u->bat);
+  }
+  u3z(ent_u->loc);
+  u3z(ent_u->lab);
+  if ( c3y == ent_u->fon_o ) {
+    _cj_fink_free(ent_u->fin_p);
+  }
+}
+
+/* _cj_pics_free(): lose and free everything in a u3j_pics.
+*/
+static void
+_cj_pics_free(u3p(u3j_pics) pic_p)
+{
+  c3_w      i_w;
+  u3j_pics* pic_u = u3to(u3j_pics, pic_p);
+  for ( i_w = 0; i_w < pic_u->len_w; ++i_w ) {
+    _cj_pice_lose(&(pic_u->ent_u[i_w]));
+  }
+  u3a_wfree(pic_u);
+}
+
+/* _cj_pics_take(): copy u3j_pics from junior road.
+*/
+static u3j_pics*
+_cj_pics_take(u3j_pics* jun_u)
+{
+  c3_w      i_w;
+  u3j_pics* pic_u = u3a_walloc(c3_wiseof(u3j_pics));
+
+  pic_u->len_w = jun_u->len_w;
+  pic_u->rov_w = jun_u->rov_w;
+  for ( i_w = 0; i_w < jun_u->len_w; ++i_w ) {
+    u3j_pice* ent_u = &(pic_u->ent_u[i_w]);
+    u3j_pice* tne_u = &(jun_u->ent_u[i_w]);
+
+    ent_u->pog_p = 0;
+    ent_u->bat   = u3_none;
+    ent_u->loc   = u3a_take(tne_u->loc);
+    ent_u->lab   = u3a_take(tne_u->lab);
+    ent_u->jet_o = tne_u->jet_o;
+    ent_u->cop_u = tne_u->cop_u;
+    ent_u->ham_u = tne_u->ham_u;
+
+    if ( c3y == tne_u->fon_o ) {
+      ent_u->fin_p = u3of(u3j_fink, _cj_fink_take(u3to(u3j_fink, tne_u->fin_p)));
+      ent_u->fon_o = c3y;
+    }
+    else {
+      ent_u->fin_p = tne_u->fin_p;
+      ent_u->fon_o = c3n;
+    }
+  }
+  return pic_u;
+}
+
+/* _cj_site_adopt(): if site shares fin_p, take ownership of it.
+*/
+static c3_o
+_cj_site_adopt(u3j_site* sit_u, u3p(u3j_fink) fin_p)
+{
+  if ( (fin_p == sit_u->fin_p) && (c3n == sit_u->fon_o) ) {
+    sit_u->fon_o = c3y;
+    return c3y;
+  }
+
+  if ( 0 != sit_u->pic_p ) {
+    c3_w      i_w;
+    u3j_pics* pic_u = u3to(u3j_pics, sit_u->pic_p);
+    for ( i_w = 0; i_w < pic_u->len_w; ++i_w ) {
+      u3j_pice* ent_u = &(pic_u->ent_u[i_w]);
+      if ( (fin_p == ent_u->fin_p) && (c3n == ent_u->fon_o) ) {
+        ent_u->fon_o = c3y;
+        return c3y;
+      }
+    }
+  }
+
+  return c3n;
+}
+
 /* u3j_rite_take(): copy junior rite references. [dst_u] is uninitialized
 */
 void
@@ -1402,6 +1539,10 @@ u3j_site_take(u3j_site* dst_u, u3j_site* src_u)
   dst_u->bat   = u3_none;
   dst_u->bas   = u3_none;
   dst_u->pog_p = 0;
+  dst_u->gen_w = 0;
+  dst_u->pic_p = ( 0 == src_u->pic_p )
+                 ? 0
+                 : u3of(u3j_pics, _cj_pics_take(u3to(u3j_pics, src_u->pic_p)));
 
   if ( u3_none == src_u->loc ) {
     dst_u->loc   = u3_none;
@@ -1440,6 +1581,10 @@ u3j_site_merge(u3j_site* dst_u, u3j_site* src_u)
   dst_u->axe = src_u->axe;
 
   if ( u3_none != src_u->loc ) {
+    u3p(u3j_fink) fin_p = dst_u->fin_p;
+    u3p(u3j_pics) pic_p = dst_u->pic_p;
+    c3_o          fon_o = dst_u->fon_o;
+
     u3z(dst_u->loc);
     u3z(dst_u->lab);
     dst_u->loc   = src_u->loc;
@@ -1447,15 +1592,57 @@ u3j_site_merge(u3j_site* dst_u, u3j_site* src_u)
     dst_u->cop_u = src_u->cop_u;
     dst_u->ham_u = src_u->ham_u;
     dst_u->jet_o = src_u->jet_o;
-
-    if ( dst_u->fin_p != src_u->fin_p ) {
-      if ( c3y == dst_u->fon_o )  {
-        _cj_fink_free(dst_u->fin_p);
+    dst_u->fin_p = src_u->fin_p;
+    dst_u->fon_o = src_u->fon_o;
+    dst_u->pic_p = src_u->pic_p;
+
+    //  the new targets may share finks owned by the old ones,
+    //  see u3j_site_lend()
+    //
+    if ( (c3y == fon_o) && (c3n == _cj_site_adopt(dst_u, fin_p)) ) {
+      _cj_fink_free(fin_p);
+    }
+
+    if ( (0 != pic_p) && (pic_p != dst_u->pic_p) ) {
+      c3_w      i_w;
+      u3j_pics* pic_u = u3to(u3j_pics, pic_p);
+      for ( i_w = 0; i_w < pic_u->len_w; ++i_w ) {
+        u3j_pice* ent_u = &(pic_u->ent_u[i_w]);
+        if ( (c3y == ent_u->fon_o) &&
+             (c3y == _cj_site_adopt(dst_u, ent_u->fin_p)) )
+        {
+          ent_u->fon_o = c3n;
+        }
+        _cj_pice_lose(ent_u);
       }
+      u3a_wfree(pic_u);
+    }
+  }
+}
 
-      dst_u->fin_p = src_u->fin_p;
-      dst_u->fon_o = src_u->fon_o;
+/* u3j_site_lend(): prepare a site copied from a senior program,
+**                  sharing its targets without owning them.
+*/
+void
+u3j_site_lend(u3j_site* sit_u)
+{
+  sit_u->bat   = u3_none;
+  sit_u->pog_p = 0;
+  sit_u->fon_o = c3n;
+  sit_u->gen_w = 0;
+
+  if ( 0 != sit_u->pic_p ) {
+    c3_w      i_w;
+    u3j_pics* pic_u = u3a_walloc(c3_wiseof(u3j_pics));
+
+    *pic_u = *u3to(u3j_pics, sit_u->pic_p);
+    for ( i_w = 0; i_w < pic_u->len_w; ++i_w ) {
+      u3j_pice* ent_u = &(pic_u->ent_u[i_w]);
+      ent_u->bat   = u3_none;
+      ent_u->pog_p = 0;
+      ent_u->fon_o = c3n;
     }
+    sit_u->pic_p = u3of(u3j_pics, pic_u);
   }
 }
 
@@ -1469,6 +1656,26 @@ u3j_site_ream(u3j_site* sit_u)
     sit_u->jet_o = _cj_nail(sit_u->loc, sit_u->axe,
         &(sit_u->lab), &(sit_u->cop_u), &(sit_u->ham_u));
   }
+
+  //  cold generations restart with the process
+  //
+  sit_u->gen_w = 0;
+
+  //  version 1 images predate [pic_p], leaving uninitialized padding
+  //
+  if ( 1 == u3H->ver_w ) {
+    sit_u->pic_p = 0;
+  }
+  else if ( 0 != sit_u->pic_p ) {
+    c3_w      i_w;
+    u3j_pics* pic_u = u3to(u3j_pics, sit_u->pic_p);
+    for ( i_w = 0; i_w < pic_u->len_w; ++i_w ) {
+      u3j_pice* ent_u = &(pic_u->ent_u[i_w]);
+      u3z(ent_u->lab);
+      ent_u->jet_o = _cj_nail(ent_u->loc, sit_u->axe,
+          &(ent_u->lab), &(ent_u->cop_u), &(ent_u->ham_u));
+    }
+  }
 }
 
 /* _cj_site_lock(): ensure site has a valid program pointer
@@ -1477,14 +1684,57 @@ static void
 _cj_site_lock(u3_noun loc, u3_noun cor, u3j_site* sit_u)
 {
   if ( (u3_none != sit_u->bat) &&
-       (c3y == u3r_sing(sit_u->bat, u3h(cor))) ) {
+       ( (sit_u->bat == u3h(cor)) ||
+         (c3y == u3r_sing(sit_u->bat, u3h(cor))) ) )
+  {
     return;
   }
   sit_u->pog_p = _cj_prog(loc, u3x_at(sit_u->axe, cor));
   if ( u3_none != sit_u->bat ) {
     u3z(sit_u->bat);
   }
-  sit_u->bat = u3k(u3h(cor));
+  sit_u->bat   = u3k(u3h(cor));
+  sit_u->gen_w = 0;
+}
+
+/* _cj_site_bare(): yes if cor has the site's battery, and that battery
+**                  had no cold state as of the current generation.
+*/
+static inline c3_o
+_cj_site_bare(u3_noun cor, u3j_site* sit_u)
+{
+  return __(  (0 != sit_u->gen_w)
+           && (u3D.gen_w == sit_u->gen_w)
+           && (sit_u->bat == u3h(cor)) );
+}
+
+/* _cj_site_bind(): remember that the site's battery is unregistered,
+**                  in both cold and hot state, so can never be located.
+*/
+static void
+_cj_site_bind(u3j_site* sit_u)
+{
+  if ( u3_none != sit_u->bat ) {
+    u3_weak bar = _cj_find_cold(sit_u->bat);
+
+    if ( u3_none != bar ) {
+      u3z(bar);
+      return;
+    }
+
+    if ( !(u3C.wag_w & u3o_hashless) ) {
+      u3_noun bas = _cj_bash(sit_u->bat);
+      u3_weak hot = u3h_get(u3H->rod_u.jed.hot_p, bas);
+
+      u3z(bas);
+      if ( u3_none != hot ) {
+        u3z(hot);
+        return;
+      }
+    }
+
+    sit_u->gen_w = u3D.gen_w;
+  }
 }
 
 /* _cj_burn(): stop tracing glu and call a nock program
@@ -1553,6 +1803,120 @@ _cj_site_kick_hot(u3_noun loc, u3_noun cor, u3j_site* sit_u, c3_o lok_o)
   return pro;
 }
 
+/* _cj_site_stow(): copy site's located target into ent_u.
+ */
+static void
+_cj_site_stow(u3j_site* sit_u, u3j_pice* ent_u)
+{
+  ent_u->pog_p = sit_u->pog_p;
+  ent_u->bat   = sit_u->bat;
+  ent_u->loc   = sit_u->loc;
+  ent_u->jet_o = sit_u->jet_o;
+  ent_u->fon_o = sit_u->fon_o;
+  ent_u->lab   = sit_u->lab;
+  ent_u->cop_u = sit_u->cop_u;
+  ent_u->ham_u = sit_u->ham_u;
+  ent_u->fin_p = sit_u->fin_p;
+}
+
+/* _cj_site_load(): make ent_u the site's located target.
+ */
+static void
+_cj_site_load(u3j_site* sit_u, u3j_pice* ent_u)
+{
+  sit_u->pog_p = ent_u->pog_p;
+  sit_u->bat   = ent_u->bat;
+  sit_u->loc   = ent_u->loc;
+  sit_u->jet_o = ent_u->jet_o;
+  sit_u->fon_o = ent_u->fon_o;
+  sit_u->lab   = ent_u->lab;
+  sit_u->cop_u = ent_u->cop_u;
+  sit_u->ham_u = ent_u->ham_u;
+  sit_u->fin_p = ent_u->fin_p;
+}
+
+/* _cj_site_push(): displace site's located target into its
+**                  polymorphic cache, evicting an entry if full.
+*/
+static void
+_cj_site_push(u3j_site* sit_u)
+{
+  u3j_pics* pic_u;
+  u3j_pice* ent_u;
+
+  if ( 0 == sit_u->pic_p ) {
+    pic_u = u3a_walloc(c3_wiseof(u3j_pics));
+    pic_u->len_w = 0;
+    pic_u->rov_w = 0;
+    sit_u->pic_p = u3of(u3j_pics, pic_u);
+  }
+  else {
+    pic_u = u3to(u3j_pics, sit_u->pic_p);
+  }
+
+  if ( pic_u->len_w < u3j_pics_len ) {
+    ent_u = &(pic_u->ent_u[pic_u->len_w++]);
+  }
+  else {
+    ent_u = &(pic_u->ent_u[pic_u->rov_w]);
+    pic_u->rov_w = (pic_u->rov_w + 1) % u3j_pics_len;
+    _cj_pice_lose(ent_u);
+  }
+
+  _cj_site_stow(sit_u, ent_u);
+  sit_u->pog_p = 0;
+  sit_u->bat   = u3_none;
+  sit_u->loc   = u3_none;
+  sit_u->lab   = u3_none;
+  sit_u->fin_p = 0;
+  sit_u->fon_o = c3n;
+}
+
+/* _cj_site_swap(): exchange site's located target with ent_u.
+ */
+static void
+_cj_site_swap(u3j_site* sit_u, u3j_pice* ent_u)
+{
+  u3j_pice tmp_u;
+  _cj_site_stow(sit_u, &tmp_u);
+  _cj_site_load(sit_u, ent_u);
+  *ent_u = tmp_u;
+}
+
+/* _cj_site_pick(): find a displaced target for cor and swap it in.
+ */
+static c3_o
+_cj_site_pick(u3_noun cor, u3j_site* sit_u)
+{
+  u3j_pics* pic_u = u3to(u3j_pics, sit_u->pic_p);
+  u3_noun     bat = u3h(cor);
+  c3_w      i_w;
+
+  //  try entries whose battery is the same noun first
+  //
+  for ( i_w = 0; i_w < pic_u->len_w; ++i_w ) {
+    u3j_pice* ent_u = &(pic_u->ent_u[i_w]);
+    if ( (bat == _cj_fink_bat(ent_u->fin_p)) &&
+         (c3y == _cj_fine(cor, ent_u->fin_p)) )
+    {
+      _cj_site_swap(sit_u, ent_u);
+      return c3y;
+    }
+  }
+
+  for ( i_w = 0; i_w < pic_u->len_w; ++i_w ) {
+    u3j_pice* ent_u = &(pic_u->ent_u[i_w]);
+    if ( (bat != _cj_fink_bat(ent_u->fin_p)) &&
+         (c3y == _cj_fine(cor, ent_u->fin_p)) )
+    {
+      _cj_site_swap(sit_u, ent_u);
+      return c3y;
+    }
+  }
+
+  return c3n;
+}
+
 /* _cj_site_kick(): execute site's kick on core.
  */
 static u3_weak
@@ -1563,46 +1927,37 @@ _cj_site_kick(u3_noun cor, u3j_site* sit_u)
   loc = pro = u3_none;
 
   if ( u3_none != sit_u->loc ) {
-    if ( c3y == _cj_fine(cor, sit_u->fin_p) ) {
+    if ( (c3y == _cj_fine(cor, sit_u->fin_p)) ||
+         ((0 != sit_u->pic_p) && (c3y == _cj_site_pick(cor, sit_u))) )
+    {
       loc = sit_u->loc;
       pro = _cj_site_kick_hot(loc, cor, sit_u, c3y);
     }
   }
 
-  if ( u3_none == loc ) {
+  if ( (u3_none == loc) && (c3n == _cj_site_bare(cor, sit_u)) ) {
     loc = _cj_spot(cor, &(sit_u->bas));
     if ( u3_none != loc ) {
-      u3p(u3j_fink) fon_p = 0;
-      u3_weak  lod   = u3_none;
-      u3_weak  lob   = u3_none;
-
       if ( u3_none != sit_u->loc ) {
-        lod = sit_u->loc;
-        lob = sit_u->lab;
-        if ( c3y == sit_u->fon_o ) {
-          fon_p = sit_u->fin_p;
-        }
+        _cj_site_push(sit_u);
       }
 
       sit_u->loc   = loc;
       sit_u->fin_p = _cj_cast(cor, loc);
       sit_u->fon_o = c3y;
+      sit_u->gen_w = 0;
       sit_u->jet_o = _cj_nail(loc, sit_u->axe,
           &(sit_u->lab), &(sit_u->cop_u), &(sit_u->ham_u));
       pro = _cj_site_kick_hot(loc, cor, sit_u, c3y);
-
-      if ( u3_none != lod ) {
-        u3z(lod);
-        u3z(lob);
-        if ( 0 != fon_p ) {
-          _cj_fink_free(fon_p);
-        }
-      }
     }
   }
 
   if ( u3_none == pro ) {
     _cj_site_lock(loc, cor, sit_u);
+
+    if ( (u3_none == loc) && (0 == sit_u->gen_w) ) {
+      _cj_site_bind(sit_u);
+    }
   }
 
   return pro;
@@ -1678,6 +2033,8 @@ u3j_gate_prep(u3j_site* sit_u, u3_noun cor)
     return;
   }
   sit_u->bas   = u3_none;
+  sit_u->gen_w = 0;
+  sit_u->pic_p = 0;
   sit_u->axe   = 2;
   sit_u->bat   = cor; // a lie, this isn't really the battery!
   sit_u->loc   = loc = _cj_spot(cor, &(sit_u->bas));
@@ -1847,6 +2204,7 @@ _cj_mine(u3_noun cey, u3_noun cor, u3_noun bas)
     hap   = _cj_warm_hump(jax_l, u3t(u3t(loc)));
     act   = u3nq(jax_l, hap, bal, _cj_jit(jax_l, bat));
     u3h_put(u3R->jed.cod_p, bat, u3nc(u3k(bas), reg));
+    _cj_cold_bump();
     u3h_put(u3R->jed.war_p, loc, act); // see note in _cj_spot
     u3z(pel); u3z(axe);
   }
@@ -2167,7 +2525,7 @@ u3j_ream(void)
   u3_noun rel = u3_nul;
   c3_assert(u3R == &(u3H->rod_u));
   u3h_free(u3R->jed.war_p);
-  u3R->jed.war_p = u3h_new();
+  u3R->jed.war_p = u3h_new_flat(0);
   u3h_walk_with(u3R->jed.cod_p, _cj_warm_tap, &rel);
   _cj_ream(rel);
   u3z(rel);
@@ -2197,6 +2555,7 @@ u3j_load(u3_noun rel)
   while ( u3_nul != ler ) {
     u3x_cell(ler, &lor, &ler);
     u3h_put(u3R->jed.cod_p, u3h(lor), u3k(u3t(lor)));
+    _cj_cold_bump();
   }
 
   u3z(rel);
@@ -2236,6 +2595,9 @@ u3j_site_lose(u3j_site* sit_u)
       _cj_fink_free(sit_u->fin_p);
     }
   }
+  if ( 0 != sit_u->pic_p ) {
+    _cj_pics_free(sit_u->pic_p);
+  }
 }
 
 /* u3j_rite_lose(): lose references of u3j_rite (but do not free).
@@ -2281,9 +2643,111 @@ u3j_site_mark(u3j_site* sit_u)
       tot_w += _cj_fink_mark(u3to(u3j_fink, sit_u->fin_p));
     }
   }
+  if ( 0 != sit_u->pic_p ) {
+    c3_w      i_w;
+    u3j_pics* pic_u = u3to(u3j_pics, sit_u->pic_p);
+    for ( i_w = 0; i_w < pic_u->len_w; ++i_w ) {
+      u3j_pice* ent_u = &(pic_u->ent_u[i_w]);
+      if ( u3_none != ent_u->bat ) {
+        tot_w += u3a_mark_noun(ent_u->bat);
+      }
+      tot_w += u3a_mark_noun(ent_u->loc);
+      tot_w += u3a_mark_noun(ent_u->lab);
+      if ( c3y == ent_u->fon_o ) {
+        tot_w += _cj_fink_mark(u3to(u3j_fink, ent_u->fin_p));
+      }
+    }
+    tot_w += u3a_mark_ptr(pic_u);
+  }
   return tot_w;
 }
 
+/* _cj_rewrite_noun(): rewrite a noun reference for compaction.
+*/
+static u3_noun
+_cj_rewrite_noun(u3_noun som)
+{
+  u3a_rewrite_noun(som);
+  return u3a_rewritten_noun(som);
+}
+
+/* _cj_fink_rewrite(): rewrite fine check for compaction, producing new post.
+*/
+static u3p(u3j_fink)
+_cj_fink_rewrite(u3p(u3j_fink) fin_p)
+{
+  u3j_fink* fin_u = u3to(u3j_fink, fin_p);
+
+  //  finks may be shared between sites, rites and cache entries
+  //
+  if ( c3y == u3a_rewrite_ptr(fin_u) ) {
+    c3_w i_w;
+
+    fin_u->sat = _cj_rewrite_noun(fin_u->sat);
+
+    for ( i_w = 0; i_w < fin_u->len_w; ++i_w ) {
+      u3j_fist* fis_u = &(fin_u->fis_u[i_w]);
+      fis_u->bat = _cj_rewrite_noun(fis_u->bat);
+      fis_u->pax = _cj_rewrite_noun(fis_u->pax);
+    }
+  }
+
+  return u3a_rewritten(fin_p);
+}
+
+/* u3j_rite_rewrite(): rewrite u3j_rite for compaction.
+*/
+void
+u3j_rite_rewrite(u3j_rite* rit_u)
+{
+  if ( (c3y == rit_u->own_o) && u3_none != rit_u->clu ) {
+    rit_u->clu   = _cj_rewrite_noun(rit_u->clu);
+    rit_u->fin_p = _cj_fink_rewrite(rit_u->fin_p);
+  }
+}
+
+/* u3j_site_rewrite(): rewrite u3j_site for compaction.
+*/
+void
+u3j_site_rewrite(u3j_site* sit_u)
+{
+  if ( 0 != sit_u->pog_p ) {
+    sit_u->pog_p = u3a_rewritten_mptr(sit_u->pog_p);
+  }
+  sit_u->axe = _cj_rewrite_noun(sit_u->axe);
+  if ( u3_none != sit_u->bat ) {
+    sit_u->bat = _cj_rewrite_noun(sit_u->bat);
+  }
+  if ( u3_none != sit_u->bas ) {
+    sit_u->bas = _cj_rewrite_noun(sit_u->bas);
+  }
+  if ( u3_none != sit_u->loc ) {
+    sit_u->loc   = _cj_rewrite_noun(sit_u->loc);
+    sit_u->lab   = _cj_rewrite_noun(sit_u->lab);
+    sit_u->fin_p = _cj_fink_rewrite(sit_u->fin_p);
+  }
+  if ( 0 != sit_u->pic_p ) {
+    u3j_pics* pic_u = u3to(u3j_pics, sit_u->pic_p);
+
+    if ( c3y == u3a_rewrite_ptr(pic_u) ) {
+      c3_w i_w;
+      for ( i_w = 0; i_w < pic_u->len_w; ++i_w ) {
+        u3j_pice* ent_u = &(pic_u->ent_u[i_w]);
+        if ( 0 != ent_u->pog_p ) {
+          ent_u->pog_p = u3a_rewritten_mptr(ent_u->pog_p);
+        }
+        if ( u3_none != ent_u->bat ) {
+          ent_u->bat = _cj_rewrite_noun(ent_u->bat);
+        }
+        ent_u->loc   = _cj_rewrite_noun(ent_u->loc);
+        ent_u->lab   = _cj_rewrite_noun(ent_u->lab);
+        ent_u->fin_p = _cj_fink_rewrite(ent_u->fin_p);
+      }
+    }
+    sit_u->pic_p = u3a_rewritten(sit_u->pic_p);
+  }
+}
+
 /* _cj_mark_hank(): mark hank cache for gc.
 */
 static void
@@ -2368,7 +2832,7 @@ u3j_reclaim(void)
   //
   u3h_walk(u3R->jed.han_p, _cj_free_hank);
   u3h_free(u3R->jed.han_p);
-  u3R->jed.han_p = u3h_new();
+  u3R->jed.han_p = u3h_new_flat(0);
 }
 
 /* u3j_rewrite_compact(): rewrite jet state for compaction.
@@ -478,12 +478,12 @@ u3m_mark(FILE* fil_u)
 static void
 _pave_parts(void)
 {
-  u3R->cax.har_p = u3h_new_cache(u3_Host.ops_u.hap_w);
-  u3R->jed.war_p = u3h_new();
+  u3R->cax.har_p = u3h_new_flat(u3_Host.ops_u.hap_w);
+  u3R->jed.war_p = u3h_new_flat(0);
   u3R->jed.cod_p = u3h_new();
-  u3R->jed.han_p = u3h_new();
+  u3R->jed.han_p = u3h_new_flat(0);
   u3R->jed.bas_p = u3h_new();
-  u3R->byc.har_p = u3h_new();
+  u3R->byc.har_p = u3h_new_flat(0);
 }
 
 /* _pave_road(): initialize road boundaries
@@ -579,7 +579,9 @@ _find_home(void)
   {
     c3_w ver_w = *((mem_w + len_w) - 1);
 
-    if ( u3v_version != ver_w ) {
+    //  older images are upgraded in place by u3m_boot()
+    //
+    if ( !ver_w || (u3v_version < ver_w) ) {
       fprintf(stderr, "loom: checkpoint version mismatch: "
                       "have %u, need %u\r\n",
                       ver_w,
@@ -844,9 +846,11 @@ u3m_leap(c3_w pad_w)
     u3R->kid_p = u3of(u3_road, rod_u);
   }
 
-  /* Set up the new road.
+  /* Set up the new road; roads within a sand road are sand.
   */
   {
+    rod_u->how.fag_w = u3R->how.fag_w & u3a_flag_sand;
+
     u3R = rod_u;
     _pave_parts();
   }
@@ -1005,17 +1009,24 @@ u3m_water(c3_w* low_w, c3_w* hig_w)
   *hig_w = u3a_temp(u3R) + c3_wiseof(u3v_home);
 }
 
-/* u3m_soft_top(): top-level safety wrapper.
+/* _cm_soft_top(): top-level safety wrapper, with road flags.
 */
-u3_noun
-u3m_soft_top(c3_w    mil_w,                     //  timer ms
+static u3_noun
+_cm_soft_top(c3_w    mil_w,                     //  timer ms
              c3_w    pad_w,                     //  base memory pad
+             c3_w    fag_w,                     //  u3a_flag bits
              u3_funk fun_f,
              u3_noun   arg)
 {
   u3_noun why, pro;
   c3_l    sig_l;
 
+  //  leak checking needs real frees
+  //
+  if ( u3C.wag_w & u3o_debug_ram ) {
+    fag_w &= ~u3a_flag_sand;
+  }
+
   /* Enter internal signal regime.
   */
   _cm_signal_deep(mil_w);
@@ -1037,6 +1048,7 @@ u3m_soft_top(c3_w    mil_w,                     //  timer ms
   /* Record the cap, and leap.
   */
   u3m_hate(pad_w);
+  u3R->how.fag_w |= fag_w;
 
   /* Trap for ordinary nock exceptions.
   */
@@ -1081,6 +1093,17 @@ u3m_soft_top(c3_w    mil_w,                     //  timer ms
   return pro;
 }
 
+/* u3m_soft_top(): top-level safety wrapper.
+*/
+u3_noun
+u3m_soft_top(c3_w    mil_w,                     //  timer ms
+             c3_w    pad_w,                     //  base memory pad
+             u3_funk fun_f,
+             u3_noun   arg)
+{
+  return _cm_soft_top(mil_w, pad_w, 0, fun_f, arg);
+}
+
 /* u3m_soft_sure(): top-level call assumed correct.
 */
 u3_noun
@@ -1296,18 +1319,19 @@ u3m_grab(u3_noun som, ...)   // terminate with u3_none
   u3a_sweep();
 }
 
-/* u3m_soft(): top-level wrapper.
+/* _cm_soft(): top-level wrapper, with road flags.
 **
 ** Produces [0 product] or [%error (list tank)], top last.
 */
-u3_noun
-u3m_soft(c3_w    mil_w,
+static u3_noun
+_cm_soft(c3_w    mil_w,
+         c3_w    fag_w,
          u3_funk fun_f,
          u3_noun   arg)
 {
   u3_noun why;
 
-  why = u3m_soft_top(mil_w, (1 << 20), fun_f, arg);   // 2MB pad
+  why = _cm_soft_top(mil_w, (1 << 20), fag_w, fun_f, arg);   // 2MB pad
 
   if ( 0 == u3h(why) ) {
     return why;
@@ -1376,6 +1400,40 @@ u3m_soft(c3_w    mil_w,
   }
 }
 
+/* u3m_soft(): top-level wrapper.
+**
+** Produces [0 product] or [%error (list tank)], top last.
+*/
+u3_noun
+u3m_soft(c3_w    mil_w,
+         u3_funk fun_f,
+         u3_noun   arg)
+{
+  return _cm_soft(mil_w, 0, fun_f, arg);
+}
+
+/* u3m_soft_sand(): top-level wrapper, on a sand road.
+**
+**   Frees are ignored, and the heap is discarded wholesale on return.
+**   If the computation runs out of memory, it is retried on an
+**   ordinary road.
+*/
+u3_noun
+u3m_soft_sand(c3_w    mil_w,
+              u3_funk fun_f,
+              u3_noun   arg)
+{
+  u3_noun pro = _cm_soft(mil_w, u3a_flag_sand, fun_f, u3k(arg));
+
+  if ( c3__meme == u3h(pro) ) {
+    u3z(pro);
+    return u3m_soft(mil_w, fun_f, arg);
+  }
+
+  u3z(arg);
+  return pro;
+}
+
 /* _cm_is_tas(): yes iff som (RETAIN) is @tas.
 */
 static c3_o
@@ -1822,11 +1880,49 @@ u3m_init(size_t len_i)
   // map at fixed address.
   //
   {
-    void* map_v = mmap((void *)u3_Loom,
-                       len_i,
-                       (PROT_READ | PROT_WRITE),
-                       (MAP_ANON | MAP_FIXED | MAP_PRIVATE),
-                       -1, 0);
+    void* map_v = MAP_FAILED;
+
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    //  explicit 2MB pages can't be protected any finer, so require
+    //  loom pages at least that large
+    //
+    if (  (u3C.wag_w & u3o_hugepage)
+       && ((u3C.pag_y + 2) >= 21) )
+    {
+      map_v = mmap((void *)u3_Loom,
+                   len_i,
+                   (PROT_READ | PROT_WRITE),
+                   (MAP_ANON | MAP_FIXED | MAP_PRIVATE |
+                    MAP_HUGETLB | (21 << MAP_HUGE_SHIFT)),
+                   -1, 0);
+
+      if ( -1 == (c3_ps)map_v ) {
+        u3l_log("loom: huge page mapping failed, falling back\r\n");
+      }
+      else {
+        u3l_log("loom: mapped with huge pages\r\n");
+      }
+    }
+#endif
+
+    if ( -1 == (c3_ps)map_v ) {
+      map_v = mmap((void *)u3_Loom,
+                   len_i,
+                   (PROT_READ | PROT_WRITE),
+                   (MAP_ANON | MAP_FIXED | MAP_PRIVATE),
+                   -1, 0);
+
+#ifdef MADV_HUGEPAGE
+      //  otherwise, ask for transparent huge pages
+      //
+      if (  (-1 != (c3_ps)map_v)
+         && (u3C.wag_w & u3o_hugepage)
+         && (0 != madvise(map_v, len_i, MADV_HUGEPAGE)) )
+      {
+        u3l_log("loom: transparent huge pages: %s\r\n", strerror(errno));
+      }
+#endif
+    }
 
     if ( -1 == (c3_ps)map_v ) {
       map_v = mmap((void *)0,
@@ -1902,6 +1998,16 @@ u3m_boot(c3_c* dir_c, size_t len_i)
   if ( c3n == nuu_o ) {
     u3j_ream();
     u3n_ream();
+
+    //  version 2 and earlier memo cache entries are not [cre pro];
+    //  the cache is not state, so start fresh, with the configured bound
+    //
+    if ( 3 > u3H->ver_w ) {
+      u3h_free(u3R->cax.har_p);
+      u3R->cax.har_p = u3h_new_flat(u3_Host.ops_u.hap_w);
+    }
+
+    u3H->ver_w = u3v_version;
     return u3A->eve_d;
   }
   else {
@@ -1966,7 +2072,7 @@ _cm_pack_rewrite(void)
   //
   c3_assert( &(u3H->rod_u) == u3R );
 
-  //  NB: these implementations must be kept in sync with u3m_reclaim();
+  //  NB: these implementations must be kept in sync with u3m_pack();
   //  anything not reclaimed must be rewritable
   //
   u3v_rewrite_compact();
@@ -1984,7 +2090,11 @@ u3m_pack(void)
 
   //  reclaim first, to free space, and discard anything we can't/don't rewrite
   //
-  u3m_reclaim();
+  //    NB: the bytecode cache is rewritten, so compiled programs survive
+  //
+  u3v_reclaim();
+  u3j_reclaim();
+  u3a_reclaim();
 
   //  sweep the heap, finding and saving new locations
   //
@@ -1998,5 +2108,9 @@ u3m_pack(void)
   //
   u3a_pack_move(u3R);
 
+  //  refresh bytecode pointers in the relocated programs
+  //
+  u3n_ream();
+
   return (u3a_open(u3R) - pre_w);
 }
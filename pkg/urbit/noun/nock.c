@@ -508,7 +508,19 @@ _n_nock_on(u3_noun bus, u3_noun fol)
   X(KUTS, "kuts", &&do_kuts),  /* 92: c3_s */                                  \
   X(KITB, "kitb", &&do_kitb),  /* 93: c3_b */                                  \
   X(KITS, "kits", &&do_kits),  /* 94: c3_s */                                  \
-  X(LAST,   NULL,      NULL),  /* 95 */
+  /* superinstructions (see _n_fuse()) */                                      \
+  X(HESW, "hesw", &&do_hesw),  /* 95: head, swap */                            \
+  X(TASW, "tasw", &&do_tasw),  /* 96: tail, swap */                            \
+  X(FBSW, "fbsw", &&do_fbsw),  /* 97: c3_y, fragment, swap */                  \
+  X(HEAU, "heau", &&do_heau),  /* 98: head, auto */                            \
+  X(TAAU, "taau", &&do_taau),  /* 99: tail, auto */                            \
+  X(FBAU, "fbau", &&do_fbau),  /* 100: c3_y, fragment, auto */                 \
+  X(HEAL, "heal", &&do_heal),  /* 101: head, ault */                           \
+  X(TAAL, "taal", &&do_taal),  /* 102: tail, ault */                           \
+  X(FBAL, "fbal", &&do_fbal),  /* 103: c3_y, fragment, ault */                 \
+  X(FBSN, "fbsn", &&do_fbsn),  /* 104: c3_y, fragment, snoc */                 \
+  X(FBSL, "fbsl", &&do_fbsl),  /* 105: c3_y, fragment, snol */                 \
+  X(LAST,   NULL,      NULL),  /* 106 */
 
 // Opcodes. Define X to select the enum name from OPCODES.
 #define X(opcode, name, indirect_jump) opcode
@@ -528,6 +540,8 @@ _n_arg(c3_y cod_y)
     case BUSH: case BAST: case BALT:
     case MUTB: case KUTB: case MITB: case KITB:
     case HILB: case HINB:
+    case FBSW: case FBAU: case FBAL:
+    case FBSN: case FBSL:
       return sizeof(c3_y);
 
     case FASK: case FASL: case FISL: case FISK:
@@ -701,6 +715,7 @@ _n_prog_new(c3_w byc_w, c3_w cal_w,
   pog_u->byc_u.ops_y = (c3_y*) _n_prog_dat(pog_u);
 
   pog_u->lit_u.len_w = lit_w;
+  pog_u->lit_u.mug_w = 0;
   pog_u->lit_u.non   = (u3_noun*) (pog_u->byc_u.ops_y + pog_u->byc_u.len_w);
 
   pog_u->mem_u.len_w = mem_w;
@@ -715,6 +730,24 @@ _n_prog_new(c3_w byc_w, c3_w cal_w,
   return pog_u;
 }
 
+/* _n_prog_mug(): mug of bytecode and literals, keying the profile.
+**
+**   the literals are parts of the formula, mugged when it was looked
+**   up in the bytecode cache; this is cheap, and done once per program.
+*/
+static c3_w
+_n_prog_mug(u3n_prog* pog_u)
+{
+  c3_w mug_w = u3r_mug_bytes(pog_u->byc_u.ops_y, pog_u->byc_u.len_w);
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < pog_u->lit_u.len_w; i_w++ ) {
+    mug_w = u3r_mug_both(mug_w, u3r_mug(pog_u->lit_u.non[i_w]));
+  }
+
+  return mug_w;
+}
+
 /* _n_prog_old(): as _n_prog_new(),
  *                but leech off senior program's data segment
  */
@@ -733,6 +766,7 @@ _n_prog_old(u3n_prog* sep_u)
   pog_u->byc_u.ops_y = sep_u->byc_u.ops_y;
 
   pog_u->lit_u.len_w = sep_u->lit_u.len_w;
+  pog_u->lit_u.mug_w = sep_u->lit_u.mug_w;
   pog_u->lit_u.non   = (u3_noun*) _n_prog_dat(pog_u);
 
   pog_u->mem_u.len_w = sep_u->mem_u.len_w;
@@ -851,6 +885,8 @@ _n_prog_asm(u3_noun ops, u3n_prog* pog_u, u3_noun sip)
         case LITB: case LILB:
         case MUTB: case KUTB:
         case SAMB:
+        case FBSW: case FBAU: case FBAL:
+        case FBSN: case FBSL:
           buf_y[i_w--] = (c3_y) u3t(op);
           buf_y[i_w]   = (c3_y) cod;
           break;
@@ -900,9 +936,11 @@ _n_prog_asm(u3_noun ops, u3n_prog* pog_u, u3_noun sip)
           sit_u->lab   = u3_none;
           sit_u->jet_o = c3n;
           sit_u->fon_o = c3n;
+          sit_u->gen_w = 0;
           sit_u->cop_u = NULL;
           sit_u->ham_u = NULL;
           sit_u->fin_p = 0;
+          sit_u->pic_p = 0;
           break;
         }
       }
@@ -916,6 +954,185 @@ _n_prog_asm(u3_noun ops, u3n_prog* pog_u, u3_noun sip)
   c3_assert(u3_nul == sip);
 }
 
+/* _n_fuse_pair(): superinstruction for adjacent ops (from _n_comp), or none.
+ *
+ *   candidates are the most frequent adjacent pairs in compiled hoon:
+ *   a fragment of the subject pushed under the top (the head of an
+ *   autocons or nock 10), consed by AUTO/AULT (the tail of an autocons),
+ *   or pushed by SNOC/SNOL (=+).  only ops without, or with a direct
+ *   8-bit, argument are fused, so that operand sizes are known here.
+ */
+static u3_weak
+_n_fuse_pair(u3_noun one, u3_noun two)
+{
+  if ( c3y == u3du(two) ) {
+    return u3_none;
+  }
+  else if ( c3y == u3ud(one) ) {
+    switch ( one ) {
+      default: return u3_none;
+
+      case HEAD: switch ( two ) {
+        default:   return u3_none;
+        case SWAP: return HESW;
+        case AUTO: return HEAU;
+        case AULT: return HEAL;
+      }
+
+      case TAIL: switch ( two ) {
+        default:   return u3_none;
+        case SWAP: return TASW;
+        case AUTO: return TAAU;
+        case AULT: return TAAL;
+      }
+    }
+  }
+  else if ( FABK != u3h(one) ) {
+    return u3_none;
+  }
+  else {
+    c3_y fus_y;
+
+    switch ( two ) {
+      default:   return u3_none;
+      case SWAP: fus_y = FBSW; break;
+      case AUTO: fus_y = FBAU; break;
+      case AULT: fus_y = FBAL; break;
+      case SNOC: fus_y = FBSN; break;
+      case SNOL: fus_y = FBSL; break;
+    }
+
+    return u3nc(fus_y, u3k(u3t(one)));
+  }
+}
+
+/* _n_fuse_skip(): if op is a skip, produce its length in ops (else 0).
+ */
+static c3_w
+_n_fuse_skip(u3_noun op)
+{
+  if ( c3y == u3du(op) ) {
+    switch ( u3h(op) ) {
+      case SBIP: case SBIN:
+        return u3t(op);
+
+      case SKIB: case SLIB:
+        return u3h(u3t(op));
+    }
+  }
+  return 0;
+}
+
+/* _n_fuse(): peephole pass, replace op pairs (from _n_comp) with
+ *            superinstructions. TRANSFER ops, produce reversed op list.
+ *
+ *   skips are counted in ops, so no pair may straddle a skip target,
+ *   and skip lengths are recounted in the fused stream.
+ */
+static u3_noun
+_n_fuse(u3_noun ops)
+{
+  c3_w len_w = u3qb_lent(ops),
+       fus_w = 0,
+       i_w, j_w, sip_w;
+  u3_noun  *lis;
+  c3_y     *tar_y;
+  c3_w     *nex_w;
+  u3_weak  *fus;
+
+  if ( len_w < 2 ) {
+    return ops;
+  }
+
+  lis   = u3a_malloc(sizeof(u3_noun) * len_w);
+  fus   = u3a_malloc(sizeof(u3_weak) * len_w);
+  nex_w = u3a_malloc(sizeof(c3_w) * (len_w + 1));
+  tar_y = u3a_malloc(len_w + 1);
+  memset(tar_y, 0, len_w + 1);
+
+  //  lay out ops in program order, marking skip targets
+  //
+  {
+    u3_noun sop = ops;
+
+    for ( i_w = len_w; i_w-- > 0; ) {
+      lis[i_w] = u3h(sop);
+      sop      = u3t(sop);
+    }
+
+    for ( i_w = 0; i_w < len_w; i_w++ ) {
+      if ( (sip_w = _n_fuse_skip(lis[i_w])) ) {
+        c3_assert( (i_w + 1 + sip_w) <= len_w );
+        tar_y[i_w + 1 + sip_w] = 1;
+      }
+    }
+  }
+
+  //  choose pairs, and assign each op its index in the fused stream
+  //
+  for ( i_w = j_w = 0; i_w < len_w; j_w++ ) {
+    nex_w[i_w] = j_w;
+    fus[i_w]   = u3_none;
+
+    if (  ((i_w + 1) < len_w)
+       && !tar_y[i_w + 1]
+       && (u3_none != (fus[i_w] = _n_fuse_pair(lis[i_w], lis[i_w + 1]))) )
+    {
+      nex_w[i_w + 1] = j_w;
+      fus[i_w + 1]   = u3_none;
+      fus_w++;
+      i_w += 2;
+    }
+    else {
+      i_w++;
+    }
+  }
+  nex_w[len_w] = j_w;
+
+  //  emit, recounting skips
+  //
+  if ( fus_w ) {
+    u3_noun pos = u3_nul;
+
+    for ( i_w = 0; i_w < len_w; i_w++ ) {
+      u3_noun op = lis[i_w];
+
+      if ( u3_none != fus[i_w] ) {
+        pos = u3nc(fus[i_w], pos);
+        i_w++;
+      }
+      else if ( !(sip_w = _n_fuse_skip(op)) ) {
+        pos = u3nc(u3k(op), pos);
+      }
+      else {
+        sip_w = nex_w[i_w + 1 + sip_w] - nex_w[i_w + 1];
+
+        switch ( u3h(op) ) {
+          default: c3_assert(0);
+
+          case SBIP: case SBIN:
+            pos = u3nc(u3nc(u3h(op), sip_w), pos);
+            break;
+
+          case SKIB: case SLIB:
+            pos = u3nc(u3nt(u3h(op), sip_w, u3k(u3t(u3t(op)))), pos);
+            break;
+        }
+      }
+    }
+
+    u3z(ops);
+    ops = pos;
+  }
+
+  u3a_free(lis);
+  u3a_free(fus);
+  u3a_free(nex_w);
+  u3a_free(tar_y);
+
+  return ops;
+}
+
 /* _n_prog_from_ops(): new program from _n_comp() product
  */
 static u3n_prog*
@@ -929,9 +1146,11 @@ _n_prog_from_ops(u3_noun ops)
        lit_w = 0,
        mem_w = 0;
 
+  ops   = _n_fuse(ops);
   sip   = _n_melt(ops, &byc_w, &cal_w, &reg_w, &lit_w, &mem_w);
   pog_u = _n_prog_new(byc_w, cal_w, reg_w, lit_w, mem_w);
   _n_prog_asm(ops, pog_u, sip);
+  pog_u->lit_u.mug_w = _n_prog_mug(pog_u);
   return pog_u;
 }
 
@@ -1639,10 +1858,7 @@ _n_find(u3_noun pre, u3_noun fol)
           rit_u->own_o = c3n;
         }
         for ( i_w = 0; i_w < old->cal_u.len_w; ++i_w ) {
-          u3j_site* sit_u = &(old->cal_u.sit_u[i_w]);
-          sit_u->bat   = u3_none;
-          sit_u->pog_p = 0;
-          sit_u->fon_o = c3n;
+          u3j_site_lend(&(old->cal_u.sit_u[i_w]));
         }
         u3h_put(u3R->byc.har_p, key, u3a_outa(old));
         u3z(key);
@@ -1708,7 +1924,7 @@ _cn_intlen(c3_w num_w)
 }
 
 /* _cn_is_indexed(): return true if bop_w is an opcodes that uses pog_u->lit_u.non
-**            bop_w: opcode (assumed 0-94)
+**            bop_w: opcode (assumed 0-105)
 */
 c3_b
 _cn_is_indexed(c3_w bop_w)
@@ -2003,6 +2219,282 @@ typedef struct {
   c3_w     ip_w;
 } burnframe;
 
+#ifdef U3_CPU_DEBUG
+/* bytecode profile: counters for opcodes, programs and call sites.
+**
+**   enabled by -P (u3o_debug_cpu) in U3_CPU_DEBUG builds.  counters
+**   live off-loom, as they span roads; programs are keyed by the mug
+**   of their bytecode and literals, call sites by label (or battery)
+**   and axis.  see u3n_damp().
+*/
+typedef struct {
+  c3_w  mug_w;                        //  key (0 if empty)
+  c3_w  axe_w;                        //  call site axis
+  c3_d  hit_d;                        //  executions
+  c3_o  jet_o;                        //  call site has jet driver?
+  c3_c* nam_c;                        //  rendered label or bytecode
+} burncount;
+
+typedef struct {
+  c3_w       len_w;                   //  entries in use
+  c3_w       siz_w;                   //  capacity, power of 2
+  burncount* con_u;                   //  entries
+} burntable;
+
+static struct {
+  c3_d      ops_d[LAST];              //  per opcode
+  c3_d      par_d[LAST][LAST];        //  per adjacent opcode pair
+  c3_y      las_y;                    //  previous opcode
+  burntable pog_u;                    //  per program
+  burntable sit_u;                    //  per call site
+} _n_pro_u;
+
+/* _n_prof_find(): find or insert counter for [mug_w axe_w].
+*/
+static burncount*
+_n_prof_find(burntable* tab_u, c3_w mug_w, c3_w axe_w)
+{
+  c3_w i_w;
+
+  if ( (tab_u->len_w << 1) >= tab_u->siz_w ) {
+    burntable neu_u;
+
+    neu_u.len_w = 0;
+    neu_u.siz_w = tab_u->siz_w ? (tab_u->siz_w << 1) : 1024;
+    neu_u.con_u = c3_calloc(sizeof(burncount) * neu_u.siz_w);
+
+    for ( i_w = 0; i_w < tab_u->siz_w; i_w++ ) {
+      burncount* con_u = &(tab_u->con_u[i_w]);
+
+      if ( con_u->mug_w ) {
+        *_n_prof_find(&neu_u, con_u->mug_w, con_u->axe_w) = *con_u;
+      }
+    }
+
+    c3_free(tab_u->con_u);
+    *tab_u = neu_u;
+  }
+
+  i_w = u3r_mug_both(mug_w, axe_w) & (tab_u->siz_w - 1);
+
+  while ( 1 ) {
+    burncount* con_u = &(tab_u->con_u[i_w]);
+
+    if ( !con_u->mug_w ) {
+      con_u->mug_w = mug_w;
+      con_u->axe_w = axe_w;
+      con_u->jet_o = c3n;
+      tab_u->len_w++;
+      return con_u;
+    }
+    else if ( (mug_w == con_u->mug_w) && (axe_w == con_u->axe_w) ) {
+      return con_u;
+    }
+
+    i_w = (i_w + 1) & (tab_u->siz_w - 1);
+  }
+}
+
+/* _n_prof_etch(): render the first opcodes of a program.
+*/
+static c3_c*
+_n_prof_etch(u3n_prog* pog_u)
+{
+  c3_y* pog_y = pog_u->byc_u.ops_y;
+  c3_w  ip_w  = 0,
+        len_w = 0,
+        i_w;
+  c3_c* nam_c = c3_malloc(128);
+
+  len_w += snprintf(nam_c, 128, "%u:", pog_u->byc_u.len_w);
+
+  for ( i_w = 0; (i_w < 16) && (HALT != pog_y[ip_w]); i_w++ ) {
+    len_w += snprintf(nam_c + len_w, 128 - len_w, " %s",
+                      opcode_names[pog_y[ip_w]]);
+    ip_w  += 1 + _n_arg(pog_y[ip_w]);
+  }
+
+  if ( HALT != pog_y[ip_w] ) {
+    snprintf(nam_c + len_w, 128 - len_w, " ...");
+  }
+
+  return nam_c;
+}
+
+/* _n_prof_op(): count an opcode dispatch.
+*/
+static inline void
+_n_prof_op(c3_y cod_y)
+{
+  if ( u3C.wag_w & u3o_debug_cpu ) {
+    _n_pro_u.ops_d[cod_y]++;
+    _n_pro_u.par_d[_n_pro_u.las_y][cod_y]++;
+    _n_pro_u.las_y = cod_y;
+  }
+}
+
+/* _n_prof_prog(): count a program entry.
+*/
+static void
+_n_prof_prog(u3n_prog* pog_u)
+{
+  if ( u3C.wag_w & u3o_debug_cpu ) {
+    burncount* con_u = _n_prof_find(&_n_pro_u.pog_u, pog_u->lit_u.mug_w, 0);
+
+    con_u->hit_d++;
+
+    if ( !con_u->nam_c ) {
+      con_u->nam_c = _n_prof_etch(pog_u);
+    }
+  }
+}
+
+/* _n_prof_site(): count a kick, after the fact.
+**            bat_w: mug of the battery, used if the site is unlocated.
+*/
+static void
+_n_prof_site(u3j_site* sit_u, c3_w bat_w)
+{
+  if ( u3C.wag_w & u3o_debug_cpu ) {
+    c3_w mug_w = ( u3_none == sit_u->lab ) ? bat_w : u3r_mug(sit_u->lab);
+    burncount* con_u;
+
+    con_u = _n_prof_find(&_n_pro_u.sit_u, mug_w, u3r_mug(sit_u->axe));
+    con_u->hit_d++;
+    con_u->jet_o = sit_u->jet_o;
+
+    if ( !con_u->nam_c ) {
+      c3_c* axe_c = u3m_pretty(sit_u->axe);
+
+      if ( u3_none == sit_u->lab ) {
+        con_u->nam_c = c3_malloc(64);
+        snprintf(con_u->nam_c, 64, "+%s (battery 0x%x)", axe_c, bat_w);
+      }
+      else {
+        c3_c* lab_c = u3m_pretty_path(sit_u->lab);
+        c3_w  len_w = strlen(lab_c) + strlen(axe_c) + 3;
+
+        con_u->nam_c = c3_malloc(len_w);
+        snprintf(con_u->nam_c, len_w, "%s +%s", lab_c, axe_c);
+        c3_free(lab_c);
+      }
+
+      c3_free(axe_c);
+    }
+  }
+}
+
+/* _n_prof_rank(): qsort comparator, by descending count.
+*/
+static c3_i
+_n_prof_rank(const void* lef_v, const void* rit_v)
+{
+  c3_d lef_d = (*(burncount**)lef_v)->hit_d,
+       rit_d = (*(burncount**)rit_v)->hit_d;
+
+  return ( lef_d < rit_d ) ? 1 : ( lef_d > rit_d ) ? -1 : 0;
+}
+
+/* _n_prof_tell(): print and clear ranked table.
+*/
+static void
+_n_prof_tell(FILE* fil_u, c3_c* cap_c, burntable* tab_u, c3_w max_w)
+{
+  c3_d tot_d = 0;
+  c3_w i_w, j_w;
+  burncount** ran_u;
+
+  if ( !tab_u->len_w ) {
+    return;
+  }
+
+  ran_u = c3_malloc(sizeof(burncount*) * tab_u->len_w);
+
+  for ( i_w = j_w = 0; i_w < tab_u->siz_w; i_w++ ) {
+    if ( tab_u->con_u[i_w].mug_w ) {
+      ran_u[j_w++] = &(tab_u->con_u[i_w]);
+      tot_d       += tab_u->con_u[i_w].hit_d;
+    }
+  }
+
+  qsort(ran_u, j_w, sizeof(burncount*), _n_prof_rank);
+
+  fprintf(fil_u, "%s: %u distinct, %" PRIu64 " total\r\n",
+                 cap_c, tab_u->len_w, tot_d);
+
+  for ( i_w = 0; (i_w < j_w) && (i_w < max_w); i_w++ ) {
+    fprintf(fil_u, "  %12" PRIu64 " %5.2f%%%s %s\r\n",
+                   ran_u[i_w]->hit_d,
+                   (100.0 * ran_u[i_w]->hit_d) / tot_d,
+                   ( c3y == ran_u[i_w]->jet_o ) ? " jet" : "",
+                   ran_u[i_w]->nam_c);
+  }
+
+  for ( i_w = 0; i_w < tab_u->siz_w; i_w++ ) {
+    c3_free(tab_u->con_u[i_w].nam_c);
+  }
+
+  c3_free(ran_u);
+  c3_free(tab_u->con_u);
+  memset(tab_u, 0, sizeof(*tab_u));
+}
+#endif
+
+/* u3n_damp(): print and clear bytecode profile.
+*/
+void
+u3n_damp(FILE* fil_u)
+{
+#ifdef U3_CPU_DEBUG
+  c3_d tot_d = 0;
+  c3_w i_w, j_w;
+
+  for ( i_w = 0; i_w < LAST; i_w++ ) {
+    tot_d += _n_pro_u.ops_d[i_w];
+  }
+
+  if ( !tot_d ) {
+    return;
+  }
+
+  //  opcodes and opcode pairs, ranked by reusing the table printer
+  //
+  {
+    burntable tab_u = {0};
+
+    for ( i_w = 0; i_w < LAST; i_w++ ) {
+      if ( _n_pro_u.ops_d[i_w] ) {
+        burncount* con_u = _n_prof_find(&tab_u, 1 + i_w, 0);
+        con_u->hit_d = _n_pro_u.ops_d[i_w];
+        con_u->nam_c = strdup(opcode_names[i_w]);
+      }
+    }
+
+    _n_prof_tell(fil_u, "bytecode: opcodes", &tab_u, LAST);
+
+    for ( i_w = 0; i_w < LAST; i_w++ ) {
+      for ( j_w = 0; j_w < LAST; j_w++ ) {
+        if ( _n_pro_u.par_d[i_w][j_w] ) {
+          burncount* con_u = _n_prof_find(&tab_u, 1 + i_w, 1 + j_w);
+          con_u->hit_d = _n_pro_u.par_d[i_w][j_w];
+          con_u->nam_c = c3_malloc(10);
+          snprintf(con_u->nam_c, 10, "%s %s",
+                   opcode_names[i_w], opcode_names[j_w]);
+        }
+      }
+    }
+
+    _n_prof_tell(fil_u, "bytecode: opcode pairs", &tab_u, 64);
+  }
+
+  _n_prof_tell(fil_u, "bytecode: programs", &_n_pro_u.pog_u, 64);
+  _n_prof_tell(fil_u, "bytecode: call sites", &_n_pro_u.sit_u, 64);
+
+  memset(_n_pro_u.ops_d, 0, sizeof(_n_pro_u.ops_d));
+  memset(_n_pro_u.par_d, 0, sizeof(_n_pro_u.par_d));
+#endif
+}
+
 /* _n_burn(): pog: program
  *            bus: subject (TRANSFER)
  *            mov: -1 north, 1 south
@@ -2033,9 +2525,12 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
 
 #ifdef U3_CPU_DEBUG
   u3R->pro.nox_d += 1;
+  _n_prof_prog(pog_u);
 #endif
-#ifdef VERBOSE_BYTECODE
+#if defined(VERBOSE_BYTECODE)
   #define BURN() fprintf(stderr, "%s ", opcode_names[pog[ip_w]]); goto *lab[pog[ip_w++]]
+#elif defined(U3_CPU_DEBUG)
+  #define BURN() _n_prof_op(pog[ip_w]); goto *lab[pog[ip_w++]]
 #else
   #define BURN() goto *lab[pog[ip_w++]]
 #endif
@@ -2247,6 +2742,7 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
       ip_w  = 0;
 #ifdef U3_CPU_DEBUG
     u3R->pro.nox_d += 1;
+    _n_prof_prog(pog_u);
 #endif
 #ifdef VERBOSE_BYTECODE
       fprintf(stderr, "\r\nnock jump: %u\r\n", o);
@@ -2394,7 +2890,14 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
       sit_u = &(pog_u->cal_u.sit_u[x]);
       top   = _n_peek(off);
       o     = *top;
+#ifdef U3_CPU_DEBUG
+      x     = ( (u3C.wag_w & u3o_debug_cpu) && (c3y == u3du(o)) )
+              ? u3r_mug(u3h(o)) : 0;
+#endif
       *top = _n_kick(o, sit_u);
+#ifdef U3_CPU_DEBUG
+      _n_prof_site(sit_u, x);
+#endif
       if ( u3_none == *top ) {
         _n_toss(mov, off);
 
@@ -2408,6 +2911,7 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
         ip_w  = 0;
 #ifdef U3_CPU_DEBUG
     u3R->pro.nox_d += 1;
+    _n_prof_prog(pog_u);
 #endif
 #ifdef VERBOSE_BYTECODE
         fprintf(stderr, "\r\nhead kick jump: %u, sp: %p\r\n", u3r_at(sit_u->axe, cor), top);
@@ -2432,7 +2936,14 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
       sit_u = &(pog_u->cal_u.sit_u[x]);
       top   = _n_peek(off);
       o     = *top;
+#ifdef U3_CPU_DEBUG
+      x     = ( (u3C.wag_w & u3o_debug_cpu) && (c3y == u3du(o)) )
+              ? u3r_mug(u3h(o)) : 0;
+#endif
       *top = _n_kick(o, sit_u);
+#ifdef U3_CPU_DEBUG
+      _n_prof_site(sit_u, x);
+#endif
       if ( u3_none == *top ) {
         *top  = o;
         pog_u = u3to(u3n_prog, sit_u->pog_p);
@@ -2440,6 +2951,7 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
         ip_w  = 0;
 #ifdef U3_CPU_DEBUG
     u3R->pro.nox_d += 1;
+    _n_prof_prog(pog_u);
 #endif
 #ifdef VERBOSE_BYTECODE
         fprintf(stderr, "\r\ntail kick jump: %u, sp: %p\r\n", u3x_at(sit_u->axe, o);, top);
@@ -2745,6 +3257,80 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
     edit_in:
       *top = u3i_edit(*top, x, o);
       BURN();
+
+    do_hesw:                        // [bus]
+      top = _n_peek(off);
+      x   = u3h(_n_kale(*top));
+      goto frag_sw;
+
+    do_tasw:
+      top = _n_peek(off);
+      x   = u3t(_n_kale(*top));
+      goto frag_sw;
+
+    do_fbsw:
+      x   = pog[ip_w++];
+      top = _n_peek(off);
+      x   = u3x_at(x, *top);
+    frag_sw:
+      _n_push(mov, off, u3k(x));    // [fag bus]
+      _n_swap(mov, off);            // [bus fag]
+      BURN();
+
+    do_heau:                        // [bus hed]
+      top = _n_peek(off);
+      x   = u3h(_n_kale(*top));
+      goto frag_au;
+
+    do_taau:
+      top = _n_peek(off);
+      x   = u3t(_n_kale(*top));
+      goto frag_au;
+
+    do_fbau:
+      x   = pog[ip_w++];
+      top = _n_peek(off);
+      x   = u3x_at(x, *top);
+    frag_au:
+      x    = u3k(x);
+      top  = _n_swap(mov, off);     // [hed bus]
+      *top = u3nc(*top, x);         // [pro bus]
+      BURN();
+
+    do_heal:                        // [bus hed]
+      top = _n_peek(off);
+      x   = u3h(_n_kale(*top));
+      goto frag_al;
+
+    do_taal:
+      top = _n_peek(off);
+      x   = u3t(_n_kale(*top));
+      goto frag_al;
+
+    do_fbal:
+      x   = pog[ip_w++];
+      top = _n_peek(off);
+      x   = u3x_at(x, *top);
+    frag_al:
+      x    = u3k(x);
+      _n_toss(mov, off);            // [hed]
+      top  = _n_peek(off);
+      *top = u3nc(*top, x);         // [pro]
+      BURN();
+
+    do_fbsn:                        // [bus]
+      x   = pog[ip_w++];
+      top = _n_peek(off);
+      x   = u3k(u3x_at(x, *top));
+      _n_push(mov, off, u3nc(x, u3k(*top)));
+      BURN();
+
+    do_fbsl:
+      x    = pog[ip_w++];
+      top  = _n_peek(off);
+      x    = u3k(u3x_at(x, *top));
+      *top = u3nc(x, *top);
+      BURN();
   }
 }
 
@@ -2850,6 +3436,7 @@ _cn_take_prog_cb(u3p(u3n_prog) pog_p)
                         pog_u->lit_u.len_w,
                         pog_u->mem_u.len_w);
     memcpy(gop_u->byc_u.ops_y, pog_u->byc_u.ops_y, pog_u->byc_u.len_w);
+    gop_u->lit_u.mug_w = pog_u->lit_u.mug_w;
   }
   else {
     gop_u = _n_prog_old(pog_u);
@@ -2949,12 +3536,34 @@ _n_ream(u3_noun kev)
   pog_u->mem_u.sot_u = (u3n_memo*) (pog_u->lit_u.non + pog_u->lit_u.len_w);
   pog_u->cal_u.sit_u = (u3j_site*) (pog_u->mem_u.sot_u + pog_u->mem_u.len_w);
   pog_u->reg_u.rit_u = (u3j_rite*) (pog_u->cal_u.sit_u + pog_u->cal_u.len_w);
+  pog_u->lit_u.mug_w = _n_prog_mug(pog_u);
 
   for ( i_w = 0; i_w < pog_u->cal_u.len_w; ++i_w ) {
     u3j_site_ream(&(pog_u->cal_u.sit_u[i_w]));
   }
 }
 
+/* _n_bare(): forget unregistered batteries at program call sites.
+*/
+static void
+_n_bare(u3_noun kev)
+{
+  c3_w i_w;
+  u3n_prog* pog_u = u3to(u3n_prog, u3t(kev));
+
+  for ( i_w = 0; i_w < pog_u->cal_u.len_w; ++i_w ) {
+    pog_u->cal_u.sit_u[i_w].gen_w = 0;
+  }
+}
+
+/* u3n_bare(): forget unregistered batteries at call sites in [har_p].
+*/
+void
+u3n_bare(u3p(u3h_root) har_p)
+{
+  u3h_walk(har_p, _n_bare);
+}
+
 /* u3n_ream(): refresh after restoring from checkpoint.
 */
 void
@@ -3025,30 +3634,64 @@ u3n_reclaim(void)
   //    Note that the hank cache *must* also be freed (in u3j_reclaim())
   //
   u3n_free();
-  u3R->byc.har_p = u3h_new();
+  u3R->byc.har_p = u3h_new_flat(0);
+}
+
+/* _n_prog_rewrite(): rewrite program contents for compaction.
+*/
+static void
+_n_prog_rewrite(u3n_prog* pog_u)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < pog_u->lit_u.len_w; ++i_w ) {
+    u3_noun som = pog_u->lit_u.non[i_w];
+    u3a_rewrite_noun(som);
+    pog_u->lit_u.non[i_w] = u3a_rewritten_noun(som);
+  }
+
+  for ( i_w = 0; i_w < pog_u->mem_u.len_w; ++i_w ) {
+    u3_noun som = pog_u->mem_u.sot_u[i_w].key;
+    u3a_rewrite_noun(som);
+    pog_u->mem_u.sot_u[i_w].key = u3a_rewritten_noun(som);
+  }
+
+  for ( i_w = 0; i_w < pog_u->cal_u.len_w; ++i_w ) {
+    u3j_site_rewrite(&(pog_u->cal_u.sit_u[i_w]));
+  }
+
+  for ( i_w = 0; i_w < pog_u->reg_u.len_w; ++i_w ) {
+    u3j_rite_rewrite(&(pog_u->reg_u.rit_u[i_w]));
+  }
+}
+
+/* _n_ward(): u3h_walk helper for u3n_rewrite_compact
+ */
+static void
+_n_ward(u3_noun kev)
+{
+  //  the value is a post to a u3n_prog, which u3h_rewrite() would
+  //  mistake for a direct atom; we rewrite it in place
+  //
+  u3a_cell* kev_u = u3a_to_ptr(kev);
+
+  _n_prog_rewrite(u3to(u3n_prog, kev_u->tel));
+  kev_u->tel = u3a_rewritten_mptr(kev_u->tel);
 }
 
 /* u3n_rewrite_compact(): rewrite the bytecode cache for compaction.
  *
- * NB: u3R->byc.har_p *must* be cleared (currently via u3n_reclaim above),
- * since it contains things that look like nouns but aren't.
- * Specifically, it contains "cells" where the tail is a
- * pointer to a u3a_malloc'ed block that contains loom pointers.
- *
- * You should be able to walk this with u3h_walk and rewrite the
- * pointers, but you need to be careful to handle that u3a_malloc
- * pointers can't be turned into a box by stepping back two words. You
- * must step back one word to get the padding, step then step back that
- * many more words (plus one?).
+ * NB: the interior pointers of each u3n_prog are stale after the heap
+ * has been moved, and must be refreshed with u3n_ream().
  */
 void
 u3n_rewrite_compact()
 {
+  u3h_walk(u3R->byc.har_p, _n_ward);
   u3h_rewrite(u3R->byc.har_p);
   u3R->byc.har_p = u3a_rewritten(u3R->byc.har_p);
 }
 
-
 /* _n_feb(): u3h_walk helper for u3n_free
  */
 static void
@@ -1262,6 +1262,69 @@ u3r_mp(mpz_t   a_mp,
   }
 }
 
+/* u3r_mpn_view():
+**
+**   View (b) as GMP limbs in (a_u), without copying if possible.
+**
+**   The loom is little-endian words, so a limb-aligned buffer of
+**   whole limbs can be handed to mpn_*() as-is; anything else
+**   (odd word count, misaligned box) is copied once.
+*/
+void
+u3r_mpn_view(u3r_mpn* a_u,
+             u3_atom  b)
+{
+  c3_assert(u3_none != b);
+  c3_assert(_(u3a_is_atom(b)));
+
+#if GMP_NAIL_BITS
+#  error "u3r_mpn_view: nail bits unsupported"
+#endif
+
+  a_u->cop_mp = 0;
+
+  if ( _(u3a_is_cat(b)) ) {
+    a_u->sat_mp = b;
+    a_u->buf_mp = &a_u->sat_mp;
+    a_u->len_mp = ( 0 == b ) ? 0 : 1;
+  }
+  else {
+    u3a_atom* b_u   = u3a_to_ptr(b);
+    c3_w      len_w = b_u->len_w;
+    c3_w      wiz_w = c3_wiseof(mp_limb_t);
+
+    a_u->len_mp = (len_w + (wiz_w - 1)) / wiz_w;
+
+    if (  !(len_w % wiz_w)
+       && !((c3_p)b_u->buf_w % sizeof(mp_limb_t)) )
+    {
+      a_u->buf_mp = (const mp_limb_t*)b_u->buf_w;
+    }
+    else {
+      mp_limb_t* cop_mp = u3a_malloc(a_u->len_mp * sizeof(mp_limb_t));
+
+      cop_mp[a_u->len_mp - 1] = 0;
+      memcpy(cop_mp, b_u->buf_w, (size_t)len_w << 2);
+
+      a_u->cop_mp = cop_mp;
+      a_u->buf_mp = cop_mp;
+    }
+  }
+}
+
+/* u3r_mpn_free():
+**
+**   Release (a_u).
+*/
+void
+u3r_mpn_free(u3r_mpn* a_u)
+{
+  if ( a_u->cop_mp ) {
+    u3a_free(a_u->cop_mp);
+    a_u->cop_mp = 0;
+  }
+}
+
 /* u3r_short():
 **
 **   Return short (a_w) of (b).
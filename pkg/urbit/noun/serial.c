@@ -434,13 +434,103 @@ typedef struct _cue_frame_s {
   c3_d  bit_d;
 } _cue_frame_t;
 
+/* _cs_cue_feed: streaming input for cue, from a file or a mapping.
+*/
+typedef struct _cs_cue_feed {
+  c3_i  fid_i;                          //  source file, or -1 if mapped
+  c3_y* buf_y;                          //  read window, or mapping
+  c3_d  siz_d;                          //  window size
+  c3_d  len_d;                          //  mapping size
+  c3_d  rel_d;                          //  mapped bytes released
+  c3_o  eof_o;                          //  source exhausted
+} _cs_cue_feed;
+
+#define _cs_cue_feed_chunk  (1ULL << 20)  //  read size
+#define _cs_cue_feed_fall   (1ULL << 26)  //  mapped release interval
+
+/* _cs_cue_feed_need(): ensure [need_d] bytes are readable (or all that remain).
+**
+**   A file is read in chunks into a window, sliding unread bytes to
+**   its front; a mapping is already readable, and pages behind the
+**   cursor are released as it advances.  Either way, what's been
+**   consumed is no longer resident: backreferences are resolved
+**   through the dictionary.
+*/
+static ur_cue_res_e
+_cs_cue_feed_need(_cs_cue_feed* fed_u, ur_bsr_t* red_u, c3_d need_d)
+{
+  if ( -1 == fed_u->fid_i ) {
+#ifdef MADV_DONTNEED
+    c3_d pos_d = ( red_u->bytes )
+                 ? (c3_d)(red_u->bytes - fed_u->buf_y)
+                 : fed_u->len_d;
+
+    if ( (pos_d - fed_u->rel_d) >= _cs_cue_feed_fall ) {
+      c3_d end_d = pos_d & ~((c3_d)sysconf(_SC_PAGESIZE) - 1);
+
+      madvise(fed_u->buf_y + fed_u->rel_d, end_d - fed_u->rel_d,
+              MADV_DONTNEED);
+      fed_u->rel_d = end_d;
+    }
+#endif
+    return ur_cue_good;
+  }
+  else if ( (red_u->left >= need_d) || (c3y == fed_u->eof_o) ) {
+    return ur_cue_good;
+  }
+  else {
+    c3_d lef_d = red_u->left;
+
+    if ( lef_d ) {
+      memmove(fed_u->buf_y, red_u->bytes, lef_d);
+    }
+
+    if ( need_d > fed_u->siz_d ) {
+      fed_u->siz_d = need_d + _cs_cue_feed_chunk;
+      fed_u->buf_y = c3_realloc(fed_u->buf_y, fed_u->siz_d);
+    }
+
+    while ( lef_d < fed_u->siz_d ) {
+      ssize_t ret_i = read(fed_u->fid_i, fed_u->buf_y + lef_d,
+                                         fed_u->siz_d - lef_d);
+
+      if ( 0 > ret_i ) {
+        if ( EINTR == errno ) {
+          continue;
+        }
+
+        fprintf(stderr, "cue: read failed: %s\r\n", strerror(errno));
+        return ur_cue_gone;
+      }
+      else if ( 0 == ret_i ) {
+        fed_u->eof_o = c3y;
+        break;
+      }
+
+      lef_d += ret_i;
+    }
+
+    //  bit-cursor (and backreferences) must fit in 62-bit direct atoms
+    //
+    if ( 0x3fffffffffffffffULL < (red_u->bits + (lef_d << 3)) ) {
+      return ur_cue_meme;
+    }
+
+    red_u->bytes = ( lef_d ) ? fed_u->buf_y : 0;
+    red_u->left  = lef_d;
+
+    return ur_cue_good;
+  }
+}
+
 /* _cs_cue_xeno_next(): read next value from bitstream, dictionary off-loom.
 */
 static inline ur_cue_res_e
-_cs_cue_xeno_next(u3a_pile*    pil_u,
-                  ur_bsr_t*    red_u,
-                  ur_dict32_t* dic_u,
-                  u3_noun*       out)
+_cs_cue_xeno_next(u3a_pile*     pil_u,
+                  _cs_cue_feed* fed_u,
+                  ur_bsr_t*     red_u,
+                  ur_dict32_t*  dic_u,
+                  u3_noun*        out)
 {
   ur_root_t* rot_u = 0;
 
@@ -449,6 +539,14 @@ _cs_cue_xeno_next(u3a_pile*    pil_u,
     ur_cue_tag_e tag_e;
     ur_cue_res_e res_e;
 
+    //  enough for a tag, a length, and a backref or direct atom
+    //
+    if (  fed_u
+       && (ur_cue_good != (res_e = _cs_cue_feed_need(fed_u, red_u, 64))) )
+    {
+      return res_e;
+    }
+
     if ( ur_cue_good != (res_e = ur_bsr_tag(red_u, &tag_e)) ) {
       return res_e;
     }
@@ -499,6 +597,13 @@ _cs_cue_xeno_next(u3a_pile*    pil_u,
           if ( 0xffffffffULL < byt_d) {
             return ur_cue_meme;
           }
+          else if (  fed_u
+                  && (ur_cue_good != (res_e = _cs_cue_feed_need(fed_u,
+                                                                red_u,
+                                                                1 + byt_d))) )
+          {
+            return res_e;
+          }
           else {
             u3i_slab_init(&sab_u, 3, byt_d);
             ur_bsr_bytes_any(red_u, len_d, sab_u.buf_y);
@@ -520,9 +625,10 @@ struct _u3_cue_xeno {
 /* _cs_cue_xeno(): cue on-loom, with off-loom dictionary in handle.
 */
 static u3_weak
-_cs_cue_xeno(u3_cue_xeno* sil_u,
-             c3_d         len_d,
-             const c3_y*  byt_y)
+_cs_cue_xeno(u3_cue_xeno*  sil_u,
+             _cs_cue_feed* fed_u,
+             c3_d          len_d,
+             const c3_y*   byt_y)
 {
   ur_bsr_t      red_u = {0};
   ur_dict32_t*  dic_u = &sil_u->dic_u;
@@ -548,7 +654,7 @@ _cs_cue_xeno(u3_cue_xeno* sil_u,
 
   //  advance into stream
   //
-  res_e = _cs_cue_xeno_next(&pil_u, &red_u, dic_u, &ref);
+  res_e = _cs_cue_xeno_next(&pil_u, fed_u, &red_u, dic_u, &ref);
 
   //  process cell results
   //
@@ -562,7 +668,7 @@ _cs_cue_xeno(u3_cue_xeno* sil_u,
       //
       if ( u3_none == fam_u->ref ) {
         fam_u->ref = ref;
-        res_e = _cs_cue_xeno_next(&pil_u, &red_u, dic_u, &ref);
+        res_e = _cs_cue_xeno_next(&pil_u, fed_u, &red_u, dic_u, &ref);
         fam_u = u3a_peek(&pil_u);
       }
       //  f is a tail-frame; pop the stack and continue
@@ -631,7 +737,56 @@ u3s_cue_xeno_with(u3_cue_xeno* sil_u,
 
   c3_assert( &(u3H->rod_u) == u3R );
 
-  som = _cs_cue_xeno(sil_u, len_d, byt_y);
+  som = _cs_cue_xeno(sil_u, 0, len_d, byt_y);
+  ur_dict32_wipe(&sil_u->dic_u);
+  return som;
+}
+
+/* u3s_cue_xeno_fd(): cue on-loom from a file, reading it in chunks.
+*/
+u3_weak
+u3s_cue_xeno_fd(u3_cue_xeno* sil_u, c3_i fid_i)
+{
+  _cs_cue_feed fed_u = {0};
+  u3_weak        som;
+
+  c3_assert( &(u3H->rod_u) == u3R );
+
+#ifdef POSIX_FADV_SEQUENTIAL
+  posix_fadvise(fid_i, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+  fed_u.fid_i = fid_i;
+  fed_u.eof_o = c3n;
+  fed_u.siz_d = _cs_cue_feed_chunk;
+  fed_u.buf_y = c3_malloc(fed_u.siz_d);
+
+  som = _cs_cue_xeno(sil_u, &fed_u, 0, 0);
+  ur_dict32_wipe(&sil_u->dic_u);
+  c3_free(fed_u.buf_y);
+  return som;
+}
+
+/* u3s_cue_xeno_mmap(): cue on-loom from a read-only file mapping,
+**                      releasing its pages as they're consumed.
+*/
+u3_weak
+u3s_cue_xeno_mmap(u3_cue_xeno* sil_u, c3_d len_d, c3_y* byt_y)
+{
+  _cs_cue_feed fed_u = {0};
+  u3_weak        som;
+
+  c3_assert( &(u3H->rod_u) == u3R );
+
+#ifdef MADV_SEQUENTIAL
+  madvise(byt_y, len_d, MADV_SEQUENTIAL);
+#endif
+
+  fed_u.fid_i = -1;
+  fed_u.buf_y = byt_y;
+  fed_u.len_d = len_d;
+
+  som = _cs_cue_xeno(sil_u, &fed_u, len_d, byt_y);
   ur_dict32_wipe(&sil_u->dic_u);
   return som;
 }
@@ -657,7 +812,7 @@ u3s_cue_xeno(c3_d        len_d,
   c3_assert( &(u3H->rod_u) == u3R );
 
   sil_u = u3s_cue_xeno_init();
-  som   = _cs_cue_xeno(sil_u, len_d, byt_y);
+  som   = _cs_cue_xeno(sil_u, 0, len_d, byt_y);
   u3s_cue_xeno_done(sil_u);
   return som;
 }
@@ -221,7 +221,7 @@ u3v_peek(u3_noun sam)
 u3_noun
 u3v_soft_peek(c3_w mil_w, u3_noun sam)
 {
-  u3_noun gon = u3m_soft(mil_w, u3v_peek, sam);
+  u3_noun gon = u3m_soft_sand(mil_w, u3v_peek, sam);
   u3_noun tag, dat;
   u3x_cell(gon, &tag, &dat);
 
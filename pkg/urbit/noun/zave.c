@@ -3,6 +3,150 @@
 */
 #include "all.h"
 
+/*  memo cache entries are stored as [cre=@ pro], where [cre] is an
+**  eviction credit: compute cost per retained word, capped.  the clock
+**  arm spends one unit of credit each time it would otherwise evict a
+**  cold entry, so expensive, compact results survive longer (a clock
+**  approximation of GreedyDual-Size).
+**
+**  cost is measured from a cache miss to the corresponding save, in
+**  nock steps if they're being counted (U3_CPU_DEBUG), or microseconds.
+*/
+#define _cz_credit_max  255
+#define _cz_size_max    4096
+#define _cz_pend_bits   8
+
+/* _cz_pend: cost measurement, keyed by mug of an unsaved miss.
+*/
+static struct {
+  c3_w mug_w;
+  c3_d tic_d;
+} _cz_pend[1 << _cz_pend_bits];
+
+/* _cz_stat: memo cache statistics, since process start.
+*/
+static struct {
+  c3_d hit_d;                           //  lookups found
+  c3_d mis_d;                           //  lookups missed
+  c3_d sav_d;                           //  entries saved
+  c3_d spa_d;                           //  evictions deferred by credit
+  c3_d evi_d;                           //  entries evicted by credit
+} _cz_stat;
+
+/* _cz_tick(): read compute-cost clock.
+*/
+static c3_d
+_cz_tick(void)
+{
+#ifdef U3_CPU_DEBUG
+  return u3R->pro.nox_d;
+#else
+  return u3t_trace_time();
+#endif
+}
+
+/* _cz_size(): estimate words retained by [som], giving up at [max_w].
+*/
+static c3_w
+_cz_size(u3_noun som, c3_w max_w)
+{
+  c3_w siz_w = 0;
+
+  while ( siz_w < max_w ) {
+    if ( c3y == u3a_is_cat(som) ) {
+      break;
+    }
+    else if ( c3y == u3a_is_pug(som) ) {
+      u3a_atom* vat_u = u3a_to_ptr(som);
+      siz_w += c3_wiseof(u3a_atom) + vat_u->len_w;
+      break;
+    }
+    else {
+      siz_w += c3_wiseof(u3a_cell);
+
+      if ( siz_w < max_w ) {
+        siz_w += _cz_size(u3h(som), max_w - siz_w);
+      }
+
+      som = u3t(som);
+    }
+  }
+
+  return siz_w;
+}
+
+/* _cz_credit(): eviction credit, by compute cost per retained word.
+*/
+static c3_w
+_cz_credit(c3_d cos_d, c3_w siz_w)
+{
+  c3_d rat_d = cos_d / c3_max(1, siz_w);
+
+  return (c3_w)c3_min((c3_d)_cz_credit_max, rat_d);
+}
+
+/* _cz_spare(): clock callback, spend credit to spare a cold entry.
+*/
+static c3_o
+_cz_spare(u3_noun kev)
+{
+  //  the [cre pro] cell is private to the cache, and may be edited
+  //
+  u3a_cell* cel_u = u3a_to_ptr(u3t(kev));
+
+  if ( 0 == cel_u->hed ) {
+    _cz_stat.evi_d++;
+    return c3n;
+  }
+
+  cel_u->hed--;
+  cel_u->mug_w = 0;
+  _cz_stat.spa_d++;
+  return c3y;
+}
+
+/* _cz_find(): find in memo cache, starting the cost clock on miss.
+*/
+static u3_weak
+_cz_find(u3_noun key)
+{
+  u3_weak ent = u3h_git(u3R->cax.har_p, key);
+
+  if ( u3_none == ent ) {
+    c3_w mug_w = u3r_mug(key);
+    c3_w inx_w = mug_w & ((1 << _cz_pend_bits) - 1);
+
+    _cz_pend[inx_w].mug_w = mug_w;
+    _cz_pend[inx_w].tic_d = _cz_tick();
+    _cz_stat.mis_d++;
+    return u3_none;
+  }
+
+  _cz_stat.hit_d++;
+  return u3k(u3t(ent));
+}
+
+/* _cz_save(): save in memo cache, charging for the cost since miss.
+**             RETAIN key; TRANSFER val.
+*/
+static void
+_cz_save(u3_noun key, u3_noun val)
+{
+  c3_w mug_w = u3r_mug(key);
+  c3_w inx_w = mug_w & ((1 << _cz_pend_bits) - 1);
+  c3_d cos_d = 0;
+  c3_w cre_w;
+
+  if ( mug_w == _cz_pend[inx_w].mug_w ) {
+    cos_d = _cz_tick() - _cz_pend[inx_w].tic_d;
+    _cz_pend[inx_w].mug_w = 0;
+  }
+
+  cre_w = _cz_credit(cos_d, _cz_size(val, _cz_size_max));
+  u3h_put_with(u3R->cax.har_p, key, u3nc(cre_w, val), _cz_spare);
+  _cz_stat.sav_d++;
+}
+
 /* u3z_key(): construct a memo cache-key.  Arguments retained.
 */
 u3_noun
@@ -36,7 +180,7 @@ u3z_key_5(c3_m fun, u3_noun one, u3_noun two, u3_noun tri, u3_noun qua, u3_noun
 u3_weak
 u3z_find(u3_noun key)
 {
-  return u3h_get(u3R->cax.har_p, key);
+  return _cz_find(key);
 }
 u3_weak
 u3z_find_m(c3_m fun, u3_noun one)
@@ -44,7 +188,7 @@ u3z_find_m(c3_m fun, u3_noun one)
   u3_noun key = u3nc(fun, u3k(one));
   u3_weak val;
 
-  val = u3h_get(u3R->cax.har_p, key);
+  val = _cz_find(key);
   u3z(key);
   return val;
 }
@@ -54,7 +198,7 @@ u3z_find_m(c3_m fun, u3_noun one)
 u3_noun
 u3z_save(u3_noun key, u3_noun val)
 {
-  u3h_put(u3R->cax.har_p, key, u3k(val));
+  _cz_save(key, u3k(val));
   u3z(key);
   return val;
 }
@@ -66,7 +210,7 @@ u3z_save_m(c3_m fun, u3_noun one, u3_noun val)
 {
   u3_noun key = u3nc(fun, u3k(one));
 
-  u3h_put(u3R->cax.har_p, key, u3k(val));
+  _cz_save(key, u3k(val));
   u3z(key);
   return val;
 }
@@ -77,13 +221,31 @@ u3_noun
 u3z_uniq(u3_noun som)
 {
   u3_noun key = u3nc(c3__uniq, u3k(som));
-  u3_noun val = u3h_get(u3R->cax.har_p, key);
+  u3_noun val = _cz_find(key);
 
   if ( u3_none != val ) {
     u3z(key); u3z(som); return val;
   }
   else {
-    u3h_put(u3R->cax.har_p, key, u3k(som));
+    _cz_save(key, u3k(som));
+    u3z(key);
     return som;
   }
 }
+
+/* u3z_mark(): mark memo cache for gc, printing statistics.
+*/
+c3_w
+u3z_mark(FILE* fil_u)
+{
+  if ( fil_u ) {
+    fprintf(fil_u, "  memoization: hits %" PRIu64 ", misses %" PRIu64
+                   ", saves %" PRIu64 "\r\n",
+                   _cz_stat.hit_d, _cz_stat.mis_d, _cz_stat.sav_d);
+    fprintf(fil_u, "  memoization: evicted %" PRIu64
+                   ", spared %" PRIu64 " (by credit)\r\n",
+                   _cz_stat.evi_d, _cz_stat.spa_d);
+  }
+
+  return u3a_maid(fil_u, "  memoization cache", u3h_mark(u3R->cax.har_p));
+}
@@ -0,0 +1,352 @@
+#include "all.h"
+
+/* _setup(): prepare for tests.
+*/
+static void
+_setup(void)
+{
+  u3m_init(1 << 26);
+  u3m_pave(c3y);
+  u3e_init();
+}
+
+//  length of an allocation boxed in the small-atom slab [i_w] (from 1)
+//
+#define _slab_len(i_w)  (u3a_minimum + (i_w) - (c3_wiseof(u3a_box) + 1))
+
+/* _test_slab_reuse(): freed small boxes are reused by size.
+*/
+static c3_i
+_test_slab_reuse(void)
+{
+  c3_i ret_i = 1;
+  c3_w i_w;
+
+  while ( u3a_reflux() );
+
+  for ( i_w = 1; i_w <= u3a_slab_no; i_w++ ) {
+    c3_w* fir_w = u3a_walloc(_slab_len(i_w));
+    c3_w* sec_w;
+
+    if ( (u3a_minimum + i_w) != u3a_botox(fir_w)->siz_w ) {
+      fprintf(stderr, "slab reuse: %u: size %u\r\n",
+                      i_w, u3a_botox(fir_w)->siz_w);
+      ret_i = 0;
+    }
+
+    u3a_wfree(fir_w);
+
+    if ( 1 != u3R->sab.len_w[i_w - 1] ) {
+      fprintf(stderr, "slab reuse: %u: not cached\r\n", i_w);
+      ret_i = 0;
+    }
+
+    //  other sizes are not served from this slab
+    //
+    if ( i_w < u3a_slab_no ) {
+      c3_w* oth_w = u3a_walloc(_slab_len(i_w + 1));
+
+      if ( oth_w == fir_w ) {
+        fprintf(stderr, "slab reuse: %u: wrong size reused\r\n", i_w);
+        ret_i = 0;
+      }
+
+      u3a_wfree(oth_w);
+    }
+
+    sec_w = u3a_walloc(_slab_len(i_w));
+
+    if ( (sec_w != fir_w) || (0 != u3R->sab.len_w[i_w - 1]) ) {
+      fprintf(stderr, "slab reuse: %u: not reused\r\n", i_w);
+      ret_i = 0;
+    }
+
+    u3a_wfree(sec_w);
+  }
+
+  //  cells
+  //
+  {
+    u3_noun fir = u3nc(1, 2);
+    u3_noun sec;
+    c3_w    cel_w;
+
+    u3z(fir);
+    cel_w = u3R->sab.cel_w;
+    sec   = u3nc(3, 4);
+
+    if ( (sec != fir) || ((cel_w - 1) != u3R->sab.cel_w) ) {
+      fprintf(stderr, "slab reuse: cell not reused\r\n");
+      ret_i = 0;
+    }
+
+    u3z(sec);
+  }
+
+  while ( u3a_reflux() );
+
+  return ret_i;
+}
+
+/* _test_slab_cap(): a slab holds at most u3a_slab_max boxes.
+*/
+static c3_i
+_test_slab_cap(void)
+{
+  c3_w   len_w = u3a_slab_max + 16;
+  c3_w** box_w = c3_malloc(len_w * sizeof(c3_w*));
+  c3_i   ret_i = 1;
+  c3_w   i_w;
+
+  while ( u3a_reflux() );
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    box_w[i_w] = u3a_walloc(_slab_len(1));
+  }
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    u3a_wfree(box_w[i_w]);
+  }
+
+  if ( u3a_slab_max != u3R->sab.len_w[0] ) {
+    fprintf(stderr, "slab cap: %u cached\r\n", u3R->sab.len_w[0]);
+    ret_i = 0;
+  }
+
+  while ( u3a_reflux() );
+
+  if ( 0 != u3R->sab.len_w[0] ) {
+    fprintf(stderr, "slab cap: %u left after reflux\r\n", u3R->sab.len_w[0]);
+    ret_i = 0;
+  }
+
+  c3_free(box_w);
+
+  return ret_i;
+}
+
+/* _slab_flood(): fill a slab, then the road, until the slab is drained.
+*/
+static u3_noun
+_slab_flood(u3_noun arg)
+{
+  c3_w** box_w = c3_malloc(u3a_slab_max * sizeof(c3_w*));
+  c3_w   i_w;
+
+  for ( i_w = 0; i_w < u3a_slab_max; i_w++ ) {
+    box_w[i_w] = u3a_walloc(_slab_len(1));
+  }
+
+  for ( i_w = 0; i_w < u3a_slab_max; i_w++ ) {
+    u3a_wfree(box_w[i_w]);
+  }
+
+  c3_free(box_w);
+
+  //  large boxes can only come from the hat, or from coalesced slabs;
+  //  they are left for the road to discard
+  //
+  for ( i_w = 0;
+        (i_w < 4096) && (u3a_slab_max == u3R->sab.len_w[0]);
+        i_w++ )
+  {
+    u3a_walloc(1 << 16);
+  }
+
+  return __(u3R->sab.len_w[0] < u3a_slab_max);
+}
+
+/* _test_slab_reflux(): slabs are drained when the road is full.
+*/
+static c3_i
+_test_slab_reflux(void)
+{
+  u3_noun gon = u3m_soft(0, _slab_flood, u3_nul);
+  c3_i  ret_i = 1;
+
+  if ( (0 != u3h(gon)) || (c3y != u3t(gon)) ) {
+    u3m_p("slab reflux", gon);
+    ret_i = 0;
+  }
+
+  u3z(gon);
+
+  return ret_i;
+}
+
+/* _test_slab_sweep(): cached boxes are not leaks, and survive a sweep.
+*/
+static c3_i
+_test_slab_sweep(void)
+{
+  c3_w   len_w = 64;
+  c3_w*  box_w[u3a_slab_no][64];
+  u3_noun cel[64];
+  c3_w   sab_w[u3a_slab_no];
+  c3_w   cel_w;
+  c3_i   ret_i = 1;
+  c3_w   i_w, j_w;
+
+  while ( u3a_reflux() );
+
+  for ( i_w = 0; i_w < u3a_slab_no; i_w++ ) {
+    for ( j_w = 0; j_w < len_w; j_w++ ) {
+      box_w[i_w][j_w] = u3a_walloc(_slab_len(i_w + 1));
+    }
+  }
+
+  for ( j_w = 0; j_w < len_w; j_w++ ) {
+    cel[j_w] = u3nc(j_w, j_w);
+  }
+
+  for ( i_w = 0; i_w < u3a_slab_no; i_w++ ) {
+    for ( j_w = 0; j_w < len_w; j_w++ ) {
+      u3a_wfree(box_w[i_w][j_w]);
+    }
+
+    sab_w[i_w] = u3R->sab.len_w[i_w];
+  }
+
+  for ( j_w = 0; j_w < len_w; j_w++ ) {
+    u3z(cel[j_w]);
+  }
+
+  cel_w = u3R->sab.cel_w;
+
+  //  asserts that nothing leaked
+  //
+  u3m_grab(u3_none);
+
+  for ( i_w = 0; i_w < u3a_slab_no; i_w++ ) {
+    if ( sab_w[i_w] != u3R->sab.len_w[i_w] ) {
+      fprintf(stderr, "slab sweep: %u: %u cached, was %u\r\n",
+                      i_w + 1, u3R->sab.len_w[i_w], sab_w[i_w]);
+      ret_i = 0;
+    }
+    else {
+      c3_w* new_w = u3a_walloc(_slab_len(i_w + 1));
+
+      if (  (1 != u3a_botox(new_w)->use_w)
+         || (new_w != box_w[i_w][len_w - 1]) )
+      {
+        fprintf(stderr, "slab sweep: %u: bad box after sweep\r\n", i_w + 1);
+        ret_i = 0;
+      }
+
+      u3a_wfree(new_w);
+    }
+  }
+
+  if ( cel_w != u3R->sab.cel_w ) {
+    fprintf(stderr, "slab sweep: %u cells cached, was %u\r\n",
+                    u3R->sab.cel_w, cel_w);
+    ret_i = 0;
+  }
+
+  while ( u3a_reflux() );
+
+  return ret_i;
+}
+
+static c3_w _sand_run_w;
+static c3_o _sand_was_o[2];
+
+/* _sand_churn(): allocate and free far more than the road can hold.
+*/
+static u3_noun
+_sand_churn(u3_noun arg)
+{
+  c3_w i_w;
+
+  if ( _sand_run_w < 2 ) {
+    _sand_was_o[_sand_run_w] = __(u3R->how.fag_w & u3a_flag_sand);
+  }
+
+  _sand_run_w++;
+
+  for ( i_w = 0; i_w < 1024; i_w++ ) {
+    u3a_free(u3a_malloc(1 << 20));
+  }
+
+  return u3_nul;
+}
+
+/* _test_sand_meme(): a sand road out of memory is retried normally.
+*/
+static c3_i
+_test_sand_meme(void)
+{
+  u3_noun gon = u3m_soft_sand(0, _sand_churn, u3_nul);
+  c3_i  ret_i = 1;
+
+  if ( (0 != u3h(gon)) || (u3_nul != u3t(gon)) ) {
+    u3m_p("sand meme", gon);
+    ret_i = 0;
+  }
+
+  if (  (2 != _sand_run_w)
+     || (c3y != _sand_was_o[0])
+     || (c3n != _sand_was_o[1]) )
+  {
+    fprintf(stderr, "sand meme: %u runs\r\n", _sand_run_w);
+    ret_i = 0;
+  }
+
+  u3z(gon);
+
+  return ret_i;
+}
+
+static c3_i
+_test_allocate(void)
+{
+  c3_i ret_i = 1;
+
+  if ( !_test_slab_reuse() ) {
+    fprintf(stderr, "test allocate: slab reuse failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_slab_cap() ) {
+    fprintf(stderr, "test allocate: slab cap failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_slab_reflux() ) {
+    fprintf(stderr, "test allocate: slab reflux failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_slab_sweep() ) {
+    fprintf(stderr, "test allocate: slab sweep failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_sand_meme() ) {
+    fprintf(stderr, "test allocate: sand meme failed\r\n");
+    ret_i = 0;
+  }
+
+  return ret_i;
+}
+
+/* main(): run all test cases.
+*/
+int
+main(int argc, char* argv[])
+{
+  _setup();
+
+  if ( !_test_allocate() ) {
+    fprintf(stderr, "test allocate: failed\r\n");
+    exit(1);
+  }
+
+  //  GC
+  //
+  u3m_grab(u3_none);
+
+  fprintf(stderr, "test allocate: ok\r\n");
+
+  return 0;
+}
@@ -0,0 +1,750 @@
+#include "all.h"
+#include "vere/vere.h"
+#include "vere/db/lmdb.h"
+
+/* _setup(): prepare for tests.
+*/
+static void
+_setup(void)
+{
+  u3m_init(1 << 24);
+  u3m_pave(c3y);
+
+  u3_Host.lup_u = uv_default_loop();
+}
+
+/* _disk_save(): log events [fir_d, las_d], each its mug and one byte.
+*/
+static c3_o
+_disk_save(u3_disk* log_u, c3_d fir_d, c3_d las_d)
+{
+  c3_d    len_d = (las_d - fir_d) + 1;
+  void**  byt_p = c3_malloc(len_d * sizeof(void*));
+  size_t* siz_i = c3_malloc(len_d * sizeof(size_t));
+  c3_o    ret_o;
+  c3_d    i_d;
+
+  for ( i_d = 0; i_d < len_d; i_d++ ) {
+    c3_y* dat_y = c3_malloc(5);
+    c3_l  mug_l = (c3_l)(fir_d + i_d);
+
+    dat_y[0] = mug_l & 0xff;
+    dat_y[1] = (mug_l >>  8) & 0xff;
+    dat_y[2] = (mug_l >> 16) & 0xff;
+    dat_y[3] = (mug_l >> 24) & 0xff;
+    dat_y[4] = 0x1;
+
+    byt_p[i_d] = dat_y;
+    siz_i[i_d] = 5;
+  }
+
+  ret_o = u3_lmdb_save(log_u->mdb_u, fir_d, len_d, byt_p, siz_i);
+
+  for ( i_d = 0; i_d < len_d; i_d++ ) {
+    c3_free(byt_p[i_d]);
+  }
+
+  c3_free(byt_p);
+  c3_free(siz_i);
+
+  if ( c3y == ret_o ) {
+    log_u->dun_d = log_u->sen_d = las_d;
+
+    if ( !log_u->fir_d ) {
+      log_u->fir_d = fir_d;
+    }
+  }
+
+  return ret_o;
+}
+
+/* _disk_note: commits reported by a log.
+*/
+typedef struct _disk_note {
+  u3_disk* log_u;                       //  log
+  c3_w     don_w;                       //  batches committed
+  c3_d     don_d[8];                    //  last event of each
+  c3_d     tim_d[8];                    //  committed at (loop ms)
+  c3_w     bal_w;                       //  batches failed
+  c3_d     bal_d[8];                    //  last event of each
+  c3_d     pan_d;                       //  event to plan on failure
+} _disk_note;
+
+/* _disk_note_done(): record a commit.
+*/
+static void
+_disk_note_done(void* ptr_v, c3_d eve_d)
+{
+  _disk_note* not_u = ptr_v;
+
+  if ( not_u->don_w < 8 ) {
+    not_u->tim_d[not_u->don_w] = uv_now(u3L);
+    not_u->don_d[not_u->don_w] = eve_d;
+  }
+
+  not_u->don_w++;
+}
+
+/* _disk_note_bail(): record a failed commit, make room, and plan more.
+*/
+static void
+_disk_note_bail(void* ptr_v, c3_d eve_d)
+{
+  _disk_note* not_u = ptr_v;
+
+  if ( not_u->bal_w < 8 ) {
+    not_u->bal_d[not_u->bal_w] = eve_d;
+  }
+
+  not_u->bal_w++;
+
+  mdb_env_set_mapsize(not_u->log_u->mdb_u, 1ULL << 30);
+
+  if ( not_u->pan_d ) {
+    u3_disk_plan(not_u->log_u, u3_fact_init(not_u->pan_d,
+                                            (c3_l)not_u->pan_d,
+                                            u3i_chub(not_u->pan_d)));
+    not_u->pan_d = 0;
+  }
+}
+
+/* _disk_open(): open a fresh log with group commit targets.
+*/
+static u3_disk*
+_disk_open(c3_c* dir_c, _disk_note* not_u, c3_w bat_w, c3_w wai_w)
+{
+  u3_disk_cb cb_u = {
+    .ptr_v = not_u,
+    .write_done_f = _disk_note_done,
+    .write_bail_f = _disk_note_bail
+  };
+
+  memset(not_u, 0, sizeof(*not_u));
+  u3_Host.ops_u.bat_w = bat_w;
+  u3_Host.ops_u.wai_w = wai_w;
+
+  if ( !mkdtemp(dir_c) ) {
+    return 0;
+  }
+
+  return not_u->log_u = u3_disk_init(dir_c, cb_u);
+}
+
+/* _disk_plan(): plan events [fir_d, las_d], each its number as job and mug.
+*/
+static void
+_disk_plan(u3_disk* log_u, c3_d fir_d, c3_d las_d)
+{
+  c3_d eve_d;
+
+  for ( eve_d = fir_d; eve_d <= las_d; eve_d++ ) {
+    u3_disk_plan(log_u, u3_fact_init(eve_d, (c3_l)eve_d, u3i_chub(eve_d)));
+  }
+}
+
+/* _disk_wait(): run the loop until [don_w] batches have committed.
+*/
+static void
+_disk_wait(_disk_note* not_u, c3_w don_w)
+{
+  while ( (not_u->don_w < don_w) && !not_u->bal_w ) {
+    uv_run(u3L, UV_RUN_ONCE);
+  }
+}
+
+/* _disk_close(): close a log, and let its timer close.
+*/
+static void
+_disk_close(u3_disk* log_u)
+{
+  u3_disk_exit(log_u);
+  uv_run(u3L, UV_RUN_NOWAIT);
+}
+
+/* _test_commit_batch(): a batch is written when it holds [bat_w] events,
+**                       and the next is gathered while it is written.
+*/
+static c3_i
+_test_commit_batch(void)
+{
+  c3_c       dir_c[] = "/tmp/disk_tests_XXXXXX";
+  _disk_note not_u;
+  u3_disk*   log_u;
+  c3_i       ret_i = 1;
+
+  if ( !(log_u = _disk_open(dir_c, &not_u, 4, 60000)) ) {
+    fprintf(stderr, "commit batch: init failed\r\n");
+    return 0;
+  }
+
+  //  short of the boundary, the batch waits for the timer
+  //
+  _disk_plan(log_u, 1, 3);
+
+  if (  (c3n != log_u->ted_o)
+     || !log_u->tim_u
+     || !uv_is_active((uv_handle_t*)log_u->tim_u) )
+  {
+    fprintf(stderr, "commit batch: written early\r\n");
+    ret_i = 0;
+  }
+
+  //  at the boundary, it is written at once
+  //
+  _disk_plan(log_u, 4, 4);
+
+  if ( (c3y != log_u->ted_o) || log_u->nex_u ) {
+    fprintf(stderr, "commit batch: not written at boundary\r\n");
+    ret_i = 0;
+  }
+
+  //  meanwhile, the next batch is gathered, and waits its turn
+  //
+  _disk_plan(log_u, 5, 6);
+  _disk_wait(&not_u, 1);
+
+  if (  (1 != not_u.don_w)
+     || (4 != not_u.don_d[0])
+     || (4 != log_u->dun_d)
+     || (6 != log_u->sen_d)
+     || !log_u->nex_u
+     || (c3n != log_u->ted_o)
+     || !uv_is_active((uv_handle_t*)log_u->tim_u) )
+  {
+    fprintf(stderr, "commit batch: first batch %u to %" PRIu64 "\r\n",
+                    not_u.don_w, not_u.don_d[0]);
+    ret_i = 0;
+  }
+
+  _disk_plan(log_u, 7, 8);
+  _disk_wait(&not_u, 2);
+
+  if ( (2 != not_u.don_w) || (8 != not_u.don_d[1]) || not_u.bal_w ) {
+    fprintf(stderr, "commit batch: second batch %u to %" PRIu64 "\r\n",
+                    not_u.don_w, not_u.don_d[1]);
+    ret_i = 0;
+  }
+
+  _disk_close(log_u);
+
+  return ret_i;
+}
+
+/* _test_commit_wait(): a batch short of [bat_w] is written after [wai_w] ms.
+*/
+static c3_i
+_test_commit_wait(void)
+{
+  c3_c       dir_c[] = "/tmp/disk_tests_XXXXXX";
+  _disk_note not_u;
+  u3_disk*   log_u;
+  c3_d       now_d;
+  c3_i       ret_i = 1;
+
+  if ( !(log_u = _disk_open(dir_c, &not_u, 0, 50)) ) {
+    fprintf(stderr, "commit wait: init failed\r\n");
+    return 0;
+  }
+
+  uv_update_time(u3L);
+  now_d = uv_now(u3L);
+
+  _disk_plan(log_u, 1, 3);
+
+  if ( c3n != log_u->ted_o ) {
+    fprintf(stderr, "commit wait: written early\r\n");
+    ret_i = 0;
+  }
+
+  _disk_wait(&not_u, 1);
+
+  if (  (1 != not_u.don_w)
+     || (3 != not_u.don_d[0])
+     || ((now_d + 50) > not_u.tim_d[0]) )
+  {
+    fprintf(stderr, "commit wait: %u batches, to %" PRIu64
+                    " after %" PRIu64 "ms\r\n",
+                    not_u.don_w, not_u.don_d[0], not_u.tim_d[0] - now_d);
+    ret_i = 0;
+  }
+
+  _disk_close(log_u);
+
+  return ret_i;
+}
+
+/* _disk_read_mug(): check that events are read in order, by mug.
+*/
+static c3_o
+_disk_read_mug(void* ptr_v, c3_d eve_d, size_t val_i, void* val_p)
+{
+  c3_d* nex_d = ptr_v;
+  c3_y* dat_y = val_p;
+  c3_l  mug_l;
+
+  if ( 4 > val_i ) {
+    return c3n;
+  }
+
+  mug_l = dat_y[0]
+        ^ (dat_y[1] <<  8)
+        ^ (dat_y[2] << 16)
+        ^ (dat_y[3] << 24);
+
+  if ( (*nex_d != eve_d) || ((c3_l)eve_d != mug_l) ) {
+    return c3n;
+  }
+
+  (*nex_d)++;
+  return c3y;
+}
+
+/* _test_commit_retry(): a failed batch is retried ahead of later events.
+*/
+static c3_i
+_test_commit_retry(void)
+{
+  c3_c       dir_c[] = "/tmp/disk_tests_XXXXXX";
+  _disk_note not_u;
+  u3_disk*   log_u;
+  c3_i       ret_i = 1;
+
+  if ( !(log_u = _disk_open(dir_c, &not_u, 0, 0)) ) {
+    fprintf(stderr, "commit retry: init failed\r\n");
+    return 0;
+  }
+
+  //  shrink the map, so that a large event cannot be written;
+  //  on failure, it is grown back and another event is planned
+  //
+  mdb_env_set_mapsize(log_u->mdb_u, 1);
+  not_u.pan_d = 4;
+
+  u3_disk_plan(log_u, u3_fact_init(1, 1, u3qc_bex(1 << 21)));
+  _disk_plan(log_u, 2, 3);
+  _disk_wait(&not_u, 1);
+
+  if ( (1 != not_u.bal_w) || (1 != not_u.bal_d[0]) ) {
+    fprintf(stderr, "commit retry: %u failed\r\n", not_u.bal_w);
+    ret_i = 0;
+  }
+
+  not_u.bal_w = 0;
+  _disk_wait(&not_u, 1);
+
+  if (  (1 != not_u.don_w)
+     || (4 != not_u.don_d[0])
+     || (4 != log_u->dun_d)
+     || not_u.bal_w )
+  {
+    fprintf(stderr, "commit retry: %u batches, to %" PRIu64 "\r\n",
+                    not_u.don_w, not_u.don_d[0]);
+    ret_i = 0;
+  }
+
+  {
+    c3_d nex_d = 1;
+    c3_d fir_d, las_d;
+
+    if (  (c3n == u3_lmdb_read(log_u->mdb_u, &nex_d, 1, 4, _disk_read_mug))
+       || (5 != nex_d) )
+    {
+      fprintf(stderr, "commit retry: read failed at %" PRIu64 "\r\n", nex_d);
+      ret_i = 0;
+    }
+
+    if (  (c3n == u3_lmdb_gulf(log_u->mdb_u, &fir_d, &las_d))
+       || (1 != fir_d)
+       || (4 != las_d) )
+    {
+      fprintf(stderr, "commit retry: log %" PRIu64 "-%" PRIu64 "\r\n",
+                      fir_d, las_d);
+      ret_i = 0;
+    }
+  }
+
+  _disk_close(log_u);
+
+  return ret_i;
+}
+
+/* _test_save_append(): events are only appended, with tables kept open.
+*/
+static c3_i
+_test_save_append(void)
+{
+  c3_c       dir_c[] = "/tmp/disk_tests_XXXXXX";
+  _disk_note not_u;
+  u3_disk*   log_u;
+  c3_d       fir_d, las_d;
+  c3_i       ret_i = 1;
+
+  if ( !(log_u = _disk_open(dir_c, &not_u, 0, 0)) ) {
+    fprintf(stderr, "save append: init failed\r\n");
+    return 0;
+  }
+
+  if ( c3n == _disk_save(log_u, 1, 10) ) {
+    fprintf(stderr, "save append: save failed\r\n");
+    ret_i = 0;
+  }
+
+  //  rewriting, or rewinding, fails, and leaves the log as it was
+  //
+  if (  (c3y == _disk_save(log_u, 10, 11))
+     || (c3y == _disk_save(log_u, 5, 5)) )
+  {
+    fprintf(stderr, "save append: overwrote\r\n");
+    ret_i = 0;
+  }
+
+  if (  (c3n == u3_lmdb_gulf(log_u->mdb_u, &fir_d, &las_d))
+     || (1 != fir_d)
+     || (10 != las_d) )
+  {
+    fprintf(stderr, "save append: log %" PRIu64 "-%" PRIu64 "\r\n",
+                    fir_d, las_d);
+    ret_i = 0;
+  }
+
+  //  after an aborted write, the log's tables are still usable
+  //
+  if ( c3n == _disk_save(log_u, 11, 12) ) {
+    fprintf(stderr, "save append: save after failure failed\r\n");
+    ret_i = 0;
+  }
+
+  _disk_close(log_u);
+
+  {
+    u3_disk_cb cb_u = {0};
+
+    if ( !(log_u = u3_disk_init(dir_c, cb_u)) ) {
+      fprintf(stderr, "save append: reopen failed\r\n");
+      return 0;
+    }
+  }
+
+  if ( (12 != log_u->dun_d) || (c3n == _disk_save(log_u, 13, 13)) ) {
+    fprintf(stderr, "save append: reopened at %" PRIu64 "\r\n", log_u->dun_d);
+    ret_i = 0;
+  }
+
+  {
+    c3_d nex_d = 1;
+
+    if (  (c3n == u3_lmdb_read(log_u->mdb_u, &nex_d, 1, 13, _disk_read_mug))
+       || (14 != nex_d) )
+    {
+      fprintf(stderr, "save append: read failed at %" PRIu64 "\r\n", nex_d);
+      ret_i = 0;
+    }
+  }
+
+  _disk_close(log_u);
+
+  return ret_i;
+}
+
+/* _disk_save_text(): log events [fir_d, las_d], each its mug and some text.
+*/
+static c3_o
+_disk_save_text(u3_disk* log_u, c3_d fir_d, c3_d las_d)
+{
+  c3_d    len_d = (las_d - fir_d) + 1;
+  void**  byt_p = c3_malloc(len_d * sizeof(void*));
+  size_t* siz_i = c3_malloc(len_d * sizeof(size_t));
+  c3_o    ret_o;
+  c3_d    i_d;
+
+  for ( i_d = 0; i_d < len_d; i_d++ ) {
+    c3_y* dat_y = c3_malloc(256);
+    c3_l  mug_l = (c3_l)(fir_d + i_d);
+    c3_i  len_i;
+
+    dat_y[0] = mug_l & 0xff;
+    dat_y[1] = (mug_l >>  8) & 0xff;
+    dat_y[2] = (mug_l >> 16) & 0xff;
+    dat_y[3] = (mug_l >> 24) & 0xff;
+
+    len_i = snprintf((c3_c*)dat_y + 4, 252,
+                     "[%%ames %%hear lane=%" PRIu64 " [%%behn %%wake ~]"
+                     " [%%http-server %%request secure=| address=[%%ipv4 .%u]"
+                     " url='/~/channel/%" PRIu64 "']]",
+                     (fir_d + i_d) % 7, (c3_w)((fir_d + i_d) % 3),
+                     (fir_d + i_d) / 100);
+
+    byt_p[i_d] = dat_y;
+    siz_i[i_d] = 4 + len_i;
+  }
+
+  ret_o = u3_lmdb_save(log_u->mdb_u, fir_d, len_d, byt_p, siz_i);
+
+  for ( i_d = 0; i_d < len_d; i_d++ ) {
+    c3_free(byt_p[i_d]);
+  }
+
+  c3_free(byt_p);
+  c3_free(siz_i);
+
+  if ( c3y == ret_o ) {
+    log_u->dun_d = log_u->sen_d = las_d;
+  }
+
+  return ret_o;
+}
+
+/* _test_pack_dicts(): packed bytes include dictionaries, and every
+**                     compressed segment's dictionary is kept.
+*/
+static c3_i
+_test_pack_dicts(void)
+{
+  c3_c       dir_c[] = "/tmp/disk_tests_XXXXXX";
+  _disk_note not_u;
+  u3_disk*   log_u;
+  c3_d       las_d = 65 * 256 + 10;
+  c3_d       eve_d;
+  c3_i       ret_i = 1;
+
+  if ( !(log_u = _disk_open(dir_c, &not_u, 0, 0)) ) {
+    fprintf(stderr, "pack dicts: init failed\r\n");
+    return 0;
+  }
+
+  //  65 segments, more than one dictionary's worth
+  //
+  u3_lmdb_pack(log_u->mdb_u, c3y);
+
+  for ( eve_d = 1; eve_d <= las_d; eve_d += 1000 ) {
+    if ( c3n == _disk_save_text(log_u, eve_d, c3_min(eve_d + 999, las_d)) ) {
+      fprintf(stderr, "pack dicts: save failed at %" PRIu64 "\r\n", eve_d);
+      ret_i = 0;
+      break;
+    }
+  }
+
+  {
+    MDB_txn*    txn_u;
+    MDB_dbi     seg_u, dic_u;
+    MDB_cursor* cur_u;
+    MDB_val     key_u, val_u;
+    c3_d        num_d = 0, zip_d = 0, has_d = 0;
+    c3_d        seg_d, raw_d, tot_d;
+
+    if (  mdb_txn_begin(log_u->mdb_u, 0, MDB_RDONLY, &txn_u)
+       || mdb_dbi_open(txn_u, "SEGMENTS", MDB_INTEGERKEY, &seg_u)
+       || mdb_dbi_open(txn_u, "DICTS", MDB_INTEGERKEY, &dic_u) )
+    {
+      fprintf(stderr, "pack dicts: open failed\r\n");
+      return 0;
+    }
+
+    mdb_cursor_open(txn_u, dic_u, &cur_u);
+
+    while ( !mdb_cursor_get(cur_u, &key_u, &val_u, MDB_NEXT) ) {
+      zip_d += val_u.mv_size;
+      has_d++;
+    }
+
+    mdb_cursor_close(cur_u);
+
+    if ( 2 > has_d ) {
+      fprintf(stderr, "pack dicts: %" PRIu64 " dictionaries\r\n", has_d);
+      ret_i = 0;
+    }
+
+    //  each segment is [codec dictionary count length payload]
+    //
+    mdb_cursor_open(txn_u, seg_u, &cur_u);
+
+    while ( !mdb_cursor_get(cur_u, &key_u, &val_u, MDB_NEXT) ) {
+      c3_y* byt_y = val_u.mv_data;
+      c3_d  dic_d = 0;
+      c3_w  i_w;
+
+      for ( i_w = 0; i_w < 8; i_w++ ) {
+        dic_d |= (c3_d)byt_y[1 + i_w] << (8 * i_w);
+      }
+
+      if ( dic_d ) {
+        MDB_val dey_u = { .mv_size = sizeof(c3_d), .mv_data = &dic_d };
+        MDB_val dat_u;
+
+        if ( mdb_get(txn_u, dic_u, &dey_u, &dat_u) ) {
+          fprintf(stderr, "pack dicts: segment %" PRIu64
+                          ": no dictionary %" PRIu64 "\r\n",
+                          *(c3_d*)key_u.mv_data, dic_d);
+          ret_i = 0;
+        }
+      }
+      else if ( 1 == byt_y[0] ) {
+        fprintf(stderr, "pack dicts: segment %" PRIu64 ": no dictionary\r\n",
+                        *(c3_d*)key_u.mv_data);
+        ret_i = 0;
+      }
+
+      zip_d += val_u.mv_size;
+      num_d++;
+    }
+
+    mdb_cursor_close(cur_u);
+    mdb_txn_abort(txn_u);
+
+    if (  (c3n == u3_lmdb_pack_info(log_u->mdb_u, &seg_d, &raw_d, &tot_d))
+       || (65 != num_d)
+       || (num_d != seg_d)
+       || (zip_d != tot_d) )
+    {
+      fprintf(stderr, "pack dicts: %" PRIu64 " segments, %" PRIu64
+                      " bytes; counted %" PRIu64 ", %" PRIu64 "\r\n",
+                      num_d, zip_d, seg_d, tot_d);
+      ret_i = 0;
+    }
+  }
+
+  //  every event reads back, across segments and dictionaries
+  //
+  {
+    c3_d nex_d = 1;
+
+    if (  (c3n == u3_lmdb_read(log_u->mdb_u, &nex_d, 1, las_d, _disk_read_mug))
+       || ((las_d + 1) != nex_d) )
+    {
+      fprintf(stderr, "pack dicts: read failed at %" PRIu64 "\r\n", nex_d);
+      ret_i = 0;
+    }
+  }
+
+  _disk_close(log_u);
+
+  return ret_i;
+}
+
+/* _test_chop_latest(): chop at the latest event, then reopen the log.
+*/
+static c3_i
+_test_chop_latest(void)
+{
+  c3_c       dir_c[] = "/tmp/disk_tests_XXXXXX";
+  u3_disk_cb cb_u = {0};
+  u3_disk*   log_u;
+  c3_d       las_d = 300;
+  c3_i       ret_i = 1;
+
+  if ( !mkdtemp(dir_c) ) {
+    fprintf(stderr, "chop_latest: mkdtemp failed\r\n");
+    return 0;
+  }
+
+  if ( !(log_u = u3_disk_init(dir_c, cb_u)) ) {
+    fprintf(stderr, "chop_latest: init failed\r\n");
+    return 0;
+  }
+
+  //  events before 257 are sealed into a segment
+  //
+  u3_lmdb_pack(log_u->mdb_u, c3y);
+
+  if ( c3n == _disk_save(log_u, 1, las_d) ) {
+    fprintf(stderr, "chop_latest: save failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( c3n == u3_disk_chop(log_u, las_d, (c3_l)las_d, c3n) ) {
+    fprintf(stderr, "chop_latest: chop failed\r\n");
+    ret_i = 0;
+  }
+
+  u3_disk_exit(log_u);
+
+  if ( !(log_u = u3_disk_init(dir_c, cb_u)) ) {
+    fprintf(stderr, "chop_latest: reopen failed\r\n");
+    return 0;
+  }
+
+  if (  (las_d != log_u->dun_d)
+     || (las_d != log_u->epo_d)
+     || (las_d <  log_u->fir_d) )
+  {
+    fprintf(stderr, "chop_latest: log %" PRIu64 "-%" PRIu64
+                    ", epoch %" PRIu64 "\r\n",
+                    log_u->fir_d, log_u->dun_d, log_u->epo_d);
+    ret_i = 0;
+  }
+
+  //  new events continue the numbering
+  //
+  if ( c3n == _disk_save(log_u, las_d + 1, las_d + 1) ) {
+    fprintf(stderr, "chop_latest: save after chop failed\r\n");
+    ret_i = 0;
+  }
+  else {
+    c3_d fir_d, dun_d;
+
+    if (  (c3n == u3_lmdb_gulf(log_u->mdb_u, &fir_d, &dun_d))
+       || ((las_d + 1) != dun_d) )
+    {
+      fprintf(stderr, "chop_latest: latest %" PRIu64 "\r\n", dun_d);
+      ret_i = 0;
+    }
+  }
+
+  u3_disk_exit(log_u);
+
+  return ret_i;
+}
+
+static c3_i
+_test_disk(void)
+{
+  c3_i ret_i = 1;
+
+  if ( !_test_commit_batch() ) {
+    fprintf(stderr, "test disk: commit batch failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_commit_wait() ) {
+    fprintf(stderr, "test disk: commit wait failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_commit_retry() ) {
+    fprintf(stderr, "test disk: commit retry failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_save_append() ) {
+    fprintf(stderr, "test disk: save append failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_pack_dicts() ) {
+    fprintf(stderr, "test disk: pack dicts failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_chop_latest() ) {
+    fprintf(stderr, "test disk: chop latest failed\r\n");
+    ret_i = 0;
+  }
+
+  return ret_i;
+}
+
+/* main(): run all test cases.
+*/
+int
+main(int argc, char* argv[])
+{
+  _setup();
+
+  if ( !_test_disk() ) {
+    fprintf(stderr, "test disk: failed\r\n");
+    exit(1);
+  }
+
+  fprintf(stderr, "test disk: ok\r\n");
+  return 0;
+}
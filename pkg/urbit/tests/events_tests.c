@@ -0,0 +1,845 @@
+#include "all.h"
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+//  16KB pages, as written by version 1 patches (and by default)
+//
+#define _v1_page  ((c3_w)1 << u3a_page)
+
+//  bytes in a page, and in a batch of patch i/o
+//
+#define _pag_siz  ((size_t)_v1_page << 2)
+#define _bat_siz  ((size_t)1 << 23)
+
+/* patch i/o, as seen by the interposed calls below.
+*/
+#define _io_max  64
+
+typedef struct {
+  c3_i   cnt_i;                       //  iovec count, 0 for pread
+  size_t len_i;                       //  bytes requested
+  off_t  off_i;                       //  offset
+} _io_call;
+
+static struct {
+  size_t   max_i;                     //  bytes per call, or 0 for any
+  long     cpu_l;                     //  processors, or 0 for actual
+  c3_w     red_w;                     //  large preads
+  c3_w     wri_w;                     //  large pwritevs
+  _io_call red_u[_io_max];
+  _io_call wri_u[_io_max];
+} _io_u;
+
+/* _io_note(): record a call of at least a page.
+*/
+static void
+_io_note(_io_call* cal_u, c3_w* len_w, c3_i cnt_i, size_t len_i, off_t off_i)
+{
+  if ( (len_i >= _pag_siz) && (*len_w < _io_max) ) {
+    cal_u[*len_w].cnt_i = cnt_i;
+    cal_u[*len_w].len_i = len_i;
+    cal_u[*len_w].off_i = off_i;
+  }
+
+  if ( len_i >= _pag_siz ) {
+    (*len_w)++;
+  }
+}
+
+/* pread(): interposed, to record and shorten patch reads.
+*/
+ssize_t
+pread(c3_i fid_i, void* buf_v, size_t len_i, off_t off_i)
+{
+  static ssize_t (*fun_f)(c3_i, void*, size_t, off_t);
+
+  if ( !fun_f ) {
+    fun_f = dlsym(RTLD_NEXT, "pread");
+  }
+
+  _io_note(_io_u.red_u, &_io_u.red_w, 0, len_i, off_i);
+
+  if ( _io_u.max_i ) {
+    len_i = c3_min(len_i, _io_u.max_i);
+  }
+
+  return fun_f(fid_i, buf_v, len_i, off_i);
+}
+
+/* pwritev(): interposed, to record and shorten patch writes.
+*/
+ssize_t
+pwritev(c3_i fid_i, const struct iovec* iov_u, c3_i cnt_i, off_t off_i)
+{
+  static ssize_t (*fun_f)(c3_i, const struct iovec*, c3_i, off_t);
+  struct iovec vec_u[IOV_MAX];
+  size_t       len_i = 0;
+  c3_i         i_i;
+
+  if ( !fun_f ) {
+    fun_f = dlsym(RTLD_NEXT, "pwritev");
+  }
+
+  for ( i_i = 0; i_i < cnt_i; i_i++ ) {
+    len_i += iov_u[i_i].iov_len;
+  }
+
+  _io_note(_io_u.wri_u, &_io_u.wri_w, cnt_i, len_i, off_i);
+
+  if ( !_io_u.max_i || (len_i <= _io_u.max_i) ) {
+    return fun_f(fid_i, iov_u, cnt_i, off_i);
+  }
+
+  //  write a prefix of the vector, at most [max_i] bytes
+  //
+  len_i = _io_u.max_i;
+
+  for ( i_i = 0; len_i && (i_i < cnt_i); i_i++ ) {
+    vec_u[i_i].iov_base = iov_u[i_i].iov_base;
+    vec_u[i_i].iov_len  = c3_min(len_i, iov_u[i_i].iov_len);
+    len_i -= vec_u[i_i].iov_len;
+  }
+
+  return fun_f(fid_i, vec_u, i_i, off_i);
+}
+
+/* sysconf(): interposed, to checksum on more threads than we have.
+*/
+long
+sysconf(c3_i nam_i)
+{
+  static long (*fun_f)(c3_i);
+
+  if ( !fun_f ) {
+    fun_f = dlsym(RTLD_NEXT, "sysconf");
+  }
+
+  if ( (_SC_NPROCESSORS_ONLN == nam_i) && _io_u.cpu_l ) {
+    return _io_u.cpu_l;
+  }
+
+  return fun_f(nam_i);
+}
+
+/* _io_reset(): clear recorded calls, and set limits.
+*/
+static void
+_io_reset(size_t max_i, long cpu_l)
+{
+  memset(&_io_u, 0, sizeof(_io_u));
+  _io_u.max_i = max_i;
+  _io_u.cpu_l = cpu_l;
+}
+
+/* _setup(): prepare for tests.
+*/
+static void
+_setup(void)
+{
+  u3m_init(1 << 26);
+}
+
+/* _fill_page(): fill a 16KB page with a pattern.
+*/
+static void
+_fill_page(c3_w* pag_w, c3_w sed_w)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < _v1_page; i_w++ ) {
+    pag_w[i_w] = (sed_w * 0x85ebca6b) ^ (i_w * 0x9e3779b9);
+  }
+}
+
+/* _check_page(): confirm a page holds the pattern.
+*/
+static c3_o
+_check_page(c3_w* pag_w, c3_w sed_w)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < _v1_page; i_w++ ) {
+    if ( pag_w[i_w] != ((sed_w * 0x85ebca6b) ^ (i_w * 0x9e3779b9)) ) {
+      return c3n;
+    }
+  }
+
+  return c3y;
+}
+
+/* _write_file(): write [len_i] bytes to [pax_c].
+*/
+static c3_o
+_write_file(c3_c* pax_c, void* buf_v, size_t len_i)
+{
+  c3_i fid_i = c3_open(pax_c, O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+  if ( -1 == fid_i ) {
+    return c3n;
+  }
+  else {
+    c3_o ret_o = ( len_i == write(fid_i, buf_v, len_i) ) ? c3y : c3n;
+    close(fid_i);
+    return ret_o;
+  }
+}
+
+/* _test_patch_v1(): a version 1 patch from an older binary is applied.
+*/
+static c3_i
+_test_patch_v1(void)
+{
+  c3_c  dir_c[] = "/tmp/events_tests_XXXXXX";
+  c3_c  pax_c[8193];
+  c3_i  ret_i = 1;
+
+  if ( !mkdtemp(dir_c) ) {
+    fprintf(stderr, "patch_v1: mkdtemp failed\r\n");
+    return 0;
+  }
+
+  snprintf(pax_c, 8192, "%s/.urb", dir_c);
+  c3_mkdir(pax_c, 0700);
+  snprintf(pax_c, 8192, "%s/.urb/chk", dir_c);
+  c3_mkdir(pax_c, 0700);
+
+  //  two pages north, one south; left as if a v1 binary died
+  //  before (or while) applying it
+  //
+  {
+    c3_w            pgs_w = 3;
+    c3_w            sed_w[3] = { 1, 2, 3 };
+    c3_w            pag_w[3] = { 0, 1, (u3C.wor_i >> u3a_page) - 1 };
+    c3_w*           mem_w = c3_malloc(pgs_w * _v1_page * sizeof(c3_w));
+    size_t          len_i = sizeof(u3e_control_v1) + pgs_w * sizeof(u3e_line);
+    u3e_control_v1* con_u = c3_calloc(len_i);
+    c3_w            i_w;
+
+    con_u->ver_y = 1;
+    con_u->nor_w = 2;
+    con_u->sou_w = 1;
+    con_u->pgs_w = pgs_w;
+
+    for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+      c3_w* buf_w = mem_w + (i_w * _v1_page);
+
+      _fill_page(buf_w, sed_w[i_w]);
+      con_u->mem_u[i_w].pag_w = pag_w[i_w];
+      con_u->mem_u[i_w].mug_w = u3r_mug_words(buf_w, _v1_page);
+    }
+
+    snprintf(pax_c, 8192, "%s/.urb/chk/control.bin", dir_c);
+    if ( c3n == _write_file(pax_c, con_u, len_i) ) {
+      fprintf(stderr, "patch_v1: control write failed\r\n");
+      ret_i = 0;
+    }
+
+    snprintf(pax_c, 8192, "%s/.urb/chk/memory.bin", dir_c);
+    if ( c3n == _write_file(pax_c, mem_w, pgs_w * _v1_page * sizeof(c3_w)) ) {
+      fprintf(stderr, "patch_v1: memory write failed\r\n");
+      ret_i = 0;
+    }
+
+    c3_free(con_u);
+    c3_free(mem_w);
+  }
+
+  if ( c3y == u3e_live(c3n, dir_c) ) {
+    fprintf(stderr, "patch_v1: image not found\r\n");
+    ret_i = 0;
+  }
+
+  if ( (2 != u3P.nor_u.pgs_w) || (1 != u3P.sou_u.pgs_w) ) {
+    fprintf(stderr, "patch_v1: image size %u/%u\r\n",
+                    u3P.nor_u.pgs_w, u3P.sou_u.pgs_w);
+    ret_i = 0;
+  }
+
+  if (  (c3n == _check_page(u3_Loom, 1))
+     || (c3n == _check_page(u3_Loom + _v1_page, 2))
+     || (c3n == _check_page(u3_Loom + (u3C.wor_i - _v1_page), 3)) )
+  {
+    fprintf(stderr, "patch_v1: loom contents\r\n");
+    ret_i = 0;
+  }
+
+  {
+    struct stat buf_u;
+
+    snprintf(pax_c, 8192, "%s/.urb/chk/control.bin", dir_c);
+    if ( 0 == stat(pax_c, &buf_u) ) {
+      fprintf(stderr, "patch_v1: patch not deleted\r\n");
+      ret_i = 0;
+    }
+  }
+
+  return ret_i;
+}
+
+/* _zero_page(): confirm a page is empty.
+*/
+static c3_o
+_zero_page(c3_w* pag_w)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < _v1_page; i_w++ ) {
+    if ( pag_w[i_w] ) {
+      return c3n;
+    }
+  }
+
+  return c3y;
+}
+
+/* _patch_dir(): make a pier directory for a checkpoint.
+*/
+static c3_o
+_patch_dir(c3_c* dir_c)
+{
+  c3_c pax_c[8193];
+
+  if ( !mkdtemp(dir_c) ) {
+    return c3n;
+  }
+
+  snprintf(pax_c, 8192, "%s/.urb", dir_c);
+  c3_mkdir(pax_c, 0700);
+  snprintf(pax_c, 8192, "%s/.urb/chk", dir_c);
+  c3_mkdir(pax_c, 0700);
+
+  return c3y;
+}
+
+/* _patch_make(): write a patch of loom pages [pag_w], each filled with
+**                a pattern seeded by its number, with a bad mug at [bad_w].
+*/
+static c3_o
+_patch_make(c3_c* dir_c,
+            c3_w  pgs_w,
+            c3_w* pag_w,
+            c3_w  nor_w,
+            c3_w  sou_w,
+            c3_w  bad_w)
+{
+  size_t       len_i = sizeof(u3e_control) + pgs_w * sizeof(u3e_line);
+  u3e_control* con_u = c3_calloc(len_i);
+  c3_w*        mem_w = c3_malloc(pgs_w * _pag_siz);
+  c3_c         pax_c[8193];
+  c3_o         ret_o = c3y;
+  c3_w         i_w;
+
+  con_u->ver_y = u3e_version;
+  con_u->pag_y = u3a_page;
+  con_u->nor_w = nor_w;
+  con_u->sou_w = sou_w;
+  con_u->pgs_w = pgs_w;
+
+  //  checksummed one page at a time
+  //
+  for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+    c3_w* buf_w = mem_w + (i_w * _v1_page);
+
+    _fill_page(buf_w, pag_w[i_w]);
+    con_u->mem_u[i_w].pag_w = pag_w[i_w];
+    con_u->mem_u[i_w].mug_w = u3r_mug_words(buf_w, _v1_page);
+
+    if ( bad_w == i_w ) {
+      con_u->mem_u[i_w].mug_w ^= 1;
+    }
+  }
+
+  snprintf(pax_c, 8192, "%s/.urb/chk/control.bin", dir_c);
+  if ( c3n == _write_file(pax_c, con_u, len_i) ) {
+    ret_o = c3n;
+  }
+
+  snprintf(pax_c, 8192, "%s/.urb/chk/memory.bin", dir_c);
+  if ( c3n == _write_file(pax_c, mem_w, pgs_w * _pag_siz) ) {
+    ret_o = c3n;
+  }
+
+  c3_free(con_u);
+  c3_free(mem_w);
+
+  return ret_o;
+}
+
+/* _patch_live(): clear the loom, and load the checkpoint in [dir_c].
+*/
+static c3_o
+_patch_live(c3_c* dir_c)
+{
+  if ( 0 != mprotect(u3_Loom, u3C.wor_i << 2, PROT_READ | PROT_WRITE) ) {
+    fprintf(stderr, "patch: mprotect: %s\r\n", strerror(errno));
+    exit(1);
+  }
+
+  memset(u3_Loom, 0, u3C.wor_i << 2);
+
+  //  u3e_live() expects to run once; forget the last checkpoint
+  //
+  u3P.nor_u.pgs_w = u3P.sou_u.pgs_w = 0;
+
+  return u3e_live(c3n, dir_c);
+}
+
+/* _patch_gone(): confirm the patch was deleted.
+*/
+static c3_o
+_patch_gone(c3_c* dir_c)
+{
+  struct stat buf_u;
+  c3_c        pax_c[8193];
+
+  snprintf(pax_c, 8192, "%s/.urb/chk/control.bin", dir_c);
+  return ( 0 == stat(pax_c, &buf_u) ) ? c3n : c3y;
+}
+
+/* _test_patch_runs(): adjacent image pages are applied in one write.
+*/
+static c3_i
+_test_patch_runs(void)
+{
+  c3_c dir_c[] = "/tmp/events_tests_XXXXXX";
+  c3_w top_w   = (u3C.wor_i >> u3a_page) - 1;
+  c3_w pag_w[6] = { 0, 1, 2, 5, 6, top_w };
+  c3_i ret_i   = 1;
+  c3_w i_w;
+
+  if (  (c3n == _patch_dir(dir_c))
+     || (c3n == _patch_make(dir_c, 6, pag_w, 7, 1, ~0)) )
+  {
+    fprintf(stderr, "patch runs: setup failed\r\n");
+    return 0;
+  }
+
+  _io_reset(0, 0);
+
+  if ( c3y == _patch_live(dir_c) ) {
+    fprintf(stderr, "patch runs: image not found\r\n");
+    ret_i = 0;
+  }
+
+  //  read once to verify, and once to apply
+  //
+  if ( 2 != _io_u.red_w ) {
+    fprintf(stderr, "patch runs: %u reads\r\n", _io_u.red_w);
+    ret_i = 0;
+  }
+
+  //  north pages 0-2 and 5-6 across the gap, then the south page
+  //
+  {
+    _io_call cal_u[3] = {
+      { 1, 3 * _pag_siz, 0 },
+      { 1, 2 * _pag_siz, 5 * _pag_siz },
+      { 1, 1 * _pag_siz, 0 }
+    };
+
+    if ( 3 != _io_u.wri_w ) {
+      fprintf(stderr, "patch runs: %u writes\r\n", _io_u.wri_w);
+      ret_i = 0;
+    }
+    else {
+      for ( i_w = 0; i_w < 3; i_w++ ) {
+        if (  (cal_u[i_w].cnt_i != _io_u.wri_u[i_w].cnt_i)
+           || (cal_u[i_w].len_i != _io_u.wri_u[i_w].len_i)
+           || (cal_u[i_w].off_i != _io_u.wri_u[i_w].off_i) )
+        {
+          fprintf(stderr, "patch runs: write %u: %zu at %zu\r\n", i_w,
+                          _io_u.wri_u[i_w].len_i,
+                          (size_t)_io_u.wri_u[i_w].off_i);
+          ret_i = 0;
+        }
+      }
+    }
+  }
+
+  for ( i_w = 0; i_w < 6; i_w++ ) {
+    if ( c3n == _check_page(u3_Loom + (pag_w[i_w] << u3a_page), pag_w[i_w]) ) {
+      fprintf(stderr, "patch runs: page %u\r\n", pag_w[i_w]);
+      ret_i = 0;
+    }
+  }
+
+  if (  (c3n == _zero_page(u3_Loom + (3 << u3a_page)))
+     || (c3n == _zero_page(u3_Loom + (4 << u3a_page))) )
+  {
+    fprintf(stderr, "patch runs: gap not empty\r\n");
+    ret_i = 0;
+  }
+
+  if ( c3n == _patch_gone(dir_c) ) {
+    fprintf(stderr, "patch runs: patch not deleted\r\n");
+    ret_i = 0;
+  }
+
+  return ret_i;
+}
+
+/* _test_patch_mugs_one(): verify and apply [pgs_w] pages on [cpu_l] cores.
+*/
+static c3_i
+_test_patch_mugs_one(c3_w pgs_w, long cpu_l)
+{
+  c3_c  dir_c[] = "/tmp/events_tests_XXXXXX";
+  c3_w* pag_w   = c3_malloc(pgs_w * sizeof(c3_w));
+  c3_i  ret_i   = 1;
+  c3_w  i_w;
+
+  for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+    pag_w[i_w] = i_w;
+  }
+
+  if (  (c3n == _patch_dir(dir_c))
+     || (c3n == _patch_make(dir_c, pgs_w, pag_w, pgs_w, 0, ~0)) )
+  {
+    fprintf(stderr, "patch mugs: setup failed\r\n");
+    c3_free(pag_w);
+    return 0;
+  }
+
+  _io_reset(0, cpu_l);
+
+  if ( c3y == _patch_live(dir_c) ) {
+    fprintf(stderr, "patch mugs: %u pages, %ld cores: rejected\r\n",
+                    pgs_w, cpu_l);
+    ret_i = 0;
+  }
+
+  for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+    if ( c3n == _check_page(u3_Loom + (i_w << u3a_page), i_w) ) {
+      fprintf(stderr, "patch mugs: %u pages, %ld cores: page %u\r\n",
+                      pgs_w, cpu_l, i_w);
+      ret_i = 0;
+      break;
+    }
+  }
+
+  //  verify and apply each read the patch in batches
+  //
+  {
+    size_t len_i = pgs_w * _pag_siz;
+    c3_w   bat_w = (len_i + (_bat_siz - 1)) / _bat_siz;
+    c3_w   ful_w = 0;
+
+    for ( i_w = 0; (i_w < _io_u.red_w) && (i_w < _io_max); i_w++ ) {
+      if ( _bat_siz == _io_u.red_u[i_w].len_i ) {
+        ful_w++;
+      }
+      else if ( _bat_siz < _io_u.red_u[i_w].len_i ) {
+        fprintf(stderr, "patch mugs: read of %zu\r\n",
+                        _io_u.red_u[i_w].len_i);
+        ret_i = 0;
+      }
+    }
+
+    if (  ((2 * bat_w) != _io_u.red_w)
+       || ((2 * (len_i / _bat_siz)) != ful_w) )
+    {
+      fprintf(stderr, "patch mugs: %u pages: %u reads, %u full\r\n",
+                      pgs_w, _io_u.red_w, ful_w);
+      ret_i = 0;
+    }
+  }
+
+  c3_free(pag_w);
+
+  return ret_i;
+}
+
+/* _test_patch_mugs(): checksums agree at any thread count,
+**                     and are checked in every batch.
+*/
+static c3_i
+_test_patch_mugs(void)
+{
+  //  one page less than a checksum thread's share, one more,
+  //  two threads' worth, and more than two i/o batches
+  //
+  c3_w len_w[4] = { 63, 64, 128, 1100 };
+  c3_i ret_i    = 1;
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < 4; i_w++ ) {
+    if (  !_test_patch_mugs_one(len_w[i_w], 1)
+       || !_test_patch_mugs_one(len_w[i_w], 8) )
+    {
+      ret_i = 0;
+    }
+  }
+
+  //  a bad mug on the last page, in the last batch
+  //
+  {
+    c3_c  dir_c[] = "/tmp/events_tests_XXXXXX";
+    c3_w  pgs_w   = 1100;
+    c3_w* pag_w   = c3_malloc(pgs_w * sizeof(c3_w));
+
+    for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+      pag_w[i_w] = i_w;
+    }
+
+    if (  (c3n == _patch_dir(dir_c))
+       || (c3n == _patch_make(dir_c, pgs_w, pag_w, pgs_w, 0, pgs_w - 1)) )
+    {
+      fprintf(stderr, "patch mugs: setup failed\r\n");
+      ret_i = 0;
+    }
+    else {
+      _io_reset(0, 8);
+
+      if (  (c3n == _patch_live(dir_c))
+         || (c3n == _zero_page(u3_Loom))
+         || (c3n == _patch_gone(dir_c)) )
+      {
+        fprintf(stderr, "patch mugs: bad mug accepted\r\n");
+        ret_i = 0;
+      }
+    }
+
+    c3_free(pag_w);
+  }
+
+  return ret_i;
+}
+
+/* _test_patch_short(): short reads and writes are retried.
+*/
+static c3_i
+_test_patch_short(void)
+{
+  c3_c  dir_c[] = "/tmp/events_tests_XXXXXX";
+  c3_w  top_w   = (u3C.wor_i >> u3a_page) - 1;
+  c3_w  pgs_w   = 1100;
+  c3_w* pag_w   = c3_malloc(pgs_w * sizeof(c3_w));
+  c3_i  ret_i   = 1;
+  c3_w  i_w;
+
+  //  north pages with a gap in the middle, and two south pages
+  //
+  for ( i_w = 0; i_w < pgs_w - 2; i_w++ ) {
+    pag_w[i_w] = ( i_w < 500 ) ? i_w : (i_w + 100);
+  }
+
+  pag_w[pgs_w - 2] = top_w;
+  pag_w[pgs_w - 1] = top_w - 1;
+
+  if (  (c3n == _patch_dir(dir_c))
+     || (c3n == _patch_make(dir_c, pgs_w, pag_w, pgs_w + 98, 2, ~0)) )
+  {
+    fprintf(stderr, "patch short: setup failed\r\n");
+    c3_free(pag_w);
+    return 0;
+  }
+
+  //  an odd length, splitting words and pages
+  //
+  _io_reset(4099, 8);
+
+  if ( c3y == _patch_live(dir_c) ) {
+    fprintf(stderr, "patch short: rejected\r\n");
+    ret_i = 0;
+  }
+
+  _io_reset(0, 0);
+
+  for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+    if ( c3n == _check_page(u3_Loom + (pag_w[i_w] << u3a_page), pag_w[i_w]) ) {
+      fprintf(stderr, "patch short: page %u\r\n", pag_w[i_w]);
+      ret_i = 0;
+      break;
+    }
+  }
+
+  if ( c3n == _zero_page(u3_Loom + (550 << u3a_page)) ) {
+    fprintf(stderr, "patch short: gap not empty\r\n");
+    ret_i = 0;
+  }
+
+  c3_free(pag_w);
+
+  return ret_i;
+}
+
+/* _save_fill(): fill loom pages [pag_w] with patterns [sed_w].
+*/
+static void
+_save_fill(c3_w len_w, c3_w* pag_w, c3_w* sed_w)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    _fill_page(u3_Loom + (pag_w[i_w] << u3a_page), sed_w[i_w]);
+  }
+}
+
+/* _save_check(): confirm image pages [pag_w] hold patterns [sed_w].
+*/
+static c3_o
+_save_check(c3_c* dir_c, c3_w len_w, c3_w* pag_w, c3_w* sed_w)
+{
+  c3_w* buf_w = c3_malloc(_pag_siz);
+  c3_c  pax_c[8193];
+  c3_o  ret_o = c3y;
+  c3_i  fid_i;
+  c3_w  i_w;
+
+  snprintf(pax_c, 8192, "%s/.urb/chk/north.bin", dir_c);
+
+  if ( -1 == (fid_i = c3_open(pax_c, O_RDONLY)) ) {
+    c3_free(buf_w);
+    return c3n;
+  }
+
+  for ( i_w = 0; (c3y == ret_o) && (i_w < len_w); i_w++ ) {
+    if (  (_pag_siz != pread(fid_i, buf_w, _pag_siz,
+                             (off_t)pag_w[i_w] * _pag_siz))
+       || (c3n == _check_page(buf_w, sed_w[i_w])) )
+    {
+      fprintf(stderr, "save: image page %u\r\n", pag_w[i_w]);
+      ret_o = c3n;
+    }
+  }
+
+  close(fid_i);
+  c3_free(buf_w);
+
+  return ret_o;
+}
+
+/* _test_save_runs(): dirty pages are saved in runs, across gaps,
+**                    and short writes are retried.
+*/
+static c3_i
+_test_save_runs(void)
+{
+  c3_c  dir_c[] = "/tmp/events_tests_XXXXXX";
+  c3_w  pag_w[7];
+  c3_w  sed_w[7];
+  c3_w* buf_w;
+  c3_i  ret_i = 1;
+  c3_w  i_w;
+
+  if ( c3n == _patch_dir(dir_c) ) {
+    fprintf(stderr, "save runs: setup failed\r\n");
+    return 0;
+  }
+
+  _io_reset(0, 0);
+
+  if ( c3n == _patch_live(dir_c) ) {
+    fprintf(stderr, "save runs: unexpected image\r\n");
+    return 0;
+  }
+
+  u3m_pave(c3y);
+  u3e_init();
+
+  //  seven whole pages on the heap
+  //
+  buf_w = u3a_walloc(8 << u3a_page);
+
+  for ( i_w = 0; i_w < 7; i_w++ ) {
+    pag_w[i_w] = ((u3a_outa(buf_w) + (_v1_page - 1)) >> u3a_page) + i_w;
+    sed_w[i_w] = i_w + 1;
+  }
+
+  _save_fill(7, pag_w, sed_w);
+  u3e_save();
+
+  //  dirty the first two pages and the fifth
+  //
+  {
+    c3_w dir_w[3] = { pag_w[0], pag_w[1], pag_w[4] };
+    c3_w des_w[3] = { 11, 12, 15 };
+
+    sed_w[0] = 11; sed_w[1] = 12; sed_w[4] = 15;
+
+    _io_reset(0, 0);
+    _save_fill(3, dir_w, des_w);
+    u3e_save();
+  }
+
+  //  the patch is written in one call, the images in one per run
+  //
+  {
+    _io_call cal_u[3] = {
+      { 2, 3 * _pag_siz, 0 },
+      { 1, 2 * _pag_siz, (off_t)pag_w[0] * _pag_siz },
+      { 1, 1 * _pag_siz, (off_t)pag_w[4] * _pag_siz }
+    };
+
+    if ( 3 != _io_u.wri_w ) {
+      fprintf(stderr, "save runs: %u writes\r\n", _io_u.wri_w);
+      ret_i = 0;
+    }
+    else {
+      for ( i_w = 0; i_w < 3; i_w++ ) {
+        if (  (cal_u[i_w].cnt_i != _io_u.wri_u[i_w].cnt_i)
+           || (cal_u[i_w].len_i != _io_u.wri_u[i_w].len_i)
+           || (cal_u[i_w].off_i != _io_u.wri_u[i_w].off_i) )
+        {
+          fprintf(stderr, "save runs: write %u: %d, %zu at %zu\r\n", i_w,
+                          _io_u.wri_u[i_w].cnt_i,
+                          _io_u.wri_u[i_w].len_i,
+                          (size_t)_io_u.wri_u[i_w].off_i);
+          ret_i = 0;
+        }
+      }
+    }
+  }
+
+  if ( c3n == _save_check(dir_c, 7, pag_w, sed_w) ) {
+    ret_i = 0;
+  }
+
+  //  dirty the third, fourth and last pages, writing a little at a time
+  //
+  {
+    c3_w dir_w[3] = { pag_w[2], pag_w[3], pag_w[6] };
+    c3_w des_w[3] = { 23, 24, 27 };
+
+    sed_w[2] = 23; sed_w[3] = 24; sed_w[6] = 27;
+
+    _io_reset(4099, 0);
+    _save_fill(3, dir_w, des_w);
+    u3e_save();
+    _io_reset(0, 0);
+  }
+
+  if ( c3n == _save_check(dir_c, 7, pag_w, sed_w) ) {
+    fprintf(stderr, "save runs: short writes\r\n");
+    ret_i = 0;
+  }
+
+  u3a_wfree(buf_w);
+
+  return ret_i;
+}
+
+/* main(): run all test cases.
+*/
+int
+main(int argc, char* argv[])
+{
+  _setup();
+
+  if (  !_test_patch_v1()
+     || !_test_patch_runs()
+     || !_test_patch_mugs()
+     || !_test_patch_short()
+     || !_test_save_runs() )
+  {
+    fprintf(stderr, "test_events: failed\r\n");
+    exit(1);
+  }
+
+  fprintf(stderr, "test_events: ok\n");
+
+  return 0;
+}
@@ -209,6 +209,296 @@ _test_cache_replace_value(void)
   return ret_i;
 }
 
+/* _test_cache_spare(): spare entries with a null value.
+*/
+static c3_o
+_test_cache_spare(u3_noun kev)
+{
+  return ( 0 == u3t(kev) ) ? c3y : c3n;
+}
+
+/* _test_cache_trim_with():
+*/
+static c3_i
+_test_cache_trim_with(void)
+{
+  c3_i ret_i = 1;
+  c3_w max_w = 10;
+  c3_w   i_w;
+
+  u3p(u3h_root) har_p = u3h_new_cache(max_w);
+  u3h_root*     har_u = u3to(u3h_root, har_p);
+
+  //  key 0 is spared; everything else has a nonzero value
+  //
+  for ( i_w = 0; i_w < 1000; i_w++ ) {
+    u3h_put_with(har_p, i_w, i_w, _test_cache_spare);
+  }
+
+  if ( 0 != u3h_get(har_p, 0) ) {
+    fprintf(stderr, "cache_trim_with (a): fail\r\n");
+    ret_i = 0;
+  }
+  if ( 999 != u3h_get(har_p, 999) ) {
+    fprintf(stderr, "cache_trim_with (b): fail\r\n");
+    ret_i = 0;
+  }
+  if ( max_w != har_u->use_w ) {
+    fprintf(stderr, "cache_trim_with (c): fail %d %d\r\n",
+            max_w, har_u->use_w );
+    ret_i = 0;
+  }
+
+  u3h_free(har_p);
+  return ret_i;
+}
+
+/* _test_flat(): test a flat hashtable, without caching.
+*/
+static c3_i
+_test_flat(void)
+{
+  c3_i ret_i = 1;
+  c3_w max_w = 1000;
+  c3_w   i_w;
+
+  u3p(u3h_root) har_p = u3h_new_flat(0);
+  u3h_root*     har_u = u3to(u3h_root, har_p);
+
+  for ( i_w = 0; i_w < max_w; i_w++ ) {
+    u3_noun key = u3nc(i_w, i_w);
+    u3h_put(har_p, key, i_w + max_w);
+    u3z(key);
+  }
+
+  for ( i_w = 0; i_w < max_w; i_w += 2 ) {
+    u3_noun key = u3nc(i_w, i_w);
+    u3h_put(har_p, key, i_w);
+    u3z(key);
+  }
+
+  for ( i_w = 0; i_w < max_w; i_w++ ) {
+    u3_noun key = u3nc(i_w, i_w);
+    c3_w  val_w = ( i_w & 1 ) ? (i_w + max_w) : i_w;
+
+    if ( val_w != u3h_get(har_p, key) ) {
+      fprintf(stderr, "flat (a): get failed %u\r\n", i_w);
+      ret_i = 0;
+    }
+    if ( c3y != u3h_hum(har_p, u3r_mug(key)) ) {
+      fprintf(stderr, "flat (b): hum failed %u\r\n", i_w);
+      ret_i = 0;
+    }
+    u3z(key);
+  }
+
+  if ( max_w != har_u->use_w ) {
+    fprintf(stderr, "flat (c): fail %d %d\r\n", max_w, har_u->use_w);
+    ret_i = 0;
+  }
+
+  u3h_free(har_p);
+  return ret_i;
+}
+
+/* _test_flat_cache_trimming(): ensure a flat cache removes stale items.
+*/
+static c3_i
+_test_flat_cache_trimming(void)
+{
+  c3_i ret_i = 1;
+  c3_w max_w = 200000;
+  c3_w i_w, fil_w = max_w / 10;
+
+  u3p(u3h_root) har_p = u3h_new_flat(fil_w);
+  u3h_root*     har_u = u3to(u3h_root, har_p);
+
+  for ( i_w = 0; i_w < max_w; i_w++ ) {
+    u3_noun cel = u3nc(i_w, i_w);
+    u3h_put(har_p, cel, cel);
+  }
+
+  {
+    c3_w  las_w = max_w - 1;
+    u3_noun key = u3nc(las_w, las_w);
+    u3_noun val = u3h_get(har_p, key);
+    u3z(key);
+
+    if ( (u3_none == val) || (las_w != u3t(val)) ) {
+      fprintf(stderr, "flat_cache_trimming (a): fail\r\n");
+      ret_i = 0;
+    }
+    else {
+      u3z(val);
+    }
+
+    if ( fil_w != har_u->use_w ) {
+      fprintf(stderr, "flat_cache_trimming (b): fail %d != %d\r\n",
+              fil_w, har_u->use_w );
+      ret_i = 0;
+    }
+  }
+
+  //  spared entries survive the clock
+  //
+  u3h_put_with(har_p, 0, 0, _test_cache_spare);
+
+  for ( i_w = 1; i_w < max_w; i_w++ ) {
+    u3h_put_with(har_p, i_w, i_w, _test_cache_spare);
+  }
+
+  if ( 0 != u3h_get(har_p, 0) ) {
+    fprintf(stderr, "flat_cache_trimming (c): fail\r\n");
+    ret_i = 0;
+  }
+  if ( fil_w != har_u->use_w ) {
+    fprintf(stderr, "flat_cache_trimming (d): fail %d != %d\r\n",
+            fil_w, har_u->use_w );
+    ret_i = 0;
+  }
+
+  u3h_free(har_p);
+  return ret_i;
+}
+
+/* _zave_spend(): incur [cos_w] units of memo cache compute cost.
+*/
+static void
+_zave_spend(c3_w cos_w)
+{
+#ifdef U3_CPU_DEBUG
+  u3R->pro.nox_d += cos_w;
+#else
+  usleep(cos_w);
+#endif
+}
+
+/* _zave_credit(): eviction credit of memo cache entry [key], or -1.
+**                 TRANSFER key.
+*/
+static c3_ws
+_zave_credit(u3_noun key)
+{
+  u3_weak ent = u3h_git(u3R->cax.har_p, key);
+  u3z(key);
+  return ( u3_none == ent ) ? -1 : (c3_ws)u3h(ent);
+}
+
+/* _test_zave(): memo cache entries are evicted by cost per word.
+*/
+static c3_i
+_test_zave(void)
+{
+  c3_i ret_i = 1;
+  c3_w max_w = 64;
+  c3_w   i_w;
+  c3_ws cre_ws;
+
+  u3p(u3h_root) cax_p = u3R->cax.har_p;
+  u3R->cax.har_p = u3h_new_flat(max_w);
+
+  //  expensive and compact: credit is capped
+  //
+  {
+    u3_noun key = u3nc(c3__test, 1);
+
+    if ( u3_none != u3z_find(key) ) {
+      fprintf(stderr, "zave (a): fail\r\n");
+      ret_i = 0;
+    }
+
+    _zave_spend(1000);
+    u3z_save(key, 42);
+  }
+
+  //  expensive and large: credit is by cost per word
+  //
+  {
+    u3_noun key = u3nc(c3__test, 2);
+    c3_w  wor_w[500];
+
+    memset(wor_w, 0xff, sizeof(wor_w));
+    u3z_find(key);
+    _zave_spend(1000);
+    u3z(u3z_save(key, u3i_words(500, wor_w)));
+  }
+
+  //  saved without a miss: free to recompute
+  //
+  u3z_save(u3nc(c3__test, 3), 43);
+
+  if ( 255 != (cre_ws = _zave_credit(u3nc(c3__test, 1))) ) {
+    fprintf(stderr, "zave (b): fail %d\r\n", cre_ws);
+    ret_i = 0;
+  }
+
+  cre_ws = _zave_credit(u3nc(c3__test, 2));
+
+  if ( (cre_ws < 1) || (cre_ws >= 255) ) {
+    fprintf(stderr, "zave (c): fail %d\r\n", cre_ws);
+    ret_i = 0;
+  }
+
+  if ( 0 != (cre_ws = _zave_credit(u3nc(c3__test, 3))) ) {
+    fprintf(stderr, "zave (d): fail %d\r\n", cre_ws);
+    ret_i = 0;
+  }
+
+  //  found results are unwrapped from [cre pro]
+  //
+  {
+    u3_noun key = u3nc(c3__test, 1);
+
+    if ( 42 != u3z_find(key) ) {
+      fprintf(stderr, "zave (e): fail\r\n");
+      ret_i = 0;
+    }
+
+    u3z(key);
+  }
+
+  //  uniquified nouns are shared
+  //
+  {
+    u3_noun fir = u3nc(1, 2);
+    u3_noun sec = u3nc(1, 2);
+
+    fir = u3z_uniq(fir);
+    sec = u3z_uniq(sec);
+
+    if ( fir != sec ) {
+      fprintf(stderr, "zave (f): fail\r\n");
+      ret_i = 0;
+    }
+
+    u3z(fir); u3z(sec);
+  }
+
+  //  fill the cache with free entries: the expensive, compact entry
+  //  spends credit to survive, the free one is evicted
+  //
+  for ( i_w = 0; i_w < 8 * max_w; i_w++ ) {
+    u3z_save(u3nc(c3__test, 16 + i_w), i_w);
+  }
+
+  cre_ws = _zave_credit(u3nc(c3__test, 1));
+
+  if ( (cre_ws < 1) || (cre_ws >= 255) ) {
+    fprintf(stderr, "zave (g): fail %d\r\n", cre_ws);
+    ret_i = 0;
+  }
+
+  if ( -1 != (cre_ws = _zave_credit(u3nc(c3__test, 3))) ) {
+    fprintf(stderr, "zave (h): fail %d\r\n", cre_ws);
+    ret_i = 0;
+  }
+
+  u3h_free(u3R->cax.har_p);
+  u3R->cax.har_p = cax_p;
+
+  return ret_i;
+}
+
 static c3_i
 _test_hashtable(void)
 {
@@ -219,6 +509,10 @@ _test_hashtable(void)
   ret_i &= _test_skip_slot();
   ret_i &= _test_cache_trimming();
   ret_i &= _test_cache_replace_value();
+  ret_i &= _test_cache_trim_with();
+  ret_i &= _test_flat();
+  ret_i &= _test_flat_cache_trimming();
+  ret_i &= _test_zave();
 
   return ret_i;
 }
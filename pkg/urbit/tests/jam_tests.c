@@ -1,5 +1,6 @@
 #include "all.h"
 #include "ur/ur.h"
+#include <errno.h>
 
 /* _setup(): prepare for tests.
 */
@@ -244,6 +245,110 @@ _test_jam_roundtrip(void)
   return ret_i;
 }
 
+/* _test_cue_stream(): cue from a file, larger than the read window.
+*/
+static c3_i
+_test_cue_stream(void)
+{
+  c3_i    ret_i = 1;
+  c3_c    pat_c[] = "/tmp/urbit-jam-test-XXXXXX";
+  c3_w    ran_w = 0x1234567;
+  c3_y    byt_y[1000];
+  u3_noun   big, lis = u3_nul;
+  c3_d    len_d;
+  c3_y*   jam_y;
+  c3_i    fid_i;
+  c3_w    i_w, j_w;
+
+  //  irregular atoms, shared structure, and one atom wider than a chunk
+  //
+  for ( i_w = 0; i_w < 2048; i_w++ ) {
+    c3_w len_w = 1 + (ran_w % sizeof(byt_y));
+
+    for ( j_w = 0; j_w < len_w; j_w++ ) {
+      ran_w = (ran_w * 1103515245) + 12345;
+      byt_y[j_w] = (c3_y)(ran_w >> 16);
+    }
+
+    lis = u3nc(u3i_bytes(len_w, byt_y), lis);
+  }
+
+  {
+    c3_y* wid_y = c3_malloc(3 << 19);
+
+    memset(wid_y, 0xa5, 3 << 19);
+    big = u3nt(u3k(lis), u3i_bytes(3 << 19, wid_y), lis);
+    c3_free(wid_y);
+  }
+
+  u3s_jam_xeno(big, &len_d, &jam_y);
+
+  if ( -1 == (fid_i = mkstemp(pat_c)) ) {
+    fprintf(stderr, "cue stream: mkstemp: %s\r\n", strerror(errno));
+    return 0;
+  }
+
+  unlink(pat_c);
+
+  if ( len_d != write(fid_i, jam_y, len_d) ) {
+    fprintf(stderr, "cue stream: write failed\r\n");
+    ret_i = 0;
+  }
+  else {
+    u3_cue_xeno* sil_u = u3s_cue_xeno_init();
+    u3_weak        pro;
+
+    lseek(fid_i, 0, SEEK_SET);
+    pro = u3s_cue_xeno_fd(sil_u, fid_i);
+
+    if ( (u3_none == pro) || (c3n == u3r_sing(big, pro)) ) {
+      fprintf(stderr, "cue stream: fd failed\r\n");
+      ret_i = 0;
+    }
+
+    u3z(pro);
+
+    {
+      c3_y* map_y = mmap(0, len_d, PROT_READ, MAP_SHARED, fid_i, 0);
+
+      if ( MAP_FAILED == map_y ) {
+        fprintf(stderr, "cue stream: mmap: %s\r\n", strerror(errno));
+        ret_i = 0;
+      }
+      else {
+        pro = u3s_cue_xeno_mmap(sil_u, len_d, map_y);
+
+        if ( (u3_none == pro) || (c3n == u3r_sing(big, pro)) ) {
+          fprintf(stderr, "cue stream: mmap failed\r\n");
+          ret_i = 0;
+        }
+
+        u3z(pro);
+        munmap(map_y, len_d);
+      }
+    }
+
+    //  truncated input
+    //
+    ftruncate(fid_i, len_d / 2);
+    lseek(fid_i, 0, SEEK_SET);
+
+    if ( u3_none != (pro = u3s_cue_xeno_fd(sil_u, fid_i)) ) {
+      fprintf(stderr, "cue stream: truncated succeeded\r\n");
+      u3z(pro);
+      ret_i = 0;
+    }
+
+    u3s_cue_xeno_done(sil_u);
+  }
+
+  close(fid_i);
+  c3_free(jam_y);
+  u3z(big);
+
+  return ret_i;
+}
+
 /* main(): run all test cases.
 */
 int
@@ -256,6 +361,11 @@ main(int argc, char* argv[])
     exit(1);
   }
 
+  if ( !_test_cue_stream() ) {
+    fprintf(stderr, "test jam: cue stream failed\r\n");
+    exit(1);
+  }
+
   //  GC
   //
   u3m_grab(u3_none);
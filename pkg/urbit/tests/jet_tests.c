@@ -5,8 +5,10 @@
 static void
 _setup(void)
 {
-  u3m_init(1 << 20);
+  u3C.wag_w |= u3o_hashless;
+  u3m_init(1 << 24);
   u3m_pave(c3y);
+  u3j_boot(c3y);
 }
 
 static inline c3_i
@@ -497,6 +499,361 @@ _test_ob(void)
   return ret_i;
 }
 
+/* _mpn_atom(): deterministic pseudo-random atom of [len_w] words.
+*/
+static u3_atom
+_mpn_atom(c3_w len_w, c3_w* sed_w)
+{
+  c3_w buf_w[16];
+  c3_w i_w;
+
+  c3_assert( len_w <= 16 );
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    *sed_w = (*sed_w * 1103515245) + 12345;
+    buf_w[i_w] = *sed_w ^ (*sed_w >> 13);
+  }
+
+  return u3i_words(len_w, buf_w);
+}
+
+/* _mpn_same(): check jet product [pro] against GMP reference [ref_mp].
+*/
+static c3_i
+_mpn_same(const c3_c* cap_c, u3_atom a, u3_atom b, u3_atom pro, mpz_t ref_mp)
+{
+  u3_atom ref = u3i_mp(ref_mp);
+  c3_i  ret_i = 1;
+
+  if ( c3n == u3r_sing(ref, pro) ) {
+    fprintf(stderr, "mpn: %s wrong\r\n", cap_c);
+    u3m_p("a", a);
+    u3m_p("b", b);
+    ret_i = 0;
+  }
+
+  u3z(ref); u3z(pro);
+  return ret_i;
+}
+
+static c3_i
+_test_mpn(void)
+{
+  c3_i ret_i = 1;
+  c3_w sed_w = 0xdeadbeef;
+  c3_w i_w, j_w, k_w;
+
+  for ( i_w = 0; i_w < 10; i_w++ ) {
+    for ( j_w = 0; j_w < 10; j_w++ ) {
+      for ( k_w = 0; k_w < 4; k_w++ ) {
+        u3_atom a = _mpn_atom(i_w, &sed_w);
+        u3_atom b = _mpn_atom(j_w, &sed_w);
+        mpz_t a_mp, b_mp, c_mp, d_mp;
+
+        u3r_mp(a_mp, a);
+        u3r_mp(b_mp, b);
+        mpz_init(c_mp);
+        mpz_init(d_mp);
+
+        mpz_add(c_mp, a_mp, b_mp);
+        ret_i &= _mpn_same("add", a, b, u3qa_add(a, b), c_mp);
+
+        mpz_init(c_mp);
+        mpz_mul(c_mp, a_mp, b_mp);
+        ret_i &= _mpn_same("mul", a, b, u3qa_mul(a, b), c_mp);
+
+        mpz_init(c_mp);
+        mpz_mul(c_mp, a_mp, a_mp);
+        ret_i &= _mpn_same("mul (sqr)", a, a, u3qa_mul(a, a), c_mp);
+
+        if ( 0 <= mpz_cmp(a_mp, b_mp) ) {
+          mpz_init(c_mp);
+          mpz_sub(c_mp, a_mp, b_mp);
+          ret_i &= _mpn_same("sub", a, b, u3qa_sub(a, b), c_mp);
+        }
+
+        if ( 0 != b ) {
+          mpz_init(c_mp);
+          mpz_tdiv_q(c_mp, a_mp, b_mp);
+          ret_i &= _mpn_same("div", a, b, u3qa_div(a, b), c_mp);
+        }
+
+        {
+          u3_noun pro = u3qc_sqt(a);
+
+          mpz_init(c_mp);
+          mpz_sqrtrem(c_mp, d_mp, a_mp);
+          ret_i &= _mpn_same("sqt", a, 0, u3k(u3h(pro)), c_mp);
+          ret_i &= _mpn_same("sqt (rem)", a, 0, u3k(u3t(pro)), d_mp);
+          u3z(pro);
+        }
+
+        mpz_init(c_mp);
+        mpz_pow_ui(c_mp, a_mp, j_w * 3 + k_w);
+        ret_i &= _mpn_same("pow", a, j_w * 3 + k_w,
+                           u3qc_pow(a, j_w * 3 + k_w), c_mp);
+
+        mpz_clear(a_mp);
+        mpz_clear(b_mp);
+        u3z(a); u3z(b);
+      }
+    }
+  }
+
+  return ret_i;
+}
+
+static c3_i
+_test_bitwise(void)
+{
+  c3_i ret_i = 1;
+  c3_w sed_w = 0xcafebabe;
+  c3_w i_w, j_w, k_w;
+
+  for ( i_w = 0; i_w < 10; i_w++ ) {
+    for ( j_w = 0; j_w < 10; j_w++ ) {
+      u3_atom a = _mpn_atom(i_w, &sed_w);
+      u3_atom b = _mpn_atom(j_w, &sed_w);
+      u3_atom dis = u3qc_dis(a, b);
+      u3_atom con = u3qc_con(a, b);
+      u3_atom mix = u3qc_mix(a, b);
+
+      for ( k_w = 0; k_w < 10; k_w++ ) {
+        c3_w a_w = u3r_word(k_w, a);
+        c3_w b_w = u3r_word(k_w, b);
+
+        if (  ((a_w & b_w) != u3r_word(k_w, dis))
+           || ((a_w | b_w) != u3r_word(k_w, con))
+           || ((a_w ^ b_w) != u3r_word(k_w, mix)) )
+        {
+          fprintf(stderr, "bitwise: %u/%u word %u wrong\r\n", i_w, j_w, k_w);
+          ret_i = 0;
+        }
+      }
+
+      u3z(dis); u3z(con); u3z(mix);
+
+      if ( 0 == j_w ) {
+        u3_noun rip = u3qc_rip(3, 1, a);
+        u3_noun lis = rip;
+
+        for ( k_w = 0; k_w < u3r_met(3, a); k_w++ ) {
+          if (  (u3_nul == lis)
+             || (u3r_byte(k_w, a) != u3h(lis)) )
+          {
+            fprintf(stderr, "bitwise: rip %u byte %u wrong\r\n", i_w, k_w);
+            ret_i = 0;
+            break;
+          }
+          lis = u3t(lis);
+        }
+
+        u3z(rip);
+      }
+
+      u3z(a); u3z(b);
+    }
+  }
+
+  return ret_i;
+}
+
+/* _sort_hoon(): +sort's quicksort over a native order, for reference.
+*/
+static u3_noun
+_sort_hoon(u3_noun lis, u3_noun (*ord_f)(u3_noun, u3_noun))
+{
+  if ( u3_nul == lis ) {
+    return u3_nul;
+  }
+  else {
+    u3_noun piv = u3h(lis);
+    u3_noun lef = u3_nul;
+    u3_noun rig = u3_nul;
+    u3_noun t   = u3t(lis);
+    u3_noun pro;
+
+    while ( u3_nul != t ) {
+      if ( c3y == ord_f(u3h(t), piv) ) {
+        lef = u3nc(u3k(u3h(t)), lef);
+      }
+      else {
+        rig = u3nc(u3k(u3h(t)), rig);
+      }
+      t = u3t(t);
+    }
+
+    lef = u3kb_flop(lef);
+    rig = u3kb_flop(rig);
+    pro = u3kb_weld(_sort_hoon(lef, ord_f),
+                    u3nc(u3k(piv), _sort_hoon(rig, ord_f)));
+
+    u3z(lef); u3z(rig);
+    return pro;
+  }
+}
+
+/* _sort_gate(): a gate in [cor], registered as the jetted order [nam].
+*/
+static u3_noun
+_sort_gate(u3_noun cor, c3_m nam_m, c3_w bat_w)
+{
+  u3_noun gat = u3nt(u3nc(1, bat_w), u3nc(0, 0), u3k(cor));
+
+  u3j_mine(u3nt(nam_m, u3nc(0, 7), u3_nul), u3k(gat));
+
+  return gat;
+}
+
+/* _test_sort_jet(): +sort with a jetted order matches the quicksort.
+*/
+static c3_i
+_test_sort_jet(u3_noun     gat,
+               u3_noun   (*fun_f)(u3_noun),
+               u3_noun   (*ord_f)(u3_noun, u3_noun),
+               u3_noun     lis,
+               const c3_c* cap_c)
+{
+  c3_i ret_i = 1;
+
+  //  these are the conditions under which +sort merges natively
+  //
+  {
+    u3j_site sit_u;
+
+    u3j_gate_prep(&sit_u, u3k(gat));
+
+    if (  (c3y != sit_u.jet_o)
+       || (c3y != sit_u.ham_u->liv)
+       || (fun_f != sit_u.ham_u->fun_f) )
+    {
+      fprintf(stderr, "sort: %s: not jetted\r\n", cap_c);
+      ret_i = 0;
+    }
+
+    u3j_gate_lose(&sit_u);
+  }
+
+  {
+    u3_noun pro = u3qb_sort(lis, gat);
+    u3_noun exp = _sort_hoon(lis, ord_f);
+
+    if ( c3n == u3r_sing(exp, pro) ) {
+      fprintf(stderr, "sort: %s: order wrong\r\n", cap_c);
+      ret_i = 0;
+    }
+
+    u3z(pro); u3z(exp);
+  }
+
+  return ret_i;
+}
+
+static c3_i
+_test_sort(void)
+{
+  c3_i ret_i = 1;
+
+  //  an unjetted gate that isn't an order: =(-.a -.b), with [a b] at +6
+  //
+  //    +sort must make exactly the quicksort's choices, placing
+  //    elements that "match" the pivot before it, in reverse
+  //
+  {
+    u3_noun gat = u3nt(u3nt(5, u3nc(0, 24), u3nc(0, 26)),
+                       u3nc(0, 0),
+                       0);
+    u3_noun lis = u3nc(u3nc(1, 'a'),
+                  u3nc(u3nc(2, 'b'),
+                  u3nc(u3nc(1, 'c'),
+                  u3nc(u3nc(3, 'd'),
+                  u3nc(u3nc(1, 'e'), u3_nul)))));
+    u3_noun exp = u3nc(u3nc(1, 'e'),
+                  u3nc(u3nc(1, 'c'),
+                  u3nc(u3nc(1, 'a'),
+                  u3nc(u3nc(2, 'b'),
+                  u3nc(u3nc(3, 'd'), u3_nul)))));
+    u3_noun pro = u3qb_sort(lis, gat);
+
+    if ( c3n == u3r_sing(exp, pro) ) {
+      fprintf(stderr, "sort: quicksort order wrong\r\n");
+      u3m_p("pro", pro);
+      ret_i = 0;
+    }
+
+    u3z(gat); u3z(lis); u3z(exp); u3z(pro);
+  }
+
+  //  already-sorted input partitions to one side at every step,
+  //  which must not recurse on the C stack
+  //
+  {
+    u3_noun gat = u3nt(u3nt(5, u3nc(0, 24), u3nc(0, 26)),
+                       u3nc(0, 0),
+                       0);
+    u3_noun lis = u3_nul;
+    u3_noun pro;
+    c3_w    i_w;
+
+    for ( i_w = 3000; i_w--; ) {
+      lis = u3nc(u3nc(i_w, i_w), lis);
+    }
+
+    pro = u3qb_sort(lis, gat);
+
+    if ( c3n == u3r_sing(lis, pro) ) {
+      fprintf(stderr, "sort: sorted input wrong\r\n");
+      ret_i = 0;
+    }
+
+    u3z(gat); u3z(lis); u3z(pro);
+  }
+
+  //  jetted orders, over lists with many duplicates
+  //
+  {
+    u3_noun cor = u3nc(u3nc(1, 0), c3__a50);
+    u3_noun ato = u3_nul;
+    u3_noun non = u3_nul;
+    c3_w    sed_w = 0xdeadbeef;
+    c3_w    i_w;
+
+    u3j_mine(u3nt(c3__a50, u3nc(1, 0), u3_nul), u3k(cor));
+
+    for ( i_w = 0; i_w < 500; i_w++ ) {
+      c3_w    ran_w = (sed_w = (sed_w * 1103515245) + 12345) >> 8;
+      u3_atom a     = ( ran_w & 0x100 )
+                      ? u3i_chub(((c3_d)(ran_w & 0x3) << 40) | 1)
+                      : (ran_w & 0xf);
+
+      ato = u3nc(u3k(a), ato);
+      non = ( ran_w & 0x200 )
+            ? u3nc(u3nc(a, (ran_w >> 12) & 0x3), non)
+            : u3nc(a, non);
+    }
+
+    {
+      u3_noun lth = _sort_gate(cor, c3_s3('l', 't', 'h'), 1);
+      u3_noun gth = _sort_gate(cor, c3_s3('g', 't', 'h'), 2);
+      u3_noun dor = _sort_gate(cor, c3_s3('d', 'o', 'r'), 3);
+      u3_noun gor = _sort_gate(cor, c3_s3('g', 'o', 'r'), 4);
+      u3_noun mor = _sort_gate(cor, c3__mor, 5);
+
+      ret_i &= _test_sort_jet(lth, u3wa_lth, u3qa_lth, ato, "lth");
+      ret_i &= _test_sort_jet(gth, u3wa_gth, u3qa_gth, ato, "gth");
+      ret_i &= _test_sort_jet(dor, u3wc_dor, u3qc_dor, non, "dor");
+      ret_i &= _test_sort_jet(gor, u3wc_gor, u3qc_gor, non, "gor");
+      ret_i &= _test_sort_jet(mor, u3wc_mor, u3qc_mor, non, "mor");
+
+      u3z(lth); u3z(gth); u3z(dor); u3z(gor); u3z(mor);
+    }
+
+    u3z(cor); u3z(ato); u3z(non);
+  }
+
+  return ret_i;
+}
+
 static c3_i
 _test_jets(void)
 {
@@ -512,6 +869,21 @@ _test_jets(void)
     ret_i = 0;
   }
 
+  if ( !_test_mpn() ) {
+    fprintf(stderr, "test jets: mpn: failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_bitwise() ) {
+    fprintf(stderr, "test jets: bitwise: failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_sort() ) {
+    fprintf(stderr, "test jets: sort: failed\r\n");
+    ret_i = 0;
+  }
+
   if ( !_test_ob() ) {
     fprintf(stderr, "test jets: ob: failed\r\n");
     ret_i = 0;
@@ -0,0 +1,495 @@
+#include "all.h"
+#include "vere/vere.h"
+#include <sys/socket.h>
+
+/* _setup(): prepare for tests.
+*/
+static void
+_setup(void)
+{
+  u3m_init(1 << 24);
+  u3m_pave(c3y);
+
+  u3_Host.lup_u = uv_default_loop();
+}
+
+/* _lord_job(): an event job.
+*/
+static u3_noun
+_lord_job(c3_w i_w)
+{
+  return u3nt(u3i_word(i_w), c3__test, u3i_string("hello"));
+}
+
+/* _lord_fact_raw(): a fact as read from the log, [mug jam].
+*/
+static u3_fact*
+_lord_fact_raw(c3_d eve_d, u3_noun job)
+{
+  u3_fact* tac_u;
+  c3_d     jam_d;
+  c3_y*    jam_y;
+  c3_y*    dat_y;
+
+  u3s_jam_xeno(job, &jam_d, &jam_y);
+  u3z(job);
+
+  dat_y = c3_malloc(4 + jam_d);
+  dat_y[0] = 0x11;
+  dat_y[1] = 0x22;
+  dat_y[2] = 0x33;
+  dat_y[3] = 0x44;
+  memcpy(dat_y + 4, jam_y, jam_d);
+
+  tac_u = u3_fact_load(eve_d, 0x44332211, 4 + jam_d, dat_y);
+
+  c3_free(jam_y);
+  c3_free(dat_y);
+
+  return tac_u;
+}
+
+/* _lord_info_free(): dispose a batch of facts.
+*/
+static void
+_lord_info_free(u3_info fon_u)
+{
+  u3_fact* tac_u = fon_u.ext_u;
+  u3_fact* nex_u;
+
+  while ( tac_u ) {
+    nex_u = tac_u->nex_u;
+    u3_fact_free(tac_u);
+    tac_u = nex_u;
+  }
+}
+
+/* _test_play_frame(): frame log entries and live events, and parse them.
+*/
+static c3_i
+_test_play_frame(void)
+{
+  c3_d         eve_d = 0x123456789aULL;
+  u3_fact*     tac_u[3];
+  u3_info      fon_u;
+  u3_cue_xeno* sil_u = u3s_cue_xeno_init();
+  c3_d         len_d;
+  c3_y*        byt_y;
+  c3_i         ret_i = 1;
+
+  //  the middle event was never written, and is jammed for the frame
+  //
+  tac_u[0] = _lord_fact_raw(eve_d, _lord_job(0));
+  tac_u[1] = u3_fact_init(eve_d + 1, 0xdeadbeef, _lord_job(1));
+  tac_u[2] = _lord_fact_raw(eve_d + 2, _lord_job(2));
+  tac_u[0]->nex_u = tac_u[1];
+  tac_u[1]->nex_u = tac_u[2];
+  fon_u.ext_u = tac_u[0];
+  fon_u.ent_u = tac_u[2];
+
+  u3_lord_play_frame(fon_u, &len_d, &byt_y);
+
+  if ( (0xff != byt_y[0]) || (0x9a != byt_y[1]) || (0x12 != byt_y[5]) ) {
+    fprintf(stderr, "play frame: bad header\r\n");
+    ret_i = 0;
+  }
+
+  if (  !tac_u[1]->hun_y
+     || (0xef != tac_u[1]->hun_y[0])
+     || (0xde != tac_u[1]->hun_y[3]) )
+  {
+    fprintf(stderr, "play frame: live event not serialized\r\n");
+    ret_i = 0;
+  }
+
+  {
+    c3_d tot_d = 9;
+    c3_w i_w;
+
+    for ( i_w = 0; i_w < 3; i_w++ ) {
+      tot_d += 4 + tac_u[i_w]->len_i;
+    }
+
+    if ( tot_d != len_d ) {
+      fprintf(stderr, "play frame: length %" PRIu64 ", expected %" PRIu64 "\r\n",
+                      len_d, tot_d);
+      ret_i = 0;
+    }
+  }
+
+  {
+    u3_weak jar = u3_lord_play_cue(sil_u, len_d, byt_y);
+    u3_noun pro = u3nt(c3__play,
+                       u3i_chubs(1, &eve_d),
+                       u3nt(_lord_job(0), _lord_job(1), u3nc(_lord_job(2), u3_nul)));
+
+    if ( (u3_none == jar) || (c3n == u3r_sing(pro, jar)) ) {
+      fprintf(stderr, "play frame: round-trip failed\r\n");
+      ret_i = 0;
+    }
+
+    u3z(pro);
+
+    if ( u3_none != jar ) {
+      u3z(jar);
+    }
+  }
+
+  //  just the header is an empty batch
+  //
+  {
+    u3_weak jar = u3_lord_play_cue(sil_u, 9, byt_y);
+    u3_noun pro = u3nt(c3__play, u3i_chubs(1, &eve_d), u3_nul);
+
+    if ( (u3_none == jar) || (c3n == u3r_sing(pro, jar)) ) {
+      fprintf(stderr, "play frame: empty batch failed\r\n");
+      ret_i = 0;
+    }
+
+    u3z(pro);
+
+    if ( u3_none != jar ) {
+      u3z(jar);
+    }
+  }
+
+  c3_free(byt_y);
+  _lord_info_free(fon_u);
+  u3s_cue_xeno_done(sil_u);
+
+  return ret_i;
+}
+
+/* _test_play_frame_bad(): malformed frames are rejected.
+*/
+static c3_i
+_test_play_frame_bad(void)
+{
+  u3_fact*     tac_u = _lord_fact_raw(1, _lord_job(0));
+  u3_info      fon_u = { .ent_u = tac_u, .ext_u = tac_u };
+  u3_cue_xeno* sil_u = u3s_cue_xeno_init();
+  c3_d         len_d;
+  c3_y*        byt_y;
+  c3_y*        bad_y;
+  c3_w         len_w;
+  c3_i         ret_i = 1;
+
+  u3_lord_play_frame(fon_u, &len_d, &byt_y);
+  bad_y = c3_malloc(len_d);
+  len_w = tac_u->len_i;
+
+  //  short header
+  //
+  if ( u3_none != u3_lord_play_cue(sil_u, 8, byt_y) ) {
+    fprintf(stderr, "play frame bad: short header accepted\r\n");
+    ret_i = 0;
+  }
+
+  //  not a frame
+  //
+  memcpy(bad_y, byt_y, len_d);
+  bad_y[0] = 0x1;
+
+  if ( u3_none != u3_lord_play_cue(sil_u, len_d, bad_y) ) {
+    fprintf(stderr, "play frame bad: bad tag accepted\r\n");
+    ret_i = 0;
+  }
+
+  //  truncated length field
+  //
+  if ( u3_none != u3_lord_play_cue(sil_u, 11, byt_y) ) {
+    fprintf(stderr, "play frame bad: truncated length accepted\r\n");
+    ret_i = 0;
+  }
+
+  //  truncated entry
+  //
+  if ( u3_none != u3_lord_play_cue(sil_u, len_d - 1, byt_y) ) {
+    fprintf(stderr, "play frame bad: truncated entry accepted\r\n");
+    ret_i = 0;
+  }
+
+  //  oversize length field
+  //
+  {
+    c3_w big_w = len_w + 1;
+
+    memcpy(bad_y, byt_y, len_d);
+    bad_y[9]  = big_w & 0xff;
+    bad_y[10] = (big_w >> 8) & 0xff;
+    bad_y[11] = (big_w >> 16) & 0xff;
+    bad_y[12] = (big_w >> 24) & 0xff;
+
+    if ( u3_none != u3_lord_play_cue(sil_u, len_d, bad_y) ) {
+      fprintf(stderr, "play frame bad: oversize length accepted\r\n");
+      ret_i = 0;
+    }
+
+    bad_y[9] = bad_y[10] = bad_y[11] = bad_y[12] = 0xff;
+
+    if ( u3_none != u3_lord_play_cue(sil_u, len_d, bad_y) ) {
+      fprintf(stderr, "play frame bad: huge length accepted\r\n");
+      ret_i = 0;
+    }
+  }
+
+  //  an entry with only a mug
+  //
+  memcpy(bad_y, byt_y, 13);
+  bad_y[9]  = 4;
+  bad_y[10] = bad_y[11] = bad_y[12] = 0;
+
+  if ( u3_none != u3_lord_play_cue(sil_u, 17, bad_y) ) {
+    fprintf(stderr, "play frame bad: empty entry accepted\r\n");
+    ret_i = 0;
+  }
+
+  //  trailing bytes after the last entry
+  //
+  {
+    c3_y* tal_y = c3_malloc(len_d + 2);
+
+    memcpy(tal_y, byt_y, len_d);
+    tal_y[len_d] = tal_y[len_d + 1] = 0;
+
+    if ( u3_none != u3_lord_play_cue(sil_u, len_d + 2, tal_y) ) {
+      fprintf(stderr, "play frame bad: trailing bytes accepted\r\n");
+      ret_i = 0;
+    }
+
+    c3_free(tal_y);
+  }
+
+  c3_free(bad_y);
+  c3_free(byt_y);
+  _lord_info_free(fon_u);
+  u3s_cue_xeno_done(sil_u);
+
+  return ret_i;
+}
+
+/* _lord_pipe(): connect [moj_u] to a socket, producing the other end.
+*/
+static c3_i
+_lord_pipe(u3_mojo* moj_u)
+{
+  c3_i fid_i[2];
+
+  if ( socketpair(AF_UNIX, SOCK_STREAM, 0, fid_i) ) {
+    fprintf(stderr, "lord: socketpair failed\r\n");
+    exit(1);
+  }
+
+  uv_pipe_init(u3L, &moj_u->pyp_u, 0);
+  uv_pipe_open(&moj_u->pyp_u, fid_i[0]);
+
+  return fid_i[1];
+}
+
+/* _lord_recv(): read newt messages sent to [fid_i], as a list of nouns.
+*/
+static u3_noun
+_lord_recv(c3_i fid_i)
+{
+  c3_y    buf_y[1 << 16];
+  ssize_t len_i;
+  c3_y*   cur_y = buf_y;
+  u3_noun lis   = u3_nul;
+
+  uv_run(u3L, UV_RUN_NOWAIT);
+
+  if ( 0 > (len_i = recv(fid_i, buf_y, sizeof(buf_y), MSG_DONTWAIT)) ) {
+    return u3_nul;
+  }
+
+  while ( len_i >= 5 ) {
+    c3_w len_w = cur_y[1]
+               ^ (cur_y[2] <<  8)
+               ^ (cur_y[3] << 16)
+               ^ (cur_y[4] << 24);
+
+    lis    = u3nc(u3s_cue_bytes(len_w, cur_y + 5), lis);
+    cur_y += 5 + len_w;
+    len_i -= 5 + len_w;
+  }
+
+  return u3kb_flop(lis);
+}
+
+/* _lord_queue_free(): dispose of writs queued for a serf or reader.
+*/
+static void
+_lord_queue_free(u3_writ* wit_u)
+{
+  while ( wit_u ) {
+    u3_writ* nex_u = wit_u->nex_u;
+
+    if ( u3_writ_peek == wit_u->typ_e ) {
+      u3z(wit_u->pek_u->sam);
+      c3_free(wit_u->pek_u);
+    }
+
+    c3_free(wit_u);
+    wit_u = nex_u;
+  }
+}
+
+/* _lord_gaze_peek(): a %once scry.
+*/
+static u3_pico*
+_lord_gaze_peek(void)
+{
+  u3_pico* pic_u = u3_pico_init();
+
+  pic_u->gan         = u3nc(u3_nul, u3_nul);
+  pic_u->typ_e       = u3_pico_once;
+  pic_u->las_u.car_m = c3__ax;
+  pic_u->las_u.des   = c3__base;
+  pic_u->las_u.pax   = u3nc(u3i_string("sys"), u3_nul);
+
+  return pic_u;
+}
+
+/* _test_gaze_behind(): a scry reader behind the requested event
+**                      is refreshed, and the scry goes to the serf.
+*/
+static c3_i
+_test_gaze_behind(void)
+{
+  u3_lord* god_u = c3_calloc(sizeof(*god_u));
+  u3_seer* see_u = c3_calloc(sizeof(*see_u));
+  u3_pico* pic_u = _lord_gaze_peek();
+  c3_i     sef_i, red_i;
+  u3_noun  lis;
+  c3_i     ret_i = 1;
+
+  god_u->liv_o = c3y;
+  god_u->eve_d = 10;
+  god_u->see_w = 1;
+  god_u->see_u[0] = see_u;
+  sef_i = _lord_pipe(&god_u->inn_u);
+
+  see_u->god_u = god_u;
+  see_u->red_w = 0;
+  see_u->liv_o = c3y;
+  see_u->fok_o = c3n;
+  see_u->eve_d = 5;
+  red_i = _lord_pipe(&see_u->inn_u);
+
+  //  the reader is refreshed, and the scry declined
+  //
+  if (  (c3n != u3_lord_gaze(god_u, 10, pic_u))
+     || (c3y != see_u->fok_o)
+     || see_u->dep_w )
+  {
+    fprintf(stderr, "gaze behind: read from a stale reader\r\n");
+    ret_i = 0;
+  }
+
+  //  so the caller asks the serf instead
+  //
+  u3_lord_peek(god_u, pic_u);
+
+  lis = _lord_recv(sef_i);
+
+  if (  (2 != u3kb_lent(u3k(lis)))
+     || (c3__live != u3h(u3h(lis)))
+     || (c3__fork != u3h(u3t(u3h(lis))))
+     || (c3__peek != u3h(u3h(u3t(lis)))) )
+  {
+    u3m_p("gaze behind: serf got", lis);
+    ret_i = 0;
+  }
+
+  u3z(lis);
+
+  //  a reader being refreshed is not refreshed again, or read from
+  //
+  if (  (c3n != u3_lord_gaze(god_u, 10, pic_u))
+     || (2 != god_u->dep_w)
+     || (u3_nul != (lis = _lord_recv(red_i))) )
+  {
+    fprintf(stderr, "gaze behind: reader used while forking\r\n");
+    ret_i = 0;
+  }
+
+  //  once forked at or after the event, the reader answers
+  //
+  see_u->liv_o = c3y;
+  see_u->fok_o = c3n;
+  see_u->eve_d = 10;
+
+  if (  (c3y != u3_lord_gaze(god_u, 10, pic_u))
+     || (1 != see_u->dep_w)
+     || (2 != god_u->dep_w) )
+  {
+    fprintf(stderr, "gaze behind: current reader not used\r\n");
+    ret_i = 0;
+  }
+
+  lis = _lord_recv(red_i);
+
+  if ( (1 != u3kb_lent(u3k(lis))) || (c3__peek != u3h(u3h(lis))) ) {
+    u3m_p("gaze behind: reader got", lis);
+    ret_i = 0;
+  }
+
+  u3z(lis);
+
+  _lord_queue_free(god_u->ext_u);
+  _lord_queue_free(see_u->ext_u);
+  uv_close((uv_handle_t*)&god_u->inn_u.pyp_u, 0);
+  uv_close((uv_handle_t*)&see_u->inn_u.pyp_u, 0);
+  uv_run(u3L, UV_RUN_NOWAIT);
+  close(sef_i);
+  close(red_i);
+
+  u3_pico_free(pic_u);
+  c3_free(see_u);
+  c3_free(god_u);
+
+  return ret_i;
+}
+
+static c3_i
+_test_lord(void)
+{
+  c3_i ret_i = 1;
+
+  if ( !_test_play_frame() ) {
+    fprintf(stderr, "test lord: play frame failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_play_frame_bad() ) {
+    fprintf(stderr, "test lord: play frame bad failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_gaze_behind() ) {
+    fprintf(stderr, "test lord: gaze behind failed\r\n");
+    ret_i = 0;
+  }
+
+  return ret_i;
+}
+
+/* main(): run all test cases.
+*/
+int
+main(int argc, char* argv[])
+{
+  _setup();
+
+  if ( !_test_lord() ) {
+    fprintf(stderr, "test lord: failed\r\n");
+    exit(1);
+  }
+
+  //  GC
+  //
+  u3m_grab(u3_none);
+
+  fprintf(stderr, "test lord: ok\r\n");
+  return 0;
+}
@@ -8,6 +8,8 @@ _setup(void)
 {
   u3m_init(1 << 20);
   u3m_pave(c3y);
+
+  u3_Host.lup_u = uv_default_loop();
 }
 
 /* _newt_encode(): synchronous serialization into a single buffer, for test purposes
@@ -333,6 +335,279 @@ _test_newt_vast(void)
   u3z(a);
 }
 
+/* _ring_note: messages delivered from a ring.
+*/
+typedef struct _ring_note {
+  c3_w  len_w;                          //  messages delivered
+  c3_d  siz_d[16];                      //  lengths
+  c3_y* byt_y[16];                      //  contents, copied
+  c3_y* poi_y[16];                      //  delivered at
+} _ring_note;
+
+/* _ring_poke(): record a delivered message.
+*/
+static void
+_ring_poke(void* ptr_v, c3_d len_d, c3_y* byt_y)
+{
+  _ring_note* not_u = ptr_v;
+
+  if ( 16 <= not_u->len_w ) {
+    fprintf(stderr, "newt ring fail: too many messages\n");
+    exit(1);
+  }
+
+  not_u->siz_d[not_u->len_w] = len_d;
+  not_u->poi_y[not_u->len_w] = byt_y;
+  not_u->byt_y[not_u->len_w] = c3_malloc(len_d);
+  memcpy(not_u->byt_y[not_u->len_w], byt_y, len_d);
+  not_u->len_w++;
+}
+
+/* _ring_bail(): fail on ring errors.
+*/
+static void
+_ring_bail(void* ptr_v, ssize_t err_i, const c3_c* err_c)
+{
+  fprintf(stderr, "newt ring fail: %s\n", err_c);
+  exit(1);
+}
+
+/* _ring_pair(): a king's ring, and the serf's end of it, delivering
+**               serf-bound messages to [not_u].
+*/
+static c3_o
+_ring_pair(u3_ring** kin_u, u3_ring** sef_u, u3_moat* mot_u, _ring_note* not_u)
+{
+  memset(not_u, 0, sizeof(*not_u));
+  memset(mot_u, 0, sizeof(*mot_u));
+
+  if ( !(*kin_u = u3_newt_ring_make()) ) {
+    return c3n;
+  }
+
+  if ( !(*sef_u = u3_newt_ring_join(dup((*kin_u)->mem_i),
+                                    dup((*kin_u)->pir_i),
+                                    dup((*kin_u)->wak_i))) )
+  {
+    fprintf(stderr, "newt ring fail: join\n");
+    exit(1);
+  }
+
+  mot_u->ptr_v = not_u;
+  mot_u->pok_f = _ring_poke;
+  mot_u->bal_f = _ring_bail;
+  u3_newt_ring_read(*sef_u, mot_u);
+
+  return c3y;
+}
+
+/* _ring_stop(): dispose of a ring pair, and the messages delivered.
+*/
+static void
+_ring_stop(u3_ring* kin_u, u3_ring* sef_u, _ring_note* not_u)
+{
+  c3_w i_w;
+
+  u3_newt_ring_stop(kin_u);
+  u3_newt_ring_stop(sef_u);
+  uv_run(u3L, UV_RUN_NOWAIT);
+
+  for ( i_w = 0; i_w < not_u->len_w; i_w++ ) {
+    c3_free(not_u->byt_y[i_w]);
+  }
+}
+
+/* _ring_send(): send a message of [len_d] bytes, patterned by [sed_y].
+*/
+static void
+_ring_send(u3_ring* rin_u, c3_d len_d, c3_y sed_y)
+{
+  c3_y* byt_y = c3_malloc(len_d);
+  c3_d  i_d;
+
+  for ( i_d = 0; i_d < len_d; i_d++ ) {
+    byt_y[i_d] = (c3_y)((i_d * 31) + (i_d >> 12) + sed_y);
+  }
+
+  u3_newt_ring_send(rin_u, len_d, byt_y);
+}
+
+/* _ring_wait(): run the loop until [len_w] messages are delivered.
+*/
+static void
+_ring_wait(_ring_note* not_u, c3_w len_w)
+{
+  while ( not_u->len_w < len_w ) {
+    uv_run(u3L, UV_RUN_ONCE);
+  }
+}
+
+/* _ring_check(): message [i_w] is [len_d] bytes, patterned by [sed_y].
+*/
+static void
+_ring_check(_ring_note* not_u, c3_w i_w, c3_d len_d, c3_y sed_y, c3_c* cas_c)
+{
+  c3_d i_d;
+
+  if ( len_d != not_u->siz_d[i_w] ) {
+    fprintf(stderr, "newt ring fail (%s): message %u: length %" PRIu64 "\n",
+                    cas_c, i_w, not_u->siz_d[i_w]);
+    exit(1);
+  }
+
+  for ( i_d = 0; i_d < len_d; i_d++ ) {
+    if ( (c3_y)((i_d * 31) + (i_d >> 12) + sed_y) != not_u->byt_y[i_w][i_d] ) {
+      fprintf(stderr, "newt ring fail (%s): message %u: byte %" PRIu64 "\n",
+                      cas_c, i_w, i_d);
+      exit(1);
+    }
+  }
+}
+
+/* _test_newt_ring_whole(): small messages, written whole.
+*/
+static void
+_test_newt_ring_whole(void)
+{
+  u3_ring*   kin_u;
+  u3_ring*   sef_u;
+  u3_moat    mot_u;
+  _ring_note not_u;
+
+  if ( c3n == _ring_pair(&kin_u, &sef_u, &mot_u, &not_u) ) {
+    fprintf(stderr, "newt ring: no shared memory, skipping\n");
+    return;
+  }
+
+  _ring_send(kin_u, 1, 1);
+  _ring_send(kin_u, 100, 2);
+  _ring_send(kin_u, 4096, 3);
+
+  if ( kin_u->ext_u ) {
+    fprintf(stderr, "newt ring fail (a): blocked\n");
+    exit(1);
+  }
+
+  _ring_wait(&not_u, 3);
+
+  _ring_check(&not_u, 0, 1, 1, "b");
+  _ring_check(&not_u, 1, 100, 2, "c");
+  _ring_check(&not_u, 2, 4096, 3, "d");
+
+  //  delivered in place, one 8-byte aligned record after another
+  //
+  if (  ((not_u.poi_y[0] + 16) != not_u.poi_y[1])
+     || ((not_u.poi_y[1] + 112) != not_u.poi_y[2]) )
+  {
+    fprintf(stderr, "newt ring fail (e): not in place\n");
+    exit(1);
+  }
+
+  _ring_stop(kin_u, sef_u, &not_u);
+}
+
+/* _test_newt_ring_frag(): large messages, in fragments, and larger
+**                         than the ring itself.
+*/
+static void
+_test_newt_ring_frag(void)
+{
+  u3_ring*   kin_u;
+  u3_ring*   sef_u;
+  u3_moat    mot_u;
+  _ring_note not_u;
+
+  if ( c3n == _ring_pair(&kin_u, &sef_u, &mot_u, &not_u) ) {
+    return;
+  }
+
+  //  the ring is 4MB, and whole messages at most 1MB
+  //
+  _ring_send(kin_u, (3 << 20) + 5, 1);
+  _ring_send(kin_u, (6 << 20) + 3, 2);
+  _ring_send(kin_u, 10, 3);
+
+  if ( !kin_u->ext_u || (kin_u->ext_u == kin_u->ent_u) ) {
+    fprintf(stderr, "newt ring fail (a): not blocked\n");
+    exit(1);
+  }
+
+  _ring_wait(&not_u, 3);
+
+  _ring_check(&not_u, 0, (3 << 20) + 5, 1, "b");
+  _ring_check(&not_u, 1, (6 << 20) + 3, 2, "c");
+  _ring_check(&not_u, 2, 10, 3, "d");
+
+  if ( kin_u->ext_u || kin_u->ent_u || sef_u->fag_y ) {
+    fprintf(stderr, "newt ring fail (e): not drained\n");
+    exit(1);
+  }
+
+  _ring_stop(kin_u, sef_u, &not_u);
+}
+
+/* _test_newt_ring_wrap(): whole messages padded past the end of the
+**                         ring, blocked writes drained in order.
+*/
+static void
+_test_newt_ring_wrap(void)
+{
+  u3_ring*   kin_u;
+  u3_ring*   sef_u;
+  u3_moat    mot_u;
+  _ring_note not_u;
+  c3_w       i_w;
+
+  if ( c3n == _ring_pair(&kin_u, &sef_u, &mot_u, &not_u) ) {
+    return;
+  }
+
+  //  the ring is 4MB; free the first 2MB of it
+  //
+  _ring_send(kin_u, 1000000, 0);
+  _ring_send(kin_u, 1000000, 1);
+  _ring_wait(&not_u, 2);
+
+  //  the third message pads to the end of the ring, and wraps
+  //
+  _ring_send(kin_u, 1000000, 2);
+  _ring_send(kin_u, 1000000, 3);
+  _ring_send(kin_u, 1000000, 4);
+
+  if ( kin_u->ext_u ) {
+    fprintf(stderr, "newt ring fail (a): blocked\n");
+    exit(1);
+  }
+
+  //  a message just larger than the free space waits,
+  //  and a small one that would fit waits behind it
+  //
+  _ring_send(kin_u, 1000001, 5);
+
+  if ( !kin_u->ext_u ) {
+    fprintf(stderr, "newt ring fail (b): not blocked\n");
+    exit(1);
+  }
+
+  _ring_send(kin_u, 10, 6);
+
+  _ring_wait(&not_u, 7);
+
+  for ( i_w = 0; i_w < 5; i_w++ ) {
+    _ring_check(&not_u, i_w, 1000000, i_w, "c");
+  }
+
+  _ring_check(&not_u, 5, 1000001, 5, "d");
+  _ring_check(&not_u, 6, 10, 6, "e");
+
+  if ( (not_u.poi_y[0] != not_u.poi_y[4]) || kin_u->ext_u ) {
+    fprintf(stderr, "newt ring fail (f): no wraparound\n");
+    exit(1);
+  }
+
+  _ring_stop(kin_u, sef_u, &not_u);
+}
+
 /* main(): run all test cases.
 */
 int
@@ -342,6 +617,9 @@ main(int argc, char* argv[])
 
   _test_newt_smol();
   _test_newt_vast();
+  _test_newt_ring_whole();
+  _test_newt_ring_frag();
+  _test_newt_ring_wrap();
 
   //  GC
   //
@@ -11,6 +11,7 @@ _setup(void)
   u3m_init(1 << 25);
   u3m_pave(c3y);
   u3e_init();
+  u3j_boot(c3y);
 }
 
 static u3_noun
@@ -52,6 +53,544 @@ _test_nock_meme(void)
   return ret_i;
 }
 
+static c3_i
+_test_fuse_spec(const c3_c* cap_c, u3_noun fol, u3_noun pro)
+{
+  //  subject: [[1 2] 3 4]
+  //
+  u3_noun bus = u3nt(u3nc(1, 2), 3, 4);
+  u3_noun gon = u3n_nock_on(bus, fol);
+  c3_i  ret_i = 1;
+
+  if ( c3n == u3r_sing(pro, gon) ) {
+    fprintf(stderr, "\033[31mnock fuse %s fail\033[0m\r\n", cap_c);
+    u3m_p("  actual", gon);
+    u3m_p("  expect", pro);
+    ret_i = 0;
+  }
+
+  u3z(gon);
+  u3z(pro);
+
+  return ret_i;
+}
+
+static c3_i
+_test_nock_fuse(void)
+{
+  c3_i ret_i = 1;
+
+  //  [[0 2] 0 3]: hesw, taal
+  //
+  ret_i &= _test_fuse_spec("head-tail",
+    u3nc(u3nc(0, 2), u3nc(0, 3)),
+    u3nt(u3nc(1, 2), 3, 4));
+
+  //  [[0 3] 0 2]: tasw, heal
+  //
+  ret_i &= _test_fuse_spec("tail-head",
+    u3nc(u3nc(0, 3), u3nc(0, 2)),
+    u3nc(u3nc(3, 4), u3nc(1, 2)));
+
+  //  [[0 4] 0 7]: fbsw, fbal
+  //
+  ret_i &= _test_fuse_spec("frag-frag",
+    u3nc(u3nc(0, 4), u3nc(0, 7)),
+    u3nc(1, 4));
+
+  //  [[[0 4] 0 5] 0 6]: fbsw, fbau, swap, fbal
+  //
+  ret_i &= _test_fuse_spec("frag-auto",
+    u3nc(u3nc(u3nc(0, 4), u3nc(0, 5)), u3nc(0, 6)),
+    u3nc(u3nc(1, 2), 3));
+
+  //  [[[0 2] 0 3] 0 3]: hesw, taau, swap, taal
+  //
+  ret_i &= _test_fuse_spec("head-tail-auto",
+    u3nc(u3nc(u3nc(0, 2), u3nc(0, 3)), u3nc(0, 3)),
+    u3nc(u3nt(u3nc(1, 2), 3, 4), u3nc(3, 4)));
+
+  //  [[[0 3] 0 2] 0 2]: tasw, heau, swap, heal
+  //
+  ret_i &= _test_fuse_spec("tail-head-auto",
+    u3nc(u3nc(u3nc(0, 3), u3nc(0, 2)), u3nc(0, 2)),
+    u3nt(u3nc(u3nc(3, 4), u3nc(1, 2)), 1, 2));
+
+  //  [8 [0 4] 0 2]: fbsl, held
+  //
+  ret_i &= _test_fuse_spec("frag-snol",
+    u3nt(8, u3nc(0, 4), u3nc(0, 2)),
+    1);
+
+  //  [[8 [0 5] 0 1] 0 4]: fbsn, swap, fbal
+  //
+  ret_i &= _test_fuse_spec("frag-snoc",
+    u3nc(u3nt(8, u3nc(0, 5), u3nc(0, 1)), u3nc(0, 4)),
+    u3nc(u3nt(2, u3nc(1, 2), u3nc(3, 4)), 1));
+
+  //  [[6 [1 &] [0 2] 0 3] 0 2]: the swap is a skip target, no fusion
+  //
+  ret_i &= _test_fuse_spec("skip-target-yes",
+    u3nc(u3nq(6, u3nc(1, 0), u3nc(0, 2), u3nc(0, 3)), u3nc(0, 2)),
+    u3nc(u3nc(1, 2), u3nc(1, 2)));
+
+  ret_i &= _test_fuse_spec("skip-target-no",
+    u3nc(u3nq(6, u3nc(1, 1), u3nc(0, 2), u3nc(0, 3)), u3nc(0, 2)),
+    u3nc(u3nc(3, 4), u3nc(1, 2)));
+
+  //  [6 [1 &] [[0 2] 0 3] [0 3] 0 2]: skip lengths recounted
+  //
+  ret_i &= _test_fuse_spec("skip-length-yes",
+    u3nq(6, u3nc(1, 0),
+            u3nc(u3nc(0, 2), u3nc(0, 3)),
+            u3nc(u3nc(0, 3), u3nc(0, 2))),
+    u3nt(u3nc(1, 2), 3, 4));
+
+  ret_i &= _test_fuse_spec("skip-length-no",
+    u3nq(6, u3nc(1, 1),
+            u3nc(u3nc(0, 2), u3nc(0, 3)),
+            u3nc(u3nc(0, 3), u3nc(0, 2))),
+    u3nc(u3nc(3, 4), u3nc(1, 2)));
+
+  //  [11 [%memo 1 0] [0 2] 0 3]: memo skip recounted
+  //
+  ret_i &= _test_fuse_spec("memo",
+    u3nt(11, u3nt(c3__memo, 1, 0), u3nc(u3nc(0, 2), u3nc(0, 3))),
+    u3nt(u3nc(1, 2), 3, 4));
+
+  return ret_i;
+}
+
+/* _site_kick_all(): kick [fol] on each core in [cor], producing results.
+*/
+static u3_noun
+_site_kick_all(u3_noun arg)
+{
+  u3_noun fol = u3h(arg);
+  u3_noun cor = u3t(arg);
+  u3_noun pro = u3_nul;
+
+  while ( u3_nul != cor ) {
+    pro = u3nc(u3n_nock_on(u3k(u3h(cor)), u3k(fol)), pro);
+    cor = u3t(cor);
+  }
+
+  u3z(arg);
+  return u3kb_flop(pro);
+}
+
+static c3_i
+_test_nock_site(void)
+{
+  //  [9 2 0 1] on root cores [[1 i] 0], registered as %sit{a,b,...}
+  //
+  const c3_w  len_w = u3j_pics_len + 2;
+  u3_noun     fol   = u3nt(9, 2, u3nc(0, 1));
+  u3_noun     cor[u3j_pics_len + 2];
+  u3_noun     all   = u3_nul;
+  u3n_prog*   pog_u;
+  u3j_site*   sit_u;
+  c3_w        i_w, j_w;
+  c3_i        ret_i = 1;
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    cor[i_w] = u3nc(u3nc(1, i_w), 0);
+    u3j_mine(u3nt(c3_s4('s', 'i', 't', 'a' + i_w), u3nc(1, 0), u3_nul),
+             u3k(cor[i_w]));
+  }
+
+  for ( j_w = 0; j_w < 64; j_w++ ) {
+    i_w = (j_w * 5) % len_w;
+    if ( i_w != u3n_nock_on(u3k(cor[i_w]), u3k(fol)) ) {
+      fprintf(stderr, "nock site: kick %u fail\r\n", j_w);
+      ret_i = 0;
+    }
+  }
+
+  pog_u = u3to(u3n_prog, u3n_find(u3_nul, fol));
+  sit_u = &(pog_u->cal_u.sit_u[0]);
+
+  if (  (0 == sit_u->pic_p)
+     || (u3j_pics_len != u3to(u3j_pics, sit_u->pic_p)->len_w) )
+  {
+    fprintf(stderr, "nock site: polymorphic cache not filled\r\n");
+    ret_i = 0;
+  }
+
+  //  kick on a junior road, sharing and then replacing targets
+  //
+  for ( i_w = len_w; i_w > 0; i_w-- ) {
+    all = u3nc(u3k(cor[i_w - 1]), all);
+  }
+
+  for ( j_w = 0; j_w < 3; j_w++ ) {
+    u3_noun gon = u3m_soft(0, _site_kick_all, u3nc(u3k(fol), u3k(all)));
+    u3_noun pro = u3_nul;
+
+    for ( i_w = len_w; i_w > 0; i_w-- ) {
+      pro = u3nc(i_w - 1, pro);
+    }
+
+    if ( (0 != u3h(gon)) || (c3n == u3r_sing(pro, u3t(gon))) ) {
+      fprintf(stderr, "nock site: junior %u fail\r\n", j_w);
+      ret_i = 0;
+    }
+
+    u3z(pro);
+    u3z(gon);
+  }
+
+  u3z(all);
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    u3z(cor[i_w]);
+  }
+  u3z(fol);
+
+  return ret_i;
+}
+
+static c3_i
+_test_nock_bare(void)
+{
+  //  [7 [0 1] 9 2 0 1] on a root core, unregistered and then registered
+  //
+  u3_noun     fol = u3nq(7, u3nc(0, 1), 9, u3nt(2, 0, 1));
+  u3_noun     cor = u3nc(u3nc(1, 42), 0);
+  u3n_prog*   pog_u;
+  u3j_site*   sit_u;
+  c3_w        j_w;
+  c3_i        ret_i = 1;
+
+  for ( j_w = 0; j_w < 2; j_w++ ) {
+    if ( 42 != u3n_nock_on(u3k(cor), u3k(fol)) ) {
+      fprintf(stderr, "nock bare: kick %u fail\r\n", j_w);
+      ret_i = 0;
+    }
+  }
+
+  pog_u = u3to(u3n_prog, u3n_find(u3_nul, fol));
+  sit_u = &(pog_u->cal_u.sit_u[0]);
+
+  if ( (0 == sit_u->gen_w) || (u3_none != sit_u->loc) ) {
+    fprintf(stderr, "nock bare: unregistered site not bound\r\n");
+    ret_i = 0;
+  }
+
+  //  a wrapped generation must not leave the binding in place
+  //
+  {
+    u3_noun cur = u3nc(u3nc(1, 43), 0);
+    c3_w  old_w = sit_u->gen_w;
+
+    u3D.gen_w = 0xffffffff;
+    u3j_mine(u3nt(c3_s4('w', 'r', 'a', 'p'), u3nc(1, 0), u3_nul), cur);
+
+    if ( (0 != sit_u->gen_w) || (1 != u3D.gen_w) ) {
+      fprintf(stderr, "nock bare: binding survived wraparound\r\n");
+      ret_i = 0;
+    }
+
+    if ( 42 != u3n_nock_on(u3k(cor), u3k(fol)) ) {
+      fprintf(stderr, "nock bare: kick after wraparound fail\r\n");
+      ret_i = 0;
+    }
+
+    if ( (1 != sit_u->gen_w) || (old_w == sit_u->gen_w) ) {
+      fprintf(stderr, "nock bare: site not rebound after wraparound\r\n");
+      ret_i = 0;
+    }
+  }
+
+  u3j_mine(u3nt(c3_s4('b', 'a', 'r', 'e'), u3nc(1, 0), u3_nul), u3k(cor));
+
+  if ( 42 != u3n_nock_on(u3k(cor), u3k(fol)) ) {
+    fprintf(stderr, "nock bare: registered kick fail\r\n");
+    ret_i = 0;
+  }
+
+  if ( (0 != sit_u->gen_w) || (u3_none == sit_u->loc) ) {
+    fprintf(stderr, "nock bare: registered site not located\r\n");
+    ret_i = 0;
+  }
+
+  u3z(cor);
+  u3z(fol);
+
+  return ret_i;
+}
+
+/* _bare_wrap(): bind an unregistered site, then wrap the generation.
+*/
+static u3_noun
+_bare_wrap(u3_noun arg)
+{
+  u3_noun   fol = u3h(arg);
+  u3_noun   cor = u3t(arg);
+  u3_noun   cur = u3nc(u3nc(1, 45), 0);
+  u3n_prog* pog_u;
+  u3j_site* sit_u;
+  c3_w      gen_w;
+
+  if ( 44 != u3n_nock_on(u3k(cor), u3k(fol)) ) {
+    u3m_bail(c3__fail);
+  }
+
+  pog_u = u3to(u3n_prog, u3n_find(u3_nul, fol));
+  sit_u = &(pog_u->cal_u.sit_u[0]);
+  gen_w = sit_u->gen_w;
+
+  u3D.gen_w = 0xffffffff;
+  u3j_mine(u3nt(c3_s4('w', 'r', 'a', 'q'), u3nc(1, 0), u3_nul), cur);
+
+  u3z(arg);
+  return u3nc(gen_w, sit_u->gen_w);
+}
+
+/* _test_nock_bare_road(): a wrap on a junior road clears senior sites.
+*/
+static c3_i
+_test_nock_bare_road(void)
+{
+  u3_noun     fol = u3nq(7, u3nc(0, 1), 9, u3nt(2, 0, 1));
+  u3_noun     cor = u3nc(u3nc(1, 44), 0);
+  u3n_prog*   pog_u;
+  u3j_site*   sit_u;
+  u3_noun     gon;
+  c3_i        ret_i = 1;
+
+  if ( 44 != u3n_nock_on(u3k(cor), u3k(fol)) ) {
+    fprintf(stderr, "nock bare road: kick fail\r\n");
+    ret_i = 0;
+  }
+
+  pog_u = u3to(u3n_prog, u3n_find(u3_nul, fol));
+  sit_u = &(pog_u->cal_u.sit_u[0]);
+
+  if ( 0 == sit_u->gen_w ) {
+    fprintf(stderr, "nock bare road: senior site not bound\r\n");
+    ret_i = 0;
+  }
+
+  gon = u3m_soft(0, _bare_wrap, u3nc(u3k(fol), u3k(cor)));
+
+  if ( 0 != u3h(gon) ) {
+    u3m_p("nock bare road", gon);
+    ret_i = 0;
+  }
+  else if ( (0 == u3h(u3t(gon))) || (0 != u3t(u3t(gon))) ) {
+    fprintf(stderr, "nock bare road: junior site not reset\r\n");
+    ret_i = 0;
+  }
+
+  if ( 0 != sit_u->gen_w ) {
+    fprintf(stderr, "nock bare road: senior site not reset\r\n");
+    ret_i = 0;
+  }
+
+  if ( 44 != u3n_nock_on(u3k(cor), u3k(fol)) ) {
+    fprintf(stderr, "nock bare road: kick after wraparound fail\r\n");
+    ret_i = 0;
+  }
+
+  if ( u3D.gen_w != sit_u->gen_w ) {
+    fprintf(stderr, "nock bare road: senior site not rebound\r\n");
+    ret_i = 0;
+  }
+
+  u3z(gon);
+  u3z(cor);
+  u3z(fol);
+
+  return ret_i;
+}
+
+static c3_i
+_test_nock_pack(void)
+{
+  //  [7 [0 1] 9 2 0 1] and [9 2 0 1] on a registered root core
+  //
+  u3_noun fol = u3nq(7, u3nc(0, 1), 9, u3nt(2, 0, 1));
+  u3_noun cor = u3nc(u3nc(1, 42), 0);
+  c3_w    wyt_w;
+  c3_i    ret_i = 1;
+
+  u3j_mine(u3nt(c3_s4('p', 'a', 'c', 'k'), u3nc(1, 0), u3_nul), u3k(cor));
+
+  if ( 42 != u3n_nock_on(u3k(cor), u3k(fol)) ) {
+    fprintf(stderr, "nock pack: kick fail\r\n");
+    ret_i = 0;
+  }
+
+  //  nouns on the C stack do not survive compaction
+  //
+  u3z(cor);
+  u3z(fol);
+
+  wyt_w = u3h_wyt(u3R->byc.har_p);
+  u3m_pack();
+
+  if ( wyt_w != u3h_wyt(u3R->byc.har_p) ) {
+    fprintf(stderr, "nock pack: bytecode cache lost\r\n");
+    ret_i = 0;
+  }
+
+  fol = u3nq(7, u3nc(0, 1), 9, u3nt(2, 0, 1));
+  cor = u3nc(u3nc(1, 42), 0);
+
+  if ( 42 != u3n_nock_on(u3k(cor), u3k(fol)) ) {
+    fprintf(stderr, "nock pack: kick after pack fail\r\n");
+    ret_i = 0;
+  }
+
+  if ( wyt_w != u3h_wyt(u3R->byc.har_p) ) {
+    fprintf(stderr, "nock pack: recompiled after pack\r\n");
+    ret_i = 0;
+  }
+
+  {
+    u3n_prog* pog_u = u3to(u3n_prog, u3n_find(u3_nul, fol));
+    u3j_site* sit_u = &(pog_u->cal_u.sit_u[0]);
+
+    if ( u3_none == sit_u->loc ) {
+      fprintf(stderr, "nock pack: site not located after pack\r\n");
+      ret_i = 0;
+    }
+  }
+
+  u3z(cor);
+  u3z(fol);
+
+  return ret_i;
+}
+
+/* _sand_edit(): edit a shared cell.
+*/
+static u3_noun
+_sand_edit(u3_noun arg)
+{
+  u3_noun c = u3nc(0x12345, 2);
+  u3_noun d = u3k(c);
+  u3_noun e = u3i_edit(c, 2, 5);
+
+  return u3nc(d, e);
+}
+
+/* _test_nock_sand(): edits (nock 10) on a sand road, where reference
+**                    counts are not maintained, copy rather than mutate.
+*/
+static c3_i
+_test_nock_sand(void)
+{
+  u3_noun gon = u3m_soft_sand(0, _sand_edit, u3_nul);
+  u3_noun pro = u3nc(u3nc(0x12345, 2), u3nc(5, 2));
+  c3_i  ret_i = 1;
+
+  if ( (0 != u3h(gon)) || (c3n == u3r_sing(pro, u3t(gon))) ) {
+    fprintf(stderr, "nock sand: shared cell mutated\r\n");
+    ret_i = 0;
+  }
+
+  u3z(pro);
+  u3z(gon);
+
+  return ret_i;
+}
+
+/* _prog_find(): compile [fol] on a junior road.
+*/
+static u3_noun
+_prog_find(u3_noun fol)
+{
+  u3n_find(u3_nul, fol);
+  u3z(fol);
+  return u3_nul;
+}
+
+/* _test_nock_prog_mug(): programs are keyed once, by bytecode and literals.
+*/
+static c3_i
+_test_nock_prog_mug(void)
+{
+  //  [1 [1 2]] and [1 [1 3]] differ only in a literal
+  //
+  u3_noun   fol = u3nt(1, 1, 2);
+  u3_noun   lof = u3nt(1, 1, 3);
+  u3n_prog* pog_u = u3to(u3n_prog, u3n_find(u3_nul, fol));
+  u3n_prog* gop_u = u3to(u3n_prog, u3n_find(u3_nul, lof));
+  c3_w      mug_w = pog_u->lit_u.mug_w;
+  c3_i      ret_i = 1;
+
+  if (  (0 == mug_w)
+     || (1 != pog_u->lit_u.len_w)
+     || (mug_w == gop_u->lit_u.mug_w) )
+  {
+    fprintf(stderr, "nock prog mug: not keyed by literals\r\n");
+    ret_i = 0;
+  }
+
+  //  the same formula, compiled under another prefix
+  //
+  gop_u = u3to(u3n_prog, u3n_find(c3__memo, fol));
+
+  if ( mug_w != gop_u->lit_u.mug_w ) {
+    fprintf(stderr, "nock prog mug: prefix changed key\r\n");
+    ret_i = 0;
+  }
+
+  //  compiled on a junior road, and taken into this one
+  //
+  {
+    u3_noun fal = u3nt(1, 1, 4);
+    u3_noun gon = u3m_soft(0, _prog_find, u3k(fal));
+    u3_noun key = u3nc(u3_nul, u3k(fal));
+    u3_weak pog = u3h_git(u3R->byc.har_p, key);
+
+    if ( (0 != u3h(gon)) || (u3_none == pog) ) {
+      fprintf(stderr, "nock prog mug: junior program not taken\r\n");
+      ret_i = 0;
+    }
+    else {
+      gop_u = u3to(u3n_prog, u3n_find(u3_nul, fal));
+
+      if (  (u3to(u3n_prog, pog) != gop_u)
+         || (0 == gop_u->lit_u.mug_w)
+         || (mug_w == gop_u->lit_u.mug_w) )
+      {
+        fprintf(stderr, "nock prog mug: junior program not keyed\r\n");
+        ret_i = 0;
+      }
+    }
+
+    u3z(key);
+    u3z(gon);
+    u3z(fal);
+  }
+
+  //  recomputed after the heap moves
+  //
+  {
+    u3_noun pro;
+
+    u3z(fol);
+    u3z(lof);
+    u3m_pack();
+
+    fol   = u3nt(1, 1, 2);
+    pog_u = u3to(u3n_prog, u3n_find(u3_nul, fol));
+    pro   = u3n_nock_on(u3_nul, u3k(fol));
+
+    if ( mug_w != pog_u->lit_u.mug_w ) {
+      fprintf(stderr, "nock prog mug: key changed by pack\r\n");
+      ret_i = 0;
+    }
+
+    u3z(pro);
+    u3z(fol);
+  }
+
+  return ret_i;
+}
+
 static c3_i
 _test_nock(void)
 {
@@ -62,6 +601,41 @@ _test_nock(void)
     ret_i = 0;
   }
 
+  if ( !_test_nock_fuse() ) {
+    fprintf(stderr, "test nock fuse: failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_nock_site() ) {
+    fprintf(stderr, "test nock site: failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_nock_bare() ) {
+    fprintf(stderr, "test nock bare: failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_nock_bare_road() ) {
+    fprintf(stderr, "test nock bare road: failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_nock_pack() ) {
+    fprintf(stderr, "test nock pack: failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_nock_sand() ) {
+    fprintf(stderr, "test nock sand: failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_nock_prog_mug() ) {
+    fprintf(stderr, "test nock prog mug: failed\r\n");
+    ret_i = 0;
+  }
+
   return ret_i;
 }
 
@@ -0,0 +1,407 @@
+#include "all.h"
+#include "vere/vere.h"
+
+/* _setup(): prepare for tests.
+*/
+static void
+_setup(void)
+{
+  u3m_init(1 << 24);
+  u3m_pave(c3y);
+
+  u3_Host.lup_u = uv_default_loop();
+}
+
+/* _pier_sky_make(): a working pier with an empty scry cache.
+*/
+static u3_pier*
+_pier_sky_make(c3_d eve_d)
+{
+  u3_pier* pir_u = c3_calloc(sizeof(*pir_u));
+  u3_work* wok_u = c3_calloc(sizeof(*wok_u));
+
+  pir_u->god_u = c3_calloc(sizeof(*pir_u->god_u));
+  pir_u->god_u->eve_d = eve_d;
+
+  wok_u->pir_u = pir_u;
+  uv_idle_init(u3L, &wok_u->idl_u);
+
+  pir_u->sat_e = u3_psat_work;
+  pir_u->wok_u = wok_u;
+
+  pir_u->sky_u.eve_d = eve_d;
+  pir_u->sky_u.nex_p = u3h_new_cache(100);
+  pir_u->sky_u.fix_p = u3h_new_cache(100);
+
+  return pir_u;
+}
+
+/* _pier_sky_drop(): dispose a pier made by _pier_sky_make().
+*/
+static void
+_pier_sky_drop(u3_pier* pir_u)
+{
+  c3_assert( !pir_u->sky_u.ext_u );
+
+  u3h_free(pir_u->sky_u.nex_p);
+  u3h_free(pir_u->sky_u.fix_p);
+
+  uv_idle_stop(&pir_u->wok_u->idl_u);
+  uv_close((uv_handle_t*)&pir_u->wok_u->idl_u, 0);
+  uv_run(u3L, UV_RUN_NOWAIT);
+
+  c3_free(pir_u->wok_u);
+  c3_free(pir_u->god_u);
+  c3_free(pir_u);
+}
+
+/* _pier_sky_note: scry responses received.
+*/
+typedef struct _pier_sky_note {
+  c3_w    cal_w;                        //  callbacks
+  u3_noun   res;                        //  last result
+} _pier_sky_note;
+
+/* _pier_sky_note_cb(): scry response callback.
+*/
+static void
+_pier_sky_note_cb(void* ptr_v, u3_noun res)
+{
+  _pier_sky_note* not_u = ptr_v;
+
+  not_u->cal_w++;
+  u3z(not_u->res);
+  not_u->res = res;
+}
+
+/* _pier_sky_path(): a scry by path, /[car_c]/~zod/base/[cas_c]/sys.
+*/
+static u3_pico*
+_pier_sky_path(_pier_sky_note* not_u, const c3_c* car_c, const c3_c* cas_c)
+{
+  u3_pico* pic_u = u3_pico_init();
+
+  pic_u->ptr_v = not_u;
+  pic_u->fun_f = _pier_sky_note_cb;
+  pic_u->gan   = u3_nul;
+  pic_u->typ_e = u3_pico_full;
+  pic_u->ful   = u3nc(c3y, u3nq(u3i_string(car_c),
+                                u3i_string("~zod"),
+                                c3__base,
+                                u3nt(u3i_string(cas_c), c3__sys, u3_nul)));
+
+  return pic_u;
+}
+
+/* _pier_sky_beam(): a scry by beam, [%beam car_c [[~zod %base cas] /sys]].
+*/
+static u3_pico*
+_pier_sky_beam(_pier_sky_note* not_u, const c3_c* car_c, u3_noun cas)
+{
+  u3_pico* pic_u = u3_pico_init();
+
+  pic_u->ptr_v = not_u;
+  pic_u->fun_f = _pier_sky_note_cb;
+  pic_u->gan   = u3_nul;
+  pic_u->typ_e = u3_pico_full;
+  pic_u->ful   = u3nc(c3n, u3nt(c3__beam,
+                                u3i_string(car_c),
+                                u3nc(u3nt(0, c3__base, cas),
+                                     u3nc(c3__sys, u3_nul))));
+
+  return pic_u;
+}
+
+/* _pier_sky_ask(): scry through the cache, answering a miss with [res].
+**
+**   yes on a hit, delivered as from the event loop.
+*/
+static c3_o
+_pier_sky_ask(u3_pier* pir_u, u3_pico* pic_u, u3_noun res)
+{
+  c3_o hit_o = u3_pier_sky_look(pir_u, pic_u);
+
+  if ( c3y == hit_o ) {
+    u3_scry* sry_u = pir_u->sky_u.ext_u;
+
+    c3_assert( sry_u && (sry_u == pir_u->sky_u.ent_u) );
+    pir_u->sky_u.ent_u = pir_u->sky_u.ext_u = 0;
+
+    sry_u->fun_f(sry_u->ptr_v, sry_u->res);
+    c3_free(sry_u);
+    u3z(res);
+  }
+  else {
+    pic_u->fun_f(pic_u->ptr_v, res);
+  }
+
+  u3_pico_free(pic_u);
+
+  return hit_o;
+}
+
+/* _pier_sky_res(): a found scry result.
+*/
+static u3_noun
+_pier_sky_res(c3_w val_w)
+{
+  return u3nt(u3_nul, u3_nul, u3nc(c3__noun, u3i_word(val_w)));
+}
+
+/* _pier_sky_fix: scries, and whether they are immutable.
+*/
+static const struct {
+  c3_o        bem_o;                    //  by beam
+  const c3_c* car_c;                    //  care
+  const c3_c* cas_c;                    //  path case
+  c3_m        cas_m;                    //  beam case
+  c3_o        fix_o;                    //  immutable
+} _pier_sky_fix[] = {
+  { c3n, "cx", "1.000",     0,      c3y },
+  { c3n, "cx", "1",         0,      c3y },
+  { c3n, "gx", "1",         0,      c3n },
+  { c3n, "cx", "1000",      0,      c3n },
+  { c3n, "cx", "~2020.1.1", 0,      c3n },
+  { c3y, "cx", 0,           c3__ud, c3y },
+  { c3y, "gx", 0,           c3__ud, c3n },
+  { c3y, "cx", 0,           c3__da, c3n },
+};
+
+/* _pier_sky_fix_new(): construct scry [i_w] of _pier_sky_fix.
+*/
+static u3_pico*
+_pier_sky_fix_new(_pier_sky_note* not_u, c3_w i_w)
+{
+  if ( c3y == _pier_sky_fix[i_w].bem_o ) {
+    return _pier_sky_beam(not_u, _pier_sky_fix[i_w].car_c,
+                                 u3nc(_pier_sky_fix[i_w].cas_m, 1));
+  }
+  else {
+    return _pier_sky_path(not_u, _pier_sky_fix[i_w].car_c,
+                                 _pier_sky_fix[i_w].cas_c);
+  }
+}
+
+/* _test_sky_fixed(): clay reads at a revision are cached across events.
+*/
+static c3_i
+_test_sky_fixed(void)
+{
+  c3_w            len_w = sizeof(_pier_sky_fix) / sizeof(_pier_sky_fix[0]);
+  _pier_sky_note  not_u = { 0, u3_nul };
+  c3_i            ret_i = 1;
+  c3_w            i_w;
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    u3_pier* pir_u = _pier_sky_make(1);
+    c3_o     fix_o = _pier_sky_fix[i_w].fix_o;
+    c3_o     hit_o;
+
+    if ( c3y == _pier_sky_ask(pir_u, _pier_sky_fix_new(&not_u, i_w),
+                                     _pier_sky_res(i_w)) )
+    {
+      fprintf(stderr, "sky fixed: %u: hit on empty cache\r\n", i_w);
+      ret_i = 0;
+    }
+
+    //  a new event flushes mutable results
+    //
+    pir_u->god_u->eve_d = 2;
+    hit_o = _pier_sky_ask(pir_u, _pier_sky_fix_new(&not_u, i_w),
+                                 _pier_sky_res(100 + i_w));
+
+    if ( fix_o != hit_o ) {
+      fprintf(stderr, "sky fixed: %u: expected %s\r\n",
+                      i_w, ( c3y == fix_o ) ? "hit" : "miss");
+      ret_i = 0;
+    }
+    else {
+      u3_noun exp = _pier_sky_res(( c3y == hit_o ) ? i_w : 100 + i_w);
+
+      if ( c3n == u3r_sing(exp, not_u.res) ) {
+        fprintf(stderr, "sky fixed: %u: wrong result\r\n", i_w);
+        ret_i = 0;
+      }
+
+      u3z(exp);
+    }
+
+    if ( (c3y == hit_o) && (1 != pir_u->sky_u.hit_d) ) {
+      fprintf(stderr, "sky fixed: %u: hit not counted\r\n", i_w);
+      ret_i = 0;
+    }
+
+    _pier_sky_drop(pir_u);
+  }
+
+  if ( (2 * len_w) != not_u.cal_w ) {
+    fprintf(stderr, "sky fixed: %u callbacks\r\n", not_u.cal_w);
+    ret_i = 0;
+  }
+
+  u3z(not_u.res);
+
+  return ret_i;
+}
+
+/* _test_sky_turn(): mutable results are cached until the next event.
+*/
+static c3_i
+_test_sky_turn(void)
+{
+  u3_pier*        pir_u = _pier_sky_make(1);
+  _pier_sky_note  not_u = { 0, u3_nul };
+  c3_i            ret_i = 1;
+
+  _pier_sky_ask(pir_u, _pier_sky_path(&not_u, "gx", "1"), _pier_sky_res(1));
+
+  if ( c3y != _pier_sky_ask(pir_u, _pier_sky_path(&not_u, "gx", "1"),
+                                   _pier_sky_res(2)) )
+  {
+    fprintf(stderr, "sky turn: miss in same event\r\n");
+    ret_i = 0;
+  }
+
+  {
+    u3_noun exp = _pier_sky_res(1);
+
+    if ( c3n == u3r_sing(exp, not_u.res) ) {
+      fprintf(stderr, "sky turn: wrong cached result\r\n");
+      ret_i = 0;
+    }
+
+    u3z(exp);
+  }
+
+  pir_u->god_u->eve_d = 2;
+
+  if ( c3n != _pier_sky_ask(pir_u, _pier_sky_path(&not_u, "gx", "1"),
+                                   _pier_sky_res(3)) )
+  {
+    fprintf(stderr, "sky turn: hit after new event\r\n");
+    ret_i = 0;
+  }
+
+  if ( 2 != pir_u->sky_u.eve_d ) {
+    fprintf(stderr, "sky turn: generation %" PRIu64 "\r\n",
+                    pir_u->sky_u.eve_d);
+    ret_i = 0;
+  }
+
+  //  the fresh result is cached for the new event
+  //
+  if ( c3y != _pier_sky_ask(pir_u, _pier_sky_path(&not_u, "gx", "1"),
+                                   _pier_sky_res(4)) )
+  {
+    fprintf(stderr, "sky turn: fresh result not cached\r\n");
+    ret_i = 0;
+  }
+
+  {
+    u3_noun exp = _pier_sky_res(3);
+
+    if ( c3n == u3r_sing(exp, not_u.res) ) {
+      fprintf(stderr, "sky turn: wrong fresh result\r\n");
+      ret_i = 0;
+    }
+
+    u3z(exp);
+  }
+
+  if ( (2 != pir_u->sky_u.hit_d) || (2 != pir_u->sky_u.mis_d) ) {
+    fprintf(stderr, "sky turn: %" PRIu64 " hits, %" PRIu64 " misses\r\n",
+                    pir_u->sky_u.hit_d, pir_u->sky_u.mis_d);
+    ret_i = 0;
+  }
+
+  u3z(not_u.res);
+  _pier_sky_drop(pir_u);
+
+  return ret_i;
+}
+
+/* _test_sky_null(): missing results are not cached as immutable.
+*/
+static c3_i
+_test_sky_null(void)
+{
+  u3_pier*        pir_u = _pier_sky_make(1);
+  _pier_sky_note  not_u = { 0, u3_nul };
+  c3_i            ret_i = 1;
+
+  //  [~ ~]: not found, but may yet be
+  //
+  _pier_sky_ask(pir_u, _pier_sky_path(&not_u, "cx", "1"),
+                       u3nc(u3_nul, u3_nul));
+
+  if ( c3n != _pier_sky_ask(pir_u, _pier_sky_path(&not_u, "cx", "1"),
+                                   _pier_sky_res(1)) )
+  {
+    fprintf(stderr, "sky null: fixed [~ ~] cached\r\n");
+    ret_i = 0;
+  }
+
+  //  ~: failed
+  //
+  _pier_sky_ask(pir_u, _pier_sky_path(&not_u, "gx", "1"), u3_nul);
+
+  if ( c3n != _pier_sky_ask(pir_u, _pier_sky_path(&not_u, "gx", "1"),
+                                   _pier_sky_res(2)) )
+  {
+    fprintf(stderr, "sky null: ~ cached\r\n");
+    ret_i = 0;
+  }
+
+  if ( 4 != not_u.cal_w ) {
+    fprintf(stderr, "sky null: %u callbacks\r\n", not_u.cal_w);
+    ret_i = 0;
+  }
+
+  u3z(not_u.res);
+  _pier_sky_drop(pir_u);
+
+  return ret_i;
+}
+
+static c3_i
+_test_pier(void)
+{
+  c3_i ret_i = 1;
+
+  if ( !_test_sky_fixed() ) {
+    fprintf(stderr, "test pier: sky fixed failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_sky_turn() ) {
+    fprintf(stderr, "test pier: sky turn failed\r\n");
+    ret_i = 0;
+  }
+
+  if ( !_test_sky_null() ) {
+    fprintf(stderr, "test pier: sky null failed\r\n");
+    ret_i = 0;
+  }
+
+  return ret_i;
+}
+
+/* main(): run all test cases.
+*/
+int
+main(int argc, char* argv[])
+{
+  _setup();
+
+  if ( !_test_pier() ) {
+    fprintf(stderr, "test pier: failed\r\n");
+    exit(1);
+  }
+
+  //  GC
+  //
+  u3m_grab(u3_none);
+
+  fprintf(stderr, "test pier: ok\r\n");
+  return 0;
+}
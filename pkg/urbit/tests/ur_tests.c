@@ -413,6 +413,49 @@ _test_bsw64(void)
        & _test_bsw64_loop("bsw 64 alt 2", 0x5555555555555555ULL);
 }
 
+/*
+**  at varying offsets, write varying numbers of bits via ur_bsw64
+**  into a buffer with room for word-at-a-time writes, and via master,
+**  comparing the result each time.
+*/
+static int
+_test_bsw64_word_loop(const char* cap, uint64_t val)
+{
+  int    ret = 1;
+  ur_bsw_t a = {0};
+  ur_bsw_t b = {0};
+  uint8_t i, j;
+
+  for ( i = 0; i < 8; i++) {
+    for ( j = 0; j <= 64; j++ ) {
+      _bsw_reinit(&a, 16, 16);
+      _bsw_reinit(&b, 16, 16);
+      a.off = a.bits = b.off = b.bits = i;
+
+      _bsw64_slow(&a, j, val);
+      ur_bsw64(&b, j, val);
+
+      ret &= _bsw_cmp_check(cap, (uint8_t)val, i, j, &a, &b);
+
+      _bsw64_slow(&a, 64 - j, ~val);
+      ur_bsw64(&b, 64 - j, ~val);
+
+      ret &= _bsw_cmp_check(cap, (uint8_t)~val, i, j, &a, &b);
+    }
+  }
+
+  return ret;
+}
+
+static int
+_test_bsw64_word(void)
+{
+  return _test_bsw64_word_loop("bsw 64 word ones", 0xffffffffffffffffULL)
+       & _test_bsw64_word_loop("bsw 64 word alt", 0xaaaaaaaaaaaaaaaaULL)
+       & _test_bsw64_word_loop("bsw 64 word mixed", 0x0123456789abcdefULL)
+       & _test_bsw64_word_loop("bsw 64 word high", 0xf00dcafe00000001ULL);
+}
+
 /*
 **  ur_bsw_bytes() golden master
 */
@@ -527,6 +570,7 @@ _test_bsw(void)
        & _test_bsw8()
        & _test_bsw32()
        & _test_bsw64()
+       & _test_bsw64_word()
        & _test_bsw_bytes()
        & _test_bsw_bex();
 }
@@ -1262,6 +1306,59 @@ _test_bsr64(void)
        & _test_bsr64_loop("bsr64 alt-2 8", 8, 0x55);
 }
 
+/*
+**  from a bitstream-reader over a long, irregular buffer, at every bit
+**  offset in its first word, read varying numbers of bits via
+**  ur_bsr32_any, ur_bsr64_any and master, comparing the results and
+**  respective states each time.
+*/
+static int
+_test_bsr_word(void)
+{
+  int         ret = 1;
+  uint8_t bytes[24];
+  ur_bsr_t a, b;
+  uint64_t c, d;
+  uint8_t  i, j;
+
+  for ( i = 0; i < sizeof(bytes); i++ ) {
+    bytes[i] = (uint8_t)(0x3b + (i * 0x9d));
+  }
+
+  for ( i = 0; i < 64; i++) {
+    for ( j = 0; j <= 64; j++ ) {
+      a.left  = b.left  = sizeof(bytes) - (i >> 3);
+      a.bytes = b.bytes = bytes + (i >> 3);
+      a.off   = b.off   = ur_mask_3(i);
+      a.bits  = b.bits  = i;
+
+      c = _bsr64_any_slow(&a, j);
+      d = ur_bsr64_any(&b, j);
+
+      ret &= _bsr_cmp_any_check("bsr64 word", i, j, &a, &b);
+
+      if ( c != d ) {
+        fprintf(stderr, "bsr64 word: off %u, len %u not equal (%016" PRIx64", %016" PRIx64")\r\n",
+                        i, j, c, d);
+        ret = 0;
+      }
+
+      c = _bsr64_any_slow(&a, ur_min(32, j));
+      d = ur_bsr32_any(&b, j);
+
+      ret &= _bsr_cmp_any_check("bsr32 word", i, j, &a, &b);
+
+      if ( c != d ) {
+        fprintf(stderr, "bsr32 word: off %u, len %u not equal (%08" PRIx64", %08" PRIx64")\r\n",
+                        i, j, c, d);
+        ret = 0;
+      }
+    }
+  }
+
+  return ret;
+}
+
 /*
 **  ur_bsr_bytes_any golden master
 */
@@ -1652,6 +1749,7 @@ _test_bsr(void)
        & _test_bsr8()
        & _test_bsr32()
        & _test_bsr64()
+       & _test_bsr_word()
        & _test_bsr_log()
        & _test_bsr_tag();
 }
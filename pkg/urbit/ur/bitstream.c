@@ -6,6 +6,59 @@
 #include "ur/defs.h"
 #include "ur/bitstream.h"
 
+/*
+**  little-endian word access at any byte offset; compilers reduce
+**  these to single (unaligned) loads and stores where supported.
+*/
+static inline uint64_t
+_bs_load64(const uint8_t *b)
+{
+  return (uint64_t)b[0]
+       ^ (uint64_t)b[1] << 8
+       ^ (uint64_t)b[2] << 16
+       ^ (uint64_t)b[3] << 24
+       ^ (uint64_t)b[4] << 32
+       ^ (uint64_t)b[5] << 40
+       ^ (uint64_t)b[6] << 48
+       ^ (uint64_t)b[7] << 56;
+}
+
+static inline void
+_bs_store64(uint8_t *b, uint64_t val)
+{
+  b[0] = ur_mask_8(val);
+  b[1] = ur_mask_8(val >>  8);
+  b[2] = ur_mask_8(val >> 16);
+  b[3] = ur_mask_8(val >> 24);
+  b[4] = ur_mask_8(val >> 32);
+  b[5] = ur_mask_8(val >> 40);
+  b[6] = ur_mask_8(val >> 48);
+  b[7] = ur_mask_8(val >> 56);
+}
+
+/*
+**  read [len] bits from a word (and a byte) of the stream,
+**  which must have more than 8 bytes left.
+*/
+static inline uint64_t
+_bsr_word_unsafe(ur_bsr_t *bsr, uint8_t len)
+{
+  const uint8_t *b = bsr->bytes;
+  uint8_t      off = bsr->off;
+  uint8_t     bits = off + len;
+  uint64_t       m = _bs_load64(b) >> off;
+
+  if ( off ) {
+    m ^= (uint64_t)b[8] << (64 - off);
+  }
+
+  bsr->bytes += bits >> 3;
+  bsr->left  -= bits >> 3;
+  bsr->off    = ur_mask_3(bits);
+
+  return ( 64 == len ) ? m : m & ((1ULL << len) - 1);
+}
+
 ur_cue_res_e
 ur_bsr_init(ur_bsr_t *bsr, uint64_t len, const uint8_t *bytes)
 {
@@ -145,6 +198,9 @@ ur_bsr32_any(ur_bsr_t *bsr, uint8_t len)
   if ( !left ) {
     return 0;
   }
+  else if ( 8 < left ) {
+    return (uint32_t)_bsr_word_unsafe(bsr, len);
+  }
   else {
     uint8_t  off = bsr->off;
     uint8_t rest = 8 - off;
@@ -238,6 +294,9 @@ ur_bsr64_any(ur_bsr_t *bsr, uint8_t len)
   if ( !left ) {
     return 0;
   }
+  else if ( 8 < left ) {
+    return _bsr_word_unsafe(bsr, len);
+  }
   else {
     uint8_t  off = bsr->off;
     uint8_t rest = 8 - off;
@@ -415,12 +474,18 @@ ur_bsr_bytes_any(ur_bsr_t *bsr, uint64_t len, uint8_t *out)
       uint64_t  max = ur_min(last, len_byt);
       uint8_t  m, l;
 
-      //  loop over all the bytes we need (or all that remain)
+      //  loop over all the bytes we need (or all that remain),
+      //  a word at a time while a following byte is available
       //
       {
         uint64_t i;
 
-        for ( i = 0; i < max; i++ ) {
+        for ( i = 0; (i + 8) <= max; i += 8 ) {
+          _bs_store64(out + i, (_bs_load64(b + i) >> off)
+                               ^ ((uint64_t)b[i + 8] << (56 + rest)));
+        }
+
+        for ( ; i < max; i++ ) {
           out[i] = (b[i] >> off) ^ (b[i + 1] << rest);
         }
 
@@ -612,23 +677,34 @@ ur_bsr_log(ur_bsr_t *bsr, uint8_t *out)
   else {
     uint8_t      off = bsr->off;
     const uint8_t *b = bsr->bytes;
-    uint8_t      byt = b[0] >> off;
-    uint8_t     skip = 0;
+    uint64_t     wor = ( 8 <= left ) ? (_bs_load64(b) >> off) : 0;
+    uint32_t   zeros;
 
-    while ( !byt ) {
-      if ( 32 == skip ) {
-        return _bsr_log_meme(bsr);
-      }
+    //  the run of zeros usually ends in the next word
+    //
+    if ( wor ) {
+      zeros = ur_tz64(wor);
+    }
+    else {
+      uint8_t  byt = b[0] >> off;
+      uint8_t skip = 0;
 
-      byt = b[++skip];
+      while ( !byt ) {
+        if ( 32 == skip ) {
+          return _bsr_log_meme(bsr);
+        }
+
+        byt = b[++skip];
 
-      if ( skip == left ) {
-        return _bsr_set_gone(bsr, (skip << 3) - off);
+        if ( skip == left ) {
+          return _bsr_set_gone(bsr, (skip << 3) - off);
+        }
       }
+
+      zeros = ur_tz8(byt) + (skip ? ((skip << 3) - off) : 0);
     }
 
     {
-      uint32_t zeros = ur_tz8(byt) + (skip ? ((skip << 3) - off) : 0);
 
       if ( 255 < zeros ) {
         return _bsr_log_meme(bsr);
@@ -826,6 +902,40 @@ ur_bsw8(ur_bsw_t *bsw, uint8_t len, uint8_t byt)
   _bsw8_unsafe(bsw, len, byt);
 }
 
+/*
+**  write [len] bits as a word (and a byte), if the buffer has room.
+**
+**    bytes past the cursor are always zero, so they may be rewritten.
+*/
+static inline ur_bool_t
+_bsw_word_unsafe(ur_bsw_t *bsw, uint8_t len, uint64_t val)
+{
+  uint64_t  fill = bsw->fill;
+  uint8_t    off = bsw->off;
+  uint8_t *bytes = bsw->bytes + fill;
+  uint8_t   bits = off + len;
+
+  if ( 9 > (bsw->size - fill) ) {
+    return 0;
+  }
+
+  if ( 64 > len ) {
+    val &= (1ULL << len) - 1;
+  }
+
+  _bs_store64(bytes, (bytes[0] & ((1 << off) - 1)) ^ (val << off));
+
+  if ( off ) {
+    bytes[8] = (uint8_t)(val >> (64 - off));
+  }
+
+  bsw->bits += len;
+  bsw->fill  = fill + (bits >> 3);
+  bsw->off   = ur_mask_3(bits);
+
+  return 1;
+}
+
 static inline void
 _bsw32_unsafe(ur_bsw_t *bsw, uint8_t len, uint32_t val)
 {
@@ -833,6 +943,10 @@ _bsw32_unsafe(ur_bsw_t *bsw, uint8_t len, uint32_t val)
   uint8_t    off = bsw->off;
   uint8_t *bytes = bsw->bytes;
 
+  if ( _bsw_word_unsafe(bsw, len, val) ) {
+    return;
+  }
+
   bsw->bits += len;
 
   if ( off ) {
@@ -914,6 +1028,10 @@ _bsw64_unsafe(ur_bsw_t *bsw, uint8_t len, uint64_t val)
   uint8_t    off = bsw->off;
   uint8_t *bytes = bsw->bytes;
 
+  if ( _bsw_word_unsafe(bsw, len, val) ) {
+    return;
+  }
+
   bsw->bits += len;
 
   if ( off ) {
@@ -1068,9 +1186,18 @@ _bsw_bytes_unsafe(ur_bsw_t *bsw, const uint64_t len, const uint8_t* src)
       const uint64_t len_byt = nel >> 3;
       const uint8_t  len_bit = ur_mask_3(nel);
 
+      uint64_t i = 0;
+
       *dst++ ^= *src << off;
 
-      for ( uint64_t i = 0; i < len_byt; i++ ) {
+      //  a word at a time while a following byte is available
+      //
+      for ( ; (i + 8) <= len_byt; i += 8 ) {
+        _bs_store64(dst + i, (_bs_load64(src + i) >> rest)
+                             ^ ((uint64_t)src[i + 8] << (56 + off)));
+      }
+
+      for ( ; i < len_byt; i++ ) {
         dst[i] = (src[i] >> rest) ^ (src[i + 1] << off);
       }
 
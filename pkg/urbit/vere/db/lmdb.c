@@ -5,6 +5,7 @@
 #include "c/defs.h"
 #include "vere/db/lmdb.h"
 #include <sys/stat.h>
+#include <zlib.h>
 
 /* mdb_logerror(): writes an error message and lmdb error code to f.
 */
@@ -18,7 +19,8 @@ intmax_t mdb_get_filesize(mdb_filehandle_t han_u);
 //
 //    this module implements a simple persistence api on top of lmdb.
 //    outside of its use of c3 type definitions, this module has no
-//    dependence on anything u3, or on any library besides lmdb itself.
+//    dependence on anything u3, or on any library besides lmdb itself
+//    (and zlib, for segment compression).
 //
 //    urbit requires very little from a persist store -- it merely
 //    needs to store variable-length buffers in:
@@ -33,6 +35,52 @@ intmax_t mdb_get_filesize(mdb_filehandle_t han_u);
 //      - read the first and last event numbers
 //      - read/save ranges of events
 //
+//    segments
+//
+//      if enabled with u3_lmdb_pack(), events are saved to EVENTS as
+//      usual, but every run of _mdb_seg_len events (aligned from event
+//      1) is then "sealed": moved, in the same transaction, into a
+//      single compressed value in SEGMENTS, keyed by its first event.
+//      reads seek the segment containing an event, so random access
+//      by event number costs one segment decompression.
+//
+//      segments are deflated with a preset dictionary (DICTS), trained
+//      from the contents of the segment being sealed; a new one is
+//      trained every _mdb_dic_age segments, and old ones are kept for
+//      the segments that reference them. a segment value is:
+//
+//        codec (1 byte; 0: stored, 1: zlib)
+//        dictionary id (8 bytes; 0: none)
+//        event count (4 bytes)
+//        uncompressed length (8 bytes)
+//        payload
+//
+//      where the uncompressed payload is an array of 4-byte event
+//      lengths, then the events. all integers are little-endian.
+//
+//    epochs
+//
+//      the log may be truncated from the front with u3_lmdb_chop(),
+//      behind a snapshot at some event S: events (or whole segments)
+//      before the cut are deleted, and S is recorded in META under
+//      "epoch". the log then begins at or before S; the caller is
+//      responsible for S being a snapshot it can actually load.
+//
+
+#define _mdb_seg_len  256         //  events per segment
+#define _mdb_seg_hed  21          //  segment header length
+#define _mdb_dic_age  64          //  segments per dictionary
+#define _mdb_dic_max  (1 << 15)   //  dictionary length (deflate window)
+
+/* _mdb_ctx: per-environment state, in the env's user context.
+*/
+struct _mdb_ctx {
+  MDB_dbi  met_u;                 //  META
+  MDB_dbi  eve_u;                 //  EVENTS, unsealed
+  MDB_dbi  seg_u;                 //  SEGMENTS, sealed
+  MDB_dbi  dic_u;                 //  DICTS, codec dictionaries
+  c3_o     pac_o;                 //  seal segments on save
+};
 
 /* u3_lmdb_init(): open lmdb at [pax_c], mmap up to [siz_i].
 */
@@ -47,9 +95,9 @@ u3_lmdb_init(const c3_c* pax_c, size_t siz_i)
     return 0;
   }
 
-  //  Our databases have two tables: META and EVENTS
+  //  Our databases have four tables: META, EVENTS, SEGMENTS and DICTS
   //
-  if ( (ret_w = mdb_env_set_maxdbs(env_u, 2)) ) {
+  if ( (ret_w = mdb_env_set_maxdbs(env_u, 4)) ) {
     mdb_logerror(stderr, ret_w, "lmdb: failed to set number of databases");
     //  XX dispose env_u
     //
@@ -78,15 +126,792 @@ u3_lmdb_init(const c3_c* pax_c, size_t siz_i)
     }
   }
 
-  return env_u;
+  //  open our tables once, up front
+  //
+  //    dbi handles opened in a committed transaction remain valid
+  //    for the life of the environment, so we keep ours in the
+  //    env's user context instead of reopening them per transaction.
+  //
+  {
+    struct _mdb_ctx* ctx_u = c3_malloc(sizeof(*ctx_u));
+    MDB_txn*         txn_u;
+    c3_w             int_w = MDB_CREATE | MDB_INTEGERKEY;
+
+    ctx_u->pac_o = c3n;
+
+    if ( (ret_w = mdb_txn_begin(env_u, 0, 0, &txn_u)) ) {
+      mdb_logerror(stderr, ret_w, "lmdb: init: txn_begin fail");
+      c3_free(ctx_u);
+      mdb_env_close(env_u);
+      return 0;
+    }
+
+    if (  (ret_w = mdb_dbi_open(txn_u, "META", MDB_CREATE, &ctx_u->met_u))
+       || (ret_w = mdb_dbi_open(txn_u, "EVENTS", int_w, &ctx_u->eve_u))
+       || (ret_w = mdb_dbi_open(txn_u, "SEGMENTS", int_w, &ctx_u->seg_u))
+       || (ret_w = mdb_dbi_open(txn_u, "DICTS", int_w, &ctx_u->dic_u)) )
+    {
+      mdb_logerror(stderr, ret_w, "lmdb: init: dbi_open fail");
+      mdb_txn_abort(txn_u);
+      c3_free(ctx_u);
+      mdb_env_close(env_u);
+      return 0;
+    }
+
+    if ( (ret_w = mdb_txn_commit(txn_u)) ) {
+      mdb_logerror(stderr, ret_w, "lmdb: init: commit fail");
+      c3_free(ctx_u);
+      mdb_env_close(env_u);
+      return 0;
+    }
+
+    mdb_env_set_userctx(env_u, ctx_u);
+  }
+
+  return env_u;
+}
+
+/* _mdb_ctx(): per-environment state, from u3_lmdb_init().
+*/
+static struct _mdb_ctx*
+_mdb_ctx(MDB_env* env_u)
+{
+  return mdb_env_get_userctx(env_u);
+}
+
+/* u3_lmdb_exit(): close lmdb.
+*/
+void
+u3_lmdb_exit(MDB_env* env_u)
+{
+  struct _mdb_ctx* ctx_u = _mdb_ctx(env_u);
+
+  mdb_env_close(env_u);
+  c3_free(ctx_u);
+}
+
+/* u3_lmdb_pack(): enable/disable sealing events into segments on save.
+*/
+void
+u3_lmdb_pack(MDB_env* env_u, c3_o pac_o)
+{
+  _mdb_ctx(env_u)->pac_o = pac_o;
+}
+
+/* _mdb_etch_w(): write little-endian word.
+*/
+static void
+_mdb_etch_w(c3_y* byt_y, c3_w val_w)
+{
+  byt_y[0] = val_w & 0xff;
+  byt_y[1] = (val_w >>  8) & 0xff;
+  byt_y[2] = (val_w >> 16) & 0xff;
+  byt_y[3] = (val_w >> 24) & 0xff;
+}
+
+/* _mdb_etch_d(): write little-endian chub.
+*/
+static void
+_mdb_etch_d(c3_y* byt_y, c3_d val_d)
+{
+  _mdb_etch_w(byt_y, val_d & 0xffffffff);
+  _mdb_etch_w(byt_y + 4, val_d >> 32);
+}
+
+/* _mdb_sift_w(): read little-endian word.
+*/
+static c3_w
+_mdb_sift_w(const c3_y* byt_y)
+{
+  return (c3_w)byt_y[0]
+       | ((c3_w)byt_y[1] <<  8)
+       | ((c3_w)byt_y[2] << 16)
+       | ((c3_w)byt_y[3] << 24);
+}
+
+/* _mdb_sift_d(): read little-endian chub.
+*/
+static c3_d
+_mdb_sift_d(const c3_y* byt_y)
+{
+  return (c3_d)_mdb_sift_w(byt_y) | ((c3_d)_mdb_sift_w(byt_y + 4) << 32);
+}
+
+/* _mdb_ends(): read first and last keys of [mdb_u], and the last value.
+*/
+static c3_w
+_mdb_ends(MDB_txn* txn_u,
+          MDB_dbi  mdb_u,
+          c3_d*    fir_d,
+          c3_d*    las_d,
+          MDB_val* val_u)
+{
+  MDB_cursor* cur_u;
+  MDB_val     key_u;
+  c3_w        ret_w;
+
+  if ( (ret_w = mdb_cursor_open(txn_u, mdb_u, &cur_u)) ) {
+    return ret_w;
+  }
+
+  if ( !(ret_w = mdb_cursor_get(cur_u, &key_u, val_u, MDB_FIRST)) ) {
+    *fir_d = *(c3_d*)key_u.mv_data;
+
+    if ( !(ret_w = mdb_cursor_get(cur_u, &key_u, val_u, MDB_LAST)) ) {
+      *las_d = *(c3_d*)key_u.mv_data;
+    }
+  }
+
+  mdb_cursor_close(cur_u);
+  return ret_w;
+}
+
+/* _mdb_seg_head(): parse segment header.
+*/
+static c3_o
+_mdb_seg_head(MDB_val* val_u,
+              c3_y*    cod_y,
+              c3_d*    dic_d,
+              c3_w*    num_w,
+              c3_d*    raw_d)
+{
+  const c3_y* byt_y = val_u->mv_data;
+
+  if ( _mdb_seg_hed > val_u->mv_size ) {
+    return c3n;
+  }
+
+  *cod_y = byt_y[0];
+  *dic_d = _mdb_sift_d(byt_y + 1);
+  *num_w = _mdb_sift_w(byt_y + 9);
+  *raw_d = _mdb_sift_d(byt_y + 13);
+
+  return ( (1 < *cod_y) || !*num_w ) ? c3n : c3y;
+}
+
+/* _mdb_gram(): hash the 8-byte gram at [byt_y].
+*/
+static c3_w
+_mdb_gram(const c3_y* byt_y)
+{
+  c3_d gam_d;
+  memcpy(&gam_d, byt_y, 8);
+  return (gam_d * 0x9e3779b97f4a7c15ULL) >> 48;
+}
+
+/* _mdb_chunk: dictionary candidate.
+*/
+struct _mdb_chunk {
+  c3_d        sco_d;              //  score
+  const c3_y* byt_y;              //  contents
+};
+
+/* _mdb_chunk_cmp(): order chunks by descending score.
+*/
+static int
+_mdb_chunk_cmp(const void* a, const void* b)
+{
+  const struct _mdb_chunk* a_u = a;
+  const struct _mdb_chunk* b_u = b;
+
+  return ( a_u->sco_d < b_u->sco_d ) ? 1 : ( a_u->sco_d > b_u->sco_d ) ? -1 : 0;
+}
+
+/* _mdb_dict_train(): train a deflate dictionary on [num_w] events.
+**
+**   a poor man's zstd trainer: fixed-size chunks of the samples are
+**   scored by how often their 8-byte grams recur across all samples,
+**   and the best distinct chunks are kept, best last (nearest to the
+**   data, where deflate can reach them most cheaply).
+*/
+static c3_y*
+_mdb_dict_train(c3_w num_w, c3_y** byt_y, c3_w* len_w, size_t* dic_i)
+{
+  const c3_w   cun_w = 64;          //  chunk length
+  const c3_w   sam_w = 1 << 16;     //  max bytes sampled per event
+  c3_w*        cnt_w = c3_calloc((1 << 16) * sizeof(c3_w));
+  struct _mdb_chunk* cun_u;
+  c3_d         cap_d = 0, tot_d = 0;
+  c3_y*        dic_y;
+  c3_w         i_w;
+
+  //  count grams
+  //
+  for ( i_w = 0; i_w < num_w; i_w++ ) {
+    c3_w max_w = c3_min(len_w[i_w], sam_w);
+    c3_w j_w;
+
+    for ( j_w = 0; j_w + 8 <= max_w; j_w++ ) {
+      cnt_w[_mdb_gram(byt_y[i_w] + j_w)]++;
+    }
+
+    cap_d += max_w / cun_w;
+  }
+
+  if ( cap_d < 16 ) {
+    c3_free(cnt_w);
+    *dic_i = 0;
+    return 0;
+  }
+
+  //  score chunks by their recurring grams
+  //
+  cun_u = c3_malloc(cap_d * sizeof(*cun_u));
+
+  for ( i_w = 0; i_w < num_w; i_w++ ) {
+    c3_w max_w = c3_min(len_w[i_w], sam_w);
+    c3_w j_w, k_w;
+
+    for ( j_w = 0; j_w + cun_w <= max_w; j_w += cun_w ) {
+      c3_d sco_d = 0;
+
+      for ( k_w = 0; k_w + 8 <= cun_w; k_w++ ) {
+        sco_d += cnt_w[_mdb_gram(byt_y[i_w] + j_w + k_w)] - 1;
+      }
+
+      if ( sco_d ) {
+        cun_u[tot_d].sco_d = sco_d;
+        cun_u[tot_d].byt_y = byt_y[i_w] + j_w;
+        tot_d++;
+      }
+    }
+  }
+
+  qsort(cun_u, tot_d, sizeof(*cun_u), _mdb_chunk_cmp);
+
+  //  take the best distinct chunks, filling the dictionary back-to-front
+  //
+  {
+    c3_w  max_w = _mdb_dic_max / cun_w;
+    c3_w  has_w = 0;
+    c3_d* has_d = c3_calloc(2 * max_w * sizeof(c3_d));
+    c3_w  fil_w = 0;
+    c3_d  j_d;
+
+    dic_y = c3_malloc(_mdb_dic_max);
+
+    for ( j_d = 0; (j_d < tot_d) && (fil_w < max_w); j_d++ ) {
+      c3_d key_d = 1;
+      c3_w k_w;
+
+      //  dedupe by chunk hash (open addressing, zero is empty)
+      //
+      for ( k_w = 0; k_w < cun_w; k_w += 8 ) {
+        c3_d gam_d;
+        memcpy(&gam_d, cun_u[j_d].byt_y + k_w, 8);
+        key_d = (key_d ^ gam_d) * 0x100000001b3ULL;
+      }
+      key_d |= 1;
+
+      for ( k_w = key_d % (2 * max_w);
+            has_d[k_w] && (has_d[k_w] != key_d);
+            k_w = (k_w + 1) % (2 * max_w) );
+
+      if ( has_d[k_w] ) {
+        continue;
+      }
+
+      has_d[k_w] = key_d;
+      has_w++;
+      fil_w++;
+      memcpy(dic_y + _mdb_dic_max - (fil_w * cun_w), cun_u[j_d].byt_y, cun_w);
+    }
+
+    c3_free(has_d);
+
+    //  shift to the front if not full
+    //
+    *dic_i = (size_t)fil_w * cun_w;
+    memmove(dic_y, dic_y + _mdb_dic_max - *dic_i, *dic_i);
+  }
+
+  c3_free(cun_u);
+  c3_free(cnt_w);
+  return dic_y;
+}
+
+/* _mdb_seal(): move events [fir_d, fir_d + num_w) into a segment.
+*/
+static c3_o
+_mdb_seal(MDB_txn* txn_u, struct _mdb_ctx* ctx_u, c3_d fir_d, c3_w num_w)
+{
+  c3_w*  len_w = c3_malloc(num_w * sizeof(c3_w));
+  c3_y** byt_y = c3_malloc(num_w * sizeof(c3_y*));
+  c3_y*  raw_y;
+  c3_d   raw_d = 4ULL * num_w;
+  c3_d   dic_d = 0;
+  c3_y*  dic_y = 0;
+  size_t dic_i = 0;
+  c3_y*  new_y = 0;
+  c3_d   new_d = 0;
+  c3_y*  seg_y;
+  c3_d   seg_d;
+  c3_w   ret_w, i_w;
+
+  //  copy events into an uncompressed segment
+  //
+  {
+    MDB_cursor* cur_u;
+    c3_d        key_d = fir_d;
+    MDB_val     key_u = { .mv_size = sizeof(c3_d), .mv_data = &key_d };
+    MDB_val     val_u;
+
+    if ( (ret_w = mdb_cursor_open(txn_u, ctx_u->eve_u, &cur_u)) ) {
+      mdb_logerror(stderr, ret_w, "lmdb: seal: cursor_open fail");
+      c3_free(len_w); c3_free(byt_y);
+      return c3n;
+    }
+
+    ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_SET_KEY);
+
+    for ( i_w = 0; i_w < num_w; i_w++ ) {
+      if (  ret_w
+         || (*(c3_d*)key_u.mv_data != fir_d + i_w)
+         || (0xffffffff < val_u.mv_size) )
+      {
+        fprintf(stderr, "lmdb: seal: missing event %" PRIu64 "\r\n",
+                        fir_d + i_w);
+        mdb_cursor_close(cur_u);
+        c3_free(len_w); c3_free(byt_y);
+        return c3n;
+      }
+
+      len_w[i_w] = val_u.mv_size;
+      byt_y[i_w] = val_u.mv_data;
+      raw_d     += val_u.mv_size;
+
+      ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_NEXT);
+    }
+
+    mdb_cursor_close(cur_u);
+
+    raw_y = c3_malloc(raw_d);
+
+    {
+      c3_y* cur_y = raw_y + (4 * num_w);
+
+      for ( i_w = 0; i_w < num_w; i_w++ ) {
+        _mdb_etch_w(raw_y + (4 * i_w), len_w[i_w]);
+        memcpy(cur_y, byt_y[i_w], len_w[i_w]);
+        byt_y[i_w] = cur_y;
+        cur_y += len_w[i_w];
+      }
+    }
+  }
+
+  //  find (or train) the dictionary
+  //
+  {
+    MDB_cursor* cur_u;
+    MDB_val     key_u, val_u;
+    c3_d        old_d = 0;
+
+    if ( (ret_w = mdb_cursor_open(txn_u, ctx_u->dic_u, &cur_u)) ) {
+      mdb_logerror(stderr, ret_w, "lmdb: seal: cursor_open fail");
+      c3_free(raw_y); c3_free(len_w); c3_free(byt_y);
+      return c3n;
+    }
+
+    if (  !mdb_cursor_get(cur_u, &key_u, &val_u, MDB_LAST)
+       && (8 < val_u.mv_size) )
+    {
+      dic_d = *(c3_d*)key_u.mv_data;
+      old_d = _mdb_sift_d(val_u.mv_data);
+      dic_y = (c3_y*)val_u.mv_data + 8;
+      dic_i = val_u.mv_size - 8;
+    }
+
+    mdb_cursor_close(cur_u);
+
+    if (  !dic_d
+       || ((fir_d - old_d) >= ((c3_d)_mdb_dic_age * _mdb_seg_len)) )
+    {
+      size_t new_i;
+
+      if ( (new_y = _mdb_dict_train(num_w, byt_y, len_w, &new_i)) ) {
+        c3_y*   dat_y = c3_malloc(8 + new_i);
+        c3_d    key_d = dic_d + 1;
+        MDB_val key_u = { .mv_size = sizeof(c3_d), .mv_data = &key_d };
+        MDB_val val_u = { .mv_size = 8 + new_i,    .mv_data = dat_y };
+
+        _mdb_etch_d(dat_y, fir_d);
+        memcpy(dat_y + 8, new_y, new_i);
+
+        ret_w = mdb_put(txn_u, ctx_u->dic_u, &key_u, &val_u, MDB_APPEND);
+        c3_free(dat_y);
+
+        if ( ret_w ) {
+          mdb_logerror(stderr, ret_w, "lmdb: seal: dictionary save fail");
+          c3_free(new_y); c3_free(raw_y); c3_free(len_w); c3_free(byt_y);
+          return c3n;
+        }
+
+        dic_d = key_d;
+        dic_y = new_y;
+        dic_i = new_i;
+        new_d = val_u.mv_size;
+      }
+    }
+  }
+
+  c3_free(len_w);
+  c3_free(byt_y);
+
+  //  compress, falling back to storing the segment as-is
+  //
+  {
+    z_stream zip_u;
+    c3_d     max_d;
+    c3_o     zip_o = c3n;
+
+    memset(&zip_u, 0, sizeof(zip_u));
+
+    if (  (0xffffffff >= raw_d)
+       && (Z_OK == deflateInit(&zip_u, Z_DEFAULT_COMPRESSION)) )
+    {
+      max_d = deflateBound(&zip_u, raw_d);
+      seg_y = c3_malloc(_mdb_seg_hed + max_d);
+
+      if ( dic_i ) {
+        deflateSetDictionary(&zip_u, dic_y, dic_i);
+      }
+
+      zip_u.next_in   = raw_y;
+      zip_u.avail_in  = raw_d;
+      zip_u.next_out  = seg_y + _mdb_seg_hed;
+      zip_u.avail_out = max_d;
+
+      if (  (Z_STREAM_END == deflate(&zip_u, Z_FINISH))
+         && (zip_u.total_out < raw_d) )
+      {
+        zip_o = c3y;
+        seg_d = _mdb_seg_hed + zip_u.total_out;
+      }
+      else {
+        c3_free(seg_y);
+      }
+
+      deflateEnd(&zip_u);
+    }
+
+    if ( c3y == zip_o ) {
+      seg_y[0] = 1;
+      _mdb_etch_d(seg_y + 1, dic_i ? dic_d : 0);
+    }
+    else {
+      seg_d = _mdb_seg_hed + raw_d;
+      seg_y = c3_malloc(seg_d);
+      memcpy(seg_y + _mdb_seg_hed, raw_y, raw_d);
+      seg_y[0] = 0;
+      _mdb_etch_d(seg_y + 1, 0);
+    }
+
+    _mdb_etch_w(seg_y + 9, num_w);
+    _mdb_etch_d(seg_y + 13, raw_d);
+  }
+
+  c3_free(new_y);
+  c3_free(raw_y);
+
+  //  replace events with the segment
+  //
+  {
+    c3_d    key_d = fir_d;
+    MDB_val key_u = { .mv_size = sizeof(c3_d), .mv_data = &key_d };
+    MDB_val val_u = { .mv_size = seg_d,        .mv_data = seg_y };
+
+    ret_w = mdb_put(txn_u, ctx_u->seg_u, &key_u, &val_u, MDB_APPEND);
+    c3_free(seg_y);
+
+    if ( ret_w ) {
+      mdb_logerror(stderr, ret_w, "lmdb: seal: segment save fail");
+      return c3n;
+    }
+
+    for ( i_w = 0; i_w < num_w; i_w++ ) {
+      key_d = fir_d + i_w;
+
+      if ( (ret_w = mdb_del(txn_u, ctx_u->eve_u, &key_u, 0)) ) {
+        mdb_logerror(stderr, ret_w, "lmdb: seal: event delete fail");
+        return c3n;
+      }
+    }
+  }
+
+  //  update compression stats, counting any new dictionary as packed
+  //
+  {
+    MDB_val key_u = { .mv_size = 4, .mv_data = "pack" };
+    MDB_val val_u;
+    c3_y    sat_y[24] = {0};
+
+    if (  !mdb_get(txn_u, ctx_u->met_u, &key_u, &val_u)
+       && (sizeof(sat_y) == val_u.mv_size) )
+    {
+      memcpy(sat_y, val_u.mv_data, sizeof(sat_y));
+    }
+
+    _mdb_etch_d(sat_y,      _mdb_sift_d(sat_y)      + 1);
+    _mdb_etch_d(sat_y + 8,  _mdb_sift_d(sat_y + 8)  + raw_d);
+    _mdb_etch_d(sat_y + 16, _mdb_sift_d(sat_y + 16) + seg_d + new_d);
+
+    val_u.mv_size = sizeof(sat_y);
+    val_u.mv_data = sat_y;
+
+    if ( (ret_w = mdb_put(txn_u, ctx_u->met_u, &key_u, &val_u, 0)) ) {
+      mdb_logerror(stderr, ret_w, "lmdb: seal: stats save fail");
+      return c3n;
+    }
+  }
+
+  return c3y;
+}
+
+/* _mdb_pack(): seal every complete segment in EVENTS.
+*/
+static c3_o
+_mdb_pack(MDB_txn* txn_u, struct _mdb_ctx* ctx_u)
+{
+  MDB_val val_u;
+  c3_d    fir_d, las_d, end_d;
+  c3_w    ret_w;
+
+  if ( (ret_w = _mdb_ends(txn_u, ctx_u->eve_u, &fir_d, &las_d, &val_u)) ) {
+    if ( MDB_NOTFOUND == ret_w ) {
+      return c3y;
+    }
+
+    mdb_logerror(stderr, ret_w, "lmdb: pack: fail");
+    return c3n;
+  }
+
+  while ( (end_d = (((fir_d - 1) / _mdb_seg_len) + 1) * _mdb_seg_len)
+          <= las_d )
+  {
+    if ( c3n == _mdb_seal(txn_u, ctx_u, fir_d, (end_d - fir_d) + 1) ) {
+      return c3n;
+    }
+
+    fir_d = end_d + 1;
+  }
+
+  return c3y;
+}
+
+/* _mdb_unseal(): decompress segment [val_u], producing its payload.
+*/
+static c3_y*
+_mdb_unseal(MDB_txn* txn_u, struct _mdb_ctx* ctx_u, MDB_val* val_u)
+{
+  c3_y  cod_y;
+  c3_d  dic_d, raw_d;
+  c3_w  num_w;
+  c3_y* raw_y;
+
+  if ( c3n == _mdb_seg_head(val_u, &cod_y, &dic_d, &num_w, &raw_d) ) {
+    fprintf(stderr, "lmdb: unseal: bad segment\r\n");
+    return 0;
+  }
+
+  raw_y = c3_malloc(raw_d);
+
+  if ( 0 == cod_y ) {
+    if ( (val_u->mv_size - _mdb_seg_hed) != raw_d ) {
+      fprintf(stderr, "lmdb: unseal: bad segment length\r\n");
+      c3_free(raw_y);
+      return 0;
+    }
+
+    memcpy(raw_y, (c3_y*)val_u->mv_data + _mdb_seg_hed, raw_d);
+  }
+  else {
+    z_stream zip_u;
+    c3_i     ret_i;
+
+    memset(&zip_u, 0, sizeof(zip_u));
+
+    if ( Z_OK != inflateInit(&zip_u) ) {
+      fprintf(stderr, "lmdb: unseal: inflate init fail\r\n");
+      c3_free(raw_y);
+      return 0;
+    }
+
+    zip_u.next_in   = (c3_y*)val_u->mv_data + _mdb_seg_hed;
+    zip_u.avail_in  = val_u->mv_size - _mdb_seg_hed;
+    zip_u.next_out  = raw_y;
+    zip_u.avail_out = raw_d;
+
+    ret_i = inflate(&zip_u, Z_FINISH);
+
+    if ( (Z_NEED_DICT == ret_i) && dic_d ) {
+      MDB_val key_u = { .mv_size = sizeof(c3_d), .mv_data = &dic_d };
+      MDB_val dic_u;
+
+      if (  !mdb_get(txn_u, ctx_u->dic_u, &key_u, &dic_u)
+         && (8 < dic_u.mv_size)
+         && (Z_OK == inflateSetDictionary(&zip_u,
+                                          (c3_y*)dic_u.mv_data + 8,
+                                          dic_u.mv_size - 8)) )
+      {
+        ret_i = inflate(&zip_u, Z_FINISH);
+      }
+    }
+
+    inflateEnd(&zip_u);
+
+    if ( (Z_STREAM_END != ret_i) || (zip_u.total_out != raw_d) ) {
+      fprintf(stderr, "lmdb: unseal: inflate fail (%d)\r\n", ret_i);
+      c3_free(raw_y);
+      return 0;
+    }
+  }
+
+  //  validate event lengths
+  //
+  {
+    c3_d tot_d = 4ULL * num_w;
+    c3_w i_w;
+
+    for ( i_w = 0; (i_w < num_w) && (tot_d <= raw_d); i_w++ ) {
+      tot_d += _mdb_sift_w(raw_y + (4 * i_w));
+    }
+
+    if ( tot_d != raw_d ) {
+      fprintf(stderr, "lmdb: unseal: bad segment contents\r\n");
+      c3_free(raw_y);
+      return 0;
+    }
+  }
+
+  return raw_y;
+}
+
+/* _mdb_read_sealed(): read events from segments, advancing [eve_d].
+*/
+static c3_o
+_mdb_read_sealed(MDB_txn*         txn_u,
+                 struct _mdb_ctx* ctx_u,
+                 void*            ptr_v,
+                 c3_d*            eve_d,
+                 c3_d*            len_d,
+                 c3_o           (*read_f)(void*, c3_d, size_t, void*))
+{
+  MDB_cursor* cur_u;
+  c3_d        cur_d = *eve_d;
+  MDB_val     key_u = { .mv_size = sizeof(c3_d), .mv_data = &cur_d };
+  MDB_val     val_u;
+  c3_o        ret_o = c3y;
+  c3_w        ret_w;
+
+  if ( (ret_w = mdb_cursor_open(txn_u, ctx_u->seg_u, &cur_u)) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: read: cursor_open fail");
+    return c3n;
+  }
+
+  //  seek the last segment starting at or before [cur_d]
+  //
+  ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_SET_RANGE);
+
+  if ( MDB_NOTFOUND == ret_w ) {
+    ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_LAST);
+  }
+  else if ( !ret_w && (*(c3_d*)key_u.mv_data > cur_d) ) {
+    ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_PREV);
+  }
+
+  while ( !ret_w && *len_d ) {
+    c3_d  key_d = *(c3_d*)key_u.mv_data;
+    c3_y  cod_y;
+    c3_d  dic_d, raw_d;
+    c3_w  num_w;
+    c3_y* raw_y;
+
+    if ( c3n == _mdb_seg_head(&val_u, &cod_y, &dic_d, &num_w, &raw_d) ) {
+      fprintf(stderr, "lmdb: read: bad segment %" PRIu64 "\r\n", key_d);
+      ret_o = c3n;
+      break;
+    }
+
+    //  past the sealed events
+    //
+    if ( (key_d > cur_d) || ((key_d + num_w) <= cur_d) ) {
+      break;
+    }
+
+    if ( !(raw_y = _mdb_unseal(txn_u, ctx_u, &val_u)) ) {
+      ret_o = c3n;
+      break;
+    }
+
+    {
+      c3_w  i_w;
+      c3_y* dat_y = raw_y + (4 * num_w);
+
+      for ( i_w = 0; i_w < (cur_d - key_d); i_w++ ) {
+        dat_y += _mdb_sift_w(raw_y + (4 * i_w));
+      }
+
+      for ( ; (i_w < num_w) && *len_d; i_w++ ) {
+        c3_w siz_w = _mdb_sift_w(raw_y + (4 * i_w));
+
+        if ( c3n == read_f(ptr_v, cur_d, siz_w, dat_y) ) {
+          ret_o = c3n;
+          break;
+        }
+
+        dat_y += siz_w;
+        cur_d++;
+        (*len_d)--;
+      }
+    }
+
+    c3_free(raw_y);
+
+    if ( c3n == ret_o ) {
+      break;
+    }
+
+    ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_NEXT);
+  }
+
+  if ( ret_w && (MDB_NOTFOUND != ret_w) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: read: segment error");
+    ret_o = c3n;
+  }
+
+  mdb_cursor_close(cur_u);
+  *eve_d = cur_d;
+  return ret_o;
 }
 
-/* u3_lmdb_exit(): close lmdb.
+/* u3_lmdb_pack_info(): read segment compression stats; [zip_d] counts
+**                      both segments and their dictionaries.
 */
-void
-u3_lmdb_exit(MDB_env* env_u)
+c3_o
+u3_lmdb_pack_info(MDB_env* env_u, c3_d* seg_d, c3_d* raw_d, c3_d* zip_d)
 {
-  mdb_env_close(env_u);
+  MDB_txn* txn_u;
+  MDB_val  key_u = { .mv_size = 4, .mv_data = "pack" };
+  MDB_val  val_u;
+  c3_w     ret_w;
+
+  *seg_d = *raw_d = *zip_d = 0;
+
+  if ( (ret_w = mdb_txn_begin(env_u, 0, MDB_RDONLY, &txn_u)) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: pack info: txn_begin fail");
+    return c3n;
+  }
+
+  if (  !mdb_get(txn_u, _mdb_ctx(env_u)->met_u, &key_u, &val_u)
+     && (24 == val_u.mv_size) )
+  {
+    *seg_d = _mdb_sift_d(val_u.mv_data);
+    *raw_d = _mdb_sift_d((c3_y*)val_u.mv_data + 8);
+    *zip_d = _mdb_sift_d((c3_y*)val_u.mv_data + 16);
+  }
+
+  mdb_txn_abort(txn_u);
+  return c3y;
 }
 
 /* u3_lmdb_stat(): print env stats.
@@ -136,93 +961,365 @@ u3_lmdb_stat(MDB_env* env_u, FILE* fil_u)
 c3_o
 u3_lmdb_gulf(MDB_env* env_u, c3_d* low_d, c3_d* hig_d)
 {
-  MDB_txn* txn_u;
-  MDB_dbi  mdb_u;
-  c3_w     ret_w;
+  struct _mdb_ctx* ctx_u = _mdb_ctx(env_u);
+  MDB_txn*         txn_u;
+  MDB_val          val_u;
+  c3_d             fir_d, las_d;
+  c3_w             ret_w;
+
+  *low_d = *hig_d = 0;
 
   //  create a read-only transaction.
   //
-  //    XX why no MDB_RDONLY?
-  //
-  if ( (ret_w = mdb_txn_begin(env_u, 0, 0, &txn_u)) ) {
+  if ( (ret_w = mdb_txn_begin(env_u, 0, MDB_RDONLY, &txn_u)) ) {
     mdb_logerror(stderr, ret_w, "lmdb: gulf: txn_begin fail");
     return c3n;
   }
 
-  //  open the database in the transaction
+  //  sealed events come first, ending with the last segment
+  //
+  if ( !(ret_w = _mdb_ends(txn_u, ctx_u->seg_u, &fir_d, &las_d, &val_u)) ) {
+    c3_y cod_y;
+    c3_d dic_d, raw_d;
+    c3_w num_w;
+
+    if ( c3n == _mdb_seg_head(&val_u, &cod_y, &dic_d, &num_w, &raw_d) ) {
+      fprintf(stderr, "lmdb: gulf: bad segment %" PRIu64 "\r\n", las_d);
+      mdb_txn_abort(txn_u);
+      return c3n;
+    }
+
+    *low_d = fir_d;
+    *hig_d = las_d + (num_w - 1);
+  }
+  else if ( MDB_NOTFOUND != ret_w ) {
+    mdb_logerror(stderr, ret_w, "lmdb: gulf: segment fail");
+    mdb_txn_abort(txn_u);
+    return c3n;
+  }
+
+  //  followed by any unsealed events
   //
+  if ( !(ret_w = _mdb_ends(txn_u, ctx_u->eve_u, &fir_d, &las_d, &val_u)) ) {
+    if ( !*low_d ) {
+      *low_d = fir_d;
+    }
+
+    *hig_d = las_d;
+  }
+  else if ( MDB_NOTFOUND != ret_w ) {
+    mdb_logerror(stderr, ret_w, "lmdb: gulf: event fail");
+    mdb_txn_abort(txn_u);
+    return c3n;
+  }
+
+  mdb_txn_abort(txn_u);
+  return c3y;
+}
+
+/* u3_lmdb_epoch(): read the snapshot the log was last chopped behind.
+*/
+c3_o
+u3_lmdb_epoch(MDB_env* env_u, c3_d* epo_d)
+{
+  MDB_txn* txn_u;
+  MDB_val  key_u = { .mv_size = 5, .mv_data = "epoch" };
+  MDB_val  val_u;
+  c3_w     ret_w;
+
+  *epo_d = 0;
+
+  if ( (ret_w = mdb_txn_begin(env_u, 0, MDB_RDONLY, &txn_u)) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: epoch: txn_begin fail");
+    return c3n;
+  }
+
+  if (  !mdb_get(txn_u, _mdb_ctx(env_u)->met_u, &key_u, &val_u)
+     && (8 == val_u.mv_size) )
   {
-    c3_w ops_w = MDB_CREATE | MDB_INTEGERKEY;
+    *epo_d = _mdb_sift_d(val_u.mv_data);
+  }
 
-    if ( (ret_w = mdb_dbi_open(txn_u, "EVENTS", ops_w, &mdb_u)) ) {
-      mdb_logerror(stderr, ret_w, "lmdb: gulf: dbi_open fail");
-      //  XX confirm
-      //
+  mdb_txn_abort(txn_u);
+  return c3y;
+}
+
+/* u3_lmdb_cut(): find the first event that must be kept to read [eve_d].
+**
+**   events are deleted in whole segments, so this is either [eve_d],
+**   or the first event of the segment that contains it.
+*/
+c3_o
+u3_lmdb_cut(MDB_env* env_u, c3_d eve_d, c3_d* cut_d)
+{
+  struct _mdb_ctx* ctx_u = _mdb_ctx(env_u);
+  MDB_txn*         txn_u;
+  MDB_cursor*      cur_u;
+  c3_d             key_d = eve_d;
+  MDB_val          key_u = { .mv_size = sizeof(c3_d), .mv_data = &key_d };
+  MDB_val          val_u;
+  c3_w             ret_w;
+
+  *cut_d = eve_d;
+
+  if ( (ret_w = mdb_txn_begin(env_u, 0, MDB_RDONLY, &txn_u)) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: cut: txn_begin fail");
+    return c3n;
+  }
+
+  if ( (ret_w = mdb_cursor_open(txn_u, ctx_u->seg_u, &cur_u)) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: cut: cursor_open fail");
+    mdb_txn_abort(txn_u);
+    return c3n;
+  }
+
+  //  seek the last segment starting at or before [eve_d]
+  //
+  ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_SET_RANGE);
+
+  if ( MDB_NOTFOUND == ret_w ) {
+    ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_LAST);
+  }
+  else if ( !ret_w && (*(c3_d*)key_u.mv_data > eve_d) ) {
+    ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_PREV);
+  }
+
+  if ( !ret_w ) {
+    c3_d fir_d = *(c3_d*)key_u.mv_data;
+    c3_y cod_y;
+    c3_d dic_d, raw_d;
+    c3_w num_w;
+
+    if ( c3n == _mdb_seg_head(&val_u, &cod_y, &dic_d, &num_w, &raw_d) ) {
+      fprintf(stderr, "lmdb: cut: bad segment %" PRIu64 "\r\n", fir_d);
+      mdb_cursor_close(cur_u);
       mdb_txn_abort(txn_u);
       return c3n;
     }
+
+    if ( (fir_d <= eve_d) && (eve_d < (fir_d + num_w)) ) {
+      *cut_d = fir_d;
+    }
+  }
+  else if ( MDB_NOTFOUND != ret_w ) {
+    mdb_logerror(stderr, ret_w, "lmdb: cut: segment error");
+    mdb_cursor_close(cur_u);
+    mdb_txn_abort(txn_u);
+    return c3n;
+  }
+
+  mdb_cursor_close(cur_u);
+  mdb_txn_abort(txn_u);
+  return c3y;
+}
+
+/* _mdb_chop_dbi(): delete every integer key in [mdb_u] below [cut_d].
+*/
+static c3_o
+_mdb_chop_dbi(MDB_txn* txn_u,
+              MDB_dbi  mdb_u,
+              c3_d     cut_d,
+              void*    ptr_v,
+              void   (*del_f)(void*, MDB_val*))
+{
+  MDB_cursor* cur_u;
+  MDB_val     key_u, val_u;
+  c3_w        ret_w;
+
+  if ( (ret_w = mdb_cursor_open(txn_u, mdb_u, &cur_u)) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: chop: cursor_open fail");
+    return c3n;
+  }
+
+  while (  !(ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_FIRST))
+        && (*(c3_d*)key_u.mv_data < cut_d) )
+  {
+    if ( del_f ) {
+      del_f(ptr_v, &val_u);
+    }
+
+    if ( (ret_w = mdb_cursor_del(cur_u, 0)) ) {
+      break;
+    }
+  }
+
+  mdb_cursor_close(cur_u);
+
+  if ( ret_w && (MDB_NOTFOUND != ret_w) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: chop: delete fail");
+    return c3n;
+  }
+
+  return c3y;
+}
+
+/* _mdb_chop_stat(): subtract a deleted segment from compression stats.
+*/
+static void
+_mdb_chop_stat(void* ptr_v, MDB_val* val_u)
+{
+  c3_d* sat_d = ptr_v;
+  c3_y  cod_y;
+  c3_d  dic_d, raw_d;
+  c3_w  num_w;
+
+  if ( c3y == _mdb_seg_head(val_u, &cod_y, &dic_d, &num_w, &raw_d) ) {
+    sat_d[0] += 1;
+    sat_d[1] += raw_d;
+    sat_d[2] += val_u->mv_size;
+  }
+}
+
+/* _mdb_chop_dict_stat(): subtract a deleted dictionary from compression stats.
+*/
+static void
+_mdb_chop_dict_stat(void* ptr_v, MDB_val* val_u)
+{
+  c3_d* sat_d = ptr_v;
+
+  sat_d[2] += val_u->mv_size;
+}
+
+/* u3_lmdb_chop(): delete events before [cut_d], starting an epoch at [epo_d].
+**
+**   [cut_d] must come from u3_lmdb_cut(), so that no segment is split.
+*/
+c3_o
+u3_lmdb_chop(MDB_env* env_u, c3_d cut_d, c3_d epo_d)
+{
+  struct _mdb_ctx* ctx_u = _mdb_ctx(env_u);
+  MDB_txn*         txn_u;
+  c3_d             sat_d[3] = {0};
+  c3_w             ret_w;
+
+  if ( (ret_w = mdb_txn_begin(env_u, 0, 0, &txn_u)) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: chop: txn_begin fail");
+    return c3n;
+  }
+
+  if (  (c3n == _mdb_chop_dbi(txn_u, ctx_u->seg_u, cut_d, sat_d, _mdb_chop_stat))
+     || (c3n == _mdb_chop_dbi(txn_u, ctx_u->eve_u, cut_d, 0, 0)) )
+  {
+    mdb_txn_abort(txn_u);
+    return c3n;
   }
 
+  //  delete dictionaries no longer referenced by any segment
+  //
+  //    everything below the least id used by a remaining segment can go
+  //    -- except the latest, which future segments may yet use. segments
+  //    stored without a dictionary (id 0) say nothing, so all must be
+  //    scanned, not just the first.
+  //
   {
     MDB_cursor* cur_u;
-    MDB_val     key_u;
-    MDB_val     val_u;
-    c3_d        fir_d, las_d;
+    MDB_val     key_u, val_u;
+    c3_d        dic_d = 0;
 
-    //  creates a cursor to point to the last event
-    //
-    if ( (ret_w = mdb_cursor_open(txn_u, mdb_u, &cur_u)) ) {
-      mdb_logerror(stderr, ret_w, "lmdb: gulf: cursor_open fail");
-      //  XX confirm
-      //
+    if ( (ret_w = mdb_cursor_open(txn_u, ctx_u->dic_u, &cur_u)) ) {
+      mdb_logerror(stderr, ret_w, "lmdb: chop: cursor_open fail");
       mdb_txn_abort(txn_u);
       return c3n;
     }
 
-    //  read with the cursor from the start of the database
-    //
-    ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_FIRST);
+    if ( !mdb_cursor_get(cur_u, &key_u, &val_u, MDB_LAST) ) {
+      dic_d = *(c3_d*)key_u.mv_data;
+    }
 
-    if ( MDB_NOTFOUND == ret_w ) {
-      *low_d = 0;
-      *hig_d = 0;
-      mdb_cursor_close(cur_u);
+    mdb_cursor_close(cur_u);
+
+    if ( (ret_w = mdb_cursor_open(txn_u, ctx_u->seg_u, &cur_u)) ) {
+      mdb_logerror(stderr, ret_w, "lmdb: chop: cursor_open fail");
       mdb_txn_abort(txn_u);
-      return c3y;
+      return c3n;
     }
-    else if ( ret_w ) {
-      mdb_logerror(stderr, ret_w, "lmdb: gulf: head fail");
-      mdb_cursor_close(cur_u);
+
+    ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_FIRST);
+
+    while ( !ret_w ) {
+      c3_y cod_y;
+      c3_d seg_d, raw_d;
+      c3_w num_w;
+
+      if (  (c3y == _mdb_seg_head(&val_u, &cod_y, &seg_d, &num_w, &raw_d))
+         && seg_d
+         && (seg_d < dic_d) )
+      {
+        dic_d = seg_d;
+      }
+
+      ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_NEXT);
+    }
+
+    mdb_cursor_close(cur_u);
+
+    if ( MDB_NOTFOUND != ret_w ) {
+      mdb_logerror(stderr, ret_w, "lmdb: chop: segment error");
       mdb_txn_abort(txn_u);
       return c3n;
     }
-    else {
-      fir_d = *(c3_d*)key_u.mv_data;
+
+    if ( c3n == _mdb_chop_dbi(txn_u, ctx_u->dic_u, dic_d,
+                              sat_d, _mdb_chop_dict_stat) )
+    {
+      mdb_txn_abort(txn_u);
+      return c3n;
     }
+  }
 
-    //  read with the cursor from the end of the database
-    //
-    ret_w = mdb_cursor_get(cur_u, &key_u, &val_u, MDB_LAST);
+  //  update compression stats
+  //
+  if ( sat_d[0] || sat_d[2] ) {
+    MDB_val key_u = { .mv_size = 4, .mv_data = "pack" };
+    MDB_val val_u;
+    c3_y    sat_y[24] = {0};
+    c3_w    i_w;
 
-    if ( !ret_w ) {
-      las_d = *(c3_d*)key_u.mv_data;
+    if (  !mdb_get(txn_u, ctx_u->met_u, &key_u, &val_u)
+       && (sizeof(sat_y) == val_u.mv_size) )
+    {
+      memcpy(sat_y, val_u.mv_data, sizeof(sat_y));
     }
 
-    //  clean up unconditionally, we're done
-    //
-    mdb_cursor_close(cur_u);
-    mdb_txn_abort(txn_u);
+    for ( i_w = 0; i_w < 3; i_w++ ) {
+      c3_d old_d = _mdb_sift_d(sat_y + (8 * i_w));
+      _mdb_etch_d(sat_y + (8 * i_w), ( old_d > sat_d[i_w] )
+                                     ? (old_d - sat_d[i_w])
+                                     : 0);
+    }
 
-    if ( ret_w ) {
-      mdb_logerror(stderr, ret_w, "lmdb: gulf: last fail");
+    val_u.mv_size = sizeof(sat_y);
+    val_u.mv_data = sat_y;
+
+    if ( (ret_w = mdb_put(txn_u, ctx_u->met_u, &key_u, &val_u, 0)) ) {
+      mdb_logerror(stderr, ret_w, "lmdb: chop: stats save fail");
+      mdb_txn_abort(txn_u);
       return c3n;
     }
-    else {
-      *low_d = fir_d;
-      *hig_d = las_d;
-      return c3y;
+  }
+
+  //  record the epoch
+  //
+  {
+    c3_y    epo_y[8];
+    MDB_val key_u = { .mv_size = 5, .mv_data = "epoch" };
+    MDB_val val_u = { .mv_size = sizeof(epo_y), .mv_data = epo_y };
+
+    _mdb_etch_d(epo_y, epo_d);
+
+    if ( (ret_w = mdb_put(txn_u, ctx_u->met_u, &key_u, &val_u, 0)) ) {
+      mdb_logerror(stderr, ret_w, "lmdb: chop: epoch save fail");
+      mdb_txn_abort(txn_u);
+      return c3n;
     }
   }
+
+  if ( (ret_w = mdb_txn_commit(txn_u)) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: chop: commit fail");
+    return c3n;
+  }
+
+  return c3y;
 }
 
 /* u3_lmdb_read(): read [len_d] events starting at [eve_d].
@@ -234,9 +1331,10 @@ u3_lmdb_read(MDB_env* env_u,
              c3_d     len_d,
              c3_o   (*read_f)(void*, c3_d, size_t, void*))
 {
-  MDB_txn* txn_u;
-  MDB_dbi  mdb_u;
-  c3_w     ret_w;
+  struct _mdb_ctx* ctx_u = _mdb_ctx(env_u);
+  MDB_txn*         txn_u;
+  MDB_dbi          mdb_u = ctx_u->eve_u;
+  c3_w             ret_w;
 
   //  create a read-only transaction.
   //
@@ -245,20 +1343,16 @@ u3_lmdb_read(MDB_env* env_u,
     return c3n;
   }
 
-  //  open the database in the transaction
+  //  read any sealed events, then the rest from EVENTS
   //
-  {
-    c3_w ops_w = MDB_CREATE | MDB_INTEGERKEY;
-
-    if ( (ret_w = mdb_dbi_open(txn_u, "EVENTS", ops_w, &mdb_u)) ) {
-      mdb_logerror(stderr, ret_w, "lmdb: read: dbi_open fail");
-      //  XX confirm
-      //
-      mdb_txn_abort(txn_u);
-      return c3n;
-    }
+  if ( c3n == _mdb_read_sealed(txn_u, ctx_u, ptr_v, &eve_d, &len_d, read_f) ) {
+    mdb_txn_abort(txn_u);
+    return c3n;
+  }
+  else if ( !len_d ) {
+    mdb_txn_abort(txn_u);
+    return c3y;
   }
-
 
   {
     MDB_cursor* cur_u;
@@ -351,9 +1445,10 @@ u3_lmdb_save(MDB_env* env_u,
              void**   byt_p,               //  array of bytes
              size_t*  siz_i)               //  array of lengths
 {
-  MDB_txn* txn_u;
-  MDB_dbi  mdb_u;
-  c3_w     ret_w;
+  struct _mdb_ctx* ctx_u = _mdb_ctx(env_u);
+  MDB_txn*         txn_u;
+  MDB_dbi          mdb_u = ctx_u->eve_u;
+  c3_w             ret_w;
 
   //  create a write transaction
   //
@@ -362,22 +1457,14 @@ u3_lmdb_save(MDB_env* env_u,
     return c3n;
   }
 
-  //  opens the database in the transaction
-  //
-  {
-    c3_w ops_w = MDB_CREATE | MDB_INTEGERKEY;
-
-    if ( (ret_w = mdb_dbi_open(txn_u, "EVENTS", ops_w, &mdb_u)) ) {
-      mdb_logerror(stderr, ret_w, "lmdb: write: dbi_open fail");
-      mdb_txn_abort(txn_u);
-      return c3n;
-    }
-  }
-
   //  write every event in the batch
   //
+  //    events are strictly sequential, so we append: lmdb skips
+  //    the tree search, and fails (as with MDB_NOOVERWRITE) if a
+  //    key is not past the end of the log.
+  //
   {
-    c3_w ops_w = MDB_NOOVERWRITE;
+    c3_w ops_w = MDB_APPEND;
     c3_d las_d = (eve_d + len_d);
     c3_d key_d, i_d;
 
@@ -397,6 +1484,15 @@ u3_lmdb_save(MDB_env* env_u,
     }
   }
 
+  //  seal any completed segments
+  //
+  if (  (c3y == ctx_u->pac_o)
+     && (c3n == _mdb_pack(txn_u, ctx_u)) )
+  {
+    mdb_txn_abort(txn_u);
+    return c3n;
+  }
+
   //  commit transaction
   //
   if ( (ret_w = mdb_txn_commit(txn_u)) ) {
@@ -416,7 +1512,7 @@ u3_lmdb_read_meta(MDB_env*    env_u,
                   void (*read_f)(void*, size_t, void*))
 {
   MDB_txn* txn_u;
-  MDB_dbi  mdb_u;
+  MDB_dbi  mdb_u = _mdb_ctx(env_u)->met_u;
   c3_w     ret_w;
 
   //  create a read transaction
@@ -426,14 +1522,6 @@ u3_lmdb_read_meta(MDB_env*    env_u,
     return read_f(ptr_v, 0, 0);
   }
 
-  //  open the database in the transaction
-  //
-  if ( (ret_w =  mdb_dbi_open(txn_u, "META", 0, &mdb_u)) ) {
-    mdb_logerror(stderr, ret_w, "lmdb: meta read: dbi_open fail");
-    mdb_txn_abort(txn_u);
-    return read_f(ptr_v, 0, 0);
-  }
-
   //  read by string key, invoking callback with result
   {
     MDB_val key_u = { .mv_size = strlen(key_c), .mv_data = (void*)key_c };
@@ -463,7 +1551,7 @@ u3_lmdb_save_meta(MDB_env*    env_u,
                   void*       val_p)
 {
   MDB_txn* txn_u;
-  MDB_dbi  mdb_u;
+  MDB_dbi  mdb_u = _mdb_ctx(env_u)->met_u;
   c3_w     ret_w;
 
   //  create a write transaction
@@ -473,14 +1561,6 @@ u3_lmdb_save_meta(MDB_env*    env_u,
     return c3n;
   }
 
-  //  opens the database in the transaction
-  //
-  if ( (ret_w = mdb_dbi_open(txn_u, "META", MDB_CREATE, &mdb_u)) ) {
-    mdb_logerror(stderr, ret_w, "lmdb: meta write: dbi_open fail");
-    mdb_txn_abort(txn_u);
-    return c3n;
-  }
-
   //  put value by string key
   //
   {
@@ -504,6 +1584,21 @@ u3_lmdb_save_meta(MDB_env*    env_u,
   return c3y;
 }
 
+/* u3_lmdb_copy(): write a compacted copy of the env into directory [pax_c].
+*/
+c3_o
+u3_lmdb_copy(MDB_env* env_u, const c3_c* pax_c)
+{
+  c3_w ret_w;
+
+  if ( (ret_w = mdb_env_copy2(env_u, pax_c, MDB_CP_COMPACT)) ) {
+    mdb_logerror(stderr, ret_w, "lmdb: copy fail");
+    return c3n;
+  }
+
+  return c3y;
+}
+
 #if !defined(U3_OS_mingw)
 /* mdb_logerror(): writes an error message and lmdb error code to f.
 */
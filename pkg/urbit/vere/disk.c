@@ -17,11 +17,20 @@ struct _cd_save {
   c3_o             ret_o;               //  result
   c3_d             eve_d;               //  first event
   c3_d             len_d;               //  number of events
+  c3_d             cap_d;               //  allocated length
+  c3_d             tim_d;               //  first planned at (loop ms)
   c3_y**           byt_y;               //  array of bytes
   size_t*          siz_i;               //  array of lengths
   struct _u3_disk* log_u;
 };
 
+//  event log format version
+//
+//    1: events in EVENTS, as mug and jam
+//    2: as 1, but sealed into compressed segments (see db/lmdb.c)
+//
+#define _disk_version 2
+
 #undef VERBOSE_DISK
 #undef DISK_TRACE_JAM
 #undef DISK_TRACE_CUE
@@ -54,6 +63,33 @@ _disk_commit_done(struct _cd_save* req_u)
   c3_o     ret_o = req_u->ret_o;
 
   if ( c3n == ret_o ) {
+    //  requeue the batch before reporting the failure, so that it is
+    //  retried ahead of any events planned since, or by the callback
+    //
+    {
+      struct _cd_save* nex_u = log_u->nex_u;
+
+      if ( nex_u ) {
+        c3_d tot_d = req_u->len_d + nex_u->len_d;
+
+        req_u->byt_y = c3_realloc(req_u->byt_y, tot_d * sizeof(c3_y*));
+        req_u->siz_i = c3_realloc(req_u->siz_i, tot_d * sizeof(size_t));
+        memcpy(req_u->byt_y + req_u->len_d,
+               nex_u->byt_y,
+               nex_u->len_d * sizeof(c3_y*));
+        memcpy(req_u->siz_i + req_u->len_d,
+               nex_u->siz_i,
+               nex_u->len_d * sizeof(size_t));
+        req_u->len_d = req_u->cap_d = tot_d;
+
+        c3_free(nex_u->byt_y);
+        c3_free(nex_u->siz_i);
+        c3_free(nex_u);
+      }
+
+      log_u->nex_u = req_u;
+    }
+
     log_u->cb_u.write_bail_f(log_u->cb_u.ptr_v, eve_d + (len_d - 1ULL));
 
 #ifdef VERBOSE_DISK
@@ -97,7 +133,9 @@ _disk_commit_done(struct _cd_save* req_u)
     log_u->put_u.ent_u = 0;
   }
 
-  _disk_free_save(req_u);
+  if ( c3y == ret_o ) {
+    _disk_free_save(req_u);
+  }
 
   _disk_commit(log_u);
 }
@@ -179,55 +217,65 @@ _disk_serialize_v1(u3_fact* tac_u, c3_y** out_y)
   }
 }
 
-/* _disk_batch(): create a write batch
+/* _disk_batch_push(): serialize a planned event into the next batch.
 */
-static struct _cd_save*
-_disk_batch(u3_disk* log_u, c3_d len_d)
+static void
+_disk_batch_push(u3_disk* log_u, u3_fact* tac_u)
 {
-  u3_fact* tac_u = log_u->put_u.ext_u;
-
-  c3_assert( (1ULL + log_u->dun_d) == tac_u->eve_d );
-  c3_assert( log_u->sen_d == log_u->put_u.ent_u->eve_d );
-
-  struct _cd_save* req_u = c3_malloc(sizeof(*req_u));
-  req_u->log_u = log_u;
-  req_u->ret_o = c3n;
-  req_u->eve_d = tac_u->eve_d;
-  req_u->len_d = len_d;
-  req_u->byt_y = c3_malloc(len_d * sizeof(c3_y*));
-  req_u->siz_i = c3_malloc(len_d * sizeof(size_t));
-
-  for ( c3_d i_d = 0ULL; i_d < len_d; ++i_d) {
-    c3_assert( (req_u->eve_d + i_d) == tac_u->eve_d );
-
-    req_u->siz_i[i_d] = _disk_serialize_v1(tac_u, &req_u->byt_y[i_d]);
-
-    tac_u = tac_u->nex_u;
+  struct _cd_save* req_u = log_u->nex_u;
+
+  if ( !req_u ) {
+    req_u = c3_malloc(sizeof(*req_u));
+    req_u->log_u = log_u;
+    req_u->ret_o = c3n;
+    req_u->eve_d = tac_u->eve_d;
+    req_u->len_d = 0;
+    req_u->cap_d = 16;
+    req_u->tim_d = uv_now(u3L);
+    req_u->byt_y = c3_malloc(req_u->cap_d * sizeof(c3_y*));
+    req_u->siz_i = c3_malloc(req_u->cap_d * sizeof(size_t));
+
+    log_u->nex_u = req_u;
   }
+  else if ( req_u->len_d == req_u->cap_d ) {
+    req_u->cap_d *= 2;
+    req_u->byt_y = c3_realloc(req_u->byt_y, req_u->cap_d * sizeof(c3_y*));
+    req_u->siz_i = c3_realloc(req_u->siz_i, req_u->cap_d * sizeof(size_t));
+  }
+
+  c3_assert( (req_u->eve_d + req_u->len_d) == tac_u->eve_d );
 
-  return req_u;
+  req_u->siz_i[req_u->len_d] =
+    _disk_serialize_v1(tac_u, &req_u->byt_y[req_u->len_d]);
+  req_u->len_d++;
 }
 
-/* _disk_commit(): commit all available events, if idle.
+/* _disk_commit_flush(): write the next batch now, if idle.
 */
 static void
-_disk_commit(u3_disk* log_u)
+_disk_commit_flush(u3_disk* log_u)
 {
-  if (  (c3n == log_u->ted_o)
-     && (log_u->sen_d > log_u->dun_d) )
-  {
-    c3_d len_d = log_u->sen_d - log_u->dun_d;
-    struct _cd_save* req_u = _disk_batch(log_u, len_d);
+  struct _cd_save* req_u = log_u->nex_u;
+
+  if ( (c3n == log_u->ted_o) && req_u ) {
+    log_u->nex_u = 0;
+
+    if ( log_u->tim_u ) {
+      uv_timer_stop(log_u->tim_u);
+    }
+
+    c3_assert( (1ULL + log_u->dun_d) == req_u->eve_d );
+    c3_assert( log_u->sen_d == (req_u->eve_d + req_u->len_d - 1ULL) );
 
 #ifdef VERBOSE_DISK
-    if ( 1ULL == len_d ) {
+    if ( 1ULL == req_u->len_d ) {
       fprintf(stderr, "disk: (%" PRIu64 "): commit: request\r\n",
                       req_u->eve_d);
     }
     else {
       fprintf(stderr, "disk: (%" PRIu64 "-%" PRIu64 "): commit: request\r\n",
                       req_u->eve_d,
-                      (req_u->eve_d + len_d - 1ULL));
+                      (req_u->eve_d + req_u->len_d - 1ULL));
     }
 #endif
 
@@ -235,6 +283,55 @@ _disk_commit(u3_disk* log_u)
   }
 }
 
+/* _disk_commit_timer_cb(): group commit latency target reached.
+*/
+static void
+_disk_commit_timer_cb(uv_timer_t* tim_u)
+{
+  _disk_commit_flush(tim_u->data);
+}
+
+/* _disk_commit(): commit planned events, if idle and due.
+**
+**   events are serialized as they're planned (in u3_disk_plan()),
+**   so the next batch is jammed while the last one is being written
+**   and synced. a batch is handed to the write thread once it holds
+**   [bat_w] events, or its first event has waited [wai_w] ms, or
+**   immediately if [wai_w] is 0.
+*/
+static void
+_disk_commit(u3_disk* log_u)
+{
+  struct _cd_save* req_u = log_u->nex_u;
+
+  if ( (c3y == log_u->ted_o) || !req_u ) {
+    return;
+  }
+
+  {
+    c3_d now_d = uv_now(u3L);
+    c3_d gap_d = ( now_d > req_u->tim_d ) ? (now_d - req_u->tim_d) : 0;
+
+    if (  (gap_d >= log_u->wai_w)
+       || (log_u->bat_w && (req_u->len_d >= log_u->bat_w)) )
+    {
+      _disk_commit_flush(log_u);
+    }
+    else {
+      if ( !log_u->tim_u ) {
+        log_u->tim_u = c3_malloc(sizeof(*log_u->tim_u));
+        uv_timer_init(u3L, log_u->tim_u);
+        log_u->tim_u->data = log_u;
+      }
+
+      if ( !uv_is_active((uv_handle_t*)log_u->tim_u) ) {
+        uv_timer_start(log_u->tim_u, _disk_commit_timer_cb,
+                       log_u->wai_w - gap_d, 0);
+      }
+    }
+  }
+}
+
 /* u3_disk_plan(): enqueue completed event for persistence.
 */
 void
@@ -252,6 +349,7 @@ u3_disk_plan(u3_disk* log_u, u3_fact* tac_u)
     log_u->put_u.ent_u = tac_u;
   }
 
+  _disk_batch_push(log_u, tac_u);
   _disk_commit(log_u);
 }
 
@@ -275,6 +373,8 @@ u3_disk_boot_plan(u3_disk* log_u, u3_noun job)
     log_u->put_u.ent_u = tac_u;
   }
 
+  _disk_batch_push(log_u, tac_u);
+
 #ifdef VERBOSE_DISK
   fprintf(stderr, "disk: (%" PRIu64 "): db boot plan\r\n", tac_u->eve_d);
 #endif
@@ -286,7 +386,7 @@ void
 u3_disk_boot_save(u3_disk* log_u)
 {
   c3_assert( !log_u->dun_d );
-  _disk_commit(log_u);
+  _disk_commit_flush(log_u);
 }
 
 static void
@@ -371,27 +471,17 @@ _disk_read_one_cb(void* ptr_v, c3_d eve_d, size_t val_i, void* val_p)
     return c3n;
   }
 
+  //  events are read for replay, so we keep the raw log entry;
+  //  it's framed as-is into the %play writ and cued by the serf
+  //
   {
-    u3_noun job;
     c3_y* dat_y = val_p;
     c3_l  mug_l = dat_y[0]
                 ^ (dat_y[1] <<  8)
                 ^ (dat_y[2] << 16)
                 ^ (dat_y[3] << 24);
 
-#ifdef DISK_TRACE_CUE
-    u3t_event_trace("king disk cue", 'B');
-#endif
-
-    //  XX u3m_soft?
-    //
-    job = u3ke_cue(u3i_bytes(val_i - 4, dat_y + 4));
-
-#ifdef DISK_TRACE_CUE
-    u3t_event_trace("king disk cue", 'E');
-#endif
-
-    tac_u = u3_fact_init(eve_d, mug_l, job);
+    tac_u = u3_fact_load(eve_d, mug_l, val_i, dat_y);
   }
 
   if ( !red_u->ent_u ) {
@@ -487,7 +577,7 @@ u3_disk_save_meta(u3_disk* log_u,
 {
   c3_assert( c3y == u3a_is_cat(lif_w) );
 
-  if (  (c3n == _disk_save_meta(log_u, "version", 1))
+  if (  (c3n == _disk_save_meta(log_u, "version", _disk_version))
      || (c3n == _disk_save_meta(log_u, "who", u3i_chubs(2, who_d)))
      || (c3n == _disk_save_meta(log_u, "fake", fak_o))
      || (c3n == _disk_save_meta(log_u, "life", lif_w)) )
@@ -495,6 +585,9 @@ u3_disk_save_meta(u3_disk* log_u,
     return c3n;
   }
 
+  log_u->ver_w = _disk_version;
+  u3_lmdb_pack(log_u->mdb_u, c3y);
+
   return c3y;
 }
 
@@ -550,7 +643,7 @@ u3_disk_read_meta(u3_disk* log_u,
   {
     c3_o val_o = c3y;
 
-    if ( 1 != ver ) {
+    if ( (1 != ver) && (2 != ver) ) {
       fprintf(stderr, "disk: read meta: unknown version %u\r\n", ver);
       val_o = c3n;
     }
@@ -569,6 +662,9 @@ u3_disk_read_meta(u3_disk* log_u,
     }
   }
 
+  log_u->ver_w = ver;
+  u3_lmdb_pack(log_u->mdb_u, __( 2 <= ver ));
+
   if ( who_d ) {
     u3r_chubs(0, 2, who_d, who);
   }
@@ -697,6 +793,13 @@ u3_disk_exit(u3_disk* log_u)
     }
   }
 
+  //  stop the group commit timer
+  //
+  if ( log_u->tim_u ) {
+    uv_close((uv_handle_t*)log_u->tim_u, (uv_close_cb)free);
+    log_u->tim_u = 0;
+  }
+
   //  try to cancel write thread
   //  shortcircuit cleanup if we cannot
   //
@@ -713,6 +816,9 @@ u3_disk_exit(u3_disk* log_u)
 
   //  dispose planned writes
   //
+  if ( log_u->nex_u ) {
+    _disk_free_save(log_u->nex_u);
+  }
 
   {
     u3_fact* tac_u = log_u->put_u.ext_u;
@@ -738,6 +844,49 @@ u3_disk_exit(u3_disk* log_u)
 #endif
 }
 
+/* _disk_chop_path(): archive path for events [fir_d, las_d], or the base.
+*/
+static c3_c*
+_disk_chop_path(u3_disk* log_u, c3_d fir_d, c3_d las_d)
+{
+  c3_c* pax_c = log_u->com_u->pax_c;
+  c3_w  len_w = strlen(pax_c) + 48;
+  c3_c* out_c = c3_malloc(len_w);
+
+  if ( !fir_d ) {
+    snprintf(out_c, len_w, "%s/chop", pax_c);
+  }
+  else {
+    snprintf(out_c, len_w, "%s/chop/%" PRIu64 "-%" PRIu64,
+                           pax_c, fir_d, las_d);
+  }
+
+  return out_c;
+}
+
+/* _disk_chop_slog(): print archived epochs.
+*/
+static void
+_disk_chop_slog(u3_disk* log_u)
+{
+  c3_c* pax_c = _disk_chop_path(log_u, 0, 0);
+  DIR*  rid_u = c3_opendir(pax_c);
+
+  if ( rid_u ) {
+    struct dirent* ent_u;
+
+    while ( (ent_u = readdir(rid_u)) ) {
+      if ( '.' != ent_u->d_name[0] ) {
+        u3l_log("    archive: events %s\n", ent_u->d_name);
+      }
+    }
+
+    closedir(rid_u);
+  }
+
+  c3_free(pax_c);
+}
+
 /* u3_disk_info(): status info as a (list mass).
 */
 u3_noun
@@ -748,8 +897,32 @@ u3_disk_info(u3_disk* log_u)
   u3_noun lit = u3i_list(
     u3_pier_mase("live",        log_u->liv_o),
     u3_pier_mase("event", u3i_chub(log_u->dun_d)),
+    u3_pier_mase("version", log_u->ver_w),
+    u3_pier_mase("first", u3i_chub(log_u->fir_d)),
+    u3_pier_mase("epoch", u3i_chub(log_u->epo_d)),
     u3_none);
 
+  {
+    c3_d seg_d, raw_d, zip_d;
+
+    if (  (c3y == u3_lmdb_pack_info(log_u->mdb_u, &seg_d, &raw_d, &zip_d))
+       && seg_d )
+    {
+      //  ratio as a percentage of the uncompressed size
+      //
+      lit = u3nc(
+        u3_pier_mass(
+          c3__pack,
+          u3i_list(
+            u3_pier_mase("segments", u3i_chub(seg_d)),
+            u3_pier_mase("raw-bytes", u3i_chub(raw_d)),
+            u3_pier_mase("zip-bytes", u3i_chub(zip_d)),
+            u3_pier_mase("zip-percent", u3i_chub((100 * zip_d) / raw_d)),
+            u3_none)),
+        lit);
+    }
+  }
+
   if ( log_u->put_u.ext_u ) {
     lit = u3nc(
       u3_pier_mass(
@@ -781,9 +954,30 @@ u3_disk_info(u3_disk* log_u)
 void
 u3_disk_slog(u3_disk* log_u)
 {
-  u3l_log("  disk: live=%s, event=%" PRIu64 "\n",
+  u3l_log("  disk: live=%s, event=%" PRIu64 ", version=%u\n",
           ( c3y == log_u->liv_o ) ? "&" : "|",
-          log_u->dun_d);
+          log_u->dun_d,
+          log_u->ver_w);
+
+  if ( log_u->epo_d ) {
+    u3l_log("    epoch: after snapshot %" PRIu64 ", first event %" PRIu64 "\n",
+            log_u->epo_d,
+            log_u->fir_d);
+  }
+
+  _disk_chop_slog(log_u);
+
+  {
+    c3_d seg_d, raw_d, zip_d;
+
+    if (  (c3y == u3_lmdb_pack_info(log_u->mdb_u, &seg_d, &raw_d, &zip_d))
+       && seg_d )
+    {
+      u3l_log("    pack: %" PRIu64 " segments, %" PRIu64 " -> %" PRIu64
+              " bytes (%.2fx)\n",
+              seg_d, raw_d, zip_d, (double)raw_d / (double)zip_d);
+    }
+  }
 
   {
     u3_read* red_u = log_u->red_u;
@@ -808,6 +1002,281 @@ u3_disk_slog(u3_disk* log_u)
   }
 }
 
+/* _disk_map_size(): lmdb mapsize.
+*/
+static size_t
+_disk_map_size(void)
+{
+  //  Arbitrarily choosing 1TB as a "large enough" mapsize
+  //
+  //  per the LMDB docs:
+  //  "[..] on 64-bit there is no penalty for making this huge (say 1TB)."
+  //
+  return
+  #if defined(U3_OS_mingw)
+    0xf00000000;
+  // 500 GiB is as large as musl on aarch64 wants to allow
+  #elif (defined(U3_CPU_aarch64) && defined(U3_OS_linux))
+    0x7d00000000;
+  #else
+    0x10000000000;
+  #endif
+}
+
+/* _cd_chop: events copied into an archive.
+*/
+struct _cd_chop {
+  c3_d    len_d;                        //  events read
+  c3_y**  byt_y;                        //  array of bytes
+  size_t* siz_i;                        //  array of lengths
+};
+
+/* _disk_chop_read_cb(): copy an event to be archived.
+*/
+static c3_o
+_disk_chop_read_cb(void* ptr_v, c3_d eve_d, size_t val_i, void* val_p)
+{
+  struct _cd_chop* cop_u = ptr_v;
+
+  cop_u->byt_y[cop_u->len_d] = c3_malloc(val_i);
+  cop_u->siz_i[cop_u->len_d] = val_i;
+  memcpy(cop_u->byt_y[cop_u->len_d], val_p, val_i);
+  cop_u->len_d++;
+
+  return c3y;
+}
+
+/* _disk_chop_mug_cb(): read the mug of a logged event.
+*/
+static c3_o
+_disk_chop_mug_cb(void* ptr_v, c3_d eve_d, size_t val_i, void* val_p)
+{
+  c3_l* mug_l = ptr_v;
+  c3_y* dat_y = val_p;
+
+  if ( 4 >= val_i ) {
+    return c3n;
+  }
+
+  *mug_l = dat_y[0]
+         ^ (dat_y[1] <<  8)
+         ^ (dat_y[2] << 16)
+         ^ (dat_y[3] << 24);
+
+  return c3y;
+}
+
+/* _disk_chop_archive(): copy events [fir_d, cut_d) into a separate log.
+*/
+static c3_o
+_disk_chop_archive(u3_disk* log_u, c3_d fir_d, c3_d cut_d)
+{
+  c3_c*           pax_c = _disk_chop_path(log_u, 0, 0);
+  MDB_env*        arc_u;
+  struct _cd_chop cop_u;
+  c3_o            ret_o = c3y;
+  c3_d            eve_d;
+
+  if ( c3_mkdir(pax_c, 0700) && (EEXIST != errno) ) {
+    fprintf(stderr, "disk: chop: mkdir %s: %s\r\n", pax_c, strerror(errno));
+    c3_free(pax_c);
+    return c3n;
+  }
+
+  c3_free(pax_c);
+  pax_c = _disk_chop_path(log_u, fir_d, cut_d - 1);
+
+  if ( c3_mkdir(pax_c, 0700) ) {
+    fprintf(stderr, "disk: chop: mkdir %s: %s\r\n", pax_c, strerror(errno));
+    c3_free(pax_c);
+    return c3n;
+  }
+
+  if ( 0 == (arc_u = u3_lmdb_init(pax_c, _disk_map_size())) ) {
+    fprintf(stderr, "disk: chop: failed to initialize archive\r\n");
+    c3_free(pax_c);
+    return c3n;
+  }
+
+  u3_lmdb_pack(arc_u, c3y);
+
+  cop_u.byt_y = c3_malloc(1000 * sizeof(c3_y*));
+  cop_u.siz_i = c3_malloc(1000 * sizeof(size_t));
+
+  for ( eve_d = fir_d; (c3y == ret_o) && (eve_d < cut_d); ) {
+    c3_d len_d = c3_min(1000, cut_d - eve_d);
+    c3_d i_d;
+
+    cop_u.len_d = 0;
+
+    if (  (c3n == u3_lmdb_read(log_u->mdb_u, &cop_u, eve_d, len_d,
+                               _disk_chop_read_cb))
+       || (len_d != cop_u.len_d)
+       || (c3n == u3_lmdb_save(arc_u, eve_d, len_d,
+                               (void**)cop_u.byt_y, cop_u.siz_i)) )
+    {
+      fprintf(stderr, "disk: chop: failed to archive events %" PRIu64
+                      "-%" PRIu64 "\r\n", eve_d, eve_d + len_d - 1);
+      ret_o = c3n;
+    }
+
+    for ( i_d = 0; i_d < cop_u.len_d; i_d++ ) {
+      c3_free(cop_u.byt_y[i_d]);
+    }
+
+    eve_d += len_d;
+  }
+
+  c3_free(cop_u.byt_y);
+  c3_free(cop_u.siz_i);
+  u3_lmdb_exit(arc_u);
+
+  //  archives are read-only
+  //
+  if ( c3y == ret_o ) {
+    c3_c* dat_c = c3_malloc(strlen(pax_c) + sizeof("/data.mdb"));
+
+    strcpy(dat_c, pax_c);
+    strcat(dat_c, "/data.mdb");
+    chmod(dat_c, 0444);
+    c3_free(dat_c);
+  }
+
+  c3_free(pax_c);
+  return ret_o;
+}
+
+/* _disk_chop_compact(): rewrite the log without free pages.
+*/
+static c3_o
+_disk_chop_compact(u3_disk* log_u)
+{
+  c3_c* pax_c = log_u->com_u->pax_c;
+  c3_w  len_w = strlen(pax_c) + sizeof("/tmp/data.mdb");
+  c3_c* tmp_c = c3_malloc(len_w);
+  c3_c* nex_c = c3_malloc(len_w);
+  c3_c* dat_c = c3_malloc(len_w);
+  c3_o  ret_o = c3n;
+
+  snprintf(tmp_c, len_w, "%s/tmp", pax_c);
+  snprintf(nex_c, len_w, "%s/tmp/data.mdb", pax_c);
+  snprintf(dat_c, len_w, "%s/data.mdb", pax_c);
+
+  //  clear any leftovers from an interrupted compaction
+  //
+  c3_unlink(nex_c);
+
+  if ( c3_mkdir(tmp_c, 0700) && (EEXIST != errno) ) {
+    fprintf(stderr, "disk: chop: mkdir %s: %s\r\n", tmp_c, strerror(errno));
+  }
+  else if ( c3y == u3_lmdb_copy(log_u->mdb_u, tmp_c) ) {
+    //  swap in the copy, and reopen
+    //
+    u3_lmdb_exit(log_u->mdb_u);
+
+    if ( rename(nex_c, dat_c) ) {
+      fprintf(stderr, "disk: chop: rename %s: %s\r\n", nex_c, strerror(errno));
+    }
+    else {
+      ret_o = c3y;
+    }
+
+    if ( 0 == (log_u->mdb_u = u3_lmdb_init(pax_c, _disk_map_size())) ) {
+      fprintf(stderr, "disk: chop: failed to reopen database\r\n");
+      c3_assert(0);
+    }
+
+    u3_lmdb_pack(log_u->mdb_u, __( 2 <= log_u->ver_w ));
+  }
+
+  c3_unlink(nex_c);
+  snprintf(nex_c, len_w, "%s/tmp/lock.mdb", pax_c);
+  c3_unlink(nex_c);
+  c3_rmdir(tmp_c);
+
+  c3_free(tmp_c);
+  c3_free(nex_c);
+  c3_free(dat_c);
+  return ret_o;
+}
+
+/* u3_disk_chop(): start a new epoch after the snapshot at [eve_d], with
+**                 state mug [mug_l], archiving or dropping older events.
+**
+**   the snapshot must be loadable independently of the log (a rock),
+**   as the events before it are no longer available for replay.
+**   the log must be idle, as from a subcommand.
+*/
+c3_o
+u3_disk_chop(u3_disk* log_u, c3_d eve_d, c3_l mug_l, c3_o arc_o)
+{
+  c3_d cut_d;
+
+  c3_assert( c3n == log_u->ted_o );
+  c3_assert( !log_u->put_u.ext_u );
+
+  if ( !eve_d || (eve_d > log_u->dun_d) || ((eve_d + 1) < log_u->fir_d) ) {
+    fprintf(stderr, "disk: chop: snapshot %" PRIu64 " not in log (%" PRIu64
+                    "-%" PRIu64 ")\r\n",
+                    eve_d, log_u->fir_d, log_u->dun_d);
+    return c3n;
+  }
+
+  //  validate the snapshot against the log
+  //
+  if ( eve_d >= log_u->fir_d ) {
+    c3_l log_l = 0;
+
+    if ( c3n == u3_lmdb_read(log_u->mdb_u, &log_l, eve_d, 1,
+                             _disk_chop_mug_cb) )
+    {
+      fprintf(stderr, "disk: chop: failed to read event %" PRIu64 "\r\n",
+                      eve_d);
+      return c3n;
+    }
+
+    if ( log_l != mug_l ) {
+      fprintf(stderr, "disk: chop: snapshot mismatch at %" PRIu64
+                      ": log %x, snapshot %x\r\n",
+                      eve_d, log_l, mug_l);
+      return c3n;
+    }
+  }
+
+  //  keep the snapshot's own event: the log's extent is all that
+  //  records the latest event, and must survive a chop at it
+  //
+  if ( c3n == u3_lmdb_cut(log_u->mdb_u, eve_d, &cut_d) ) {
+    return c3n;
+  }
+
+  if (  (c3y == arc_o)
+     && (cut_d > log_u->fir_d)
+     && (c3n == _disk_chop_archive(log_u, log_u->fir_d, cut_d)) )
+  {
+    return c3n;
+  }
+
+  if ( c3n == u3_lmdb_chop(log_u->mdb_u, cut_d, eve_d) ) {
+    return c3n;
+  }
+
+  log_u->epo_d = eve_d;
+
+  if ( cut_d > log_u->fir_d ) {
+    log_u->fir_d = cut_d;
+
+    //  deleted pages are only reused by lmdb, never returned;
+    //  copy the log to actually shrink it
+    //
+    if ( c3n == _disk_chop_compact(log_u) ) {
+      fprintf(stderr, "disk: chop: compaction failed, continuing\r\n");
+    }
+  }
+
+  return c3y;
+}
+
 /* u3_disk_init(): load or create pier directories and event log.
 */
 u3_disk*
@@ -819,6 +1288,10 @@ u3_disk_init(c3_c* pax_c, u3_disk_cb cb_u)
   log_u->cb_u  = cb_u;
   log_u->red_u = 0;
   log_u->put_u.ent_u = log_u->put_u.ext_u = 0;
+  log_u->nex_u = 0;
+  log_u->tim_u = 0;
+  log_u->wai_w = u3_Host.ops_u.wai_w;
+  log_u->bat_w = u3_Host.ops_u.bat_w;
 
   //  create/load pier directory
   //
@@ -882,40 +1355,24 @@ u3_disk_init(c3_c* pax_c, u3_disk_cb cb_u)
       return 0;
     }
 
-    //  Arbitrarily choosing 1TB as a "large enough" mapsize
-    //
-    //  per the LMDB docs:
-    //  "[..] on 64-bit there is no penalty for making this huge (say 1TB)."
-    //
-    {
-      const size_t siz_i =
-      #if defined(U3_OS_mingw)
-        0xf00000000;
-      // 500 GiB is as large as musl on aarch64 wants to allow
-      #elif (defined(U3_CPU_aarch64) && defined(U3_OS_linux))
-        0x7d00000000;
-      #else
-        0x10000000000;
-      #endif
-
-      if ( 0 == (log_u->mdb_u = u3_lmdb_init(log_c, siz_i)) ) {
-        fprintf(stderr, "disk: failed to initialize database\r\n");
-        c3_free(log_c);
-        c3_free(log_u);
-        return 0;
-      }
+    if ( 0 == (log_u->mdb_u = u3_lmdb_init(log_c, _disk_map_size())) ) {
+      fprintf(stderr, "disk: failed to initialize database\r\n");
+      c3_free(log_c);
+      c3_free(log_u);
+      return 0;
     }
 
     c3_free(log_c);
   }
 
-  //  get the latest event number from the db
+  //  get the first and latest event numbers, and the epoch, from the db
   //
   {
     log_u->dun_d = 0;
-    c3_d fir_d;
 
-    if ( c3n == u3_lmdb_gulf(log_u->mdb_u, &fir_d, &log_u->dun_d) ) {
+    if (  (c3n == u3_lmdb_gulf(log_u->mdb_u, &log_u->fir_d, &log_u->dun_d))
+       || (c3n == u3_lmdb_epoch(log_u->mdb_u, &log_u->epo_d)) )
+    {
       fprintf(stderr, "disk: failed to load latest event from database\r\n");
       c3_free(log_u);
       return 0;
@@ -452,7 +452,36 @@ _git_pill_url(c3_c *out_c, c3_c *arv_c)
   sprintf(out_c, "https://bootstrap.urbit.org/git-%s.pill", hax_c);
 }
 
+/* _king_pill_file(): cue pill file at [pil_c], streaming it from disk.
+*/
+static u3_noun
+_king_pill_file(c3_c* pil_c)
+{
+  c3_i         fid_i = c3_open(pil_c, O_RDONLY, 0644);
+  u3_cue_xeno* sil_u;
+  u3_weak        pil;
+
+  if ( 0 > fid_i ) {
+    u3l_log("boot: unable to open pill %s: %s\r\n", pil_c, strerror(errno));
+    exit(1);
+  }
+
+  sil_u = u3s_cue_xeno_init_with(ur_fib27, ur_fib28);
+  pil   = u3s_cue_xeno_fd(sil_u, fid_i);
+  u3s_cue_xeno_done(sil_u);
+  close(fid_i);
+
+  if ( (u3_none == pil) || (c3n == u3du(pil)) ) {
+    u3l_log("boot: unable to cue pill %s\r\n", pil_c);
+    exit(1);
+  }
+
+  return pil;
+}
+
 /* _boothack_pill(): parse CLI pill arguments into +pill specifier
+**
+**   a pill file is cued as it's read; a downloaded pill is still jammed.
 */
 static u3_noun
 _boothack_pill(void)
@@ -462,7 +491,7 @@ _boothack_pill(void)
 
   if ( 0 != u3_Host.ops_u.pil_c ) {
     u3l_log("boot: loading pill %s\r\n", u3_Host.ops_u.pil_c);
-    pil = u3m_file(u3_Host.ops_u.pil_c);
+    pil = _king_pill_file(u3_Host.ops_u.pil_c);
   }
   else {
     c3_c url_c[2048];
@@ -832,7 +861,11 @@ _king_boot_ivory(void)
     u3_cue_xeno* sil_u = u3s_cue_xeno_init_with(ur_fib27, ur_fib28);
     u3_weak        pil;
 
-    if ( u3_none == (pil = u3s_cue_xeno_with(sil_u, len_d, byt_y)) ) {
+    pil = ( u3_Host.ops_u.lit_c )
+          ? u3s_cue_xeno_mmap(sil_u, len_d, byt_y)
+          : u3s_cue_xeno_with(sil_u, len_d, byt_y);
+
+    if ( u3_none == pil ) {
       u3l_log("lite: unable to cue ivory pill\r\n");
       exit(1);
     }
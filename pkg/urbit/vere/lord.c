@@ -15,6 +15,7 @@
   $%  $:  %live
           $%  [%cram eve=@]
               [%exit cod=@]
+              [%fork red=@ud]
               [%save eve=@]
               [%meld ~]
               [%pack ~]
@@ -23,6 +24,20 @@
       [%play eve=@ lit=(list ?((pair @da ovum) *))]
       [%work mil=@ job=(pair @da ovum)]
   ==
+::
+::    NB: %play is not sent as a jam, but as a frame of raw event log
+::    entries, so that each event is cued exactly once (by the serf):
+::
+::      0xff, eve (8 bytes), then per event: length (4 bytes),
+::      mug (4 bytes), jammed job; all integers little-endian
+::
+::    a leading 0xff is a backreference, which can't begin a jam.
+::
+::    NB: with scry readers, [%live %fork red] (re)forks the serf into
+::    reader .red, on [FD 6+2red] (writs) and [FD 7+2red] (pleas).
+::    a reader answers %peek against its copy-on-write state as of
+::    the %fork, and may also %slog and %flog.
+::
 ::  +plea: from serf to king
 ::
 +$  plea
@@ -102,7 +117,8 @@ _lord_writ_free(u3_writ* wit_u)
     case u3_writ_cram:
     case u3_writ_meld:
     case u3_writ_pack:
-    case u3_writ_exit: {
+    case u3_writ_exit:
+    case u3_writ_fork: {
     } break;
   }
 
@@ -118,6 +134,37 @@ _lord_bail_noop(void*       ptr_v,
 {
 }
 
+/* _lord_seer_free_cb(): scry reader closed.
+*/
+static void
+_lord_seer_free_cb(void*       ptr_v,
+                   ssize_t     err_i,
+                   const c3_c* err_c)
+{
+  c3_free(ptr_v);
+}
+
+/* _lord_seer_stop(): close and dispose scry reader.
+*/
+static void
+_lord_seer_stop(u3_seer* see_u)
+{
+  u3_writ* wit_u = see_u->ext_u;
+  u3_writ* nex_u;
+
+  while ( wit_u ) {
+    nex_u = wit_u->nex_u;
+    _lord_writ_free(wit_u);
+    wit_u = nex_u;
+  }
+
+  see_u->ent_u = see_u->ext_u = 0;
+  see_u->liv_o = c3n;
+
+  u3_newt_moat_stop(&see_u->out_u, _lord_seer_free_cb);
+  u3_newt_mojo_stop(&see_u->inn_u, _lord_bail_noop);
+}
+
 /* _lord_stop(): close and dispose all resources.
 */
 static void
@@ -141,6 +188,24 @@ _lord_stop(u3_lord* god_u)
   u3_newt_moat_stop(&god_u->out_u, _lord_stop_cb);
   u3_newt_mojo_stop(&god_u->inn_u, _lord_bail_noop);
 
+  //  dispose scry readers, which don't outlive us
+  //
+  {
+    c3_w i_w;
+
+    for ( i_w = 0; i_w < god_u->see_w; i_w++ ) {
+      if ( god_u->see_u[i_w] ) {
+        _lord_seer_stop(god_u->see_u[i_w]);
+        god_u->see_u[i_w] = 0;
+      }
+    }
+  }
+
+  if ( god_u->rin_u ) {
+    u3_newt_ring_stop(god_u->rin_u);
+    god_u->rin_u = 0;
+  }
+
   uv_read_stop((uv_stream_t*)&(god_u->err_u));
 
   uv_close((uv_handle_t*)&god_u->cub_u, 0);
@@ -200,6 +265,7 @@ _lord_writ_str(u3_writ_type typ_e)
     case u3_writ_meld: return "meld";
     case u3_writ_pack: return "pack";
     case u3_writ_exit: return "exit";
+    case u3_writ_fork: return "fork";
   }
 }
 
@@ -275,6 +341,18 @@ _lord_plea_live(u3_lord* god_u, u3_noun dat)
       //
       u3l_log("pier: pack complete\n");
     } break;
+
+    //  the reader is frozen where the serf is now
+    //
+    case u3_writ_fork: {
+      u3_seer* see_u = god_u->see_u[wit_u->red_w];
+
+      if ( see_u ) {
+        see_u->fok_o = c3n;
+        see_u->liv_o = c3y;
+        see_u->eve_d = god_u->eve_d;
+      }
+    } break;
   }
 
   c3_free(wit_u);
@@ -408,18 +486,11 @@ _lord_plea_peek_done(u3_lord* god_u, u3_peek* pek_u, u3_noun rep)
   c3_free(pek_u);
 }
 
-/* _lord_plea_peek(): hear serf %peek response
+/* _lord_plea_peek_with(): hear %peek response, from serf or reader.
 */
 static void
-_lord_plea_peek(u3_lord* god_u, u3_noun dat)
+_lord_plea_peek_with(u3_lord* god_u, u3_peek* pek_u, u3_noun dat)
 {
-  u3_peek* pek_u;
-  {
-    u3_writ* wit_u = _lord_writ_need(god_u, u3_writ_peek);
-    pek_u = wit_u->pek_u;
-    c3_free(wit_u);
-  }
-
   if ( c3n == u3a_is_cell(dat) ) {
     return _lord_plea_foul(god_u, c3__peek, dat);
   }
@@ -441,6 +512,21 @@ _lord_plea_peek(u3_lord* god_u, u3_noun dat)
   u3z(dat);
 }
 
+/* _lord_plea_peek(): hear serf %peek response
+*/
+static void
+_lord_plea_peek(u3_lord* god_u, u3_noun dat)
+{
+  u3_peek* pek_u;
+  {
+    u3_writ* wit_u = _lord_writ_need(god_u, u3_writ_peek);
+    pek_u = wit_u->pek_u;
+    c3_free(wit_u);
+  }
+
+  _lord_plea_peek_with(god_u, pek_u, dat);
+}
+
 /* _lord_plea_play_bail(): hear serf %play %bail
 */
 static void
@@ -776,20 +862,6 @@ _lord_writ_make(u3_lord* god_u, u3_writ* wit_u)
       msg = u3nc(c3__peek, u3nc(0, u3k(wit_u->pek_u->sam)));
     } break;
 
-    case u3_writ_play: {
-      u3_fact* tac_u = wit_u->fon_u.ext_u;
-      c3_d     eve_d = tac_u->eve_d;
-      u3_noun    lit = u3_nul;
-
-      while ( tac_u ) {
-        lit   = u3nc(u3k(tac_u->job), lit);
-        tac_u = tac_u->nex_u;
-      }
-
-      msg = u3nt(c3__play, u3i_chubs(1, &eve_d), u3kb_flop(lit));
-
-    } break;
-
     case u3_writ_save: {
       msg = u3nt(c3__live, c3__save, u3i_chubs(1, &god_u->eve_d));
     } break;
@@ -811,11 +883,145 @@ _lord_writ_make(u3_lord* god_u, u3_writ* wit_u)
       //
       msg = u3nt(c3__live, c3__exit, 0);
     } break;
+
+    case u3_writ_fork: {
+      msg = u3nt(c3__live, c3__fork, u3i_word(wit_u->red_w));
+    } break;
   }
 
   return msg;
 }
 
+/* u3_lord_play_frame(): frame %play batch from raw log entries.
+*/
+void
+u3_lord_play_frame(u3_info fon_u, c3_d* out_d, c3_y** out_y)
+{
+  u3_fact* tac_u;
+  c3_d     len_d = 9;
+  c3_y*    byt_y;
+
+  //  measure the frame, serializing any events not read from the log
+  //
+  for ( tac_u = fon_u.ext_u; tac_u; tac_u = tac_u->nex_u ) {
+    if ( !tac_u->hun_y ) {
+      c3_d  jam_d;
+      c3_y* jam_y;
+
+      u3s_jam_xeno(tac_u->job, &jam_d, &jam_y);
+
+      tac_u->len_i = 4 + jam_d;
+      tac_u->hun_y = c3_malloc(tac_u->len_i);
+      tac_u->hun_y[0] = tac_u->mug_l & 0xff;
+      tac_u->hun_y[1] = (tac_u->mug_l >> 8) & 0xff;
+      tac_u->hun_y[2] = (tac_u->mug_l >> 16) & 0xff;
+      tac_u->hun_y[3] = (tac_u->mug_l >> 24) & 0xff;
+      memcpy(tac_u->hun_y + 4, jam_y, jam_d);
+      c3_free(jam_y);
+    }
+
+    len_d += 4 + tac_u->len_i;
+  }
+
+  byt_y = c3_malloc(len_d);
+
+  {
+    c3_d  eve_d = fon_u.ext_u->eve_d;
+    c3_y* cur_y = byt_y;
+    c3_w  i_w;
+
+    *cur_y++ = 0xff;
+
+    for ( i_w = 0; i_w < 8; i_w++ ) {
+      *cur_y++ = (eve_d >> (8 * i_w)) & 0xff;
+    }
+
+    for ( tac_u = fon_u.ext_u; tac_u; tac_u = tac_u->nex_u ) {
+      c3_w len_w = tac_u->len_i;
+
+      *cur_y++ = len_w & 0xff;
+      *cur_y++ = (len_w >> 8) & 0xff;
+      *cur_y++ = (len_w >> 16) & 0xff;
+      *cur_y++ = (len_w >> 24) & 0xff;
+
+      memcpy(cur_y, tac_u->hun_y, tac_u->len_i);
+      cur_y += tac_u->len_i;
+    }
+
+    c3_assert( (byt_y + len_d) == cur_y );
+  }
+
+  *out_d = len_d;
+  *out_y = byt_y;
+}
+
+/* u3_lord_play_cue(): parse %play frame, cueing each event once.
+*/
+u3_weak
+u3_lord_play_cue(u3_cue_xeno* sil_u, c3_d len_d, c3_y* byt_y)
+{
+  u3_noun lit = u3_nul;
+  c3_d  eve_d = 0;
+  c3_w    i_w;
+
+  if ( (9 > len_d) || (0xff != byt_y[0]) ) {
+    return u3_none;
+  }
+
+  for ( i_w = 0; i_w < 8; i_w++ ) {
+    eve_d |= (c3_d)byt_y[1 + i_w] << (8 * i_w);
+  }
+
+  byt_y += 9;
+  len_d -= 9;
+
+  while ( len_d ) {
+    u3_weak job;
+    c3_w  len_w;
+
+    if ( 4 > len_d ) {
+      u3z(lit);
+      return u3_none;
+    }
+
+    len_w = byt_y[0]
+          ^ (byt_y[1] <<  8)
+          ^ (byt_y[2] << 16)
+          ^ (byt_y[3] << 24);
+    byt_y += 4;
+    len_d -= 4;
+
+    //  skip the mug, cue the job
+    //
+    if (  (4 >= len_w)
+       || (len_w > len_d)
+       || (u3_none == (job = u3s_cue_xeno_with(sil_u, len_w - 4, byt_y + 4))) )
+    {
+      u3z(lit);
+      return u3_none;
+    }
+
+    lit    = u3nc(job, lit);
+    byt_y += len_w;
+    len_d -= len_w;
+  }
+
+  return u3nt(c3__play, u3i_chubs(1, &eve_d), u3kb_flop(lit));
+}
+
+/* _lord_send(): send bytes to serf, by ring or pipe.
+*/
+static void
+_lord_send(u3_lord* god_u, c3_d len_d, c3_y* byt_y)
+{
+  if ( god_u->rin_u ) {
+    u3_newt_ring_send(god_u->rin_u, len_d, byt_y);
+  }
+  else {
+    u3_newt_send(&god_u->inn_u, len_d, byt_y);
+  }
+}
+
 /* _lord_writ_send(): send writ to serf.
 */
 static void
@@ -828,7 +1034,14 @@ _lord_writ_send(u3_lord* god_u, u3_writ* wit_u)
     god_u->inn_u.bal_f = _lord_bail_noop;
   }
 
-  {
+  if ( u3_writ_play == wit_u->typ_e ) {
+    c3_d  len_d;
+    c3_y* byt_y;
+
+    u3_lord_play_frame(wit_u->fon_u, &len_d, &byt_y);
+    _lord_send(god_u, len_d, byt_y);
+  }
+  else {
     u3_noun jar = _lord_writ_make(god_u, wit_u);
     c3_d  len_d;
     c3_y* byt_y;
@@ -843,7 +1056,7 @@ _lord_writ_send(u3_lord* god_u, u3_writ* wit_u)
     u3t_event_trace("king ipc jam", 'E');
 #endif
 
-    u3_newt_send(&god_u->inn_u, len_d, byt_y);
+    _lord_send(god_u, len_d, byt_y);
     u3z(jar);
   }
 }
@@ -868,10 +1081,10 @@ _lord_writ_plan(u3_lord* god_u, u3_writ* wit_u)
   _lord_writ_send(god_u, wit_u);
 }
 
-/* u3_lord_peek(): read namespace, injecting what's missing.
+/* _lord_writ_peek(): %peek writ from proto-peek.
 */
-void
-u3_lord_peek(u3_lord* god_u, u3_pico* pic_u)
+static u3_writ*
+_lord_writ_peek(u3_lord* god_u, u3_pico* pic_u)
 {
   u3_writ* wit_u = _lord_writ_new(god_u);
   wit_u->typ_e = u3_writ_peek;
@@ -902,11 +1115,203 @@ u3_lord_peek(u3_lord* god_u, u3_pico* pic_u)
     wit_u->pek_u->sam = u3nc(u3k(pic_u->gan), sam);
   }
 
+  return wit_u;
+}
+
+/* u3_lord_peek(): read namespace, injecting what's missing.
+*/
+void
+u3_lord_peek(u3_lord* god_u, u3_pico* pic_u)
+{
   //  XX cache check, unless last
   //
+  _lord_writ_plan(god_u, _lord_writ_peek(god_u, pic_u));
+}
+
+/* _lord_seer_pop(): pop a scry reader's writ queue, if nonempty.
+*/
+static u3_writ*
+_lord_seer_pop(u3_seer* see_u)
+{
+  u3_writ* wit_u = see_u->ext_u;
+
+  if ( wit_u ) {
+    if ( !(see_u->ext_u = wit_u->nex_u) ) {
+      see_u->ent_u = 0;
+    }
+
+    wit_u->nex_u = 0;
+    see_u->dep_w--;
+  }
+
+  return wit_u;
+}
+
+/* _lord_seer_plan(): enqueue a %peek writ on a scry reader, and send.
+*/
+static void
+_lord_seer_plan(u3_seer* see_u, u3_writ* wit_u)
+{
+  u3_noun jar = _lord_writ_make(see_u->god_u, wit_u);
+  c3_d  len_d;
+  c3_y* byt_y;
+
+  if ( !see_u->ent_u ) {
+    see_u->ent_u = see_u->ext_u = wit_u;
+  }
+  else {
+    see_u->ent_u->nex_u = wit_u;
+    see_u->ent_u = wit_u;
+  }
+
+  see_u->dep_w++;
+
+  u3s_jam_xeno(jar, &len_d, &byt_y);
+  u3_newt_send(&see_u->inn_u, len_d, byt_y);
+  u3z(jar);
+}
+
+/* _lord_seer_fork(): (re)fork a scry reader from the serf's state.
+**
+**   the reader must be idle: the serf kills the old fork outright.
+*/
+static void
+_lord_seer_fork(u3_lord* god_u, u3_seer* see_u)
+{
+  u3_writ* wit_u = _lord_writ_new(god_u);
+  wit_u->typ_e = u3_writ_fork;
+  wit_u->red_w = see_u->red_w;
+
+  c3_assert( !see_u->dep_w );
+
+  see_u->liv_o = c3n;
+  see_u->fok_o = c3y;
+
   _lord_writ_plan(god_u, wit_u);
 }
 
+/* _lord_on_seer_plea(): handle plea from scry reader.
+*/
+static void
+_lord_on_seer_plea(void* ptr_v, c3_d len_d, c3_y* byt_y)
+{
+  u3_seer* see_u = ptr_v;
+  u3_lord* god_u = see_u->god_u;
+  u3_noun    tag, dat;
+  u3_weak    jar;
+
+  jar = u3s_cue_xeno_with(god_u->sil_u, len_d, byt_y);
+
+  if ( u3_none == jar ) {
+    return _lord_plea_foul(god_u, 0, u3_blip);
+  }
+  else if ( c3n == u3r_cell(jar, &tag, &dat) ) {
+    return _lord_plea_foul(god_u, 0, jar);
+  }
+
+  switch ( tag ) {
+    default: {
+      return _lord_plea_foul(god_u, 0, jar);
+    }
+
+    case c3__peek: {
+      u3_writ* wit_u = _lord_seer_pop(see_u);
+
+      if ( !wit_u ) {
+        return _lord_plea_foul(god_u, c3__peek, jar);
+      }
+
+      _lord_plea_peek_with(god_u, wit_u->pek_u, u3k(dat));
+      c3_free(wit_u);
+    } break;
+
+    case  c3__slog: {
+      _lord_plea_slog(god_u, u3k(dat));
+    } break;
+
+    case  c3__flog: {
+      _lord_plea_flog(god_u, u3k(dat));
+    } break;
+  }
+
+  u3z(jar);
+}
+
+/* _lord_on_seer_bail(): scry reader gone, send its peeks to the serf.
+*/
+static void
+_lord_on_seer_bail(void*       ptr_v,
+                   ssize_t     err_i,
+                   const c3_c* err_c)
+{
+  u3_seer* see_u = ptr_v;
+  u3_lord* god_u = see_u->god_u;
+  u3_writ* wit_u;
+
+  if ( UV_EOF == err_i ) {
+    u3l_log("lord: scry reader %u exited\r\n", see_u->red_w);
+  }
+  else {
+    u3l_log("lord: scry reader %u: %s\r\n", see_u->red_w, err_c);
+  }
+
+  while ( (wit_u = _lord_seer_pop(see_u)) ) {
+    _lord_writ_plan(god_u, wit_u);
+  }
+
+  god_u->see_u[see_u->red_w] = 0;
+  _lord_seer_stop(see_u);
+}
+
+/* u3_lord_gaze(): read namespace on a scry reader, if one is
+**                 frozen at or after [eve_d]; c3n if none.
+**
+**   if none is, an idle reader is refreshed (at most one at a time),
+**   to be frozen where the serf is once the %fork is processed.
+*/
+c3_o
+u3_lord_gaze(u3_lord* god_u, c3_d eve_d, u3_pico* pic_u)
+{
+  u3_seer* see_u = 0;
+  u3_seer* old_u = 0;
+  c3_o     fok_o = c3n;
+  c3_w     i_w;
+
+  if ( c3n == god_u->liv_o ) {
+    return c3n;
+  }
+
+  for ( i_w = 0; i_w < god_u->see_w; i_w++ ) {
+    u3_seer* nex_u = god_u->see_u[i_w];
+
+    if ( !nex_u ) {
+      continue;
+    }
+    else if ( c3y == nex_u->fok_o ) {
+      fok_o = c3y;
+    }
+    else if ( (c3y == nex_u->liv_o) && (nex_u->eve_d >= eve_d) ) {
+      if ( !see_u || (nex_u->dep_w < see_u->dep_w) ) {
+        see_u = nex_u;
+      }
+    }
+    else if ( !nex_u->dep_w && !old_u ) {
+      old_u = nex_u;
+    }
+  }
+
+  if ( see_u ) {
+    _lord_seer_plan(see_u, _lord_writ_peek(god_u, pic_u));
+    return c3y;
+  }
+
+  if ( (c3n == fok_o) && old_u ) {
+    _lord_seer_fork(god_u, old_u);
+  }
+
+  return c3n;
+}
+
 /* u3_lord_play(): recompute batch.
 */
 void
@@ -1112,6 +1517,15 @@ _lord_on_serf_bail(void*       ptr_v,
 u3_noun
 u3_lord_info(u3_lord* god_u)
 {
+  c3_w liv_w = 0;
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < god_u->see_w; i_w++ ) {
+    if ( god_u->see_u[i_w] && (c3y == god_u->see_u[i_w]->liv_o) ) {
+      liv_w++;
+    }
+  }
+
   return u3_pier_mass(
     c3__lord,
     u3i_list(
@@ -1119,7 +1533,9 @@ u3_lord_info(u3_lord* god_u)
       u3_pier_mase("event", u3i_chub(god_u->eve_d)),
       u3_pier_mase("mug",   god_u->mug_l),
       u3_pier_mase("queue", u3i_word(god_u->dep_w)),
+      u3_pier_mase("scry-readers", u3i_word(liv_w)),
       u3_newt_moat_info(&god_u->out_u),
+      ( god_u->rin_u ) ? u3_newt_ring_info(god_u->rin_u) : u3_none,
       u3_none));
 }
 
@@ -1134,6 +1550,29 @@ u3_lord_slog(u3_lord* god_u)
           god_u->mug_l,
           god_u->dep_w);
   u3_newt_moat_slog(&god_u->out_u);
+
+  if ( god_u->rin_u ) {
+    u3l_log("    ipc: shared-memory ring\n");
+  }
+
+  {
+    c3_w i_w;
+
+    for ( i_w = 0; i_w < god_u->see_w; i_w++ ) {
+      u3_seer* see_u = god_u->see_u[i_w];
+
+      if ( !see_u ) {
+        u3l_log("    scry reader %u: exited\n", i_w);
+      }
+      else {
+        u3l_log("    scry reader %u: live=%s, event=%" PRIu64 ", queue=%u\n",
+                i_w,
+                ( c3y == see_u->liv_o ) ? "&" : "|",
+                see_u->eve_d,
+                see_u->dep_w);
+      }
+    }
+  }
 }
 
 /* u3_lord_init(): instantiate child process.
@@ -1154,15 +1593,46 @@ u3_lord_init(c3_c* pax_c, c3_w wag_w, c3_d key_d[4], u3_lord_cb cb_u)
   god_u->key_d[2] = key_d[2];
   god_u->key_d[3] = key_d[3];
 
+  //  set up shared-memory transport, if requested
+  //
+  //    falls back to pipes if unavailable (i.e., not on linux)
+  //
+  if (  (c3y == u3_Host.ops_u.rin)
+     && !(god_u->rin_u = u3_newt_ring_make()) )
+  {
+    u3l_log("lord: shared-memory ipc unavailable, using pipes\r\n");
+  }
+
+  //  scry readers are forked by the serf, on demand (see u3_lord_gaze())
+  //
+#ifndef U3_OS_mingw
+  {
+    c3_w i_w;
+
+    god_u->see_w = c3_min(u3_Host.ops_u.sry_w, u3_seer_max);
+
+    for ( i_w = 0; i_w < god_u->see_w; i_w++ ) {
+      u3_seer* see_u = c3_calloc(sizeof(*see_u));
+      see_u->god_u = god_u;
+      see_u->red_w = i_w;
+      see_u->liv_o = c3n;
+      see_u->fok_o = c3n;
+      god_u->see_u[i_w] = see_u;
+    }
+  }
+#endif
+
   //  spawn new process and connect to it
   //
   {
-    c3_c* arg_c[10];
+    c3_c* arg_c[12];
     c3_c  key_c[256];
     c3_c  wag_c[11];
     c3_c  hap_c[11];
     c3_c  cev_c[11];
     c3_c  lom_c[11];
+    c3_c  pag_c[11];
+    c3_c  sry_c[11];
     c3_i  err_i;
 
     sprintf(key_c, "%" PRIx64 ":%" PRIx64 ":%" PRIx64 ":%" PRIx64 "",
@@ -1177,6 +1647,8 @@ u3_lord_init(c3_c* pax_c, c3_w wag_w, c3_d key_d[4], u3_lord_cb cb_u)
 
     sprintf(lom_c, "%u", u3_Host.ops_u.lom_y);
 
+    sprintf(pag_c, "%u", u3_Host.ops_u.pag_y);
+
     arg_c[0] = god_u->bin_c;            //  executable
     arg_c[1] = "serf";                  //  protocol
     arg_c[2] = god_u->pax_c;            //  path to checkpoint directory
@@ -1194,14 +1666,18 @@ u3_lord_init(c3_c* pax_c, c3_w wag_w, c3_d key_d[4], u3_lord_cb cb_u)
       arg_c[7] = "0";
     }
 
+    arg_c[8] = pag_c;                   //  loom page bex
+
 #ifdef U3_OS_mingw
     sprintf(cev_c, "%" PRIu64, u3_Host.cev_u);
-    arg_c[8] = cev_c;
+    arg_c[9] = cev_c;
 #else
-    arg_c[8] = 0;
+    sprintf(sry_c, "%u", god_u->see_w);
+    arg_c[9]  = ( god_u->rin_u ) ? "ring" : "pipe";  //  shared-memory ipc
+    arg_c[10] = sry_c;                               //  scry readers
 #endif
 
-    arg_c[9] = 0;
+    arg_c[11] = 0;
 
     uv_pipe_init(u3L, &god_u->inn_u.pyp_u, 0);
     uv_timer_init(u3L, &god_u->out_u.tim_u);
@@ -1220,6 +1696,50 @@ u3_lord_init(c3_c* pax_c, c3_w wag_w, c3_d key_d[4], u3_lord_cb cb_u)
     god_u->ops_u.stdio = god_u->cod_u;
     god_u->ops_u.stdio_count = 3;
 
+    //  the serf gets the ring's memory at [FD 3], its own wakeups
+    //  at [FD 4], and ours at [FD 5]
+    //
+    if ( god_u->rin_u ) {
+      god_u->cod_u[3].flags = UV_INHERIT_FD;
+      god_u->cod_u[3].data.fd = god_u->rin_u->mem_i;
+
+      god_u->cod_u[4].flags = UV_INHERIT_FD;
+      god_u->cod_u[4].data.fd = god_u->rin_u->pir_i;
+
+      god_u->cod_u[5].flags = UV_INHERIT_FD;
+      god_u->cod_u[5].data.fd = god_u->rin_u->wak_i;
+
+      god_u->ops_u.stdio_count = 6;
+    }
+
+    //  scry reader [n] gets writs at [FD 6+2n] and sends pleas at [FD 7+2n]
+    //
+    if ( god_u->see_w ) {
+      c3_w i_w;
+
+      if ( !god_u->rin_u ) {
+        god_u->cod_u[3].flags = UV_IGNORE;
+        god_u->cod_u[4].flags = UV_IGNORE;
+        god_u->cod_u[5].flags = UV_IGNORE;
+      }
+
+      for ( i_w = 0; i_w < god_u->see_w; i_w++ ) {
+        u3_seer* see_u = god_u->see_u[i_w];
+
+        uv_pipe_init(u3L, &see_u->inn_u.pyp_u, 0);
+        uv_timer_init(u3L, &see_u->out_u.tim_u);
+        uv_pipe_init(u3L, &see_u->out_u.pyp_u, 0);
+
+        god_u->cod_u[6 + 2 * i_w].flags = UV_CREATE_PIPE | UV_READABLE_PIPE;
+        god_u->cod_u[6 + 2 * i_w].data.stream = (uv_stream_t*)&see_u->inn_u;
+
+        god_u->cod_u[7 + 2 * i_w].flags = UV_CREATE_PIPE | UV_WRITABLE_PIPE;
+        god_u->cod_u[7 + 2 * i_w].data.stream = (uv_stream_t*)&see_u->out_u;
+      }
+
+      god_u->ops_u.stdio_count = 6 + 2 * god_u->see_w;
+    }
+
     // if any fds are inherited, libuv ignores UV_PROCESS_WINDOWS_HIDE*
     god_u->ops_u.flags = UV_PROCESS_WINDOWS_HIDE;
     god_u->ops_u.exit_cb = _lord_on_serf_exit;
@@ -1256,6 +1776,30 @@ u3_lord_init(c3_c* pax_c, c3_w wag_w, c3_d key_d[4], u3_lord_cb cb_u)
     god_u->inn_u.bal_f = _lord_on_serf_bail;
 
     u3_newt_read(&god_u->out_u);
+
+    if ( god_u->rin_u ) {
+      u3_newt_ring_read(god_u->rin_u, &god_u->out_u);
+    }
   }
+
+  //  start reading from scry readers
+  //
+  {
+    c3_w i_w;
+
+    for ( i_w = 0; i_w < god_u->see_w; i_w++ ) {
+      u3_seer* see_u = god_u->see_u[i_w];
+
+      see_u->out_u.ptr_v = see_u;
+      see_u->out_u.pok_f = _lord_on_seer_plea;
+      see_u->out_u.bal_f = _lord_on_seer_bail;
+
+      see_u->inn_u.ptr_v = see_u;
+      see_u->inn_u.bal_f = _lord_on_seer_bail;
+
+      u3_newt_read(&see_u->out_u);
+    }
+  }
+
   return god_u;
 }
@@ -10,10 +10,19 @@
 **
 **  the implementation is relatively inefficient and could
 **  lose a few copies, mallocs, etc.
+**
+**  alternately, between king and serf, messages can be passed
+**  through a u3_ring: a pair of single-producer, single-consumer
+**  ring buffers in shared memory (a memfd), with an eventfd per
+**  process for wakeups. see "shared-memory rings", below.
 */
 #include "all.h"
 #include "vere/vere.h"
 
+#if defined(U3_OS_linux)
+#include <sys/eventfd.h>
+#endif
+
 /* _newt_mess_head(): await next msg header.
 */
 static void
@@ -478,3 +487,557 @@ u3_newt_send(u3_mojo* moj_u, c3_d len_d, c3_y* byt_y)
     }
   }
 }
+
+/*  shared-memory rings
+**
+**    each ring is written only by its producer, and read only by its
+**    consumer. [hed_d] and [tal_d] count bytes produced and consumed,
+**    and never wrap; their difference is the ring's occupancy.
+**
+**    messages are written as 8-byte aligned records: a 4-byte length,
+**    a 4-byte type, and the payload. a message is written whole if it
+**    is small enough (padding to the end of the ring if it would
+**    wrap), and is delivered in place, without copying; larger
+**    messages are split into fragments and reassembled by the reader.
+**
+**    a sleeping consumer sets [nap_w] and a blocked producer [wan_w];
+**    their peer then writes to the sleeper's eventfd. otherwise, no
+**    syscalls are made at all.
+*/
+
+#define _newt_ring_len  (1ULL << 22)    //  bytes per direction
+#define _newt_ring_hed  4096            //  header length
+#define _newt_ring_max  (_newt_ring_len >> 2) //  max whole message
+
+#define _newt_ring_whole  0             //  complete message
+#define _newt_ring_frag   1             //  fragment, more to follow
+#define _newt_ring_last   2             //  final fragment
+#define _newt_ring_pad    3             //  skip to end of ring
+
+/* u3_rung: one direction of a u3_ring, in shared memory.
+*/
+struct _u3_rung {
+  c3_d hed_d;                           //  produced, written by producer
+  c3_y pad_y[56];                       //
+  c3_d tal_d;                           //  consumed, written by consumer
+  c3_y pod_y[56];                       //
+  c3_w nap_w;                           //  consumer sleeping
+  c3_w wan_w;                           //  producer blocked
+  c3_d siz_d;                           //  data length (power of 2)
+};
+
+/* u3_pend: blocked write.
+*/
+typedef struct _u3_pend {
+  struct _u3_pend* nex_u;
+  c3_d             len_d;               //  message length
+  c3_d             off_d;               //  bytes already written
+  c3_y*            byt_y;               //  message
+} u3_pend;
+
+#if defined(U3_OS_linux)
+
+/* _newt_rung_data(): ring data.
+*/
+static inline c3_y*
+_newt_rung_data(u3_rung* rug_u)
+{
+  return (c3_y*)rug_u + _newt_ring_hed;
+}
+
+/* _newt_ring_poke(): wake the peer.
+*/
+static void
+_newt_ring_poke(u3_ring* rin_u)
+{
+  c3_d one_d = 1;
+
+  if ( sizeof(one_d) != write(rin_u->pir_i, &one_d, sizeof(one_d)) ) {
+    if ( EAGAIN != errno ) {
+      fprintf(stderr, "newt: ring wake failed: %s\r\n", strerror(errno));
+    }
+  }
+}
+
+/* _newt_ring_put(): write from [pen_u], as far as possible.
+*/
+static c3_o
+_newt_ring_put(u3_ring* rin_u, u3_pend* pen_u)
+{
+  u3_rung* rug_u = rin_u->out_u;
+  c3_y*    dat_y = _newt_rung_data(rug_u);
+  c3_d     siz_d = rug_u->siz_d;
+  c3_d     hed_d = rug_u->hed_d;
+  c3_o     wan_o = c3n;
+  c3_o     ret_o = c3y;
+
+  while ( pen_u->off_d < pen_u->len_d ) {
+    c3_d tal_d = __atomic_load_n(&rug_u->tal_d, __ATOMIC_ACQUIRE);
+    c3_d fre_d = siz_d - (hed_d - tal_d);
+    c3_d pos_d = hed_d & (siz_d - 1);
+    c3_d end_d = siz_d - pos_d;
+    c3_d ava_d = c3_min(fre_d, end_d);
+    c3_d rem_d = pen_u->len_d - pen_u->off_d;
+    c3_d cop_d, ned_d;
+    c3_w typ_w;
+
+    //  small messages are written whole; large ones in fragments
+    //
+    if ( !pen_u->off_d && (rem_d <= _newt_ring_max) ) {
+      cop_d = rem_d;
+      typ_w = _newt_ring_whole;
+    }
+    else {
+      cop_d = ( 8 < ava_d ) ? c3_min(rem_d, ava_d - 8) : 0;
+      typ_w = ( cop_d == rem_d ) ? _newt_ring_last : _newt_ring_frag;
+    }
+
+    ned_d = (8 + cop_d + 7) & ~7ULL;
+
+    if ( cop_d && (ned_d <= ava_d) ) {
+      c3_w* hdr_w = (c3_w*)(dat_y + pos_d);
+
+      hdr_w[0] = (c3_w)cop_d;
+      hdr_w[1] = typ_w;
+      memcpy(dat_y + pos_d + 8, pen_u->byt_y + pen_u->off_d, cop_d);
+
+      pen_u->off_d += cop_d;
+      hed_d        += ned_d;
+      __atomic_store_n(&rug_u->hed_d, hed_d, __ATOMIC_RELEASE);
+    }
+    //  skip to the start of the ring, if the rest of it is free
+    //
+    else if ( pos_d && (end_d <= fre_d) ) {
+      c3_w* hdr_w = (c3_w*)(dat_y + pos_d);
+
+      hdr_w[0] = 0;
+      hdr_w[1] = _newt_ring_pad;
+
+      hed_d += end_d;
+      __atomic_store_n(&rug_u->hed_d, hed_d, __ATOMIC_RELEASE);
+    }
+    //  full: ask to be woken when space is freed, and check once more
+    //
+    else if ( c3n == wan_o ) {
+      __atomic_store_n(&rug_u->wan_w, 1, __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+      wan_o = c3y;
+    }
+    else {
+      ret_o = c3n;
+      break;
+    }
+  }
+
+  //  wake the consumer, if it's asleep
+  //
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+  if ( __atomic_exchange_n(&rug_u->nap_w, 0, __ATOMIC_RELAXED) ) {
+    _newt_ring_poke(rin_u);
+  }
+
+  return ret_o;
+}
+
+/* _newt_ring_flush(): write blocked messages, in order.
+*/
+static void
+_newt_ring_flush(u3_ring* rin_u)
+{
+  u3_pend* pen_u;
+
+  while ( (pen_u = rin_u->ext_u) ) {
+    if ( c3n == _newt_ring_put(rin_u, pen_u) ) {
+      return;
+    }
+
+    if ( !(rin_u->ext_u = pen_u->nex_u) ) {
+      rin_u->ent_u = 0;
+    }
+
+    c3_free(pen_u->byt_y);
+    c3_free(pen_u);
+  }
+}
+
+/* _newt_ring_drain(): deliver all inbound msgs, then sleep.
+*/
+static void
+_newt_ring_drain(u3_ring* rin_u)
+{
+  u3_rung* rug_u = rin_u->inn_u;
+  c3_y*    dat_y = _newt_rung_data(rug_u);
+  c3_d     siz_d = rug_u->siz_d;
+  c3_d     tal_d = rug_u->tal_d;
+  c3_o     nap_o = c3n;
+
+  while ( (c3y == rin_u->liv_o) && rin_u->mot_u ) {
+    u3_moat* mot_u = rin_u->mot_u;
+    c3_d     hed_d = __atomic_load_n(&rug_u->hed_d, __ATOMIC_ACQUIRE);
+    c3_d     pos_d = tal_d & (siz_d - 1);
+    c3_w*    hdr_w = (c3_w*)(dat_y + pos_d);
+    c3_w     len_w;
+
+    //  empty: go to sleep, checking once more
+    //
+    if ( hed_d == tal_d ) {
+      if ( c3y == nap_o ) {
+        break;
+      }
+
+      __atomic_store_n(&rug_u->nap_w, 1, __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+      nap_o = c3y;
+      continue;
+    }
+    else if ( c3y == nap_o ) {
+      __atomic_store_n(&rug_u->nap_w, 0, __ATOMIC_RELAXED);
+      nap_o = c3n;
+    }
+
+    len_w = hdr_w[0];
+
+    switch ( hdr_w[1] ) {
+      default: {
+        fprintf(stderr, "newt: ring: bad record at %" PRIu64 "\r\n", tal_d);
+        rin_u->liv_o = c3n;
+        mot_u->bal_f(mot_u->ptr_v, -1, "newt-ring");
+        return;
+      }
+
+      case _newt_ring_pad: {
+        tal_d += siz_d - pos_d;
+      } break;
+
+      //  delivered in place
+      //
+      case _newt_ring_whole: {
+        mot_u->pok_f(mot_u->ptr_v, len_w, dat_y + pos_d + 8);
+        tal_d += (8ULL + len_w + 7) & ~7ULL;
+      } break;
+
+      case _newt_ring_frag:
+      case _newt_ring_last: {
+        rin_u->fag_y = c3_realloc(rin_u->fag_y, rin_u->fag_d + len_w);
+        memcpy(rin_u->fag_y + rin_u->fag_d, dat_y + pos_d + 8, len_w);
+        rin_u->fag_d += len_w;
+        tal_d        += (8ULL + len_w + 7) & ~7ULL;
+
+        if ( _newt_ring_last == hdr_w[1] ) {
+          c3_y* fag_y = rin_u->fag_y;
+          c3_d  fag_d = rin_u->fag_d;
+
+          rin_u->fag_y = 0;
+          rin_u->fag_d = 0;
+
+          mot_u->pok_f(mot_u->ptr_v, fag_d, fag_y);
+          c3_free(fag_y);
+        }
+      } break;
+    }
+
+    __atomic_store_n(&rug_u->tal_d, tal_d, __ATOMIC_RELEASE);
+
+    //  wake the producer, if it's blocked
+    //
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if ( __atomic_exchange_n(&rug_u->wan_w, 0, __ATOMIC_RELAXED) ) {
+      _newt_ring_poke(rin_u);
+    }
+  }
+}
+
+/* _newt_ring_wake_cb(): eventfd readable; read and/or write.
+*/
+static void
+_newt_ring_wake_cb(uv_poll_t* pol_u, c3_i sas_i, c3_i evt_i)
+{
+  u3_ring* rin_u = pol_u->data;
+  c3_d     val_d;
+
+  if ( sas_i ) {
+    fprintf(stderr, "newt: ring poll failed: %s\r\n", uv_strerror(sas_i));
+    return;
+  }
+
+  if (  (sizeof(val_d) != read(rin_u->wak_i, &val_d, sizeof(val_d)))
+     && (EAGAIN != errno) )
+  {
+    fprintf(stderr, "newt: ring wake read failed: %s\r\n", strerror(errno));
+  }
+
+  _newt_ring_drain(rin_u);
+
+  if ( c3y == rin_u->liv_o ) {
+    _newt_ring_flush(rin_u);
+  }
+}
+
+/* _newt_ring_init(): map rings, start watching for wakeups.
+*/
+static u3_ring*
+_newt_ring_init(c3_i mem_i, c3_i wak_i, c3_i pir_i, c3_o kin_o)
+{
+  u3_ring* rin_u;
+  size_t   map_i = 2 * (_newt_ring_hed + _newt_ring_len);
+  c3_y*    map_y = mmap(0, map_i, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, mem_i, 0);
+
+  if ( MAP_FAILED == map_y ) {
+    fprintf(stderr, "newt: ring mmap failed: %s\r\n", strerror(errno));
+    return 0;
+  }
+
+  rin_u = c3_calloc(sizeof(*rin_u));
+  rin_u->mem_i = mem_i;
+  rin_u->wak_i = wak_i;
+  rin_u->pir_i = pir_i;
+  rin_u->map_y = map_y;
+  rin_u->map_i = map_i;
+  rin_u->liv_o = c3y;
+
+  //  the king writes the first ring, the serf the second
+  //
+  {
+    u3_rung* one_u = (u3_rung*)map_y;
+    u3_rung* two_u = (u3_rung*)(map_y + _newt_ring_hed + _newt_ring_len);
+
+    rin_u->out_u = ( c3y == kin_o ) ? one_u : two_u;
+    rin_u->inn_u = ( c3y == kin_o ) ? two_u : one_u;
+  }
+
+  uv_poll_init(u3L, &rin_u->pol_u, wak_i);
+  rin_u->pol_u.data = rin_u;
+  uv_poll_start(&rin_u->pol_u, UV_READABLE, _newt_ring_wake_cb);
+
+  return rin_u;
+}
+
+/* u3_newt_ring_make(): create shared-memory transport, or 0.
+*/
+u3_ring*
+u3_newt_ring_make(void)
+{
+  size_t   map_i = 2 * (_newt_ring_hed + _newt_ring_len);
+  c3_i     mem_i, wak_i, pir_i;
+  u3_ring* rin_u;
+
+  if ( 0 > (mem_i = memfd_create("urbit-ipc", MFD_CLOEXEC)) ) {
+    fprintf(stderr, "newt: ring memfd failed: %s\r\n", strerror(errno));
+    return 0;
+  }
+
+  if ( ftruncate(mem_i, map_i) ) {
+    fprintf(stderr, "newt: ring truncate failed: %s\r\n", strerror(errno));
+    close(mem_i);
+    return 0;
+  }
+
+  if ( 0 > (wak_i = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) ) {
+    fprintf(stderr, "newt: ring eventfd failed: %s\r\n", strerror(errno));
+    close(mem_i);
+    return 0;
+  }
+
+  if ( 0 > (pir_i = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) ) {
+    fprintf(stderr, "newt: ring eventfd failed: %s\r\n", strerror(errno));
+    close(mem_i);
+    close(wak_i);
+    return 0;
+  }
+
+  if ( !(rin_u = _newt_ring_init(mem_i, wak_i, pir_i, c3y)) ) {
+    close(mem_i);
+    close(wak_i);
+    close(pir_i);
+    return 0;
+  }
+
+  //  both consumers start asleep, so the first write wakes them
+  //
+  rin_u->out_u->siz_d = rin_u->inn_u->siz_d = _newt_ring_len;
+  rin_u->out_u->nap_w = rin_u->inn_u->nap_w = 1;
+
+  return rin_u;
+}
+
+/* u3_newt_ring_join(): map a peer's shared-memory transport, or 0.
+*/
+u3_ring*
+u3_newt_ring_join(c3_i mem_i, c3_i wak_i, c3_i pir_i)
+{
+  struct stat buf_u;
+  u3_ring*    rin_u;
+
+  if (  fstat(mem_i, &buf_u)
+     || (buf_u.st_size != 2 * (_newt_ring_hed + _newt_ring_len)) )
+  {
+    fprintf(stderr, "newt: ring join: bad shared memory\r\n");
+    return 0;
+  }
+
+  if ( !(rin_u = _newt_ring_init(mem_i, wak_i, pir_i, c3n)) ) {
+    return 0;
+  }
+
+  if (  (_newt_ring_len != rin_u->inn_u->siz_d)
+     || (_newt_ring_len != rin_u->out_u->siz_d) )
+  {
+    fprintf(stderr, "newt: ring join: bad ring length\r\n");
+    u3_newt_ring_stop(rin_u);
+    return 0;
+  }
+
+  return rin_u;
+}
+
+/* u3_newt_ring_read(): start delivering inbound msgs to [mot_u].
+*/
+void
+u3_newt_ring_read(u3_ring* rin_u, u3_moat* mot_u)
+{
+  rin_u->mot_u = mot_u;
+
+  //  wake ourselves, for anything sent before we were listening
+  //
+  {
+    c3_d one_d = 1;
+
+    if ( sizeof(one_d) != write(rin_u->wak_i, &one_d, sizeof(one_d)) ) {
+      fprintf(stderr, "newt: ring wake failed: %s\r\n", strerror(errno));
+    }
+  }
+}
+
+/* u3_newt_ring_send(): write buffer to ring.
+*/
+void
+u3_newt_ring_send(u3_ring* rin_u, c3_d len_d, c3_y* byt_y)
+{
+  u3_pend pen_u = { .nex_u = 0, .len_d = len_d, .off_d = 0, .byt_y = byt_y };
+
+  c3_assert( len_d );
+
+  //  fast path: written in full
+  //
+  if (  !rin_u->ext_u
+     && (c3y == _newt_ring_put(rin_u, &pen_u)) )
+  {
+    c3_free(byt_y);
+    return;
+  }
+
+  //  wait for space, after anything already waiting
+  //
+  {
+    u3_pend* nex_u = c3_malloc(sizeof(*nex_u));
+    *nex_u = pen_u;
+
+    if ( rin_u->ent_u ) {
+      rin_u->ent_u->nex_u = nex_u;
+      rin_u->ent_u = nex_u;
+    }
+    else {
+      rin_u->ent_u = rin_u->ext_u = nex_u;
+    }
+  }
+}
+
+/* _newt_ring_free_cb(): dispose ring after close.
+*/
+static void
+_newt_ring_free_cb(uv_handle_t* had_u)
+{
+  u3_ring* rin_u = had_u->data;
+  u3_pend* pen_u = rin_u->ext_u;
+
+  while ( pen_u ) {
+    u3_pend* nex_u = pen_u->nex_u;
+    c3_free(pen_u->byt_y);
+    c3_free(pen_u);
+    pen_u = nex_u;
+  }
+
+  munmap(rin_u->map_y, rin_u->map_i);
+  close(rin_u->mem_i);
+  close(rin_u->wak_i);
+  close(rin_u->pir_i);
+  c3_free(rin_u->fag_y);
+  c3_free(rin_u);
+}
+
+/* u3_newt_ring_stop(): stop and dispose, asynchronously.
+*/
+void
+u3_newt_ring_stop(u3_ring* rin_u)
+{
+  rin_u->liv_o = c3n;
+  rin_u->mot_u = 0;
+  uv_close((uv_handle_t*)&rin_u->pol_u, _newt_ring_free_cb);
+}
+
+/* u3_newt_ring_info(): status info as $mass.
+*/
+u3_noun
+u3_newt_ring_info(u3_ring* rin_u)
+{
+  u3_pend* pen_u = rin_u->ext_u;
+  c3_w     len_w = 0;
+
+  while ( pen_u ) {
+    len_w++;
+    pen_u = pen_u->nex_u;
+  }
+
+  return u3_pier_mass(
+    c3__ring,
+    u3i_list(
+      u3_pier_mase("pending-outbound", u3i_word(len_w)),
+      u3_pier_mase("inbound-bytes",
+        u3i_chub(rin_u->inn_u->hed_d - rin_u->inn_u->tal_d)),
+      u3_pier_mase("outbound-bytes",
+        u3i_chub(rin_u->out_u->hed_d - rin_u->out_u->tal_d)),
+      u3_none));
+}
+
+#else
+
+u3_ring*
+u3_newt_ring_make(void)
+{
+  return 0;
+}
+
+u3_ring*
+u3_newt_ring_join(c3_i mem_i, c3_i wak_i, c3_i pir_i)
+{
+  return 0;
+}
+
+void
+u3_newt_ring_read(u3_ring* rin_u, u3_moat* mot_u)
+{
+  c3_assert(0);
+}
+
+void
+u3_newt_ring_send(u3_ring* rin_u, c3_d len_d, c3_y* byt_y)
+{
+  c3_assert(0);
+}
+
+void
+u3_newt_ring_stop(u3_ring* rin_u)
+{
+  c3_assert(0);
+}
+
+u3_noun
+u3_newt_ring_info(u3_ring* rin_u)
+{
+  c3_assert(0);
+}
+
+#endif /* U3_OS_linux */
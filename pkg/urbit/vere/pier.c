@@ -8,14 +8,298 @@
 #define PIER_READ_BATCH 1000ULL
 #define PIER_PLAY_BATCH 500ULL
 #define PIER_WORK_BATCH 10ULL
+#define PIER_SCRY_CACHE 1000
+#define PIER_SCRY_FIXED 1000
 
 #undef VERBOSE_PIER
 
+/* struct _cp_scry: scry in flight, to be cached on response.
+*/
+struct _cp_scry {
+  struct _u3_pier* pir_u;               //  pier backpointer
+  void*            ptr_v;               //  original context
+  u3_peek_cb       fun_f;               //  original callback
+  u3_noun            key;               //  cache key
+  c3_o             fix_o;               //  immutable
+  c3_o             red_o;               //  answered by a scry reader
+};
+
+/* _pier_sky_key(): scry cache key, ignoring context.
+*/
+static u3_noun
+_pier_sky_key(u3_pico* pic_u)
+{
+  switch ( pic_u->typ_e ) {
+    default: c3_assert(0);
+
+    case u3_pico_full: {
+      return u3nt(c3__full, u3k(pic_u->gan), u3k(pic_u->ful));
+    }
+
+    case u3_pico_once: {
+      return u3nc(c3__once, u3nq(u3k(pic_u->gan),
+                                 pic_u->las_u.car_m,
+                                 u3k(pic_u->las_u.des),
+                                 u3k(pic_u->las_u.pax)));
+    }
+  }
+}
+
+/* _pier_sky_care(): yes if [car] is a clay care.
+*/
+static c3_o
+_pier_sky_care(u3_noun car)
+{
+  return __(  (c3y == u3a_is_cat(car))
+           && ('c' == (car & 0xff)) );
+}
+
+/* _pier_sky_fixed(): yes if scry is a clay read at a revision (%ud) case.
+**
+**   clay's namespace is immutable, so such a result can never change;
+**   %da cases are excluded, as they may refer to the future.
+*/
+static c3_o
+_pier_sky_fixed(u3_pico* pic_u)
+{
+  u3_noun hed, tal;
+
+  if (  (u3_pico_full != pic_u->typ_e)
+     || (c3n == u3r_cell(pic_u->ful, &hed, &tal)) )
+  {
+    return c3n;
+  }
+
+  //  [%.n %beam care [[ship desk [%ud @]] path]]
+  //
+  if ( c3n == hed ) {
+    u3_noun tag, car, bem, bek, cas, num;
+
+    return __(  (c3y == u3r_trel(tal, &tag, &car, &bem))
+             && (c3__beam == tag)
+             && (c3y == _pier_sky_care(car))
+             && (c3y == u3r_cell(bem, &bek, 0))
+             && (c3y == u3r_trel(bek, 0, 0, &cas))
+             && (c3y == u3r_p(cas, c3__ud, &num))
+             && (c3y == u3a_is_atom(num)) );
+  }
+  //  [%.y /care/ship/desk/case/...], with an @ud case
+  //
+  else {
+    u3_weak car = u3r_at(2, tal);
+    u3_weak cas = u3r_at(30, tal);
+    u3_weak num;
+
+    if (  (u3_none == car)
+       || (c3n == _pier_sky_care(car))
+       || (u3_none == cas)
+       || (c3n == u3a_is_atom(cas))
+       || (u3_none == (num = u3s_sift_ud(cas))) )
+    {
+      return c3n;
+    }
+
+    u3z(num);
+    return c3y;
+  }
+}
+
+/* _pier_sky_turn(): drop cached results from previous events.
+*/
+static void
+_pier_sky_turn(u3_pier* pir_u)
+{
+  c3_d eve_d = pir_u->god_u->eve_d;
+
+  if ( eve_d != pir_u->sky_u.eve_d ) {
+    u3h_free(pir_u->sky_u.nex_p);
+    pir_u->sky_u.nex_p = u3h_new_cache(PIER_SCRY_CACHE);
+    pir_u->sky_u.eve_d = eve_d;
+  }
+}
+
+/* _pier_sky_init(): initialize scry cache.
+*/
+static void
+_pier_sky_init(u3_pier* pir_u)
+{
+  pir_u->sky_u.eve_d = pir_u->god_u->eve_d;
+  pir_u->sky_u.nex_p = u3h_new_cache(PIER_SCRY_CACHE);
+  pir_u->sky_u.fix_p = u3h_new_cache(PIER_SCRY_FIXED);
+}
+
+/* _pier_sky_free(): dispose scry cache and undelivered hits.
+*/
+static void
+_pier_sky_free(u3_pier* pir_u)
+{
+  u3_scry* sry_u = pir_u->sky_u.ext_u;
+  u3_scry* nex_u;
+
+  while ( sry_u ) {
+    nex_u = sry_u->nex_u;
+    u3z(sry_u->res);
+    c3_free(sry_u);
+    sry_u = nex_u;
+  }
+
+  pir_u->sky_u.ent_u = pir_u->sky_u.ext_u = 0;
+
+  if ( pir_u->sky_u.nex_p ) {
+    u3h_free(pir_u->sky_u.nex_p);
+    pir_u->sky_u.nex_p = 0;
+  }
+
+  if ( pir_u->sky_u.fix_p ) {
+    u3h_free(pir_u->sky_u.fix_p);
+    pir_u->sky_u.fix_p = 0;
+  }
+}
+
+/* _pier_sky_done(): scry response, cache and forward.
+*/
+static void
+_pier_sky_done(void* ptr_v, u3_noun res)
+{
+  struct _cp_scry* sky_u = ptr_v;
+  u3_pier*         pir_u = sky_u->pir_u;
+
+  if (  (u3_psat_work == pir_u->sat_e)
+     && pir_u->sky_u.fix_p
+     && pir_u->god_u
+     && (c3y == u3du(res)) )
+  {
+    //  only found results are immutable
+    //
+    if ( c3y == sky_u->fix_o ) {
+      if ( c3y == u3du(u3t(res)) ) {
+        u3h_put(pir_u->sky_u.fix_p, sky_u->key, u3k(res));
+      }
+    }
+    //  serf responses arrive in order, and so reflect the state as of
+    //  the last completed event. scry readers may be behind it.
+    //
+    else if ( c3n == sky_u->red_o ) {
+      _pier_sky_turn(pir_u);
+      u3h_put(pir_u->sky_u.nex_p, sky_u->key, u3k(res));
+    }
+  }
+
+  sky_u->fun_f(sky_u->ptr_v, res);
+
+  u3z(sky_u->key);
+  c3_free(sky_u);
+}
+
+/* u3_pier_sky_look(): check scry cache, queueing a hit for delivery,
+**                    or wrapping [pic_u]'s callback to cache its response.
+*/
+c3_o
+u3_pier_sky_look(u3_pier* pir_u, u3_pico* pic_u)
+{
+  u3_noun key = _pier_sky_key(pic_u);
+  c3_o  fix_o = _pier_sky_fixed(pic_u);
+  u3_weak res;
+
+  if ( c3y == fix_o ) {
+    res = u3h_get(pir_u->sky_u.fix_p, key);
+  }
+  else {
+    _pier_sky_turn(pir_u);
+    res = u3h_get(pir_u->sky_u.nex_p, key);
+  }
+
+  //  hits are delivered from the event loop, not reentrantly
+  //
+  if ( u3_none != res ) {
+    u3_scry* sry_u = c3_malloc(sizeof(*sry_u));
+    sry_u->nex_u = 0;
+    sry_u->ptr_v = pic_u->ptr_v;
+    sry_u->fun_f = pic_u->fun_f;
+    sry_u->res   = res;
+
+    if ( !pir_u->sky_u.ent_u ) {
+      c3_assert( !pir_u->sky_u.ext_u );
+      pir_u->sky_u.ent_u = pir_u->sky_u.ext_u = sry_u;
+    }
+    else {
+      pir_u->sky_u.ent_u->nex_u = sry_u;
+      pir_u->sky_u.ent_u = sry_u;
+    }
+
+    pir_u->sky_u.hit_d++;
+    u3z(key);
+    u3_pier_spin(pir_u);
+    return c3y;
+  }
+  else {
+    struct _cp_scry* sky_u = c3_malloc(sizeof(*sky_u));
+    sky_u->pir_u = pir_u;
+    sky_u->ptr_v = pic_u->ptr_v;
+    sky_u->fun_f = pic_u->fun_f;
+    sky_u->key   = key;
+    sky_u->fix_o = fix_o;
+    sky_u->red_o = c3n;
+
+    pic_u->ptr_v = sky_u;
+    pic_u->fun_f = _pier_sky_done;
+
+    pir_u->sky_u.mis_d++;
+    return c3n;
+  }
+}
+
+/* _pier_sky_kick(): deliver cached scry results.
+*/
+static void
+_pier_sky_kick(u3_pier* pir_u)
+{
+  u3_scry* sry_u = pir_u->sky_u.ext_u;
+  u3_scry* nex_u;
+
+  //  detach the queue, as callbacks may scry again
+  //
+  pir_u->sky_u.ent_u = pir_u->sky_u.ext_u = 0;
+
+  while ( sry_u ) {
+    nex_u = sry_u->nex_u;
+    sry_u->fun_f(sry_u->ptr_v, sry_u->res);
+    c3_free(sry_u);
+    sry_u = nex_u;
+  }
+}
+
 /* _pier_peek_plan(): add a u3_pico to the peek queue
 */
 static void
 _pier_peek_plan(u3_pier* pir_u, u3_pico* pic_u)
 {
+  if (  (u3_psat_work == pir_u->sat_e)
+     && pir_u->sky_u.fix_p )
+  {
+    struct _cp_scry* sky_u;
+
+    //  answer from the scry cache, if we can
+    //
+    if ( c3y == u3_pier_sky_look(pir_u, pic_u) ) {
+      u3_pico_free(pic_u);
+      return;
+    }
+
+    //  on a miss, the callback context is our cache entry
+    //
+    sky_u = pic_u->ptr_v;
+
+    //  dispatch to a scry reader immediately, if one has seen every
+    //  event whose effects we've released (see u3_lord_gaze())
+    //
+    if ( c3y == u3_lord_gaze(pir_u->god_u, pir_u->wok_u->fec_u.rel_d, pic_u) ) {
+      sky_u->red_o = c3y;
+      u3_pico_free(pic_u);
+      return;
+    }
+  }
+
   if (!pir_u->pec_u.ent_u) {
     c3_assert( !pir_u->pec_u.ext_u );
     pir_u->pec_u.ent_u = pir_u->pec_u.ext_u = pic_u;
@@ -242,6 +526,8 @@ _pier_work(u3_work* wok_u)
 {
   u3_pier* pir_u = wok_u->pir_u;
 
+  _pier_sky_kick(pir_u);
+
   if ( c3n == pir_u->liv_o ) {
     pir_u->liv_o = u3_auto_live(wok_u->car_u);
 
@@ -542,6 +828,7 @@ _pier_work_init(u3_pier* pir_u)
   wok_u->fec_u.rel_d = pir_u->log_u->dun_d;
 
   _pier_work_time(pir_u);
+  _pier_sky_init(pir_u);
 
   //  XX plan kelvin event
   //
@@ -1156,9 +1443,11 @@ _pier_on_lord_play_bail(void* ptr_v, u3_info fon_u,
       u3l_log("pier: (%" PRIu64 "): play: bail\r\n", eve_d);
       u3_pier_punt_goof("play", dud);
       {
+        u3_noun job = u3_fact_job(tac_u);
         u3_noun wir, tag;
-        u3x_qual(tac_u->job, 0, &wir, &tag, 0);
+        u3x_qual(job, 0, &wir, &tag, 0);
         u3_pier_punt_ovum("play", u3k(wir), u3k(tag));
+        u3z(job);
       }
 
       u3_pier_bail(pir_u);
@@ -1406,6 +1695,21 @@ _pier_on_lord_live(void* ptr_v)
     c3_assert( u3_psat_init == pir_u->sat_e );
     c3_assert( log_u->sen_d == log_u->dun_d );
 
+    //  the log has been chopped past our snapshot
+    //
+    if (  (god_u->eve_d < log_u->dun_d)
+       && ((1ULL + god_u->eve_d) < log_u->fir_d) )
+    {
+      fprintf(stderr, "pier: snapshot at event %" PRIu64 " precedes the"
+                      " event log, which starts at %" PRIu64 "\r\n",
+                      god_u->eve_d, log_u->fir_d);
+      fprintf(stderr, "pier: restore the snapshot for epoch %" PRIu64
+                      " with 'urbit queu'\r\n",
+                      log_u->epo_d);
+      u3_pier_bail(pir_u);
+      return;
+    }
+
     if ( god_u->eve_d < log_u->dun_d ) {
       c3_d eve_d;
 
@@ -1509,6 +1813,12 @@ u3_pier_info(u3_pier* pir_u)
                        ( wok_u->wal_u
                          ? u3i_chub(wok_u->wal_u->eve_d)
                          : 0)),
+          u3_pier_mass(u3i_string("scry-cache"),
+            u3i_list(
+              u3_pier_mase("event", u3i_chub(pir_u->sky_u.eve_d)),
+              u3_pier_mase("hits", u3i_chub(pir_u->sky_u.hit_d)),
+              u3_pier_mase("misses", u3i_chub(pir_u->sky_u.mis_d)),
+              u3_none)),
           u3_pier_mass(c3__auto, u3_auto_info(wok_u->car_u)),
           u3_none));
     } break;
@@ -1581,6 +1891,12 @@ u3_pier_slog(u3_pier* pir_u)
           u3l_log("  wall: %" PRIu64 "\n", wok_u->wal_u->eve_d);
         }
 
+        u3l_log("  scry cache: event=%" PRIu64
+                " hits=%" PRIu64 " misses=%" PRIu64 "\n",
+                pir_u->sky_u.eve_d,
+                pir_u->sky_u.hit_d,
+                pir_u->sky_u.mis_d);
+
         if ( wok_u->car_u ) {
           u3_auto_slog(wok_u->car_u);
         }
@@ -1724,9 +2040,13 @@ _pier_pill_parse(u3_noun pil)
   u3x_cell(pil, &pil_p, &pil_q);
 
   {
-    //  XX use faster cue
+    //  a pill read from a file was cued as it was read
+    //
+    //    XX use faster cue
     //
-    u3_noun pro = u3m_soft(0, u3ke_cue, u3k(pil_p));
+    u3_noun pro = ( c3y == u3du(pil_p) )
+                  ? u3nc(u3_blip, u3k(pil_p))
+                  : u3m_soft(0, u3ke_cue, u3k(pil_p));
     u3_noun mot, tag, dat;
 
     if (  (c3n == u3r_trel(pro, &mot, &tag, &dat))
@@ -2094,6 +2414,10 @@ _pier_work_close_cb(uv_handle_t* idl_u)
 static void
 _pier_work_close(u3_work* wok_u)
 {
+  //  undelivered scry results reference drivers
+  //
+  _pier_sky_free(wok_u->pir_u);
+
   u3_auto_exit(wok_u->car_u);
 
   //  free pending effects
@@ -2454,5 +2778,29 @@ u3_pier_sway(c3_l tab_l, u3_noun tax)
 c3_w
 u3_pier_mark(FILE* fil_u)
 {
-  return 0;
+  u3_pier* pir_u = u3K.pir_u;
+  c3_w     tot_w = 0;
+
+  while ( pir_u ) {
+    if ( u3_psat_work == pir_u->sat_e ) {
+      u3_scry* sry_u = pir_u->sky_u.ext_u;
+
+      if ( pir_u->sky_u.nex_p ) {
+        tot_w += u3h_mark(pir_u->sky_u.nex_p);
+      }
+
+      if ( pir_u->sky_u.fix_p ) {
+        tot_w += u3h_mark(pir_u->sky_u.fix_p);
+      }
+
+      while ( sry_u ) {
+        tot_w += u3a_mark_noun(sry_u->res);
+        sry_u = sry_u->nex_u;
+      }
+    }
+
+    pir_u = pir_u->nex_u;
+  }
+
+  return u3a_maid(fil_u, "scry cache", tot_w);
 }
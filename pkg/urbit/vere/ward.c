@@ -74,16 +74,48 @@ u3_fact_init(c3_d eve_d, c3_l mug_l, u3_noun job)
   tac_u->mug_l = mug_l;
   tac_u->nex_u = 0;
   tac_u->job   = job;
+  tac_u->hun_y = 0;
+  tac_u->len_i = 0;
 
   return tac_u;
 }
 
+/* u3_fact_load(): initialize event from raw log entry, uncued.
+*/
+u3_fact*
+u3_fact_load(c3_d eve_d, c3_l mug_l, size_t len_i, const c3_y* byt_y)
+{
+  u3_fact *tac_u = u3_fact_init(eve_d, mug_l, u3_none);
+  tac_u->hun_y = c3_malloc(len_i);
+  tac_u->len_i = len_i;
+  memcpy(tac_u->hun_y, byt_y, len_i);
+
+  return tac_u;
+}
+
+/* u3_fact_job(): produce event (pair date ovum), cueing if needed.
+*/
+u3_noun
+u3_fact_job(u3_fact* tac_u)
+{
+  if ( u3_none == tac_u->job ) {
+    c3_assert( tac_u->hun_y && (4 < tac_u->len_i) );
+    tac_u->job = u3ke_cue(u3i_bytes(tac_u->len_i - 4, tac_u->hun_y + 4));
+  }
+
+  return u3k(tac_u->job);
+}
+
 /* u3_fact_free(): dispose completed event.
 */
 void
 u3_fact_free(u3_fact *tac_u)
 {
-  u3z(tac_u->job);
+  if ( u3_none != tac_u->job ) {
+    u3z(tac_u->job);
+  }
+
+  c3_free(tac_u->hun_y);
   c3_free(tac_u);
 }
 
@@ -17,6 +17,7 @@
   $%  $:  %live
           $%  [%cram eve=@]
               [%exit cod=@]
+              [%fork red=@ud]
               [%save eve=@]
               [%meld ~]
               [%pack ~]
@@ -25,6 +26,14 @@
       [%play eve=@ lit=(list ?((pair @da ovum) *))]
       [%work mil=@ job=(pair @da ovum)]
   ==
+::
+::    NB: %play arrives as a frame of raw event log entries,
+::    not a jam (see vere/lord.c); it's parsed in daemon/main.c
+::
+::    NB: [%live %fork red] forks a scry reader on its own pipes
+::    (see daemon/main.c), which only accepts %peek, and only
+::    sends %peek, %slog, and %flog
+::
 ::  +plea: from serf to king
 ::
 +$  plea
@@ -233,6 +242,11 @@ _serf_grab(u3_noun sac)
     u3a_print_memory(fil_u, "free lists", u3a_idle(u3R));
     u3a_print_memory(fil_u, "sweep", u3a_sweep());
 
+    if ( u3C.wag_w & u3o_debug_cpu ) {
+      fprintf(fil_u, "\r\n");
+      u3n_damp(fil_u);
+    }
+
     fflush(fil_u);
 
 #ifdef U3_MEMORY_LOG
@@ -293,6 +307,10 @@ u3_serf_grab(void)
     u3a_print_memory(stderr, "free lists", u3a_idle(u3R));
     u3a_print_memory(stderr, "sweep", u3a_sweep());
     fprintf(stderr, "\r\n");
+
+    if ( u3C.wag_w & u3o_debug_cpu ) {
+      u3n_damp(stderr);
+    }
   }
 
   fflush(stderr);
@@ -801,7 +819,7 @@ u3_serf_play(u3_serf* sef_u, c3_d eve_d, u3_noun lit)
 u3_noun
 u3_serf_peek(u3_serf* sef_u, c3_w mil_w, u3_noun sam)
 {
-  u3_noun gon = u3m_soft(mil_w, u3v_peek, sam);
+  u3_noun gon = u3m_soft_sand(mil_w, u3v_peek, sam);
   u3_noun pro;
 
   {
@@ -831,6 +849,10 @@ u3_serf_peek(u3_serf* sef_u, c3_w mil_w, u3_noun sam)
 static void
 _serf_writ_live_exit(u3_serf* sef_u, c3_w cod_w)
 {
+  //  finish any snapshot in progress
+  //
+  u3e_wait();
+
   if ( u3C.wag_w & u3o_debug_cpu ) {
     FILE* fil_u;
 
@@ -856,6 +878,7 @@ _serf_writ_live_exit(u3_serf* sef_u, c3_w cod_w)
     }
 
     u3t_damp(fil_u);
+    u3n_damp(fil_u);
 
     {
       fclose(fil_u);
@@ -883,7 +906,7 @@ _serf_writ_live_save(u3_serf* sef_u, c3_d eve_d)
     exit(1);
   }
 
-  u3e_save();
+  u3e_save_async();
 }
 
 /* u3_serf_live(): apply %live command [com], producing *ret on c3y.
@@ -1000,6 +1023,24 @@ u3_serf_live(u3_serf* sef_u, u3_noun com, u3_noun* ret)
       *ret = u3nc(c3__live, u3_nul);
       return c3y;
     }
+
+    //  (re)start a read-only fork of the current state, to answer %peek
+    //
+    case c3__fork: {
+      c3_w red_w;
+
+      if (  !sef_u->fok_f
+         || (c3n == u3r_safe_word(dat, &red_w)) )
+      {
+        u3z(com);
+        return c3n;
+      }
+
+      u3z(com);
+      sef_u->fok_f(red_w);
+      *ret = u3nc(c3__live, u3_nul);
+      return c3y;
+    }
   }
 }
 